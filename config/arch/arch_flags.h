@@ -637,6 +637,17 @@
 #     uC.PERIPH["EFR32MG1V132F256GM32"]    = {GPIO = true, UART = true}
 #     uC.PERIPH["EFR32MG1V132F256GM48"]    = {GPIO = true, UART = true}
 # end
+#
+# if uC.ARCH == "linux" then
+#     uC.AddPriorityItems = function(this, no_default)
+#         this:AddItem("Priority 0 (the only one)", "0")
+#         if no_default ~= true then
+#             this:AddItem("Default priority", "__CPU_DEFAULT_IRQ_PRIORITY__")
+#         end
+#     end
+#
+#     uC.PERIPH["LINUX"] = {UART = true, VDISK = true}
+# end
 #++*/
 
 #/* include of CPU mandatory file in Makefile
@@ -720,6 +731,9 @@ include ./config/arch/$(__CPU_ARCH__)/cpu_flags.h
 #include "efr32/cpu_flags.h"
 #include "efr32/gpio_flags.h"
 #include "efr32/uart_flags.h"
+#elif (__CPU_ARCH__ == linux)
+#include "linux/cpu_flags.h"
+#include "linux/uart_flags.h"
 #endif
 
 #/*--
@@ -1064,6 +1078,20 @@ __ENABLE_SPIEE__=_NO_
 __ENABLE_SND__=_NO_
 #*/
 
+#/*--
+# if uC.PERIPH[uC.NAME].VDISK ~= nil then
+#     this:PutWidgets("VDISK")
+#     this:SetToolTip("Virtual disk driver. Image file of the host is used as storage.")
+# else
+#     this:AddWidget("Value")
+#     this:SetFlagValue("__ENABLE_VDISK__", "_NO_")
+# end
+#--*/
+#define __ENABLE_VDISK__ _NO_
+#/*
+__ENABLE_VDISK__=_NO_
+#*/
+
 #// MODULE LIST END
 #//-----------------------------------------------------------------------------
 #/*-- save current configuration if CPU was changed
@@ -0,0 +1,103 @@
+#/*=============================================================================
+# @file    cpu_flags.h
+#
+# @author  Daniel Zorychta
+#
+# @brief   This file contains CPU configuration flags.
+#          Hybrid file: included both by Make and CC.
+#
+# @note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+#
+#          This program is free software; you can redistribute it and/or modify
+#          it under the terms of the GNU General Public License as published by
+#          the Free Software Foundation and modified by the dnx RTOS exception.
+#
+#          NOTE: The modification  to the GPL is  included to allow you to
+#                distribute a combined work that includes dnx RTOS without
+#                being obliged to provide the source  code for proprietary
+#                components outside of the dnx RTOS.
+#
+#          The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+#          but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+#          MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+#          GNU General Public License for more details.
+#
+#          Full license text is available on the following file: doc/license.txt.
+#
+#
+#=============================================================================*/
+
+#/*
+#* NOTE: All flags defined as: __FLAG_NAME__ (with doubled underscore as suffix
+#*       and prefix) are exported to the single configuration file
+#*       (by using Configtool) when entire project configuration is exported.
+#*       All other flag definitions and statements are ignored.
+#*/
+
+#ifndef _CPU_FLAGS_H_
+#define _CPU_FLAGS_H_
+
+#/*--
+# this:SetLayout("TitledGridBack", 2, "Home > Microcontroller > Selection",
+#                function() this:LoadFile("arch/arch_flags.h") end)
+#++*/
+
+#/*--
+# this:AddWidget("Value")
+#--*/
+#define __CPU_FAMILY__ HOST_PROCESS
+#/*
+__CPU_FAMILY__=HOST_PROCESS
+#*/
+
+#/*--
+# this:AddWidget("Value")
+#--*/
+#define __CPU_NAME__ LINUX
+#/*
+__CPU_NAME__=LINUX
+#*/
+
+#/*--
+# this:AddWidget("Spinbox", 256, 1048576, "RAM size [KiB]")
+# this:SetToolTip("Size of memory allocated from the host and used as a system RAM.")
+#--*/
+#define __CPU_RAM_SIZE__ 8192
+#/*
+__CPU_RAM_SIZE__=8192
+#*/
+
+#/*--
+# this:AddWidget("Combobox", "Default IRQ priority")
+# uC.AddPriorityItems(this, true)
+#--*/
+#define __CPU_DEFAULT_IRQ_PRIORITY__ 0
+
+
+#//-----------------------------------------------------------------------------
+#// mandatory flags, not configurable
+#//-----------------------------------------------------------------------------
+#define _CPU_START_FREQUENCY_           (1000000000UL)
+#define _CPU_HEAP_ALIGN_                (16)
+#define _CPU_IRQ_RTOS_KERNEL_PRIORITY_  (0)
+#define _CPU_IRQ_RTOS_SYSCALL_PRIORITY_ (0)
+#define _CPU_IRQ_RTOS_APICALL_PRIORITY_ (0)
+#define _CPU_IRQ_SAFE_PRIORITY_         (0)
+#define ARCH_linux
+#/*
+CPUCONFIG_AFLAGS=
+CPUCONFIG_CFLAGS=-fno-pie -funsigned-char
+CPUCONFIG_CXXFLAGS=-fno-pie -funsigned-char
+CPUCONFIG_LDFLAGS=-pthread -no-pie -Wl,--defsym=__text_start=__executable_start -Wl,--defsym=__text_end=__etext
+#*/
+
+#// CPU family
+#define HOST_PROCESS             0x0b7d5a13
+
+#// All CPU names definitions - general usage
+#define LINUX                    0x2c8e4f01
+
+#endif /* _CPU_FLAGS_H_ */
+#/*=============================================================================
+#  End of file
+#=============================================================================*/
@@ -44,6 +44,15 @@ this:AddWidget("Checkbox", "Enable file system debug")
 --*/
 #define __EEFS_LOG_ENABLE__ _NO_
 
+/*--
+this:AddWidget("Spinbox", 0, 32, "Number of cache blocks")
+this:SetToolTip("Number of 128 byte blocks cached by each mounted file system. "..
+                "Modified blocks are written to the memory at synchronization "..
+                "or block replacement (use 'sync' mount option for write-through). "..
+                "Value 0 disables cache.")
+--*/
+#define __EEFS_CFG_CACHE_BLOCKS__ 8
+
 #endif /* _EEFS_FLAGS_H_ */
 /*==============================================================================
   End of file
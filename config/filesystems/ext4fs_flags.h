@@ -76,6 +76,34 @@ this:AddItem("Write Back", "1")
 --*/
 #define __EXT4FS_CFG_WR_BUF_STRATEGY__ 1
 
+/*--
+this:AddWidget("Spinbox", 0, 60000, "Journal commit interval [ms]")
+this:SetToolTip("File operations are grouped in a single journal transaction "..
+                "which is committed by background thread after this time "..
+                "or on fflush(). Value 0 commits each operation in the caller "..
+                "context. The value can be changed by the 'commit=<ms>' mount option.")
+--*/
+#define __EXT4FS_CFG_COMMIT_INTERVAL__ 5000
+
+/*--
+this:AddWidget("Spinbox", 1, 1024, "Journal commit threshold [blocks]")
+this:SetToolTip("Background commit is started earlier when running transaction "..
+                "has this number of modified blocks. Transaction twice larger "..
+                "is committed in the caller context. Each block of transaction "..
+                "is kept in memory until commit.")
+--*/
+#define __EXT4FS_CFG_COMMIT_BLOCKS__ 32
+
+/*--
+this:AddWidget("Combobox", "Discard freed blocks (TRIM)")
+this:AddItem("Disable", "0")
+this:AddItem("Enable", "1")
+this:SetToolTip("Blocks freed by file remove or truncate are reported to the "..
+                "storage device after transaction commit, so flash devices "..
+                "can erase them in background.")
+--*/
+#define __EXT4FS_CFG_DISCARD__ 1
+
 #endif /* _EXT4FS_FLAGS_H_ */
 /*==============================================================================
   End of file
@@ -73,6 +73,24 @@ this:SetToolTip("When option is disabled, file system uses the sector buffer in
 --*/
 #define __FATFS_BUFFERED_FILE_ENABLE__ _YES_
 
+/*--
+this:AddWidget("Spinbox", 0, 65536, "Fast seek memory budget (bytes)")
+this:SetToolTip("Memory which can be used by cluster link maps of opened files "..
+                "on file system mounted with the 'fastseek' option. The map is "..
+                "created on first seek in a large file, so seek does not follow "..
+                "the FAT chain. The budget can be changed by the 'clmt=<bytes>' option.")
+--*/
+#define __FATFS_CLMT_BUDGET__ 1024
+
+/*--
+this:AddWidget("Checkbox", "Discard freed clusters (TRIM)")
+this:SetToolTip("When option is enabled, clusters freed by file remove or truncate "..
+                "are reported to the storage device (TRIM/discard), so flash "..
+                "devices can erase them in background. Storage device driver "..
+                "should support discard request.")
+--*/
+#define __FATFS_DISCARD_ENABLE__ _YES_
+
 #endif /* _FATFS_FLAGS_H_ */
 /*==============================================================================
   End of file
@@ -40,7 +40,12 @@ this:SetLayout("TitledGridBack", 2, "Home > File Systems > ramfs",
 ++*/
 
 /*--
-this:AddWidget("Spinbox", 8, 4096, "File chain size (bytes)")
+this:AddWidget("Spinbox", 512, 4096, "File data block size (bytes)")
+--*/
+#define __RAMFS_FILE_BLOCK_SIZE__ 1024
+
+/*--
+this:AddWidget("Spinbox", 8, 4096, "Small file tail block size (bytes)")
 --*/
 #define __RAMFS_FILE_CHAIN_SIZE__ 32
 
@@ -45,6 +45,32 @@ this:AddWidget("Checkbox", "Executable flag in regular files")
 --*/
 #define __ROMFS_CFG_EXEC_FILES__ _YES_
 
+/*--
+this:AddWidget("Checkbox", "Compress files")
+this:SetToolTip("Files are compressed by image generator (LZ4 block format). "..
+                "Blocks that cannot be compressed are stored not compressed.")
+--*/
+#define __ROMFS_CFG_COMPRESSION__ _YES_
+
+/*--
+this:AddWidget("Combobox", "Block size")
+this:SetToolTip("Files are compressed in blocks of selected size. Larger blocks "..
+                "give better compression, smaller blocks give faster random reads.")
+this:AddItem("256 bytes", "256")
+this:AddItem("512 bytes", "512")
+this:AddItem("1 KiB", "1024")
+this:AddItem("2 KiB", "2048")
+this:AddItem("4 KiB", "4096")
+--*/
+#define __ROMFS_CFG_BLOCK_SIZE__ 1024
+
+/*--
+this:AddWidget("Spinbox", 1, 16, "Number of cache blocks")
+this:SetToolTip("Number of decompressed blocks kept by each mounted file system. "..
+                "Cache block is allocated on demand and has size of the block.")
+--*/
+#define __ROMFS_CFG_CACHE_BLOCKS__ 2
+
 #endif /* _ROMFS_FLAGS_H_ */
 /*==============================================================================
   End of file
@@ -97,6 +97,15 @@ this:SetToolTip("Number of threads that can be started by system process.")
 --*/
 #define __OS_TASK_MAX_SYSTEM_THREADS__ 6
 
+/*--
+this:AddWidget("Spinbox", 0, 16, "Thread malloc cache depth [blocks]")
+this:SetToolTip("Number of recently freed small program memory blocks that are kept by each thread in every size class. "..
+                "Cached blocks are allocated again without heap search and scheduler locking. "..
+                "The cache is flushed when thread exits or when system runs out of memory.\n"..
+                "Set to 0 to disable the cache.")
+--*/
+#define __OS_TASK_MALLOC_MAGAZINE_DEPTH__ 2
+
 /*--
 this:AddExtraWidget("Label", "LabelFeatures", "\nSystem features (advanced)", -1, "bold")
 this:AddExtraWidget("Void", "VoidFeatures")
@@ -107,6 +116,14 @@ this:SetToolTip("If this option is selected then system is halted in the idle ta
 --*/
 #define __OS_SLEEP_ON_IDLE__ _NO_
 
+/*--
+this:AddWidget("Checkbox", "Tickless idle")
+this:SetToolTip("If this option is selected then system tick is stopped when all tasks are waiting. "..
+                "CPU sleeps until the nearest task timeout or interrupt (one-shot timer is used). "..
+                "Uptime and CPU load are updated by the number of skipped ticks.")
+--*/
+#define __OS_TICKLESS_IDLE__ _NO_
+
 /*--
 this:AddWidget("Checkbox", "Color terminal")
 this:SetToolTip("If this function is selected then terminal output can be colorized by using VT100 commands.")
@@ -271,6 +288,42 @@ this:SetToolTip("This option determine period of cache synchronization with stor
 --*/
 #define __OS_SYSTEM_CACHE_SYNC_PERIOD__ 30
 
+/*--
+this:AddWidget("Spinbox", 1, 8, "Cache synchronization threads")
+this:SetToolTip("Maximum number of threads used by cache synchronization. "..
+                "Modified file systems are synchronized in parallel, so "..
+                "slow storage does not delay synchronization of other devices. "..
+                "Each thread above the first is a kworker thread started at boot.")
+--*/
+#define __OS_SYSTEM_SYNC_THREADS__ 2
+
+/*--
+this:AddWidget("Spinbox", 0, 256, "VFS lookup cache entries")
+this:SetToolTip("Number of path lookup results (directories, regular files and not existing files) kept by the VFS. "..
+                "The cache is used by all file systems except these mounted with the 'nodcache' option "..
+                "and these which content is changed outside the VFS (e.g. procfs). "..
+                "Set to 0 to disable the cache.")
+--*/
+#define __OS_VFS_DENTRY_CACHE_SIZE__ 16
+
+/*--
+this:AddWidget("Spinbox", 0, 1024, "Block cache size (512 B blocks)")
+this:SetToolTip("Maximum number of device blocks cached by the block file systems "..
+                "(FAT, ext4, EEFS). Modified blocks are written to the device by "..
+                "the system cache synchronization. Blocks are allocated on demand "..
+                "and are released when the system is low on memory. "..
+                "Set to 0 to disable the cache.")
+--*/
+#define __OS_BLOCK_CACHE_SIZE__ 16
+
+/*--
+this:AddWidget("Spinbox", 1, 32, "Block cache burst (blocks)")
+this:SetToolTip("Maximum number of blocks transferred by a single device request. "..
+                "Sequential reads are read ahead and adjacent modified blocks are "..
+                "written together up to this number of blocks.")
+--*/
+#define __OS_BLOCK_CACHE_BURST__ 8
+
 /*--
 this:AddWidget("Spinbox", 0, 16777216, "Network memory limit [bytes]")
 this:SetToolTip("This option enables memory limit for network subsystem. Use 0 for no limit.")
@@ -304,6 +357,25 @@ this:SetToolTip("Enable/Disable block overflow check of heap memory.")
 --*/
 #define __OS_HEAP_OVERFLOW_CHECK__ _NO_
 
+/*--
+this:AddWidget("Combobox", "Heap small block size classes")
+this:AddItem("Disable", "_NO_")
+this:AddItem("Enable", "_YES_")
+this:SetToolTip("Enable/Disable segregated free lists of small blocks. Freed small blocks are kept in size class lists "..
+                "and are allocated again in constant time. Bigger blocks are allocated by using first-fit search.")
+--*/
+#define __OS_HEAP_SIZE_CLASSES__ _YES_
+
+/*--
+this:AddWidget("Combobox", "Kernel object pools")
+this:AddItem("Disable", "_NO_")
+this:AddItem("Enable", "_YES_")
+this:SetToolTip("Enable/Disable pools of fixed-size kernel objects (list items, files, directories, pipes, sockets). "..
+                "Objects are allocated from preallocated pages in constant time. Pages are allocated from the "..
+                "heap on demand and are kept until the pool is destroyed.")
+--*/
+#define __OS_MEMORY_POOLS__ _YES_
+
 
 /*--
 this:AddExtraWidget("Label", "LabelMisc", "\nMiscellaneous", -1, "bold")
@@ -82,6 +82,7 @@ __PROJECT_TOOLCHAIN__=arm-none-eabi-
 #define stm32f7 0x3cb2ba7c
 #define stm32h7 0x56A5cde6
 #define efr32   0xcd975039
+#define linux   0x7a1e03b5
 #/*--
 # this:AddWidget("Combobox", "CPU architecture")
 # this:AddItem("STMicroelectronics STM32F1", "stm32f1")
@@ -90,6 +91,7 @@ __PROJECT_TOOLCHAIN__=arm-none-eabi-
 # this:AddItem("STMicroelectronics STM32F7", "stm32f7")
 # this:AddItem("STMicroelectronics STM32H7", "stm32h7")
 # this:AddItem("Silicon Labs EFR32 Mighty Gecko (experimental)", "efr32")
+# this:AddItem("Linux host process (benchmarks)", "linux")
 #--*/
 #define __CPU_ARCH__ stm32f1
 #/*
@@ -144,6 +144,7 @@ There are documented libraries that are modified for system purposes.
 \li \subpage dnx-misc-h     The set of helpful macros and functions
 \li \subpage dnx-net-h      The set of networking functions
 \li \subpage dnx-os-h       The dnx RTOS specific functions
+\li \subpage dnx-ring-h     Batched system calls (submission and completion ring)
 \li \subpage dnx-thread-h   The set of functions for thread handling
 \li \subpage dnx-vt100-h    VT100 terminal handling
 \li \subpage sys-endian-h   Endianness
@@ -152,6 +153,7 @@ There are documented libraries that are modified for system purposes.
 \li \subpage sys-shm-h      Library contains functions for shared memory management
 \li \subpage sys-stat-h     Library contains functions for nodes create and information
 \li \subpage sys-statfs-h   File systems information
+\li \subpage sys-uio-h      Vectored and positional file I/O
 \li \subpage sys-types-h    System types
 \li \subpage sys-time-h     System set/get time
 \li \subpage assert-h       Program assertion macro
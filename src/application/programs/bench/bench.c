@@ -0,0 +1,420 @@
+/*==============================================================================
+File    bench.c
+
+Author  Daniel Zorychta
+
+Brief   Kernel benchmark suite (init program of host benchmark image)
+
+        Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+        This program is free software; you can redistribute it and/or modify
+        it under the terms of the GNU General Public License as published by
+        the Free Software Foundation and modified by the dnx RTOS exception.
+
+        NOTE: The modification  to the GPL is  included to allow you to
+              distribute a combined work that includes dnx RTOS without
+              being obliged to provide the source  code for proprietary
+              components outside of the dnx RTOS.
+
+        The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+        but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+        MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+        GNU General Public License for more details.
+
+        Full license text is available on the following file: doc/license.txt.
+
+==============================================================================*/
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mount.h>
+#include <sys/stat.h>
+#include <sys/ioctl.h>
+#include <dnx/os.h>
+#include <dnx/thread.h>
+#include <dnx/misc.h>
+
+/*==============================================================================
+  Local macros
+==============================================================================*/
+#define TTY_FILE                "/dev/ttyS0"
+#define FAT_DEV                 "/dev/vda"
+#define EXT4_DEV                "/dev/vdb"
+#define FAT_IMAGE               "fat.img"
+#define EXT4_IMAGE              "ext4.img"
+#define TEST_FILE               "bench.dat"
+#define FILE_SIZE_KIB           1024
+#define SYSCALL_CALLS           20000
+#define BLOCK_SIZE              4096
+
+#define TCL_SCRIPT              "set i 0; while {< $i 2000} {set i [+ $i 1]}; puts $i"
+
+/*==============================================================================
+  Local object types
+==============================================================================*/
+typedef struct {
+        const char *name;               /* step name */
+        const char *cmd;                /* program command, NULL if internal test */
+        int       (*test)(const char*); /* internal test function */
+        const char *dir;                /* mount point or internal test path */
+        const char *fs;                 /* file system mounted on dir for the step */
+        const char *dev;                /* device required by the step */
+} step_t;
+
+typedef enum {
+        PASSED,
+        FAILED,
+        SKIPPED
+} result_t;
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+static void     setup       (const char *fat_img, const char *ext4_img);
+static result_t run         (const step_t *step, u32_t *time);
+static int      run_program (const char *cmd);
+static int      syscall_test(const char *path);
+static int      file_test   (const char *dir);
+
+/*==============================================================================
+  Local objects
+==============================================================================*/
+GLOBAL_VARIABLES_SECTION {
+        bool    fat;
+        bool    ext4;
+        char    file[128];
+        u8_t    buf[BLOCK_SIZE];
+};
+
+static const step_t STEP[] = {
+        {"heap",        "resbench",                               NULL,          NULL,             NULL,      NULL    },
+        {"reaper",      "reapbench",                              NULL,          NULL,             NULL,      NULL    },
+        {"spawn",       "spawnbench",                             NULL,          NULL,             NULL,      NULL    },
+        {"syscalls",    NULL,                                     syscall_test,  "/proc/cpuinfo",  NULL,      NULL    },
+        {"ring",        "ringbench",                              NULL,          NULL,             NULL,      NULL    },
+        {"pipes",       "pipebench",                              NULL,          NULL,             NULL,      NULL    },
+        {"VFS lookup",  "vfsbench /tmp",                          NULL,          NULL,             NULL,      NULL    },
+        {"stat cache",  "statbench",                              NULL,          NULL,             NULL,      NULL    },
+        {"ramfs",       NULL,                                     file_test,     "/tmp",           NULL,      NULL    },
+        {"FAT file",    NULL,                                     file_test,     "/mnt/fat",       "fatfs",   FAT_DEV },
+        {"FAT seek",    "fseekbench " FAT_DEV " /mnt/fat 4 500",  NULL,          NULL,             NULL,      FAT_DEV },
+        {"ext4 file",   NULL,                                     file_test,     "/mnt/ext4",      "ext4fs",  EXT4_DEV},
+        {"ext4 sync",   "syncbench /mnt/ext4 256",                NULL,          "/mnt/ext4",      "ext4fs",  EXT4_DEV},
+        {"ext4 stat",   "statbench ext4fs " EXT4_DEV,             NULL,          NULL,             NULL,      EXT4_DEV},
+        {"printf",      "printfbench",                            NULL,          NULL,             NULL,      NULL    },
+        {"utcl",        "tcl -c \"" TCL_SCRIPT "\"",              NULL,          NULL,             NULL,      NULL    },
+};
+
+static const char *RESULT_STR[] = {
+        [PASSED]  = "PASSED",
+        [FAILED]  = "FAILED",
+        [SKIPPED] = "SKIPPED",
+};
+
+/*==============================================================================
+  Exported objects
+==============================================================================*/
+PROGRAM_PARAMS(bench, STACK_DEPTH_LOW);
+
+/*==============================================================================
+  External objects
+==============================================================================*/
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+
+//==============================================================================
+/**
+ * Main program function.
+ *
+ * Program is the init program of the host benchmark image (make bench). It
+ * creates base file system, initializes console and image disks, runs each
+ * benchmark program and internal test, prints summary and shuts down system.
+ * FAT and ext4 image file names can be given as arguments. Steps that require
+ * missing disk are skipped.
+ *
+ * @param argc      argument count
+ * @param argv      arguments
+ */
+//==============================================================================
+int main(int argc, char *argv[])
+{
+        setup(argc > 1 ? argv[1] : FAT_IMAGE, argc > 2 ? argv[2] : EXT4_IMAGE);
+
+        result_t result[ARRAY_SIZE(STEP)];
+        u32_t    time[ARRAY_SIZE(STEP)];
+        uint     failed = 0;
+
+        for (size_t i = 0; i < ARRAY_SIZE(STEP); i++) {
+                printf("\n=== %s ===\n", STEP[i].name);
+                fflush(stdout);
+
+                result[i] = run(&STEP[i], &time[i]);
+
+                if (result[i] == FAILED) {
+                        failed++;
+                }
+        }
+
+        puts("\nBenchmark summary:");
+
+        for (size_t i = 0; i < ARRAY_SIZE(STEP); i++) {
+                printf("  %s: %s (%u ms)\n",
+                       STEP[i].name, RESULT_STR[result[i]], cast(uint, time[i]));
+        }
+
+        if (failed) {
+                printf("bench: %u of %u steps FAILED\n", failed, cast(uint, ARRAY_SIZE(STEP)));
+        } else {
+                printf("bench: all steps passed\n");
+        }
+
+        fflush(stdout);
+        sync();
+        system_shutdown();
+
+        return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+//==============================================================================
+/**
+ * @brief  Function creates base file system and initializes console and disks.
+ *
+ * @param  fat_img      FAT image file
+ * @param  ext4_img     ext4 image file
+ */
+//==============================================================================
+static void setup(const char *fat_img, const char *ext4_img)
+{
+        mount("ramfs", "", "/", "");
+        mkdir("/dev", 0666);
+        mkdir("/tmp", 0666);
+        mkdir("/run", 0666);
+        mkdir("/proc", 0666);
+        mkdir("/mnt", 0666);
+        mkdir("/mnt/fat", 0666);
+        mkdir("/mnt/ext4", 0666);
+        mount("procfs", "", "/proc", "");
+
+        driver_init("UART", 0, 0, TTY_FILE);
+
+        stdout = fopen(TTY_FILE, "r+");
+        stderr = stdout;
+
+        VDISK_config_t cfg = {.path = fat_img, .read_only = false};
+        global->fat = driver_init2("VDISK", 0, 0, FAT_DEV, &cfg) >= 0;
+
+        cfg.path = ext4_img;
+        global->ext4 = driver_init2("VDISK", 1, 0, EXT4_DEV, &cfg) >= 0;
+
+        printf("dnx RTOS kernel benchmark (%s)\n", get_OS_name());
+        printf("FAT image: %s\n", global->fat ? fat_img : "none");
+        printf("ext4 image: %s\n", global->ext4 ? ext4_img : "none");
+}
+
+//==============================================================================
+/**
+ * @brief  Function runs single step and measures its time.
+ *
+ * @param  step         step to run
+ * @param  time         step time in ms
+ *
+ * @return Step result.
+ */
+//==============================================================================
+static result_t run(const step_t *step, u32_t *time)
+{
+        *time = 0;
+
+        if (  (step->dev && isstreq(step->dev, FAT_DEV)  && !global->fat)
+           || (step->dev && isstreq(step->dev, EXT4_DEV) && !global->ext4) ) {
+
+                printf("%s: disk not available\n", step->dev);
+                return SKIPPED;
+        }
+
+        if (step->fs && mount(step->fs, step->dev, step->dir, "") != 0) {
+                perror(step->dir);
+                return FAILED;
+        }
+
+        u64_t tstart = get_time_ms();
+
+        int err = step->cmd ? run_program(step->cmd) : step->test(step->dir);
+
+        *time = cast(u32_t, get_time_ms() - tstart);
+
+        if (step->fs && umount(step->dir) != 0) {
+                perror(step->dir);
+                err = -1;
+        }
+
+        return err ? FAILED : PASSED;
+}
+
+//==============================================================================
+/**
+ * @brief  Function starts program and waits for its exit.
+ *
+ * @param  cmd          program command
+ *
+ * @return 0 if program exited successfully, otherwise -1.
+ */
+//==============================================================================
+static int run_program(const char *cmd)
+{
+        static const process_attr_t attr = {
+                .p_stdin  = TTY_FILE,
+                .p_stdout = TTY_FILE,
+                .p_stderr = TTY_FILE,
+                .cwd      = "/",
+                .priority = PRIORITY_NORMAL,
+                .detached = false
+        };
+
+        pid_t pid = process_create(cmd, &attr);
+        if (pid == 0) {
+                perror(cmd);
+                return -1;
+        }
+
+        int status = -1;
+        if (process_wait(pid, &status, MAX_DELAY_MS) != 0) {
+                perror(cmd);
+                return -1;
+        }
+
+        return status == EXIT_SUCCESS ? 0 : -1;
+}
+
+//==============================================================================
+/**
+ * @brief  Function measures cost of simple system call and stat() call.
+ *
+ * @param  path         file used by stat()
+ *
+ * @return 0 on success, otherwise -1.
+ */
+//==============================================================================
+static int syscall_test(const char *path)
+{
+        pid_t pid = getpid();
+
+        u64_t tstart = get_time_ms();
+
+        for (int i = 0; i < SYSCALL_CALLS; i++) {
+                if (getpid() != pid) {
+                        return -1;
+                }
+        }
+
+        u32_t time = cast(u32_t, get_time_ms() - tstart);
+
+        printf("  getpid()   %6u ms  %6u ns/call\n", cast(uint, time),
+               cast(uint, (cast(u64_t, time) * 1000000) / SYSCALL_CALLS));
+
+        struct stat st;
+
+        tstart = get_time_ms();
+
+        for (int i = 0; i < SYSCALL_CALLS; i++) {
+                if (stat(path, &st) != 0) {
+                        perror(path);
+                        return -1;
+                }
+        }
+
+        time = cast(u32_t, get_time_ms() - tstart);
+
+        printf("  stat()     %6u ms  %6u ns/call\n", cast(uint, time),
+               cast(uint, (cast(u64_t, time) * 1000000) / SYSCALL_CALLS));
+
+        return 0;
+}
+
+//==============================================================================
+/**
+ * @brief  Function measures sequential write and read of file.
+ *
+ * @param  dir          test directory
+ *
+ * @return 0 on success, otherwise -1.
+ */
+//==============================================================================
+static int file_test(const char *dir)
+{
+        const u32_t blocks = FILE_SIZE_KIB * 1024 / BLOCK_SIZE;
+
+        snprintf(global->file, sizeof(global->file), "%s/%s", dir, TEST_FILE);
+
+        FILE *f = fopen(global->file, "w");
+        if (!f) {
+                perror(global->file);
+                return -1;
+        }
+
+        int err = 0;
+
+        u64_t tstart = get_time_ms();
+
+        for (u32_t i = 0; i < blocks && !err; i++) {
+                memset(global->buf, i, sizeof(global->buf));
+
+                if (fwrite(global->buf, 1, sizeof(global->buf), f) != sizeof(global->buf)) {
+                        err = -1;
+                }
+        }
+
+        if (fclose(f) != 0) {
+                err = -1;
+        }
+
+        u32_t wtime = cast(u32_t, get_time_ms() - tstart);
+
+        f = err ? NULL : fopen(global->file, "r");
+        if (!f) {
+                perror(global->file);
+                remove(global->file);
+                return -1;
+        }
+
+        tstart = get_time_ms();
+
+        for (u32_t i = 0; i < blocks && !err; i++) {
+                if (  fread(global->buf, 1, sizeof(global->buf), f) != sizeof(global->buf)
+                   || global->buf[0] != cast(u8_t, i)
+                   || global->buf[BLOCK_SIZE - 1] != cast(u8_t, i) ) {
+                        err = -1;
+                }
+        }
+
+        u32_t rtime = cast(u32_t, get_time_ms() - tstart);
+
+        fclose(f);
+
+        if (err) {
+                printf("%s: data mismatch\n", global->file);
+        } else {
+                printf("  write %u KiB  %6u ms  %6u KiB/s\n", FILE_SIZE_KIB,
+                       cast(uint, wtime), cast(uint, (FILE_SIZE_KIB * 1000) / max(1, wtime)));
+                printf("  read  %u KiB  %6u ms  %6u KiB/s\n", FILE_SIZE_KIB,
+                       cast(uint, rtime), cast(uint, (FILE_SIZE_KIB * 1000) / max(1, rtime)));
+        }
+
+        if (remove(global->file) != 0) {
+                perror(global->file);
+                err = -1;
+        }
+
+        return err;
+}
+
+/*==============================================================================
+  End of file
+==============================================================================*/
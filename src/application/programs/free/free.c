@@ -103,6 +103,8 @@ int main(int argc, char *argv[])
                 printf("  Programs   : %d\n", sysmem.programs_memory_usage);
                 printf("  Shared     : %d\n", sysmem.shared_memory_usage);
                 printf("  Cached     : %d\n", sysmem.cached_memory_usage);
+                printf("  Pools      : %d (%d free)\n", sysmem.pools_memory_usage,
+                                                        sysmem.pools_free_memory);
                 printf("  Static     : %d\n\n", sysmem.static_memory_usage);
 
                 printf("Detailed modules memory usage:\n");
@@ -111,6 +113,18 @@ int main(int argc, char *argv[])
                                get_module_name(module),
                                get_module_memory_usage(module));
                 }
+
+                printf("\nDetailed pools usage:\n");
+                uint pool_count = get_number_of_memory_pools();
+                for (uint pool = 0; pool < pool_count; pool++) {
+                        mempoolstat_t stat;
+                        if (get_memory_pool_usage(pool, &stat) == 0) {
+                                printf("  %s"VT100_CURSOR_BACKWARD(99)VT100_CURSOR_FORWARD(14)
+                                       ": %u/%u objects of %u B (max %u, %u pages)\n",
+                                       stat.name, stat.used, stat.objects,
+                                       stat.object_size, stat.used_max, stat.pages);
+                        }
+                }
         }
 
         free(modmem);
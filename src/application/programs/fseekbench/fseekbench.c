@@ -0,0 +1,250 @@
+/*==============================================================================
+File    fseekbench.c
+
+Author  Daniel Zorychta
+
+Brief   FAT fast seek benchmark (random reads in large file)
+
+        Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+        This program is free software; you can redistribute it and/or modify
+        it under the terms of the GNU General Public License as published by
+        the Free Software Foundation and modified by the dnx RTOS exception.
+
+        NOTE: The modification  to the GPL is  included to allow you to
+              distribute a combined work that includes dnx RTOS without
+              being obliged to provide the source  code for proprietary
+              components outside of the dnx RTOS.
+
+        The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+        but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+        MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+        GNU General Public License for more details.
+
+        Full license text is available on the following file: doc/license.txt.
+
+==============================================================================*/
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/mount.h>
+#include <dnx/os.h>
+#include <dnx/misc.h>
+
+/*==============================================================================
+  Local macros
+==============================================================================*/
+#define BLOCK_SIZE              4096
+#define DEFAULT_FILE_SIZE_MiB   16
+#define DEFAULT_READS           256
+#define TEST_FILE               "fseekbench.dat"
+#define RANDOM_SEED             0x12345678
+
+/*==============================================================================
+  Local object types
+==============================================================================*/
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+static int  create_file(u32_t blocks);
+static int  measure(const char *opts, u32_t blocks, u32_t reads);
+static u32_t next_random(void);
+
+/*==============================================================================
+  Local objects
+==============================================================================*/
+GLOBAL_VARIABLES_SECTION {
+        const char *dev;
+        const char *dir;
+        u32_t       seed;
+        char        file[128];
+        u8_t        buf[BLOCK_SIZE];
+};
+
+/*==============================================================================
+  Exported objects
+==============================================================================*/
+PROGRAM_PARAMS(fseekbench, STACK_DEPTH_LOW);
+
+/*==============================================================================
+  External objects
+==============================================================================*/
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+
+//==============================================================================
+/**
+ * Main program function.
+ *
+ * Program measures random 4 KiB reads across a large file on FAT file system.
+ * File system is mounted from selected device twice: without cluster link map
+ * (each seek follows FAT chain) and with 'fastseek' option. The same sequence
+ * of offsets is read in both passes. Test file is created if does not exist.
+ *
+ * @param argc      argument count
+ * @param argv      arguments
+ */
+//==============================================================================
+int main(int argc, char *argv[])
+{
+        if (argc < 3) {
+                printf("Usage: %s <device> <mount dir> [file MiB] [reads]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+
+        global->dev = argv[1];
+        global->dir = argv[2];
+
+        u32_t MiB   = argc > 3 ? cast(u32_t, atoi(argv[3])) : DEFAULT_FILE_SIZE_MiB;
+        u32_t reads = argc > 4 ? cast(u32_t, atoi(argv[4])) : DEFAULT_READS;
+        u32_t blocks = MiB * (1024 * 1024 / BLOCK_SIZE);
+
+        if (blocks == 0 || reads == 0) {
+                puts("Invalid file size or number of reads");
+                return EXIT_FAILURE;
+        }
+
+        snprintf(global->file, sizeof(global->file), "%s/%s", global->dir, TEST_FILE);
+
+        if (mount("fatfs", global->dev, global->dir, "") != 0) {
+                perror(global->dir);
+                return EXIT_FAILURE;
+        }
+
+        int err = create_file(blocks);
+        umount(global->dir);
+
+        if (err) {
+                perror(global->file);
+                return EXIT_FAILURE;
+        }
+
+        printf("Random %u B reads of %u MiB file:\n", BLOCK_SIZE, MiB);
+
+        if (  measure("", blocks, reads) != 0
+           || measure("fastseek", blocks, reads) != 0) {
+
+                perror(global->file);
+                return EXIT_FAILURE;
+        }
+
+        return EXIT_SUCCESS;
+}
+
+//==============================================================================
+/**
+ * @brief  Function create test file if file does not exist or has different
+ *         size.
+ *
+ * @param  blocks       file size in blocks
+ *
+ * @return 0 on success, otherwise -1.
+ */
+//==============================================================================
+static int create_file(u32_t blocks)
+{
+        struct stat st;
+        if (stat(global->file, &st) == 0 && st.st_size == cast(u64_t, blocks) * BLOCK_SIZE) {
+                return 0;
+        }
+
+        printf("Creating test file (%u blocks)...\n", cast(uint, blocks));
+
+        FILE *f = fopen(global->file, "w");
+        if (!f) {
+                return -1;
+        }
+
+        int err = 0;
+
+        for (u32_t i = 0; i < blocks && !err; i++) {
+                memset(global->buf, i, sizeof(global->buf));
+
+                if (fwrite(global->buf, 1, sizeof(global->buf), f) != sizeof(global->buf)) {
+                        err = -1;
+                }
+        }
+
+        fclose(f);
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function mount file system with selected options and measure
+ *         random reads.
+ *
+ * @param  opts         mount options
+ * @param  blocks       file size in blocks
+ * @param  reads        number of reads
+ *
+ * @return 0 on success, otherwise -1.
+ */
+//==============================================================================
+static int measure(const char *opts, u32_t blocks, u32_t reads)
+{
+        if (mount("fatfs", global->dev, global->dir, opts) != 0) {
+                return -1;
+        }
+
+        int   err = -1;
+        FILE *f   = fopen(global->file, "r");
+
+        if (f) {
+                err          = 0;
+                global->seed = RANDOM_SEED;
+
+                u64_t tstart = get_time_ms();
+
+                for (u32_t i = 0; i < reads && !err; i++) {
+                        u32_t blk = next_random() % blocks;
+
+                        if (  fseek(f, cast(i64_t, blk) * BLOCK_SIZE, SEEK_SET) != 0
+                           || fread(global->buf, 1, BLOCK_SIZE, f) != BLOCK_SIZE
+                           || global->buf[0] != cast(u8_t, blk) ) {
+                                err = -1;
+                        }
+                }
+
+                u32_t time = cast(u32_t, get_time_ms() - tstart);
+
+                fclose(f);
+
+                if (!err) {
+                        printf("  %s: %6u ms  %6u us/read\n",
+                               opts[0] ? opts : "normal", cast(uint, time),
+                               cast(uint, (cast(u64_t, time) * 1000) / reads));
+                }
+        }
+
+        umount(global->dir);
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function return pseudo-random number. Sequence is repeated in each
+ *         pass.
+ *
+ * @return Pseudo-random number.
+ */
+//==============================================================================
+static u32_t next_random(void)
+{
+        global->seed = global->seed * 1664525 + 1013904223;
+        return global->seed >> 8;
+}
+
+/*==============================================================================
+  End of file
+==============================================================================*/
@@ -0,0 +1,125 @@
+/*==============================================================================
+File    fstrim.c
+
+Author  Daniel Zorychta
+
+Brief   Discard free space of mounted file system (TRIM)
+
+        Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+        This program is free software; you can redistribute it and/or modify
+        it under the terms of the GNU General Public License as published by
+        the Free Software Foundation and modified by the dnx RTOS exception.
+
+        NOTE: The modification  to the GPL is  included to allow you to
+              distribute a combined work that includes dnx RTOS without
+              being obliged to provide the source  code for proprietary
+              components outside of the dnx RTOS.
+
+        The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+        but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+        MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+        GNU General Public License for more details.
+
+        Full license text is available on the following file: doc/license.txt.
+
+==============================================================================*/
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/ioctl.h>
+#include <dnx/misc.h>
+
+/*==============================================================================
+  Local macros
+==============================================================================*/
+#define TEMP_FILE               ".fstrim"
+
+/*==============================================================================
+  Local object types
+==============================================================================*/
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+
+/*==============================================================================
+  Local objects
+==============================================================================*/
+GLOBAL_VARIABLES_SECTION {
+        char file[128];
+};
+
+/*==============================================================================
+  Exported objects
+==============================================================================*/
+PROGRAM_PARAMS(fstrim, STACK_DEPTH_LOW);
+
+/*==============================================================================
+  External objects
+==============================================================================*/
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+//==============================================================================
+/**
+ * @brief Program main function. Free space of file system mounted at
+ *        selected directory is discarded by request sent to a temporary
+ *        file created in the directory.
+ *
+ * @param  argc         count of arguments
+ * @param *argv[]       argument table
+ *
+ * @return program status
+ */
+//==============================================================================
+int main(int argc, char *argv[])
+{
+        if (argc < 2) {
+                printf("Usage: %s <mount point> [min extent bytes]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+
+        struct vfs_fstrim fstrim = {.min_len = 0, .trimmed = 0};
+
+        if (argc > 2) {
+                fstrim.min_len = max(0, strtol(argv[2], NULL, 0));
+        }
+
+        const char *dir = argv[1];
+        size_t      len = strlen(dir);
+
+        snprintf(global->file, sizeof(global->file), "%s%s%s",
+                 dir, (len && dir[len - 1] == '/') ? "" : "/", TEMP_FILE);
+
+        FILE *file = fopen(global->file, "w");
+        if (!file) {
+                perror(global->file);
+                return EXIT_FAILURE;
+        }
+
+        int status = EXIT_SUCCESS;
+
+        if (ioctl(fileno(file), IOCTL_VFS__FSTRIM, &fstrim) == 0) {
+                printf("%s: %u KiB discarded\n", dir,
+                       cast(u32_t, fstrim.trimmed / 1024));
+        } else {
+                perror(dir);
+                status = EXIT_FAILURE;
+        }
+
+        fclose(file);
+        remove(global->file);
+
+        return status;
+}
+
+/*==============================================================================
+  End of file
+==============================================================================*/
@@ -0,0 +1,329 @@
+/*==============================================================================
+File    pipebench.c
+
+Author  Daniel Zorychta
+
+Brief   Pipe throughput and latency benchmark
+
+        Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+        This program is free software; you can redistribute it and/or modify
+        it under the terms of the GNU General Public License as published by
+        the Free Software Foundation and modified by the dnx RTOS exception.
+
+        NOTE: The modification  to the GPL is  included to allow you to
+              distribute a combined work that includes dnx RTOS without
+              being obliged to provide the source  code for proprietary
+              components outside of the dnx RTOS.
+
+        The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+        but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+        MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+        GNU General Public License for more details.
+
+        Full license text is available on the following file: doc/license.txt.
+
+==============================================================================*/
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <dnx/os.h>
+#include <dnx/thread.h>
+#include <dnx/misc.h>
+
+/*==============================================================================
+  Local macros
+==============================================================================*/
+#define FIFO_PATH               "/tmp/pipebench.fifo"
+#define DEFAULT_TOTAL           (64 * 1024)
+#define MAX_BLOCK               512
+#define LATENCY_SAMPLES         40
+#define LATENCY_BATCH           25
+
+/*==============================================================================
+  Local object types
+==============================================================================*/
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+static void   writer_thread     (void *arg);
+static void   ping_thread       (void *arg);
+static int    open_pipe         (bool rd, fd_t *fd);
+static void   measure_throughput(size_t block);
+static void   measure_latency   (void);
+
+/*==============================================================================
+  Local objects
+==============================================================================*/
+GLOBAL_VARIABLES_SECTION {
+        size_t      total;
+        size_t      block;
+        sem_t      *ack;
+        u32_t       sample[LATENCY_SAMPLES];
+        u8_t        wrbuf[MAX_BLOCK];
+        u8_t        rdbuf[MAX_BLOCK];
+};
+
+static const size_t BLOCKS[] = {1, 64, 512};
+
+static const thread_attr_t THREAD_ATTR = {
+        .stack_depth = STACK_DEPTH_LOW,
+        .priority    = PRIORITY_NORMAL,
+        .detached    = false
+};
+
+/*==============================================================================
+  Exported objects
+==============================================================================*/
+PROGRAM_PARAMS(pipebench, STACK_DEPTH_LOW);
+
+/*==============================================================================
+  External objects
+==============================================================================*/
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+
+//==============================================================================
+/**
+ * Main program function.
+ *
+ * Program measures throughput and latency of system pipe (FIFO file). Data
+ * are transferred by open(), read() and write() functions, so the whole VFS
+ * and system call path is measured. Number of bytes transferred in each
+ * throughput test can be given as argument.
+ *
+ * @param argc      argument count
+ * @param argv      arguments
+ */
+//==============================================================================
+int main(int argc, char *argv[])
+{
+        global->total = argc > 1 ? cast(size_t, atoi(argv[1])) : DEFAULT_TOTAL;
+        if (global->total == 0) {
+                printf("Usage: %s [bytes]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+
+        global->ack = semaphore_new(1, 0);
+        if (!global->ack) {
+                perror(NULL);
+                return EXIT_FAILURE;
+        }
+
+        for (size_t i = 0; i < sizeof(global->wrbuf); i++) {
+                global->wrbuf[i] = i;
+        }
+
+        puts("Pipe test in progress...");
+
+        for (size_t i = 0; i < ARRAY_SIZE(BLOCKS); i++) {
+                measure_throughput(BLOCKS[i]);
+        }
+
+        measure_latency();
+
+        semaphore_delete(global->ack);
+        remove(FIFO_PATH);
+
+        return EXIT_SUCCESS;
+}
+
+//==============================================================================
+/**
+ * @brief  Function measure throughput of pipe. Writer thread sends data in
+ *         blocks of selected size, reader reads all available data (up to
+ *         512 bytes) by single read, as pipe consumers do.
+ *
+ * @param  block        block size
+ */
+//==============================================================================
+static void measure_throughput(size_t block)
+{
+        fd_t fd;
+        if (open_pipe(true, &fd) != 0) {
+                return;
+        }
+
+        global->block = block;
+
+        u64_t tstart = get_time_ms();
+        tid_t tid    = thread_create(writer_thread, &THREAD_ATTR, NULL);
+        if (tid == 0) {
+                perror(NULL);
+                close(fd);
+                return;
+        }
+
+        size_t received = 0;
+        size_t reads    = 0;
+        while (received < global->total) {
+                ssize_t n = read(fd, global->rdbuf, min(MAX_BLOCK, global->total - received));
+                if (n <= 0) {
+                        break;
+                }
+
+                received += n;
+                reads++;
+        }
+
+        u32_t time = max(1, get_time_ms() - tstart);
+
+        thread_join(tid);
+        close(fd);
+
+        u32_t kBps = (cast(u64_t, received) * 1000) / (time * 1024);
+
+        printf("%3u B blocks: %u.%03u MB/s (%u B in %u ms, %u reads)\n",
+               (uint)block, kBps / 1024, ((kBps % 1024) * 1000) / 1024,
+               (uint)received, time, (uint)reads);
+}
+
+//==============================================================================
+/**
+ * @brief  Function measure latency of 1 byte transfer. Each sample is an
+ *         average round trip (pipe byte and semaphore acknowledge) of a batch.
+ */
+//==============================================================================
+static void measure_latency(void)
+{
+        fd_t fd;
+        if (open_pipe(true, &fd) != 0) {
+                return;
+        }
+
+        tid_t tid = thread_create(ping_thread, &THREAD_ATTR, NULL);
+        if (tid == 0) {
+                perror(NULL);
+                close(fd);
+                return;
+        }
+
+        for (size_t i = 0; i < LATENCY_SAMPLES * LATENCY_BATCH; i++) {
+                read(fd, global->rdbuf, 1);
+                semaphore_signal(global->ack);
+        }
+
+        thread_join(tid);
+        close(fd);
+
+        // insertion sort of samples
+        for (size_t i = 1; i < LATENCY_SAMPLES; i++) {
+                u32_t val = global->sample[i];
+                size_t j  = i;
+
+                for (; (j > 0) && (global->sample[j - 1] > val); j--) {
+                        global->sample[j] = global->sample[j - 1];
+                }
+
+                global->sample[j] = val;
+        }
+
+        printf("latency: p50 %u us, p90 %u us, p99 %u us\n",
+               global->sample[(LATENCY_SAMPLES * 50) / 100],
+               global->sample[(LATENCY_SAMPLES * 90) / 100],
+               global->sample[(LATENCY_SAMPLES * 99) / 100]);
+}
+
+//==============================================================================
+/**
+ * @brief  Writer thread of throughput test.
+ *
+ * @param  arg          thread's argument
+ */
+//==============================================================================
+static void writer_thread(void *arg)
+{
+        UNUSED_ARG1(arg);
+
+        fd_t fd;
+        if (open_pipe(false, &fd) != 0) {
+                return;
+        }
+
+        size_t sent = 0;
+        while (sent < global->total) {
+                ssize_t n = write(fd, global->wrbuf, min(global->block, global->total - sent));
+                if (n <= 0) {
+                        break;
+                }
+
+                sent += n;
+        }
+
+        close(fd);
+}
+
+//==============================================================================
+/**
+ * @brief  Writer thread of latency test. Each byte is flushed, so reader is
+ *         woken up at once (as interactive writer does).
+ *
+ * @param  arg          thread's argument
+ */
+//==============================================================================
+static void ping_thread(void *arg)
+{
+        UNUSED_ARG1(arg);
+
+        fd_t fd;
+        if (open_pipe(false, &fd) != 0) {
+                return;
+        }
+
+        for (size_t s = 0; s < LATENCY_SAMPLES; s++) {
+                u64_t tstart = get_time_ms();
+
+                for (size_t i = 0; i < LATENCY_BATCH; i++) {
+                        write(fd, global->wrbuf, 1);
+                        fflush(cast(FILE*, fd));
+                        semaphore_wait(global->ack, MAX_DELAY_MS);
+                }
+
+                global->sample[s] = ((get_time_ms() - tstart) * 1000) / LATENCY_BATCH;
+        }
+
+        close(fd);
+}
+
+//==============================================================================
+/**
+ * @brief  Function open FIFO file. FIFO is created by reader.
+ *
+ * @param  rd           open for read (reader)
+ * @param  fd           opened file
+ *
+ * @return 0 on success, otherwise -1.
+ */
+//==============================================================================
+static int open_pipe(bool rd, fd_t *fd)
+{
+        if (rd) {
+                remove(FIFO_PATH);
+
+                if (mkfifo(FIFO_PATH, 0666) != 0) {
+                        perror(FIFO_PATH);
+                        return -1;
+                }
+        }
+
+        *fd = rd ? open(FIFO_PATH, O_RDONLY) : open(FIFO_PATH, O_WRONLY | O_CREAT | O_TRUNC);
+        if (*fd == -1) {
+                perror(FIFO_PATH);
+                return -1;
+        }
+
+        return 0;
+}
+
+/*==============================================================================
+  End of file
+==============================================================================*/
@@ -0,0 +1,311 @@
+/*==============================================================================
+File    printfbench.c
+
+Author  Daniel Zorychta
+
+Brief   printf() formatting cost benchmark
+
+        Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+        This program is free software; you can redistribute it and/or modify
+        it under the terms of the GNU General Public License as published by
+        the Free Software Foundation and modified by the dnx RTOS exception.
+
+        NOTE: The modification  to the GPL is  included to allow you to
+              distribute a combined work that includes dnx RTOS without
+              being obliged to provide the source  code for proprietary
+              components outside of the dnx RTOS.
+
+        The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+        but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+        MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+        GNU General Public License for more details.
+
+        Full license text is available on the following file: doc/license.txt.
+
+==============================================================================*/
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <dnx/os.h>
+#include <dnx/misc.h>
+
+/*==============================================================================
+  Local macros
+==============================================================================*/
+#define FILE_PATH               "/tmp/printfbench.txt"
+#define DEFAULT_TIME_MS         250
+#define BATCH_CALLS             100
+#define STR_LEN                 128
+#define TEXT_64                 "0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef"
+
+/*==============================================================================
+  Local object types
+==============================================================================*/
+typedef enum {
+        SINK_SNPRINTF,
+        SINK_FPRINTF,
+        SINK_LEGACY
+} sink_t;
+
+typedef enum {
+        ARGS_NONE,
+        ARGS_INT,
+        ARGS_STR,
+        ARGS_MIXED,
+        ARGS_FLOAT
+} args_t;
+
+typedef struct {
+        const char *name;
+        const char *format;
+        args_t      args;
+} fmt_t;
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+static int  legacy_vfprintf(FILE *file, const char *format, va_list arg);
+static int  output(sink_t sink, FILE *file, const char *format, ...);
+static int  print(sink_t sink, FILE *file, const fmt_t *fmt, int i);
+static void measure(sink_t sink, const fmt_t *fmt);
+
+/*==============================================================================
+  Local objects
+==============================================================================*/
+GLOBAL_VARIABLES_SECTION {
+        u32_t time_ms;
+        u32_t MHz;
+        char  str[STR_LEN];
+};
+
+static const fmt_t FORMATS[] = {
+        {"text",   "Hello world!\n",             ARGS_NONE },
+        {"%d",     "%d\n",                       ARGS_INT  },
+        {"%08x",   "%08x\n",                     ARGS_INT  },
+        {"%s",     "%s\n",                       ARGS_STR  },
+        {"mixed",  "[%u] %s: 0x%04X, %d%%\n",    ARGS_MIXED},
+        {"%.3f",   "%.3f\n",                     ARGS_FLOAT},
+        {"long",   "%s: " TEXT_64 TEXT_64 "\n",  ARGS_STR  },
+};
+
+static const char *SINK_NAME[] = {"snprintf", "fprintf", "legacy"};
+
+/*==============================================================================
+  Exported objects
+==============================================================================*/
+PROGRAM_PARAMS(printfbench, STACK_DEPTH_LOW);
+
+/*==============================================================================
+  External objects
+==============================================================================*/
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+
+//==============================================================================
+/**
+ * Main program function.
+ *
+ * Program measures cost of single printf() call for common formats. Each
+ * format is printed to the buffer (snprintf), to the file (fprintf) and to
+ * the file by using legacy method: message is sized by first vsnprintf()
+ * pass, formatted to allocated buffer and written by fwrite(). Each format
+ * is called in batches until measurement time elapses, so result does not
+ * depend on resolution of millisecond clock. Measurement time [ms] of single
+ * format and CPU frequency [MHz] can be given as arguments; if frequency is
+ * given then number of CPU cycles per call is calculated.
+ *
+ * @param argc      argument count
+ * @param argv      arguments
+ */
+//==============================================================================
+int main(int argc, char *argv[])
+{
+        global->time_ms = argc > 1 ? cast(u32_t, atoi(argv[1])) : DEFAULT_TIME_MS;
+        global->MHz     = argc > 2 ? cast(u32_t, atoi(argv[2])) : 0;
+
+        if (global->time_ms == 0) {
+                printf("Usage: %s [time ms] [CPU MHz]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+
+        puts("printf test in progress...");
+
+        for (sink_t sink = SINK_SNPRINTF; sink <= SINK_LEGACY; sink++) {
+                for (size_t i = 0; i < ARRAY_SIZE(FORMATS); i++) {
+                        measure(sink, &FORMATS[i]);
+                }
+        }
+
+        remove(FILE_PATH);
+
+        return EXIT_SUCCESS;
+}
+
+//==============================================================================
+/**
+ * @brief  Function measure time of single format call. Format is called in
+ *         batches until measurement time elapses.
+ *
+ * @param  sink         output type
+ * @param  fmt          format
+ */
+//==============================================================================
+static void measure(sink_t sink, const fmt_t *fmt)
+{
+        FILE *file = NULL;
+
+        if (sink != SINK_SNPRINTF) {
+                file = fopen(FILE_PATH, "w");
+                if (!file) {
+                        perror(FILE_PATH);
+                        return;
+                }
+        }
+
+        u32_t calls  = 0;
+        u32_t time   = 0;
+        u64_t tstart = get_time_ms();
+
+        do {
+                for (u32_t i = 0; i < BATCH_CALLS; i++) {
+                        print(sink, file, fmt, calls + i);
+                }
+
+                // file size does not grow with number of calls
+                if (file) {
+                        fseek(file, 0, SEEK_SET);
+                }
+
+                calls += BATCH_CALLS;
+                time   = get_time_ms() - tstart;
+
+        } while (time < global->time_ms);
+
+        if (file) {
+                fclose(file);
+        }
+
+        u32_t ns = (cast(u64_t, time) * 1000000) / calls;
+
+        printf("%s %s: %u ns/call (%u calls)", SINK_NAME[sink], fmt->name, ns, calls);
+
+        if (global->MHz) {
+                printf(", %u cycles/call", (ns * global->MHz) / 1000);
+        }
+
+        puts("");
+}
+
+//==============================================================================
+/**
+ * @brief  Function print message of selected format with arguments suitable
+ *         for format.
+ *
+ * @param  sink         output type
+ * @param  file         output file (fprintf and legacy)
+ * @param  fmt          format
+ * @param  i            iteration number
+ *
+ * @return Number of printed characters.
+ */
+//==============================================================================
+static int print(sink_t sink, FILE *file, const fmt_t *fmt, int i)
+{
+        switch (fmt->args) {
+        case ARGS_NONE:
+                return output(sink, file, fmt->format);
+
+        case ARGS_INT:
+                return output(sink, file, fmt->format, i);
+
+        case ARGS_STR:
+                return output(sink, file, fmt->format, "foobar");
+
+        case ARGS_MIXED:
+                return output(sink, file, fmt->format, i, "foobar", i, -i);
+
+        case ARGS_FLOAT:
+                return output(sink, file, fmt->format, i / 7.0);
+        }
+
+        return 0;
+}
+
+//==============================================================================
+/**
+ * @brief  Function print message to selected output.
+ *
+ * @param  sink         output type
+ * @param  file         output file (fprintf and legacy)
+ * @param  format       format
+ * @param  ...          arguments
+ *
+ * @return Number of printed characters.
+ */
+//==============================================================================
+static int output(sink_t sink, FILE *file, const char *format, ...)
+{
+        int n = 0;
+
+        va_list arg;
+        va_start(arg, format);
+
+        switch (sink) {
+        case SINK_SNPRINTF:
+                n = vsnprintf(global->str, sizeof(global->str), format, arg);
+                break;
+
+        case SINK_FPRINTF:
+                n = vfprintf(file, format, arg);
+                break;
+
+        case SINK_LEGACY:
+                n = legacy_vfprintf(file, format, arg);
+                break;
+        }
+
+        va_end(arg);
+
+        return n;
+}
+
+//==============================================================================
+/**
+ * @brief  Legacy vfprintf(): two formatting passes, heap buffer and fwrite().
+ *
+ * @param  file         output file
+ * @param  format       format
+ * @param  arg          arguments
+ *
+ * @return Number of printed characters.
+ */
+//==============================================================================
+static int legacy_vfprintf(FILE *file, const char *format, va_list arg)
+{
+        int n = 0;
+
+        va_list carg;
+        va_copy(carg, arg);
+        size_t size = vsnprintf(NULL, 0, format, carg) + 1;
+        va_end(carg);
+
+        char *str = calloc(1, size);
+        if (str) {
+                n = vsnprintf(str, size, format, arg);
+                fwrite(str, sizeof(char), n, file);
+                free(str);
+        }
+
+        return n;
+}
+
+/*==============================================================================
+  End of file
+==============================================================================*/
@@ -0,0 +1,331 @@
+/*==============================================================================
+File    reapbench.c
+
+Author  Daniel Zorychta
+
+Brief   Killed process clean up benchmark (system call latency)
+
+        Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+        This program is free software; you can redistribute it and/or modify
+        it under the terms of the GNU General Public License as published by
+        the Free Software Foundation and modified by the dnx RTOS exception.
+
+        NOTE: The modification  to the GPL is  included to allow you to
+              distribute a combined work that includes dnx RTOS without
+              being obliged to provide the source  code for proprietary
+              components outside of the dnx RTOS.
+
+        The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+        but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+        MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+        GNU General Public License for more details.
+
+        Full license text is available on the following file: doc/license.txt.
+
+==============================================================================*/
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <dnx/os.h>
+#include <dnx/thread.h>
+#include <dnx/misc.h>
+
+/*==============================================================================
+  Local macros
+==============================================================================*/
+#define DEFAULT_PROCESSES       20
+#define DEFAULT_BLOCKS          5000
+#define BUSY_PROCESSES          4
+#define BUSY_BLOCKS             200
+#define BLOCK_SIZE              16
+#define SPAWN_INTERVAL          20
+#define REAP_TIMEOUT            2000
+#define BUSY_REAP_TIMEOUT       5000
+#define PROBE_INTERVAL          1
+
+/*==============================================================================
+  Local object types
+==============================================================================*/
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+static int  child(size_t blocks);
+static int  run_children(size_t processes, size_t blocks, u32_t timeout);
+static void probe_thread(void *arg);
+static void busy_thread(void *arg);
+static int  count_children(void);
+static void print_histogram(void);
+
+/*==============================================================================
+  Local objects
+==============================================================================*/
+GLOBAL_VARIABLES_SECTION {
+        volatile bool stop;
+        u32_t         hist[6];
+        u32_t         max;
+        u32_t         calls;
+        const char   *name;
+        char          cmd[32];
+};
+
+static const char *HIST_LABEL[] = {"   0", "   1", "   2", "3..4", "5..8", "  >8"};
+
+static const thread_attr_t PROBE_ATTR = {
+        .stack_depth = STACK_DEPTH_LOW,
+        .priority    = PRIORITY_HIGHEST,
+        .detached    = false
+};
+
+static const thread_attr_t BUSY_ATTR = {
+        .stack_depth = STACK_DEPTH_LOW,
+        .priority    = PRIORITY_LOWEST + 1,
+        .detached    = false
+};
+
+/*==============================================================================
+  Exported objects
+==============================================================================*/
+PROGRAM_PARAMS(reapbench, STACK_DEPTH_LOW);
+
+/*==============================================================================
+  External objects
+==============================================================================*/
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+
+//==============================================================================
+/**
+ * Main program function.
+ *
+ * Program starts detached processes that allocate many memory blocks and
+ * exit without releasing them. Meanwhile a high priority probe thread calls
+ * a short system call each millisecond and collects latency histogram. The
+ * clean up of killed processes should not be visible in the probe latency.
+ * Then a few processes are started while a busy thread of low priority
+ * takes all free CPU time, which starves the reaper thread. The processes
+ * must be released anyway. Number of processes and number of blocks per
+ * process of the first test can be given as arguments.
+ *
+ * @param argc      argument count
+ * @param argv      arguments
+ */
+//==============================================================================
+int main(int argc, char *argv[])
+{
+        if ((argc == 3) && (strcmp(argv[1], "-c") == 0)) {
+                return child(atoi(argv[2]));
+        }
+
+        size_t processes = (argc > 1) ? atoi(argv[1]) : DEFAULT_PROCESSES;
+        size_t blocks    = (argc > 2) ? atoi(argv[2]) : DEFAULT_BLOCKS;
+
+        global->name = argv[0];
+
+        printf("Starting %u processes with %u blocks each...\n",
+               (uint)processes, (uint)blocks);
+
+        tid_t tid = thread_create(probe_thread, &PROBE_ATTR, NULL);
+        if (tid == 0) {
+                perror(NULL);
+                return EXIT_FAILURE;
+        }
+
+        int err = run_children(processes, blocks, REAP_TIMEOUT);
+
+        global->stop = true;
+        thread_join(tid);
+
+        print_histogram();
+
+        printf("Starting %u processes with %u blocks each on busy CPU...\n",
+               BUSY_PROCESSES, BUSY_BLOCKS);
+
+        global->stop = false;
+
+        tid = thread_create(busy_thread, &BUSY_ATTR, NULL);
+        if (tid == 0) {
+                perror(NULL);
+                return EXIT_FAILURE;
+        }
+
+        u64_t tstart = get_time_ms();
+
+        if (run_children(BUSY_PROCESSES, BUSY_BLOCKS, BUSY_REAP_TIMEOUT) == 0) {
+                printf("Busy CPU: processes released in %u ms\n",
+                       (uint)(get_time_ms() - tstart));
+        } else {
+                err = -1;
+        }
+
+        global->stop = true;
+        thread_join(tid);
+
+        return err ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+//==============================================================================
+/**
+ * @brief  Child process. Function allocates blocks and exit, blocks are
+ *         released by the system.
+ *
+ * @param  blocks       number of blocks
+ *
+ * @return Exit status.
+ */
+//==============================================================================
+static int child(size_t blocks)
+{
+        for (size_t i = 0; i < blocks; i++) {
+                if (!malloc(BLOCK_SIZE)) {
+                        return EXIT_FAILURE;
+                }
+        }
+
+        return EXIT_SUCCESS;
+}
+
+//==============================================================================
+/**
+ * @brief  Function start detached child processes and wait until system
+ *         releases them.
+ *
+ * @param  processes    number of processes
+ * @param  blocks       number of blocks allocated by each process
+ * @param  timeout      release timeout [ms]
+ *
+ * @return 0 on success, otherwise -1.
+ */
+//==============================================================================
+static int run_children(size_t processes, size_t blocks, u32_t timeout)
+{
+        snprintf(global->cmd, sizeof(global->cmd), "%s -c %u", global->name, (uint)blocks);
+
+        process_attr_t attr = {
+                .priority = PRIORITY_NORMAL,
+                .detached = true
+        };
+
+        int err = 0;
+
+        for (size_t i = 0; i < processes; i++) {
+                if (process_create(global->cmd, &attr) == 0) {
+                        perror(global->cmd);
+                        err = -1;
+                        break;
+                }
+
+                msleep(SPAWN_INTERVAL);
+        }
+
+        u64_t tstart = get_time_ms();
+        while ((count_children() > 0) && (get_time_ms() - tstart < timeout)) {
+                msleep(SPAWN_INTERVAL);
+        }
+
+        int left = count_children();
+        if (left > 0) {
+                printf("%d processes not released\n", left);
+                err = -1;
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Probe thread. Thread measures latency of short system call.
+ *
+ * @param  arg          not used
+ */
+//==============================================================================
+static void probe_thread(void *arg)
+{
+        UNUSED_ARG1(arg);
+
+        while (!global->stop) {
+                u64_t tstart = get_time_ms();
+                process_getpid();
+                u32_t time = get_time_ms() - tstart;
+
+                size_t bucket = (time <= 2) ? time
+                              : (time <= 4) ? 3
+                              : (time <= 8) ? 4 : 5;
+
+                global->hist[bucket]++;
+                global->max = max(global->max, time);
+                global->calls++;
+
+                msleep(PROBE_INTERVAL);
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Busy thread. Thread takes CPU time not used by threads of higher
+ *         priority.
+ *
+ * @param  arg          not used
+ */
+//==============================================================================
+static void busy_thread(void *arg)
+{
+        UNUSED_ARG1(arg);
+
+        while (!global->stop) {
+                // CPU is busy
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function count child processes that exist in the system.
+ *
+ * @return Number of child processes.
+ */
+//==============================================================================
+static int count_children(void)
+{
+        pid_t          self = process_getpid();
+        process_stat_t stat;
+        size_t         seek = 0;
+        int            n    = 0;
+
+        while (process_stat_seek(seek++, &stat) == 0) {
+                if ((stat.pid != self) && (strcmp(stat.name, "reapbench") == 0)) {
+                        n++;
+                }
+        }
+
+        return n;
+}
+
+//==============================================================================
+/**
+ * @brief  Function print probe latency histogram. Calls longer than 1 ms are
+ *         delayed by the system (clock resolution is 1 ms).
+ */
+//==============================================================================
+static void print_histogram(void)
+{
+        u32_t delayed = global->calls - global->hist[0] - global->hist[1];
+
+        printf("System call latency (%u calls, %u delayed, max %u ms):\n",
+               (uint)global->calls, (uint)delayed, (uint)global->max);
+
+        for (size_t i = 0; i < ARRAY_SIZE(HIST_LABEL); i++) {
+                printf("  %s ms: %u\n", HIST_LABEL[i], (uint)global->hist[i]);
+        }
+}
+
+/*==============================================================================
+  End of file
+==============================================================================*/
@@ -0,0 +1,187 @@
+/*==============================================================================
+File    resbench.c
+
+Author  Daniel Zorychta
+
+Brief   Process resource tracking benchmark (free() latency)
+
+        Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+        This program is free software; you can redistribute it and/or modify
+        it under the terms of the GNU General Public License as published by
+        the Free Software Foundation and modified by the dnx RTOS exception.
+
+        NOTE: The modification  to the GPL is  included to allow you to
+              distribute a combined work that includes dnx RTOS without
+              being obliged to provide the source  code for proprietary
+              components outside of the dnx RTOS.
+
+        The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+        but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+        MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+        GNU General Public License for more details.
+
+        Full license text is available on the following file: doc/license.txt.
+
+==============================================================================*/
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dnx/os.h>
+#include <dnx/misc.h>
+
+/*==============================================================================
+  Local macros
+==============================================================================*/
+#define BLOCK_SIZE              16
+#define FREES_PER_TEST          20000
+
+/*==============================================================================
+  Local object types
+==============================================================================*/
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+static int measure(size_t live, bool newest_first);
+
+/*==============================================================================
+  Local objects
+==============================================================================*/
+GLOBAL_VARIABLES_SECTION {
+        void **blk;
+};
+
+static const size_t DEFAULT_LIVE[] = {10, 1000, 10000};
+
+static const char *ORDER_NAME[] = {"oldest", "newest"};
+
+/*==============================================================================
+  Exported objects
+==============================================================================*/
+PROGRAM_PARAMS(resbench, STACK_DEPTH_LOW);
+
+/*==============================================================================
+  External objects
+==============================================================================*/
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+
+//==============================================================================
+/**
+ * Main program function.
+ *
+ * Program measures free() latency for different number of live allocations
+ * of the process. Blocks are released in allocation order (the oldest
+ * block first) and in reverse order (the newest block first). The newest
+ * block is the head of the process resource list, so both orders have the
+ * same latency only if release does not search the list. Numbers of live
+ * allocations can be given as arguments.
+ *
+ * @param argc      argument count
+ * @param argv      arguments
+ */
+//==============================================================================
+int main(int argc, char *argv[])
+{
+        int status = EXIT_SUCCESS;
+
+        puts("Resource tracking test in progress...");
+
+        for (int order = 0; order < 2; order++) {
+                if (argc > 1) {
+                        for (int i = 1; i < argc; i++) {
+                                if (measure(atoi(argv[i]), order) != 0) {
+                                        status = EXIT_FAILURE;
+                                }
+                        }
+                } else {
+                        for (size_t i = 0; i < ARRAY_SIZE(DEFAULT_LIVE); i++) {
+                                if (measure(DEFAULT_LIVE[i], order) != 0) {
+                                        status = EXIT_FAILURE;
+                                }
+                        }
+                }
+        }
+
+        return status;
+}
+
+//==============================================================================
+/**
+ * @brief  Function measure free() latency with selected number of live
+ *         allocations.
+ *
+ * @param  live         number of live allocations
+ * @param  newest_first release the newest block first
+ *
+ * @return 0 on success, otherwise -1.
+ */
+//==============================================================================
+static int measure(size_t live, bool newest_first)
+{
+        if (live == 0) {
+                return -1;
+        }
+
+        global->blk = calloc(live, sizeof(void*));
+        if (!global->blk) {
+                printf("%6u live: not enough memory\n", (uint)live);
+                return -1;
+        }
+
+        int    err    = 0;
+        size_t rounds = max(1, FREES_PER_TEST / live);
+        u64_t  time   = 0;
+
+        for (size_t r = 0; (r < rounds) && !err; r++) {
+
+                for (size_t i = 0; i < live; i++) {
+                        global->blk[i] = malloc(BLOCK_SIZE);
+                        if (!global->blk[i]) {
+                                printf("%6u live: not enough memory\n", (uint)live);
+                                err = -1;
+                                break;
+                        }
+                }
+
+                u64_t tstart = get_time_ms();
+
+                for (size_t n = 0; n < live; n++) {
+                        size_t i = newest_first ? (live - 1 - n) : n;
+                        free(global->blk[i]);
+                        global->blk[i] = NULL;
+                }
+
+                time += get_time_ms() - tstart;
+        }
+
+        if (!err) {
+                u32_t ns = (time * 1000000) / (rounds * live);
+
+                printf("%6u live, %s first: free() %u.%03u us (%u frees in %u ms)\n",
+                       (uint)live, ORDER_NAME[newest_first], ns / 1000, ns % 1000,
+                       (uint)(rounds * live), (u32_t)time);
+        }
+
+        for (size_t i = 0; i < live; i++) {
+                if (global->blk[i]) {
+                        free(global->blk[i]);
+                }
+        }
+
+        free(global->blk);
+        global->blk = NULL;
+
+        return err;
+}
+
+/*==============================================================================
+  End of file
+==============================================================================*/
@@ -0,0 +1,345 @@
+/*==============================================================================
+File    ringbench.c
+
+Author  Daniel Zorychta
+
+Brief   Batched system call benchmark (submission ring)
+
+        Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+        This program is free software; you can redistribute it and/or modify
+        it under the terms of the GNU General Public License as published by
+        the Free Software Foundation and modified by the dnx RTOS exception.
+
+        NOTE: The modification  to the GPL is  included to allow you to
+              distribute a combined work that includes dnx RTOS without
+              being obliged to provide the source  code for proprietary
+              components outside of the dnx RTOS.
+
+        The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+        but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+        MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+        GNU General Public License for more details.
+
+        Full license text is available on the following file: doc/license.txt.
+
+==============================================================================*/
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/uio.h>
+#include <dnx/os.h>
+#include <dnx/ring.h>
+#include <dnx/misc.h>
+
+/*==============================================================================
+  Local macros
+==============================================================================*/
+#define FILE_PATH               "/tmp/ringbench.dat"
+#define DEFAULT_RECORDS         8192
+#define RECORD_SIZE             16
+#define BATCH                   32
+#define RING_ENTRIES            (2 * BATCH)
+#define REAP_TIMEOUT            1000
+
+/*==============================================================================
+  Local object types
+==============================================================================*/
+typedef enum {
+        MODE_SYSCALL,
+        MODE_RING,
+        MODE_RING_ASYNC
+} io_mode_t;
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+static int  test_link(void);
+static int  measure(io_mode_t mode);
+static int  reap(size_t count);
+static int  verify(io_mode_t mode);
+static void fill(u8_t *buf, size_t record, io_mode_t mode);
+
+/*==============================================================================
+  Local objects
+==============================================================================*/
+GLOBAL_VARIABLES_SECTION {
+        ring_t  ring;
+        FILE   *file;
+        size_t  records;
+        u8_t    buf[2][BATCH][RECORD_SIZE];
+        u8_t    check[BATCH * RECORD_SIZE];
+};
+
+static const char *MODE_NAME[] = {"syscall", "ring", "ring async"};
+
+/*==============================================================================
+  Exported objects
+==============================================================================*/
+PROGRAM_PARAMS(ringbench, STACK_DEPTH_LOW);
+
+/*==============================================================================
+  External objects
+==============================================================================*/
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+
+//==============================================================================
+/**
+ * Main program function.
+ *
+ * Program writes small records to file by separate system calls (pwrite()),
+ * by ring submissions and by asynchronous ring submissions, and compares
+ * time per record. Records are written in batches of 32 records. Linked
+ * entries are also tested. Number of records can be given as argument.
+ *
+ * @param argc      argument count
+ * @param argv      arguments
+ */
+//==============================================================================
+int main(int argc, char *argv[])
+{
+        global->records = argc > 1 ? cast(size_t, atoi(argv[1])) : DEFAULT_RECORDS;
+        if (global->records == 0) {
+                printf("Usage: %s [records]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+
+        if (ring_init(&global->ring, RING_ENTRIES) != 0) {
+                perror(NULL);
+                return EXIT_FAILURE;
+        }
+
+        global->file = fopen(FILE_PATH, "w+");
+        if (!global->file) {
+                perror(FILE_PATH);
+                ring_destroy(&global->ring);
+                return EXIT_FAILURE;
+        }
+
+        puts("Ring test in progress...");
+
+        int status = EXIT_SUCCESS;
+
+        if (test_link() != 0) {
+                status = EXIT_FAILURE;
+        }
+
+        for (io_mode_t mode = MODE_SYSCALL; mode <= MODE_RING_ASYNC; mode++) {
+                if ((measure(mode) != 0) || (verify(mode) != 0)) {
+                        status = EXIT_FAILURE;
+                }
+        }
+
+        fclose(global->file);
+        remove(FILE_PATH);
+        ring_destroy(&global->ring);
+
+        return status;
+}
+
+//==============================================================================
+/**
+ * @brief  Function test linked entries. Entry linked with failed entry must
+ *         be canceled, next not linked entry must be executed.
+ *
+ * @return 0 on success, otherwise -1.
+ */
+//==============================================================================
+static int test_link(void)
+{
+        struct stat st;
+
+        ring_sqe_t *sqe = ring_get_sqe(&global->ring);
+        ring_prep_fstat(sqe, NULL, &st);
+        sqe->flags |= RING_SQE_LINK;
+
+        sqe = ring_get_sqe(&global->ring);
+        ring_prep_fstat(sqe, global->file, &st);
+
+        sqe = ring_get_sqe(&global->ring);
+        ring_prep_fstat(sqe, global->file, &st);
+
+        static const int EXPECTED[] = {EINVAL, ECANCELED, ESUCC};
+
+        int err = (ring_submit(&global->ring, 0) == ARRAY_SIZE(EXPECTED)) ? 0 : -1;
+
+        for (size_t i = 0; i < ARRAY_SIZE(EXPECTED); i++) {
+                ring_cqe_t *cqe = ring_peek_cqe(&global->ring);
+
+                if (!cqe || (cqe->err != EXPECTED[i])) {
+                        err = -1;
+                }
+
+                ring_cqe_seen(&global->ring);
+        }
+
+        printf("link: %s\n", err ? "FAILED" : "OK");
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function measure time of records write in selected mode.
+ *
+ * @param  mode         write mode
+ *
+ * @return 0 on success, otherwise -1.
+ */
+//==============================================================================
+static int measure(io_mode_t mode)
+{
+        int    err     = 0;
+        size_t pending = 0;
+        size_t set     = 0;
+        u64_t  tstart  = get_time_ms();
+
+        for (size_t i = 0; (i < global->records) && !err; i += BATCH, set ^= 1) {
+                size_t n = min(BATCH, global->records - i);
+
+                for (size_t k = 0; k < n; k++) {
+                        fill(global->buf[set][k], i + k, mode);
+                }
+
+                if (mode == MODE_SYSCALL) {
+                        for (size_t k = 0; (k < n) && !err; k++) {
+                                if (pwrite(global->file, global->buf[set][k], RECORD_SIZE,
+                                           (i + k) * RECORD_SIZE) != RECORD_SIZE) {
+                                        err = -1;
+                                }
+                        }
+
+                        continue;
+                }
+
+                for (size_t k = 0; k < n; k++) {
+                        ring_sqe_t *sqe = ring_get_sqe(&global->ring);
+                        ring_prep_write(sqe, global->file, global->buf[set][k],
+                                        RECORD_SIZE, (i + k) * RECORD_SIZE);
+                }
+
+                // buffers of the next batch are filled when this batch is written
+                err = reap(pending);
+
+                if (!err) {
+                        int flags = (mode == MODE_RING_ASYNC) ? RING_SUBMIT_ASYNC : 0;
+
+                        if (ring_submit(&global->ring, flags) != cast(int, n)) {
+                                err = -1;
+                        }
+
+                        pending = n;
+                }
+        }
+
+        if (!err) {
+                err = reap(pending);
+        }
+
+        u32_t time = get_time_ms() - tstart;
+
+        if (!err) {
+                u32_t ns = (cast(u64_t, time) * 1000000) / global->records;
+
+                printf("%s: %u.%03u us/record (%u records in %u ms)\n",
+                       MODE_NAME[mode], ns / 1000, ns % 1000,
+                       cast(uint, global->records), time);
+        } else {
+                printf("%s: FAILED\n", MODE_NAME[mode]);
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function reap completions of write entries.
+ *
+ * @param  count        number of completions
+ *
+ * @return 0 on success, otherwise -1.
+ */
+//==============================================================================
+static int reap(size_t count)
+{
+        int err = 0;
+
+        for (size_t i = 0; i < count; i++) {
+                ring_cqe_t *cqe = ring_wait_cqe(&global->ring, REAP_TIMEOUT);
+                if (!cqe) {
+                        return -1;
+                }
+
+                if (cqe->res != RECORD_SIZE) {
+                        err = -1;
+                }
+
+                ring_cqe_seen(&global->ring);
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function verify file content written in selected mode.
+ *
+ * @param  mode         write mode
+ *
+ * @return 0 on success, otherwise -1.
+ */
+//==============================================================================
+static int verify(io_mode_t mode)
+{
+        for (size_t i = 0; i < global->records; i += BATCH) {
+                size_t n = min(BATCH, global->records - i);
+
+                if (pread(global->file, global->check, n * RECORD_SIZE,
+                          i * RECORD_SIZE) != cast(ssize_t, n * RECORD_SIZE)) {
+                        printf("%s: read error\n", MODE_NAME[mode]);
+                        return -1;
+                }
+
+                for (size_t k = 0; k < n; k++) {
+                        u8_t record[RECORD_SIZE];
+                        fill(record, i + k, mode);
+
+                        if (memcmp(record, &global->check[k * RECORD_SIZE], RECORD_SIZE) != 0) {
+                                printf("%s: record %u corrupted\n",
+                                       MODE_NAME[mode], cast(uint, i + k));
+                                return -1;
+                        }
+                }
+        }
+
+        return 0;
+}
+
+//==============================================================================
+/**
+ * @brief  Function fill record content. Content depends on record number and
+ *         write mode.
+ *
+ * @param  buf          record buffer
+ * @param  record       record number
+ * @param  mode         write mode
+ */
+//==============================================================================
+static void fill(u8_t *buf, size_t record, io_mode_t mode)
+{
+        for (size_t i = 0; i < RECORD_SIZE; i++) {
+                buf[i] = record * 7 + i + mode;
+        }
+}
+
+/*==============================================================================
+  End of file
+==============================================================================*/
@@ -0,0 +1,315 @@
+/*==============================================================================
+File    spawnbench.c
+
+Author  Daniel Zorychta
+
+Brief   Process spawn/exit stress benchmark (PID allocation and lookup)
+
+        Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+        This program is free software; you can redistribute it and/or modify
+        it under the terms of the GNU General Public License as published by
+        the Free Software Foundation and modified by the dnx RTOS exception.
+
+        NOTE: The modification  to the GPL is  included to allow you to
+              distribute a combined work that includes dnx RTOS without
+              being obliged to provide the source  code for proprietary
+              components outside of the dnx RTOS.
+
+        The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+        but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+        MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+        GNU General Public License for more details.
+
+        Full license text is available on the following file: doc/license.txt.
+
+==============================================================================*/
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <dnx/os.h>
+#include <dnx/thread.h>
+#include <dnx/misc.h>
+
+/*==============================================================================
+  Local macros
+==============================================================================*/
+#define DEFAULT_PROCESSES       128
+#define MAX_PROCESSES           256
+#define CHURN_CYCLES            200
+#define STAT_ROUNDS             50
+#define WAIT_TIMEOUT            2000
+
+/*==============================================================================
+  Local object types
+==============================================================================*/
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+static int  sleeper(void);
+static int  spawn(size_t processes);
+static int  churn(void);
+static int  stat_all(size_t processes);
+static int  kill_all(size_t processes);
+static void print_result(const char *name, u32_t time, size_t ops);
+
+/*==============================================================================
+  Local objects
+==============================================================================*/
+GLOBAL_VARIABLES_SECTION {
+        pid_t       pid[MAX_PROCESSES];
+        const char *name;
+        char        cmd[32];
+};
+
+static const process_attr_t CHILD_ATTR = {
+        .priority = PRIORITY_NORMAL,
+        .detached = false
+};
+
+/*==============================================================================
+  Exported objects
+==============================================================================*/
+PROGRAM_PARAMS(spawnbench, STACK_DEPTH_LOW);
+
+/*==============================================================================
+  External objects
+==============================================================================*/
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+
+//==============================================================================
+/**
+ * Main program function.
+ *
+ * Program starts many sleeping processes (128 by default) and measures time
+ * of process spawn, spawn/exit/wait cycle of short process when all sleeping
+ * processes live, process statistics read by PID, and process kill. PIDs of
+ * live processes must be unique. Number of sleeping processes can be
+ * given as argument.
+ *
+ * @param argc      argument count
+ * @param argv      arguments
+ */
+//==============================================================================
+int main(int argc, char *argv[])
+{
+        if ((argc == 2) && (strcmp(argv[1], "-s") == 0)) {
+                return sleeper();
+        }
+
+        if ((argc == 2) && (strcmp(argv[1], "-e") == 0)) {
+                return EXIT_SUCCESS;
+        }
+
+        size_t processes = (argc > 1) ? atoi(argv[1]) : DEFAULT_PROCESSES;
+        if ((processes == 0) || (processes > MAX_PROCESSES)) {
+                printf("Usage: %s [processes (1..%d)]\n", argv[0], MAX_PROCESSES);
+                return EXIT_FAILURE;
+        }
+
+        global->name = argv[0];
+
+        printf("Spawn test with %u live processes in progress...\n", (uint)processes);
+
+        int err = spawn(processes);
+
+        if (!err) {
+                err = churn();
+        }
+
+        if (!err) {
+                err = stat_all(processes);
+        }
+
+        if (kill_all(processes) != 0) {
+                err = -1;
+        }
+
+        return err ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+//==============================================================================
+/**
+ * @brief  Sleeping child process. Process is killed by the parent.
+ *
+ * @return Exit status.
+ */
+//==============================================================================
+static int sleeper(void)
+{
+        for (;;) {
+                sleep(1);
+        }
+
+        return EXIT_SUCCESS;
+}
+
+//==============================================================================
+/**
+ * @brief  Function start sleeping processes.
+ *
+ * @param  processes    number of processes
+ *
+ * @return 0 on success, otherwise -1.
+ */
+//==============================================================================
+static int spawn(size_t processes)
+{
+        snprintf(global->cmd, sizeof(global->cmd), "%s -s", global->name);
+
+        u64_t tstart = get_time_ms();
+
+        for (size_t i = 0; i < processes; i++) {
+                global->pid[i] = process_create(global->cmd, &CHILD_ATTR);
+                if (global->pid[i] == 0) {
+                        perror(global->cmd);
+                        return -1;
+                }
+        }
+
+        print_result("spawn", get_time_ms() - tstart, processes);
+
+        for (size_t i = 0; i < processes; i++) {
+                for (size_t k = i + 1; k < processes; k++) {
+                        if (global->pid[i] == global->pid[k]) {
+                                printf("PID %u used twice\n", global->pid[i]);
+                                return -1;
+                        }
+                }
+        }
+
+        return 0;
+}
+
+//==============================================================================
+/**
+ * @brief  Function start short processes one by one and wait for their exit.
+ *
+ * @return 0 on success, otherwise -1.
+ */
+//==============================================================================
+static int churn(void)
+{
+        snprintf(global->cmd, sizeof(global->cmd), "%s -e", global->name);
+
+        u64_t tstart = get_time_ms();
+
+        for (size_t i = 0; i < CHURN_CYCLES; i++) {
+                pid_t pid = process_create(global->cmd, &CHILD_ATTR);
+                if (pid == 0) {
+                        perror(global->cmd);
+                        return -1;
+                }
+
+                int status = -1;
+                if ((process_wait(pid, &status, WAIT_TIMEOUT) != 0) || (status != 0)) {
+                        printf("spawn/exit: process %u not finished\n", pid);
+                        return -1;
+                }
+        }
+
+        print_result("spawn/exit", get_time_ms() - tstart, CHURN_CYCLES);
+
+        return 0;
+}
+
+//==============================================================================
+/**
+ * @brief  Function read statistics of all sleeping processes by PID.
+ *
+ * @param  processes    number of processes
+ *
+ * @return 0 on success, otherwise -1.
+ */
+//==============================================================================
+static int stat_all(size_t processes)
+{
+        process_stat_t stat;
+
+        u64_t tstart = get_time_ms();
+
+        for (size_t r = 0; r < STAT_ROUNDS; r++) {
+                for (size_t i = 0; i < processes; i++) {
+                        if (  (process_stat(global->pid[i], &stat) != 0)
+                           || (stat.pid != global->pid[i]) ) {
+                                printf("stat: process %u not found\n", global->pid[i]);
+                                return -1;
+                        }
+                }
+        }
+
+        print_result("stat", get_time_ms() - tstart, STAT_ROUNDS * processes);
+
+        return 0;
+}
+
+//==============================================================================
+/**
+ * @brief  Function kill all sleeping processes. Killed process must not be
+ *         found by PID.
+ *
+ * @param  processes    number of processes
+ *
+ * @return 0 on success, otherwise -1.
+ */
+//==============================================================================
+static int kill_all(size_t processes)
+{
+        int err = 0;
+
+        u64_t tstart = get_time_ms();
+
+        for (size_t i = 0; i < processes; i++) {
+                if (global->pid[i] && (process_kill(global->pid[i]) != 0)) {
+                        printf("kill: process %u not found\n", global->pid[i]);
+                        err = -1;
+                }
+        }
+
+        u32_t time = get_time_ms() - tstart;
+
+        for (size_t i = 0; i < processes; i++) {
+                process_stat_t stat;
+
+                if (global->pid[i] && (process_stat(global->pid[i], &stat) == 0)) {
+                        printf("kill: process %u still exists\n", global->pid[i]);
+                        err = -1;
+                }
+        }
+
+        if (!err) {
+                print_result("kill", time, processes);
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function print time per operation.
+ *
+ * @param  name         operation name
+ * @param  time         total time [ms]
+ * @param  ops          number of operations
+ */
+//==============================================================================
+static void print_result(const char *name, u32_t time, size_t ops)
+{
+        u32_t ns = (cast(u64_t, time) * 1000000) / ops;
+
+        printf("%s: %u.%03u us/op (%u ops in %u ms)\n",
+               name, ns / 1000, ns % 1000, (uint)ops, time);
+}
+
+/*==============================================================================
+  End of file
+==============================================================================*/
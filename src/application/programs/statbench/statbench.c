@@ -0,0 +1,285 @@
+/*==============================================================================
+File    statbench.c
+
+Author  Daniel Zorychta
+
+Brief   VFS lookup cache benchmark (stat throughput)
+
+        Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+        This program is free software; you can redistribute it and/or modify
+        it under the terms of the GNU General Public License as published by
+        the Free Software Foundation and modified by the dnx RTOS exception.
+
+        NOTE: The modification  to the GPL is  included to allow you to
+              distribute a combined work that includes dnx RTOS without
+              being obliged to provide the source  code for proprietary
+              components outside of the dnx RTOS.
+
+        The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+        but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+        MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+        GNU General Public License for more details.
+
+        Full license text is available on the following file: doc/license.txt.
+
+==============================================================================*/
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/mount.h>
+#include <dnx/os.h>
+#include <dnx/misc.h>
+
+/*==============================================================================
+  Local macros
+==============================================================================*/
+#define TEST_TIME_MS            1000
+#define BATCH_CALLS             100
+#define MOUNT_POINT             "/tmp/statbench_%s_%s"
+#define DIR_DEPTH               6
+#define TEST_FILE               "file"
+#define MISSING_FILE            "missing"
+
+/*==============================================================================
+  Local object types
+==============================================================================*/
+typedef enum {
+        PATH_DIR,
+        PATH_FILE,
+        PATH_MISSING,
+        _PATH_COUNT
+} path_t;
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+static const char *dir_path(int depth);
+static int  make_tree(void);
+static void remove_tree(void);
+static int  measure(const char *fs, const char *src, const char *opts, u32_t *ops);
+static void set_paths(const char *fs, const char *name);
+
+/*==============================================================================
+  Local objects
+==============================================================================*/
+GLOBAL_VARIABLES_SECTION {
+        char mnt[64];
+        char path[_PATH_COUNT][128];
+        char dir[128];
+};
+
+static const char *PATH_NAME[_PATH_COUNT] = {
+        [PATH_DIR]     = "directory",
+        [PATH_FILE]    = "file",
+        [PATH_MISSING] = "missing",
+};
+
+/*==============================================================================
+  Exported objects
+==============================================================================*/
+PROGRAM_PARAMS(statbench, STACK_DEPTH_LOW);
+
+/*==============================================================================
+  External objects
+==============================================================================*/
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+
+//==============================================================================
+/**
+ * Main program function.
+ *
+ * Program measures stat() throughput of a directory, a regular file and a not
+ * existing file placed deep in the tree of file system. File system is mounted
+ * twice: with VFS lookup cache disabled (nodcache option) and with default
+ * options, so the results show the cost of file system lookup and the cache
+ * hit path. Each pass uses own mount point, because not all file systems can
+ * be unmounted (e.g. ramfs). File system and its source file can be given as
+ * arguments (default ramfs).
+ *
+ * @param argc      argument count
+ * @param argv      arguments
+ */
+//==============================================================================
+int main(int argc, char *argv[])
+{
+        const char *fs  = argc > 1 ? argv[1] : "ramfs";
+        const char *src = argc > 2 ? argv[2] : "";
+
+        puts("stat test in progress...");
+
+        u32_t nocache[_PATH_COUNT];
+        u32_t cache[_PATH_COUNT];
+
+        int err = measure(fs, src, "nodcache", nocache)
+               || measure(fs, src, "", cache);
+
+        if (err) {
+                return EXIT_FAILURE;
+        }
+
+        for (path_t p = 0; p < _PATH_COUNT; p++) {
+                printf("%s: stat() %u ops/s (nodcache %u ops/s)\n",
+                       PATH_NAME[p], cast(uint, cache[p]), cast(uint, nocache[p]));
+        }
+
+        return EXIT_SUCCESS;
+}
+
+//==============================================================================
+/**
+ * @brief  Function mount file system with selected options and measure stat()
+ *         throughput of each test path.
+ *
+ * @param  fs           file system name
+ * @param  src          source file
+ * @param  opts         mount options
+ * @param  ops          stat() calls per second of each path
+ *
+ * @return 0 on success, otherwise -1.
+ */
+//==============================================================================
+static int measure(const char *fs, const char *src, const char *opts, u32_t *ops)
+{
+        set_paths(fs, opts[0] ? opts : "dcache");
+
+        if (mkdir(global->mnt, 0777) != 0) {
+                perror(global->mnt);
+                return -1;
+        }
+
+        if (mount(fs, src, global->mnt, opts) != 0) {
+                perror(global->mnt);
+                remove(global->mnt);
+                return -1;
+        }
+
+        int err = make_tree();
+
+        for (path_t p = 0; (p < _PATH_COUNT) && !err; p++) {
+                struct stat st;
+                u32_t calls = 0;
+                u32_t time  = 0;
+
+                u64_t tstart = get_time_ms();
+
+                do {
+                        for (int i = 0; i < BATCH_CALLS; i++) {
+                                stat(global->path[p], &st);
+                        }
+
+                        calls += BATCH_CALLS;
+                        time   = cast(u32_t, get_time_ms() - tstart);
+
+                } while (time < TEST_TIME_MS);
+
+                ops[p] = (cast(u64_t, calls) * 1000) / time;
+        }
+
+        remove_tree();
+
+        // file system can stay mounted if it cannot be released (ramfs)
+        if (umount(global->mnt) == 0) {
+                remove(global->mnt);
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function sets mount point and test paths of the pass.
+ *
+ * @param  fs           file system name
+ * @param  name         pass name
+ */
+//==============================================================================
+static void set_paths(const char *fs, const char *name)
+{
+        snprintf(global->mnt, sizeof(global->mnt), MOUNT_POINT, fs, name);
+
+        snprintf(global->path[PATH_DIR], sizeof(global->path[0]), "%s", dir_path(DIR_DEPTH));
+
+        snprintf(global->path[PATH_FILE], sizeof(global->path[0]), "%s/%s",
+                 global->path[PATH_DIR], TEST_FILE);
+
+        snprintf(global->path[PATH_MISSING], sizeof(global->path[0]), "%s/%s",
+                 global->path[PATH_DIR], MISSING_FILE);
+}
+
+//==============================================================================
+/**
+ * @brief  Function returns path of test directory of selected depth.
+ *
+ * @param  depth        directory depth (0: mount point)
+ *
+ * @return Directory path.
+ */
+//==============================================================================
+static const char *dir_path(int depth)
+{
+        size_t len = snprintf(global->dir, sizeof(global->dir), "%s", global->mnt);
+
+        for (int i = 0; i < depth; i++) {
+                len += snprintf(&global->dir[len], sizeof(global->dir) - len, "/d%d", i);
+        }
+
+        return global->dir;
+}
+
+//==============================================================================
+/**
+ * @brief  Function creates test directories and test file. Existing
+ *         directories (persistent file system) are used.
+ *
+ * @return 0 on success, otherwise -1.
+ */
+//==============================================================================
+static int make_tree(void)
+{
+        for (int depth = 1; depth <= DIR_DEPTH; depth++) {
+                struct stat st;
+                const char *dir = dir_path(depth);
+
+                if ((stat(dir, &st) != 0) && (mkdir(dir, 0777) != 0)) {
+                        perror(dir);
+                        return -1;
+                }
+        }
+
+        FILE *f = fopen(global->path[PATH_FILE], "w");
+        if (f) {
+                fputs("statbench", f);
+                fclose(f);
+                return 0;
+        } else {
+                perror(global->path[PATH_FILE]);
+                return -1;
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function removes test file and test directories.
+ */
+//==============================================================================
+static void remove_tree(void)
+{
+        remove(global->path[PATH_FILE]);
+
+        for (int depth = DIR_DEPTH; depth > 0; depth--) {
+                remove(dir_path(depth));
+        }
+}
+
+/*==============================================================================
+  End of file
+==============================================================================*/
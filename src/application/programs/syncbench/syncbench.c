@@ -0,0 +1,236 @@
+/*==============================================================================
+File    syncbench.c
+
+Author  Daniel Zorychta
+
+Brief   File system lookup latency during cache synchronization
+
+        Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+        This program is free software; you can redistribute it and/or modify
+        it under the terms of the GNU General Public License as published by
+        the Free Software Foundation and modified by the dnx RTOS exception.
+
+        NOTE: The modification  to the GPL is  included to allow you to
+              distribute a combined work that includes dnx RTOS without
+              being obliged to provide the source  code for proprietary
+              components outside of the dnx RTOS.
+
+        The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+        but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+        MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+        GNU General Public License for more details.
+
+        Full license text is available on the following file: doc/license.txt.
+
+==============================================================================*/
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <dnx/os.h>
+#include <dnx/thread.h>
+#include <dnx/misc.h>
+
+/*==============================================================================
+  Local macros
+==============================================================================*/
+#define DEFAULT_BASE            "/mnt"
+#define DEFAULT_SIZE_KIB        1024
+#define TEST_FILE               "syncbench.dat"
+#define STAT_PATH               "/proc/cpuinfo"
+#define STAT_BATCH              20
+#define IDLE_TIME_MS            1000
+#define BLOCK_SIZE              512
+
+/*==============================================================================
+  Local object types
+==============================================================================*/
+typedef struct {
+        u32_t   min;
+        u32_t   max;
+        u32_t   sum;
+        u32_t   batches;
+} latency_t;
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+static void sync_thread (void *arg);
+static void stat_batch  (latency_t *lat);
+static void show        (const char *name, const latency_t *lat);
+
+/*==============================================================================
+  Local objects
+==============================================================================*/
+GLOBAL_VARIABLES_SECTION {
+        bool    sync_done;
+        u32_t   sync_time;
+        char    file[128];
+        u8_t    buf[BLOCK_SIZE];
+};
+
+static const thread_attr_t THREAD_ATTR = {
+        .stack_depth = STACK_DEPTH_LOW,
+        .priority    = PRIORITY_NORMAL,
+        .detached    = false
+};
+
+/*==============================================================================
+  Exported objects
+==============================================================================*/
+PROGRAM_PARAMS(syncbench, STACK_DEPTH_LOW);
+
+/*==============================================================================
+  External objects
+==============================================================================*/
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+
+//==============================================================================
+/**
+ * Main program function.
+ *
+ * Program measures latency of stat() of procfs file while large file written
+ * to FAT file system is synchronized by sync(). Latency is measured in batches
+ * of stat() calls; the same measurement without synchronization is the
+ * reference. Directory on FAT file system (default /mnt) and size of written
+ * file in KiB can be given as arguments.
+ *
+ * @param argc      argument count
+ * @param argv      arguments
+ */
+//==============================================================================
+int main(int argc, char *argv[])
+{
+        const char *base = argc > 1 ? argv[1] : DEFAULT_BASE;
+        size_t      size = argc > 2 ? cast(size_t, max(0, atoi(argv[2]))) : DEFAULT_SIZE_KIB;
+
+        if (size == 0) {
+                printf("Usage: %s [dir] [KiB]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+
+        snprintf(global->file, sizeof(global->file), "%s/%s", base, TEST_FILE);
+
+        latency_t idle = {.min = UINT32_MAX};
+        latency_t busy = {.min = UINT32_MAX};
+
+        sync();
+
+        u64_t tstart = get_time_ms();
+        while (get_time_ms() - tstart < IDLE_TIME_MS) {
+                stat_batch(&idle);
+        }
+
+        FILE *f = fopen(global->file, "w");
+        if (!f) {
+                perror(global->file);
+                return EXIT_FAILURE;
+        }
+
+        printf("Writing %u KiB to %s...\n", (uint)size, global->file);
+
+        memset(global->buf, 0xA5, sizeof(global->buf));
+
+        for (size_t i = 0; i < size * (1024 / BLOCK_SIZE); i++) {
+                if (fwrite(global->buf, 1, sizeof(global->buf), f) != sizeof(global->buf)) {
+                        perror(global->file);
+                        break;
+                }
+        }
+
+        puts("Synchronization in progress...");
+
+        global->sync_done = false;
+
+        tid_t tid = thread_create(sync_thread, &THREAD_ATTR, NULL);
+        if (tid) {
+                while (!global->sync_done) {
+                        stat_batch(&busy);
+                }
+
+                thread_join(tid);
+        } else {
+                perror(NULL);
+        }
+
+        fclose(f);
+        remove(global->file);
+
+        show("idle", &idle);
+        show("sync", &busy);
+        printf("sync() time: %u ms\n", global->sync_time);
+
+        return tid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+//==============================================================================
+/**
+ * @brief  Thread synchronize file systems and measure synchronization time.
+ *
+ * @param  arg          thread's argument
+ */
+//==============================================================================
+static void sync_thread(void *arg)
+{
+        UNUSED_ARG1(arg);
+
+        u64_t tstart = get_time_ms();
+        sync();
+        global->sync_time = get_time_ms() - tstart;
+
+        global->sync_done = true;
+}
+
+//==============================================================================
+/**
+ * @brief  Function measure single batch of stat() calls.
+ *
+ * @param  lat          latency statistics
+ */
+//==============================================================================
+static void stat_batch(latency_t *lat)
+{
+        struct stat st;
+
+        u64_t tstart = get_time_ms();
+        for (int i = 0; i < STAT_BATCH; i++) {
+                stat(STAT_PATH, &st);
+        }
+        u32_t us = (get_time_ms() - tstart) * 1000 / STAT_BATCH;
+
+        lat->min  = min(lat->min, us);
+        lat->max  = max(lat->max, us);
+        lat->sum += us;
+        lat->batches++;
+}
+
+//==============================================================================
+/**
+ * @brief  Function print latency statistics.
+ *
+ * @param  name         measurement name
+ * @param  lat          latency statistics
+ */
+//==============================================================================
+static void show(const char *name, const latency_t *lat)
+{
+        if (lat->batches) {
+                printf("%s: stat() min %u us, avg %u us, max %u us (%u batches)\n",
+                       name, lat->min, lat->sum / lat->batches, lat->max, lat->batches);
+        } else {
+                printf("%s: no samples\n", name);
+        }
+}
+
+/*==============================================================================
+  End of file
+==============================================================================*/
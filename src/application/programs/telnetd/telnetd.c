@@ -102,7 +102,7 @@ static char *create_and_open_pipe(SOCKET *socket, char c, FILE **f)
 {
         char *name = calloc(1, PIPE_NAME_LEN);
         if (name) {
-                snprintf(name, PIPE_NAME_LEN, "/run/tn%x%c", cast(int, socket), c);
+                snprintf(name, PIPE_NAME_LEN, "/run/tn%x%c", cast(uint, cast(uintptr_t, socket)), c);
 
                 if (mkfifo(name, 0666) == 0) {
                         *f = fopen(name, "r+");
@@ -46,7 +46,7 @@
 ==============================================================================*/
 #define KEY_READ_INTERVAL_SEC   (CLOCKS_PER_SEC / 100)
 #define REFRESH_INTERVAL_SEC    (CLOCKS_PER_SEC * 1)
-#define MSG_LINE_POS            VT100_CURSOR_HOME VT100_CURSOR_DOWN(5) VT100_ERASE_LINE_FROM_CUR
+#define MSG_LINE_POS            VT100_CURSOR_HOME VT100_CURSOR_DOWN(6) VT100_ERASE_LINE_FROM_CUR
 
 /*==============================================================================
   Local types, enums definitions
@@ -61,6 +61,7 @@
 ==============================================================================*/
 GLOBAL_VARIABLES_SECTION {
         memstat_t      mem;
+        mempoolstat_t  pool;
         process_stat_t pstat;
         bool           show_threads;
         uint           refresh_inteval_s;
@@ -144,6 +145,20 @@ int main(int argc, char *argv[])
                         global->mem.network_memory_usage,
                         global->mem.programs_memory_usage);
 
+                u32_t pool_used = 0, pool_objects = 0;
+                uint  pool_count = get_number_of_memory_pools();
+                for (uint pool = 0; pool < pool_count; pool++) {
+                        if (get_memory_pool_usage(pool, &global->pool) == 0) {
+                                pool_used    += global->pool.used;
+                                pool_objects += global->pool.objects;
+                        }
+                }
+
+                printf("%u pools, %u/%u objects used, %d in pools, %d free\n",
+                        pool_count, pool_used, pool_objects,
+                        global->mem.pools_memory_usage,
+                        global->mem.pools_free_memory);
+
                 printf("\n");
 
                 printf(VT100_FONT_COLOR_BLACK VT100_BACK_COLOR_WHITE
@@ -0,0 +1,223 @@
+/*==============================================================================
+File    vfsbench.c
+
+Author  Daniel Zorychta
+
+Brief   VFS path lookup benchmark (open/stat throughput)
+
+        Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+        This program is free software; you can redistribute it and/or modify
+        it under the terms of the GNU General Public License as published by
+        the Free Software Foundation and modified by the dnx RTOS exception.
+
+        NOTE: The modification  to the GPL is  included to allow you to
+              distribute a combined work that includes dnx RTOS without
+              being obliged to provide the source  code for proprietary
+              components outside of the dnx RTOS.
+
+        The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+        but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+        MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+        GNU General Public License for more details.
+
+        Full license text is available on the following file: doc/license.txt.
+
+==============================================================================*/
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/mount.h>
+#include <dnx/os.h>
+#include <dnx/misc.h>
+
+/*==============================================================================
+  Local macros
+==============================================================================*/
+#define TEST_TIME_MS            2000
+#define MAX_MOUNTS              32
+#define DEFAULT_BASE            "/tmp"
+#define TEST_FILE               "vfsbench.dat"
+#define MOUNT_DIR               "vfsbench_mnt"
+
+/*==============================================================================
+  Local object types
+==============================================================================*/
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+static int  mount_up_to(size_t count);
+static void umount_all(void);
+static void measure(size_t mounts);
+
+/*==============================================================================
+  Local objects
+==============================================================================*/
+GLOBAL_VARIABLES_SECTION {
+        const char *base;
+        size_t      mounted;
+        char        path[128];
+        char        file[128];
+};
+
+static const size_t MOUNTS[] = {1, 8, 32};
+
+/*==============================================================================
+  Exported objects
+==============================================================================*/
+PROGRAM_PARAMS(vfsbench, STACK_DEPTH_LOW);
+
+/*==============================================================================
+  External objects
+==============================================================================*/
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+
+//==============================================================================
+/**
+ * Main program function.
+ *
+ * Program measures stat() and fopen()/fclose() throughput of a file while
+ * 1, 8 and 32 additional ramfs file systems are mounted next to it. Base
+ * directory of the test can be given as argument (default /tmp).
+ *
+ * @param argc      argument count
+ * @param argv      arguments
+ */
+//==============================================================================
+int main(int argc, char *argv[])
+{
+        int status = EXIT_FAILURE;
+
+        global->base = argc > 1 ? argv[1] : DEFAULT_BASE;
+
+        snprintf(global->file, sizeof(global->file), "%s/%s", global->base, TEST_FILE);
+
+        FILE *f = fopen(global->file, "w");
+        if (f) {
+                fclose(f);
+
+                puts("VFS lookup test in progress...");
+
+                status = EXIT_SUCCESS;
+
+                for (size_t i = 0; i < ARRAY_SIZE(MOUNTS); i++) {
+                        if (mount_up_to(MOUNTS[i]) == 0) {
+                                measure(MOUNTS[i]);
+                        } else {
+                                perror(global->path);
+                                status = EXIT_FAILURE;
+                                break;
+                        }
+                }
+
+                umount_all();
+                remove(global->file);
+
+        } else {
+                perror(global->file);
+        }
+
+        return status;
+}
+
+//==============================================================================
+/**
+ * @brief  Function mount ramfs file systems until selected number of mounts
+ *         is reached.
+ *
+ * @param  count        number of mounts
+ *
+ * @return 0 on success, otherwise -1.
+ */
+//==============================================================================
+static int mount_up_to(size_t count)
+{
+        while (global->mounted < min(count, MAX_MOUNTS)) {
+                snprintf(global->path, sizeof(global->path), "%s/%s%u",
+                         global->base, MOUNT_DIR, (uint)global->mounted);
+
+                if (mkdir(global->path, 0777) != 0) {
+                        return -1;
+                }
+
+                if (mount("ramfs", "", global->path, "") != 0) {
+                        remove(global->path);
+                        return -1;
+                }
+
+                global->mounted++;
+        }
+
+        return 0;
+}
+
+//==============================================================================
+/**
+ * @brief  Function unmount all file systems mounted by the test.
+ */
+//==============================================================================
+static void umount_all(void)
+{
+        while (global->mounted > 0) {
+                global->mounted--;
+
+                snprintf(global->path, sizeof(global->path), "%s/%s%u",
+                         global->base, MOUNT_DIR, (uint)global->mounted);
+
+                umount(global->path);
+                remove(global->path);
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function measure stat() and fopen()/fclose() throughput.
+ *
+ * @param  mounts       number of mounted file systems
+ */
+//==============================================================================
+static void measure(size_t mounts)
+{
+        struct stat st;
+        u32_t       stats = 0;
+        u32_t       opens = 0;
+
+        u64_t tstart = get_time_ms();
+        while (get_time_ms() - tstart < TEST_TIME_MS) {
+                for (int i = 0; i < 100; i++) {
+                        stat(global->file, &st);
+                }
+
+                stats += 100;
+        }
+
+        tstart = get_time_ms();
+        while (get_time_ms() - tstart < TEST_TIME_MS) {
+                for (int i = 0; i < 10; i++) {
+                        FILE *f = fopen(global->file, "r");
+                        if (f) {
+                                fclose(f);
+                        }
+                }
+
+                opens += 10;
+        }
+
+        printf("%2u mounts: stat() %u ops/s, fopen()/fclose() %u ops/s\n",
+               (uint)mounts,
+               stats * 1000 / TEST_TIME_MS,
+               opens * 1000 / TEST_TIME_MS);
+}
+
+/*==============================================================================
+  End of file
+==============================================================================*/
@@ -0,0 +1,216 @@
+/*==============================================================================
+File    cmx_systick.c
+
+Author  Daniel Zorychta
+
+Brief   SysTick functions shared by Cortex-M ports (CPU load counter and
+        tickless idle).
+
+        Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+        This program is free software; you can redistribute it and/or modify
+        it under the terms of the GNU General Public License as published by
+        the Free Software Foundation and modified by the dnx RTOS exception.
+
+        NOTE: The modification  to the GPL is  included to allow you to
+              distribute a combined work that includes dnx RTOS without
+              being obliged to provide the source  code for proprietary
+              components outside of the dnx RTOS.
+
+        The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+        but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+        MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+        GNU General Public License for more details.
+
+        Full license text is available on the following file: doc/license.txt.
+
+==============================================================================*/
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include "config.h"
+#include "cpu/cpuctl.h"
+#include "kernel/kwrapper.h"
+
+#if defined(ARCH_stm32f1)
+#       include "stm32f1/stm32f10x.h"
+#elif defined(ARCH_stm32f3)
+#       include "stm32f3/stm32f3xx.h"
+#elif defined(ARCH_stm32f4)
+#       include "stm32f4/stm32f4xx.h"
+#elif defined(ARCH_stm32f7)
+#       include "stm32f7/stm32f7xx.h"
+#elif defined(ARCH_stm32h7)
+#       include "stm32h7/stm32h7xx.h"
+#elif defined(ARCH_efr32)
+#       include "efr32/efr32xx.h"
+#endif
+
+/*==============================================================================
+  Local symbolic constants/macros
+==============================================================================*/
+
+/*==============================================================================
+  Local types, enums definitions
+==============================================================================*/
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+
+/*==============================================================================
+  Local object definitions
+==============================================================================*/
+#if (__OS_MONITOR_CPU_LOAD__ > 0)
+static u32_t load_counter_last;
+#if (__OS_TICKLESS_IDLE__ > 0)
+static u32_t load_counter_sleep;
+#endif
+#endif
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+
+//==============================================================================
+/**
+ * @brief  Function return valut that was counted from last call of this function.
+ *         This function must reset timer after read. Function is called from
+ *         IRQs.
+ *
+ * @param  None
+ *
+ * @return Timer value for last read (time delta).
+ */
+//==============================================================================
+#if (__OS_MONITOR_CPU_LOAD__ > 0)
+u32_t _cpuctl_get_CPU_load_counter_delta(void)
+{
+        bool  ovf = SysTick->CTRL & SysTick_CTRL_COUNTFLAG_Msk;
+        u32_t now = SysTick->VAL;
+
+        u32_t delta;
+        if (ovf) {
+                delta = ((SysTick->LOAD + 1) - now) + load_counter_last;
+        } else {
+                delta = load_counter_last - now;
+        }
+
+        load_counter_last = now;
+
+        #if (__OS_TICKLESS_IDLE__ > 0)
+        delta += load_counter_sleep;
+        load_counter_sleep = 0;
+        #endif
+
+        return delta;
+}
+#endif
+
+#if (__OS_TICKLESS_IDLE__ > 0)
+//==============================================================================
+/**
+ * @brief  Function return maximum number of ticks that can be skipped by
+ *         one-shot timer (limited by 24-bit SysTick counter).
+ *
+ * @return Number of ticks.
+ */
+//==============================================================================
+u32_t _cpuctl_tickless_max_ticks(void)
+{
+        return SysTick_LOAD_RELOAD_Msk / (SysTick->LOAD + 1);
+}
+
+//==============================================================================
+/**
+ * @brief  Function switch SysTick to one-shot mode and sleep CPU until timer
+ *         expires or other interrupt occurs (port function _cpuctl_sleep()). After wake up the periodic tick
+ *         is restored with the phase of skipped tick periods. Function is
+ *         called by the kernel when scheduler is suspended.
+ *
+ * @param  ticks        number of ticks to sleep (at least 2)
+ *
+ * @return Number of complete tick periods that elapsed and are not served
+ *         by SysTick interrupt.
+ */
+//==============================================================================
+u32_t _cpuctl_tickless_sleep(u32_t ticks)
+{
+        __disable_irq();
+        __DSB();
+        __ISB();
+
+        #if (__OS_MONITOR_CPU_LOAD__ > 0)
+        load_counter_sleep = _cpuctl_get_CPU_load_counter_delta();
+        #endif
+
+        /* stop SysTick, the counter contains the rest of current tick period */
+        u32_t period = SysTick->LOAD + 1;
+        SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+
+        if (eTaskConfirmSleepModeStatus() == eAbortSleep) {
+                /* complete current tick period and return to periodic mode */
+                SysTick->LOAD = SysTick->VAL;
+                SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+                SysTick->LOAD = period - 1;
+
+                __enable_irq();
+                return 0;
+        }
+
+        u32_t reload = SysTick->VAL + (period * (ticks - 1));
+        SysTick->LOAD = reload;
+        SysTick->VAL  = 0;
+        SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+
+        __DSB();
+        _cpuctl_sleep();
+        __ISB();
+
+        u32_t ctrl = SysTick->CTRL;
+        SysTick->CTRL = ctrl & ~SysTick_CTRL_ENABLE_Msk;
+        u32_t now  = SysTick->VAL;
+        u32_t rest;
+        u32_t counts;
+
+        if (ctrl & SysTick_CTRL_COUNTFLAG_Msk) {
+                /* timer expired: the last tick is served by pending interrupt */
+                rest = (period - 1) - (reload - now);
+                if ((rest == 0) || (rest > period)) {
+                        rest = period - 1;
+                }
+
+                counts = reload + (reload - now);
+                ticks  = ticks - 1;
+
+        } else {
+                /* woken by other interrupt: count complete tick periods */
+                u32_t decrements = (ticks * period) - now;
+
+                ticks  = decrements / period;
+                rest   = ((ticks + 1) * period) - decrements;
+                counts = reload - now;
+        }
+
+        SysTick->LOAD = rest;
+        SysTick->VAL  = 0;
+        SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+        SysTick->LOAD = period - 1;
+
+        #if (__OS_MONITOR_CPU_LOAD__ > 0)
+        load_counter_sleep += counts;
+        load_counter_last   = rest;
+        #else
+        UNUSED_ARG1(counts);
+        #endif
+
+        __enable_irq();
+
+        return ticks;
+}
+#endif
+
+/*==============================================================================
+  End of file
+==============================================================================*/
@@ -66,11 +66,17 @@ extern void  _cpuctl_sleep                      (void);
 extern void  _cpuctl_update_system_clocks       (void);
 extern void  _cpuctl_delay_us                   (u16_t);
 
+/* SysTick load counter delta and tickless functions: cmx/cmx_systick.c */
 #if (__OS_MONITOR_CPU_LOAD__ > 0)
 extern void  _cpuctl_init_CPU_load_counter      (void);
 extern u32_t _cpuctl_get_CPU_load_counter_delta (void);
 #endif
 
+#if (__OS_TICKLESS_IDLE__ > 0)
+extern u32_t _cpuctl_tickless_max_ticks         (void);
+extern u32_t _cpuctl_tickless_sleep             (u32_t);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,294 @@
+/*=========================================================================*//**
+@file    cpuctl.c
+
+@author  Daniel Zorychta
+
+@brief   This file support CPU control
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include "config.h"
+#include "linux/cpuctl.h"
+#include "linux/host.h"
+#include "kernel/kwrapper.h"
+#include "kernel/kpanic.h"
+#include "kernel/sysfunc.h"
+
+/*==============================================================================
+  Local symbolic constants/macros
+==============================================================================*/
+/* RAM size configured by project (KiB) */
+#define RAM_SIZE                ((size_t)__CPU_RAM_SIZE__ * 1024)
+
+/* size of startup stack region, reused by kernel as heap */
+#define START_STACK_SIZE        (16 * 1024)
+
+/* maximum sleep time of tickless idle (10 seconds) */
+#define TICKLESS_MAX_TICKS      (__OS_TASK_SCHED_FREQ__ * 10)
+
+#define STR(x)                  #x
+#define XSTR(x)                 STR(x)
+
+/*==============================================================================
+  Local types, enums definitions
+==============================================================================*/
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+
+/*==============================================================================
+  Local object definitions
+==============================================================================*/
+static _mm_region_t ram;
+
+#if (__OS_MONITOR_CPU_LOAD__ > 0)
+static u64_t load_counter_last;
+#endif
+
+/*==============================================================================
+  Exported object definitions
+==============================================================================*/
+/*
+ * Symbols defined by linker script on microcontrollers. The startup stack
+ * is not used on host (main() runs on host stack), the area is registered
+ * as heap region by the kernel. Static data of the system is a part of the
+ * host process image, thus RAM starts at the stack area. Text section
+ * symbols are defined by linker flags (see config/arch/linux/cpu_flags.h).
+ */
+u8_t __stack_start[START_STACK_SIZE + 512] __attribute__((aligned(64)));
+
+__asm__(".globl __stack_size\n\t"
+        ".set __stack_size, " XSTR(START_STACK_SIZE + 512) "\n\t"
+        ".globl __ram_start\n\t"
+        ".set __ram_start, __stack_start");
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+
+//==============================================================================
+/**
+ * @brief  Basic (first) CPU/microcontroller configuration. This function is
+ *         called before system start.
+ *
+ * @param  None
+ *
+ * @return None
+ */
+//==============================================================================
+void _cpuctl_init(void)
+{
+        #if (__OS_MONITOR_CPU_LOAD__ > 0)
+        _cpuctl_init_CPU_load_counter();
+        #endif
+
+        void *mem = _host_mem_alloc(RAM_SIZE);
+        if (mem) {
+                _mm_register_region(&ram, mem, RAM_SIZE, _MM_FLAG__DMA_CAPABLE, "RAM");
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  This function restart CPU (host program is started again).
+ */
+//==============================================================================
+void _cpuctl_restart_system(void)
+{
+        _host_restart();
+}
+
+//==============================================================================
+/**
+ * @brief  This function shutdown CPU (host program exits).
+ */
+//==============================================================================
+void _cpuctl_shutdown_system(void)
+{
+        _host_exit(0);
+}
+
+//==============================================================================
+/**
+ * @brief  Start counter used for CPU load measurement. Host monotonic time
+ *         in microseconds is used.
+ *
+ * @param  None
+ *
+ * @return None
+ */
+//==============================================================================
+#if (__OS_MONITOR_CPU_LOAD__ > 0)
+void _cpuctl_init_CPU_load_counter(void)
+{
+        load_counter_last = _host_time_us();
+}
+#endif
+
+//==============================================================================
+/**
+ * @brief  Function return valut that was counted from last call of this function.
+ *         This function must reset timer after read. Function is called from
+ *         IRQs.
+ *
+ * @param  None
+ *
+ * @return Timer value for last read (time delta).
+ */
+//==============================================================================
+#if (__OS_MONITOR_CPU_LOAD__ > 0)
+u32_t _cpuctl_get_CPU_load_counter_delta(void)
+{
+        u64_t now   = _host_time_us();
+        u32_t delta = now - load_counter_last;
+        load_counter_last = now;
+
+        return delta;
+}
+#endif
+
+//==============================================================================
+/**
+ * @brief  Function sleep CPU weakly. All IRQs must be able to wake up CPU.
+ *
+ * @param  None
+ *
+ * @return None
+ */
+//==============================================================================
+void _cpuctl_sleep(void)
+{
+        _host_sleep();
+}
+
+#if (__OS_TICKLESS_IDLE__ > 0)
+//==============================================================================
+/**
+ * @brief  Function return maximum number of ticks that can be skipped by
+ *         one-shot timer.
+ *
+ * @return Number of ticks.
+ */
+//==============================================================================
+u32_t _cpuctl_tickless_max_ticks(void)
+{
+        return TICKLESS_MAX_TICKS;
+}
+
+//==============================================================================
+/**
+ * @brief  Function switch tick timer to one-shot mode and sleep CPU until
+ *         timer expires or other interrupt occurs. Function is called by the
+ *         kernel when scheduler is suspended.
+ *
+ * @param  ticks        number of ticks to sleep (at least 2)
+ *
+ * @return Number of complete tick periods that elapsed and are not served
+ *         by tick interrupt.
+ */
+//==============================================================================
+u32_t _cpuctl_tickless_sleep(u32_t ticks)
+{
+        _host_irq_disable();
+
+        if (eTaskConfirmSleepModeStatus() == eAbortSleep) {
+                ticks = 0;
+        } else {
+                _host_tick_oneshot(ticks);
+                _host_irq_wait();
+                ticks = _host_tick_resume(ticks - 1);
+        }
+
+        _host_irq_enable();
+
+        return ticks;
+}
+#endif
+
+//==============================================================================
+/**
+ * @brief  Function update all system clock after CPU frequency change.
+ *         Tick timer of host has constant frequency.
+ *
+ * @param  None
+ *
+ * @return None
+ */
+//==============================================================================
+void _cpuctl_update_system_clocks(void)
+{
+#if (__OS_MONITOR_CPU_LOAD__ > 0)
+        _cpuctl_init_CPU_load_counter();
+#endif
+}
+
+//==============================================================================
+/**
+ * @brief  Function delay code processing in microseconds.
+ *
+ * @note   Function should block CPU for specified amount of time.
+ * @note   Function should work in critical section and interrupts.
+ *
+ * @param  microseconds         microsecond delay
+ */
+//==============================================================================
+void _cpuctl_delay_us(u16_t microseconds)
+{
+        u64_t end = _host_time_us() + microseconds;
+
+        while (_host_time_us() < end);
+}
+
+//==============================================================================
+/**
+ * @brief  Function printout dumped registers. Registers are not dumped on
+ *         host (faults terminate host process).
+ *
+ * @param  file         destination file
+ */
+//==============================================================================
+void _cpuctl_print_exception(void *file)
+{
+        UNUSED_ARG1(file);
+}
+
+//==============================================================================
+/**
+ * @brief  Function return command of the first program. Host program
+ *         arguments are used as command, if given.
+ *
+ * @return Command line.
+ */
+//==============================================================================
+const char *_cpuctl_init_prog(void)
+{
+        const char *cmd = _host_cmdline();
+        return cmd ? cmd : __OS_INIT_PROG__;
+}
+
+/*==============================================================================
+  End of file
+==============================================================================*/
@@ -0,0 +1,1057 @@
+/*=========================================================================*//**
+@file    host.c
+
+@author  Daniel Zorychta
+
+@brief   Linux host process services used by dnx RTOS (threads, interrupts,
+         console and files).
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+/*
+ * NOTE: This file is compiled with host compiler flags and host C library
+ *       headers. Do not include any dnx RTOS header except host.h.
+ *
+ *       Functions that take host locks block the interrupt signal, because
+ *       interrupt handler can switch context and never return to the
+ *       interrupted code.
+ */
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <termios.h>
+#include "host.h"
+
+/*==============================================================================
+  Local symbolic constants/macros
+==============================================================================*/
+#define IRQ_SIGNAL              SIGUSR1
+#define THREAD_STACK_SIZE       (1024 * 1024)
+#define CONSOLE_BUFFER_SIZE     4096
+#define CMDLINE_SIZE            256
+
+/*==============================================================================
+  Local types, enums definitions
+==============================================================================*/
+typedef struct {
+        pthread_t       id;
+        pthread_mutex_t lock;
+        pthread_cond_t  cond;
+        bool            running;
+        bool            dying;
+        void          (*entry)(void*);
+        void           *arg;
+} host_thread_t;
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+static void irq_raise(int irq);
+static void thread_wait(host_thread_t *thread);
+static void terminal_restore(void);
+
+/*==============================================================================
+  Local object definitions
+==============================================================================*/
+static int                 host_argc;
+static char              **host_argv;
+static sigset_t            irq_set;
+static _host_irq_handler_t irq_handler[_HOST_IRQ_COUNT];
+static atomic_uint         irq_pending;
+static __thread int        irq_level;
+static atomic_uint         tick_count;
+
+static struct {
+        pthread_mutex_t lock;
+        pthread_cond_t  cond;
+        struct timespec next;
+        uint64_t        period_ns;
+        uint32_t        oneshot;
+} tick = {.lock = PTHREAD_MUTEX_INITIALIZER};
+
+static struct {
+        pthread_mutex_t lock;
+        char            buf[CONSOLE_BUFFER_SIZE];
+        size_t          head;
+        size_t          tail;
+        bool            open;
+} console = {.lock = PTHREAD_MUTEX_INITIALIZER};
+
+static struct termios      term_saved;
+static bool                term_changed;
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+
+//==============================================================================
+/**
+ * @brief  Interrupt signal handler. Function calls handlers of all pending
+ *         interrupts. Handler can switch context, in this case the rest of
+ *         pending interrupts is served by the next running thread.
+ *
+ * @param  sig          signal number
+ */
+//==============================================================================
+static void irq_signal_handler(int sig)
+{
+        (void)sig;
+
+        int err = errno;
+        irq_level++;
+
+        unsigned pending;
+        while ((pending = atomic_exchange(&irq_pending, 0)) != 0) {
+                for (int irq = 0; irq < _HOST_IRQ_COUNT; irq++) {
+                        if ((pending & (1u << irq)) && irq_handler[irq]) {
+                                irq_handler[irq]();
+                        }
+                }
+        }
+
+        irq_level--;
+        errno = err;
+}
+
+//==============================================================================
+/**
+ * @brief  Termination signal handler. Restore terminal settings and exit.
+ *
+ * @param  sig          signal number
+ */
+//==============================================================================
+static void term_signal_handler(int sig)
+{
+        terminal_restore();
+        _exit(128 + sig);
+}
+
+//==============================================================================
+/**
+ * @brief  Host program entry. Interrupts are disabled until the first task
+ *         is started by the scheduler.
+ *
+ * @param  argc         argument count
+ * @param  argv         arguments
+ *
+ * @return Program status.
+ */
+//==============================================================================
+int main(int argc, char *argv[])
+{
+        host_argc = argc;
+        host_argv = argv;
+
+        sigemptyset(&irq_set);
+        sigaddset(&irq_set, IRQ_SIGNAL);
+        pthread_sigmask(SIG_BLOCK, &irq_set, NULL);
+
+        struct sigaction sa;
+        memset(&sa, 0, sizeof(sa));
+        sa.sa_handler = irq_signal_handler;
+        sa.sa_mask    = irq_set;
+        sa.sa_flags   = SA_RESTART;
+        sigaction(IRQ_SIGNAL, &sa, NULL);
+
+        sa.sa_handler = term_signal_handler;
+        sa.sa_flags   = 0;
+        sigaction(SIGINT, &sa, NULL);
+        sigaction(SIGTERM, &sa, NULL);
+        sigaction(SIGHUP, &sa, NULL);
+
+        signal(SIGPIPE, SIG_IGN);
+
+        return _dnx_main();
+}
+
+//==============================================================================
+/**
+ * @brief  Function block interrupt signal in the calling thread.
+ *
+ * @param  old          previous signal mask
+ */
+//==============================================================================
+static inline void irq_mask(sigset_t *old)
+{
+        pthread_sigmask(SIG_BLOCK, &irq_set, old);
+}
+
+//==============================================================================
+/**
+ * @brief  Function restore signal mask of the calling thread.
+ *
+ * @param  old          signal mask to restore
+ */
+//==============================================================================
+static inline void irq_unmask(const sigset_t *old)
+{
+        pthread_sigmask(SIG_SETMASK, old, NULL);
+}
+
+//==============================================================================
+/**
+ * @brief  Function mark interrupt as pending and signal the process. Signal
+ *         is delivered to the only thread that does not block it: currently
+ *         running task with enabled interrupts.
+ *
+ * @param  irq          interrupt number
+ */
+//==============================================================================
+static void irq_raise(int irq)
+{
+        atomic_fetch_or(&irq_pending, 1u << irq);
+        kill(getpid(), IRQ_SIGNAL);
+}
+
+//==============================================================================
+/**
+ * @brief  Function attach interrupt handler.
+ *
+ * @param  irq          interrupt number
+ * @param  handler      handler
+ */
+//==============================================================================
+void _host_irq_attach(int irq, _host_irq_handler_t handler)
+{
+        if (irq >= 0 && irq < _HOST_IRQ_COUNT) {
+                irq_handler[irq] = handler;
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function disable interrupts in the calling thread.
+ */
+//==============================================================================
+void _host_irq_disable(void)
+{
+        pthread_sigmask(SIG_BLOCK, &irq_set, NULL);
+}
+
+//==============================================================================
+/**
+ * @brief  Function enable interrupts in the calling thread. Interrupts stay
+ *         disabled when called from interrupt handler; mask is restored when
+ *         handler returns.
+ */
+//==============================================================================
+void _host_irq_enable(void)
+{
+        if (irq_level == 0) {
+                pthread_sigmask(SIG_UNBLOCK, &irq_set, NULL);
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function check if interrupt handler is executed by calling thread.
+ *
+ * @return True if handler is active, otherwise false.
+ */
+//==============================================================================
+bool _host_irq_is_active(void)
+{
+        return irq_level > 0;
+}
+
+//==============================================================================
+/**
+ * @brief  Function add nanoseconds to time.
+ *
+ * @param  ts           time
+ * @param  ns           nanoseconds to add
+ */
+//==============================================================================
+static void timespec_add(struct timespec *ts, uint64_t ns)
+{
+        ns += ts->tv_nsec;
+        ts->tv_sec += ns / 1000000000;
+        ts->tv_nsec = ns % 1000000000;
+}
+
+//==============================================================================
+/**
+ * @brief  Function return time difference (a - b) in nanoseconds.
+ *
+ * @param  a            time
+ * @param  b            time
+ *
+ * @return Difference, negative if b is later than a.
+ */
+//==============================================================================
+static int64_t timespec_diff(const struct timespec *a, const struct timespec *b)
+{
+        return ((int64_t)(a->tv_sec - b->tv_sec) * 1000000000) + (a->tv_nsec - b->tv_nsec);
+}
+
+//==============================================================================
+/**
+ * @brief  Tick timer thread. Ticks are counted and the interrupt is raised;
+ *         ticks that were not served in time are taken at once by handler.
+ *         In one-shot mode ticks are counted but the interrupt is raised
+ *         when the selected tick expires (thread sleeps until then).
+ *
+ * @param  arg          not used
+ *
+ * @return Never returns.
+ */
+//==============================================================================
+static void *tick_thread(void *arg)
+{
+        (void)arg;
+
+        pthread_mutex_lock(&tick.lock);
+
+        for (;;) {
+                struct timespec deadline = tick.next;
+
+                if (tick.oneshot > 1) {
+                        timespec_add(&deadline, tick.period_ns * (tick.oneshot - 1));
+                }
+
+                pthread_cond_timedwait(&tick.cond, &tick.lock, &deadline);
+
+                struct timespec now;
+                clock_gettime(CLOCK_MONOTONIC, &now);
+
+                int64_t elapsed = timespec_diff(&now, &tick.next);
+                if (elapsed >= 0) {
+                        uint32_t ticks = (elapsed / tick.period_ns) + 1;
+                        timespec_add(&tick.next, tick.period_ns * ticks);
+                        atomic_fetch_add(&tick_count, ticks);
+
+                        if (tick.oneshot <= ticks) {
+                                tick.oneshot = 0;
+                                irq_raise(_HOST_IRQ_TICK);
+                        } else {
+                                tick.oneshot -= ticks;
+                        }
+                }
+        }
+
+        return NULL;
+}
+
+//==============================================================================
+/**
+ * @brief  Function start tick timer.
+ *
+ * @param  frequency    tick frequency [Hz]
+ */
+//==============================================================================
+void _host_tick_start(uint32_t frequency)
+{
+        tick.period_ns = 1000000000 / (frequency ? frequency : 1000);
+
+        pthread_condattr_t attr;
+        pthread_condattr_init(&attr);
+        pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+        pthread_cond_init(&tick.cond, &attr);
+        pthread_condattr_destroy(&attr);
+
+        clock_gettime(CLOCK_MONOTONIC, &tick.next);
+        timespec_add(&tick.next, tick.period_ns);
+
+        sigset_t old;
+        irq_mask(&old);
+
+        pthread_t id;
+        pthread_create(&id, NULL, tick_thread, NULL);
+        pthread_detach(id);
+
+        irq_unmask(&old);
+}
+
+//==============================================================================
+/**
+ * @brief  Function return number of ticks counted since last call.
+ *
+ * @return Number of ticks.
+ */
+//==============================================================================
+uint32_t _host_tick_take(void)
+{
+        return atomic_exchange(&tick_count, 0);
+}
+
+//==============================================================================
+/**
+ * @brief  Function switch tick timer to one-shot mode. Tick interrupt is
+ *         raised when selected number of ticks expires.
+ *
+ * @param  ticks        number of ticks
+ */
+//==============================================================================
+void _host_tick_oneshot(uint32_t ticks)
+{
+        sigset_t old;
+        irq_mask(&old);
+
+        pthread_mutex_lock(&tick.lock);
+        tick.oneshot = ticks;
+        pthread_cond_signal(&tick.cond);
+        pthread_mutex_unlock(&tick.lock);
+
+        irq_unmask(&old);
+}
+
+//==============================================================================
+/**
+ * @brief  Function switch tick timer back to periodic mode. Counted ticks
+ *         are taken up to selected limit, the rest is served by interrupt.
+ *
+ * @param  max          maximum number of ticks to take
+ *
+ * @return Number of taken ticks.
+ */
+//==============================================================================
+uint32_t _host_tick_resume(uint32_t max)
+{
+        sigset_t old;
+        irq_mask(&old);
+
+        pthread_mutex_lock(&tick.lock);
+
+        tick.oneshot = 0;
+        pthread_cond_signal(&tick.cond);
+
+        uint32_t ticks = atomic_load(&tick_count);
+        if (ticks > max) {
+                ticks = max;
+        }
+
+        if (atomic_fetch_sub(&tick_count, ticks) > ticks) {
+                irq_raise(_HOST_IRQ_TICK);
+        }
+
+        pthread_mutex_unlock(&tick.lock);
+
+        irq_unmask(&old);
+
+        return ticks;
+}
+
+//==============================================================================
+/**
+ * @brief  Thread start routine. Thread waits for the first switch to it.
+ *
+ * @param  arg          thread object
+ *
+ * @return Never returns.
+ */
+//==============================================================================
+static void *thread_start_routine(void *arg)
+{
+        host_thread_t *thread = arg;
+
+        thread_wait(thread);
+        thread->entry(thread->arg);
+
+        return NULL;
+}
+
+//==============================================================================
+/**
+ * @brief  Function suspend calling thread until it is switched in. Thread
+ *         that was deleted in the meantime is terminated.
+ *
+ * @param  thread       calling thread object
+ */
+//==============================================================================
+static void thread_wait(host_thread_t *thread)
+{
+        pthread_mutex_lock(&thread->lock);
+
+        while (!thread->running && !thread->dying) {
+                pthread_cond_wait(&thread->cond, &thread->lock);
+        }
+
+        bool dying = thread->dying;
+
+        pthread_mutex_unlock(&thread->lock);
+
+        if (dying) {
+                pthread_mutex_destroy(&thread->lock);
+                pthread_cond_destroy(&thread->cond);
+                free(thread);
+                pthread_exit(NULL);
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function create suspended thread. Thread starts with blocked
+ *         interrupts.
+ *
+ * @param  entry        thread function
+ * @param  arg          thread function argument
+ *
+ * @return Thread object or NULL on error.
+ */
+//==============================================================================
+void *_host_thread_create(void (*entry)(void*), void *arg)
+{
+        sigset_t old;
+        irq_mask(&old);
+
+        host_thread_t *thread = calloc(1, sizeof(host_thread_t));
+        if (thread) {
+                pthread_mutex_init(&thread->lock, NULL);
+                pthread_cond_init(&thread->cond, NULL);
+                thread->entry = entry;
+                thread->arg   = arg;
+
+                pthread_attr_t attr;
+                pthread_attr_init(&attr);
+                pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+                pthread_attr_setstacksize(&attr, THREAD_STACK_SIZE);
+
+                if (pthread_create(&thread->id, &attr, thread_start_routine, thread) != 0) {
+                        pthread_mutex_destroy(&thread->lock);
+                        pthread_cond_destroy(&thread->cond);
+                        free(thread);
+                        thread = NULL;
+                }
+
+                pthread_attr_destroy(&attr);
+        }
+
+        irq_unmask(&old);
+
+        return thread;
+}
+
+//==============================================================================
+/**
+ * @brief  Function switch execution from calling thread to selected one.
+ *         Calling thread is suspended until it is switched in again.
+ *
+ * @param  to           thread to run
+ * @param  from         calling thread
+ */
+//==============================================================================
+void _host_thread_switch(void *to, void *from)
+{
+        host_thread_t *next = to;
+        host_thread_t *self = from;
+
+        if (next == self) {
+                return;
+        }
+
+        sigset_t old;
+        irq_mask(&old);
+
+        pthread_mutex_lock(&self->lock);
+        self->running = false;
+        pthread_mutex_unlock(&self->lock);
+
+        pthread_mutex_lock(&next->lock);
+        next->running = true;
+        pthread_cond_signal(&next->cond);
+        pthread_mutex_unlock(&next->lock);
+
+        thread_wait(self);
+
+        irq_unmask(&old);
+}
+
+//==============================================================================
+/**
+ * @brief  Function start the first thread. Calling (main) thread does not
+ *         take part in scheduling anymore.
+ *
+ * @param  first        first thread to run
+ */
+//==============================================================================
+void _host_thread_start(void *first)
+{
+        host_thread_t *next = first;
+
+        irq_mask(NULL);
+
+        pthread_mutex_lock(&next->lock);
+        next->running = true;
+        pthread_cond_signal(&next->cond);
+        pthread_mutex_unlock(&next->lock);
+
+        for (;;) {
+                pause();
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function delete suspended thread.
+ *
+ * @param  thread       thread to delete
+ */
+//==============================================================================
+void _host_thread_delete(void *thread)
+{
+        host_thread_t *victim = thread;
+
+        if (victim) {
+                sigset_t old;
+                irq_mask(&old);
+
+                pthread_mutex_lock(&victim->lock);
+                victim->dying = true;
+                pthread_cond_signal(&victim->cond);
+                pthread_mutex_unlock(&victim->lock);
+
+                irq_unmask(&old);
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function wait for interrupt. Function returns immediately if
+ *         interrupts are disabled.
+ */
+//==============================================================================
+void _host_sleep(void)
+{
+        sigset_t old;
+        irq_mask(&old);
+
+        if (!sigismember(&old, IRQ_SIGNAL) && atomic_load(&irq_pending) == 0) {
+                sigset_t wait = old;
+                sigdelset(&wait, IRQ_SIGNAL);
+                sigsuspend(&wait);
+        }
+
+        irq_unmask(&old);
+}
+
+//==============================================================================
+/**
+ * @brief  Function wait for interrupt when interrupts are disabled. Pending
+ *         interrupt is served when interrupts are enabled again.
+ */
+//==============================================================================
+void _host_irq_wait(void)
+{
+        bool taken = false;
+
+        while (atomic_load(&irq_pending) == 0) {
+                int sig;
+                if (sigwait(&irq_set, &sig) == 0) {
+                        taken = true;
+                }
+        }
+
+        if (taken) {
+                kill(getpid(), IRQ_SIGNAL);
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function return monotonic time.
+ *
+ * @return Time in microseconds.
+ */
+//==============================================================================
+uint64_t _host_time_us(void)
+{
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return ((uint64_t)ts.tv_sec * 1000000) + ((uint64_t)ts.tv_nsec / 1000);
+}
+
+//==============================================================================
+/**
+ * @brief  Function terminate host process.
+ *
+ * @param  status       exit status
+ */
+//==============================================================================
+void _host_exit(int status)
+{
+        terminal_restore();
+        _exit(status);
+}
+
+//==============================================================================
+/**
+ * @brief  Function restart host process with the same arguments.
+ */
+//==============================================================================
+void _host_restart(void)
+{
+        terminal_restore();
+        execv("/proc/self/exe", host_argv);
+        _exit(EXIT_FAILURE);
+}
+
+//==============================================================================
+/**
+ * @brief  Function allocate memory used as system RAM.
+ *
+ * @param  size         size
+ *
+ * @return Pointer to memory or NULL.
+ */
+//==============================================================================
+void *_host_mem_alloc(size_t size)
+{
+        void *mem = NULL;
+        return posix_memalign(&mem, 64, size) == 0 ? mem : NULL;
+}
+
+//==============================================================================
+/**
+ * @brief  Function return host program arguments joined by space.
+ *
+ * @return Command line or NULL if program was started without arguments.
+ */
+//==============================================================================
+const char *_host_cmdline(void)
+{
+        static char cmdline[CMDLINE_SIZE];
+
+        if (host_argc < 2) {
+                return NULL;
+        }
+
+        cmdline[0] = '\0';
+
+        for (int i = 1; i < host_argc; i++) {
+                if (i > 1) {
+                        strncat(cmdline, " ", sizeof(cmdline) - strlen(cmdline) - 1);
+                }
+
+                strncat(cmdline, host_argv[i], sizeof(cmdline) - strlen(cmdline) - 1);
+        }
+
+        return cmdline;
+}
+
+//==============================================================================
+/**
+ * @brief  Function restore terminal settings changed by console.
+ */
+//==============================================================================
+static void terminal_restore(void)
+{
+        if (term_changed) {
+                tcsetattr(STDIN_FILENO, TCSANOW, &term_saved);
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Console reader thread. Received bytes are buffered and console
+ *         interrupt is raised. Bytes that do not fit to buffer are dropped.
+ *
+ * @param  arg          not used
+ *
+ * @return NULL at end of input.
+ */
+//==============================================================================
+static void *console_thread(void *arg)
+{
+        (void)arg;
+
+        for (;;) {
+                char buf[256];
+                ssize_t n = read(STDIN_FILENO, buf, sizeof(buf));
+
+                if (n < 0 && errno == EINTR) {
+                        continue;
+
+                } else if (n <= 0) {
+                        break;
+                }
+
+                pthread_mutex_lock(&console.lock);
+
+                for (ssize_t i = 0; i < n; i++) {
+                        size_t next = (console.head + 1) % CONSOLE_BUFFER_SIZE;
+                        if (next != console.tail) {
+                                console.buf[console.head] = buf[i];
+                                console.head = next;
+                        }
+                }
+
+                pthread_mutex_unlock(&console.lock);
+
+                irq_raise(_HOST_IRQ_CONSOLE);
+        }
+
+        return NULL;
+}
+
+//==============================================================================
+/**
+ * @brief  Function open console: terminal is switched to raw mode (line
+ *         editing and echo are done by system) and input is started.
+ */
+//==============================================================================
+void _host_console_open(void)
+{
+        sigset_t old;
+        irq_mask(&old);
+
+        pthread_mutex_lock(&console.lock);
+
+        if (!console.open) {
+                console.open = true;
+
+                if (isatty(STDIN_FILENO) && tcgetattr(STDIN_FILENO, &term_saved) == 0) {
+                        struct termios term = term_saved;
+                        term.c_lflag &= ~(ICANON | ECHO | ECHONL | IEXTEN);
+                        term.c_iflag &= ~(ICRNL | INLCR | IXON);
+                        term.c_cc[VMIN]  = 1;
+                        term.c_cc[VTIME] = 0;
+                        term_changed = tcsetattr(STDIN_FILENO, TCSANOW, &term) == 0;
+                }
+
+                pthread_t id;
+                if (pthread_create(&id, NULL, console_thread, NULL) == 0) {
+                        pthread_detach(id);
+                }
+        }
+
+        pthread_mutex_unlock(&console.lock);
+
+        irq_unmask(&old);
+}
+
+//==============================================================================
+/**
+ * @brief  Function read buffered console input.
+ *
+ * @param  buf          destination buffer
+ * @param  len          buffer size
+ *
+ * @return Number of read bytes.
+ */
+//==============================================================================
+size_t _host_console_read(void *buf, size_t len)
+{
+        size_t n = 0;
+
+        sigset_t old;
+        irq_mask(&old);
+
+        pthread_mutex_lock(&console.lock);
+
+        while (n < len && console.tail != console.head) {
+                ((char*)buf)[n++] = console.buf[console.tail];
+                console.tail = (console.tail + 1) % CONSOLE_BUFFER_SIZE;
+        }
+
+        pthread_mutex_unlock(&console.lock);
+
+        irq_unmask(&old);
+
+        return n;
+}
+
+//==============================================================================
+/**
+ * @brief  Function write data to console.
+ *
+ * @param  buf          source buffer
+ * @param  len          number of bytes to write
+ *
+ * @return Number of written bytes.
+ */
+//==============================================================================
+size_t _host_console_write(const void *buf, size_t len)
+{
+        size_t n = 0;
+
+        while (n < len) {
+                ssize_t w = write(STDOUT_FILENO, (const char*)buf + n, len - n);
+
+                if (w < 0 && errno == EINTR) {
+                        continue;
+
+                } else if (w <= 0) {
+                        break;
+                }
+
+                n += (size_t)w;
+        }
+
+        return n;
+}
+
+//==============================================================================
+/**
+ * @brief  Function open host file.
+ *
+ * @param  path         file path
+ * @param  read_only    true to open file in read-only mode
+ *
+ * @return File descriptor or -1 on error.
+ */
+//==============================================================================
+int _host_file_open(const char *path, bool read_only)
+{
+        return open(path, (read_only ? O_RDONLY : O_RDWR) | O_CLOEXEC);
+}
+
+//==============================================================================
+/**
+ * @brief  Function close host file.
+ *
+ * @param  fd           file descriptor
+ */
+//==============================================================================
+void _host_file_close(int fd)
+{
+        close(fd);
+}
+
+//==============================================================================
+/**
+ * @brief  Function return size of host file.
+ *
+ * @param  fd           file descriptor
+ *
+ * @return File size or -1 on error.
+ */
+//==============================================================================
+int64_t _host_file_size(int fd)
+{
+        return lseek(fd, 0, SEEK_END);
+}
+
+//==============================================================================
+/**
+ * @brief  Function read host file at selected offset. Area beyond end of
+ *         file is read as zeros.
+ *
+ * @param  fd           file descriptor
+ * @param  buf          destination buffer
+ * @param  len          number of bytes to read
+ * @param  offset       file offset
+ *
+ * @return Number of read bytes or -1 on error.
+ */
+//==============================================================================
+int _host_file_read(int fd, void *buf, size_t len, uint64_t offset)
+{
+        size_t n = 0;
+
+        while (n < len) {
+                ssize_t r = pread(fd, (char*)buf + n, len - n, (off_t)(offset + n));
+
+                if (r < 0 && errno == EINTR) {
+                        continue;
+
+                } else if (r < 0) {
+                        return -1;
+
+                } else if (r == 0) {
+                        memset((char*)buf + n, 0, len - n);
+                        break;
+                }
+
+                n += (size_t)r;
+        }
+
+        return (int)len;
+}
+
+//==============================================================================
+/**
+ * @brief  Function write host file at selected offset.
+ *
+ * @param  fd           file descriptor
+ * @param  buf          source buffer
+ * @param  len          number of bytes to write
+ * @param  offset       file offset
+ *
+ * @return Number of written bytes or -1 on error.
+ */
+//==============================================================================
+int _host_file_write(int fd, const void *buf, size_t len, uint64_t offset)
+{
+        size_t n = 0;
+
+        while (n < len) {
+                ssize_t w = pwrite(fd, (const char*)buf + n, len - n, (off_t)(offset + n));
+
+                if (w < 0 && errno == EINTR) {
+                        continue;
+
+                } else if (w <= 0) {
+                        return -1;
+                }
+
+                n += (size_t)w;
+        }
+
+        return (int)n;
+}
+
+//==============================================================================
+/**
+ * @brief  Function flush host file data to storage.
+ *
+ * @param  fd           file descriptor
+ *
+ * @return 0 on success, -1 on error.
+ */
+//==============================================================================
+int _host_file_sync(int fd)
+{
+        return fdatasync(fd);
+}
+
+//==============================================================================
+/**
+ * @brief  Function deallocate host file area (punch hole). Size of file is
+ *         not changed.
+ *
+ * @param  fd           file descriptor
+ * @param  offset       area offset
+ * @param  len          area size
+ *
+ * @return 0 on success, -1 on error.
+ */
+//==============================================================================
+int _host_file_discard(int fd, uint64_t offset, uint64_t len)
+{
+        return fallocate(fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+                         (off_t)offset, (off_t)len);
+}
+
+/*==============================================================================
+  End of file
+==============================================================================*/
@@ -0,0 +1,116 @@
+/*=========================================================================*//**
+@file    host.h
+
+@author  Daniel Zorychta
+
+@brief   Interface between dnx RTOS and Linux host process.
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+/*
+ * The host.c file is compiled with host C library headers and is linked with
+ * the system image, which is compiled against dnx RTOS library headers. Both
+ * worlds meet only at this interface, thus only compiler provided types can
+ * be used here.
+ *
+ * The host process emulates a single core microcontroller:
+ *  - each kernel task is a host thread, only one thread runs at a time,
+ *  - interrupts are delivered as a signal to the thread that currently runs,
+ *    disabling interrupts blocks the signal,
+ *  - tick timer and console input are host threads that raise interrupts.
+ */
+
+#ifndef _HOST_H_
+#define _HOST_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/*==============================================================================
+  Exported symbolic constants/macros
+==============================================================================*/
+/** interrupt sources */
+#define _HOST_IRQ_TICK                  0
+#define _HOST_IRQ_CONSOLE               1
+#define _HOST_IRQ_COUNT                 2
+
+/*==============================================================================
+  Exported types, enums definitions
+==============================================================================*/
+typedef void (*_host_irq_handler_t)(void);
+
+/*==============================================================================
+  Exported function prototypes
+==============================================================================*/
+extern int         _dnx_main(void);
+
+extern void        _host_irq_attach(int irq, _host_irq_handler_t handler);
+extern void        _host_irq_disable(void);
+extern void        _host_irq_enable(void);
+extern bool        _host_irq_is_active(void);
+extern void        _host_irq_wait(void);
+
+extern void        _host_tick_start(uint32_t frequency);
+extern uint32_t    _host_tick_take(void);
+extern void        _host_tick_oneshot(uint32_t ticks);
+extern uint32_t    _host_tick_resume(uint32_t max);
+
+extern void       *_host_thread_create(void (*entry)(void*), void *arg);
+extern void        _host_thread_switch(void *to, void *from);
+extern void        _host_thread_start(void *first);
+extern void        _host_thread_delete(void *thread);
+
+extern void        _host_sleep(void);
+extern uint64_t    _host_time_us(void);
+extern void        _host_exit(int status);
+extern void        _host_restart(void);
+extern void       *_host_mem_alloc(size_t size);
+extern const char *_host_cmdline(void);
+
+extern void        _host_console_open(void);
+extern size_t      _host_console_read(void *buf, size_t len);
+extern size_t      _host_console_write(const void *buf, size_t len);
+
+extern int         _host_file_open(const char *path, bool read_only);
+extern void        _host_file_close(int fd);
+extern int64_t     _host_file_size(int fd);
+extern int         _host_file_read(int fd, void *buf, size_t len, uint64_t offset);
+extern int         _host_file_write(int fd, const void *buf, size_t len, uint64_t offset);
+extern int         _host_file_sync(int fd);
+extern int         _host_file_discard(int fd, uint64_t offset, uint64_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _HOST_H_ */
+/*==============================================================================
+  End of file
+==============================================================================*/
@@ -321,37 +321,6 @@ void _cpuctl_init_CPU_load_counter(void)
 }
 #endif
 
-//==============================================================================
-/**
- * @brief  Function return valut that was counted from last call of this function.
- *         This function must reset timer after read. Function is called from
- *         IRQs.
- *
- * @param  None
- *
- * @return Timer value for last read (time delta).
- */
-//==============================================================================
-#if (__OS_MONITOR_CPU_LOAD__ > 0)
-u32_t _cpuctl_get_CPU_load_counter_delta(void)
-{
-        static uint32_t last;
-        bool  ovf = SysTick->CTRL & SysTick_CTRL_COUNTFLAG_Msk;
-        u32_t now = SysTick->VAL;
-
-        u32_t delta;
-        if (ovf) {
-                delta = ((SysTick->LOAD + 1) - now) + last;
-        } else {
-                delta = last - now;
-        }
-
-        last = now;
-
-        return delta;
-}
-#endif
-
 //==============================================================================
 /**
  * @brief  Function sleep CPU weakly. All IRQs must be able to wake up CPU.
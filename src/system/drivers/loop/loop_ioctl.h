@@ -345,6 +345,12 @@ request:
         // ...
 \endcode
 
+The storage discard request (@ref IOCTL_STORAGE__DISCARD) sent by file systems
+is passed to the host in the same way. The <i>rq.ioctl.arg</i> points to the
+@ref STORAGE_discard_t object. The host can release the selected range of the
+backing storage (e.g. punch a hole in the image file) or just respond with
+ESUCC status.
+
 \subsubsection drv-loop-ddesc-host-stat Handling device statistics request
 The client program or operating system can check some device statistics. In this
 the host application should handle statistics request. Example code:
@@ -422,6 +428,7 @@ request. Example code of handling flush request:
   Include files
 ==============================================================================*/
 #include "drivers/ioctl_macros.h"
+#include "drivers/class/storage/ioctl.h"
 
 #ifdef __cplusplus
 extern "C" {
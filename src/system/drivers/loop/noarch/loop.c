@@ -85,6 +85,7 @@ static int submit_request(loop_t *hdl);
 static int submit_response(loop_t *hdl);
 static int wait_for_response(loop_t *hdl, u32_t timeout);
 static int wait_for_request(loop_t *hdl, u32_t timeout);
+static int client_request(loop_t *hdl, int request, void *arg);
 
 /*==============================================================================
   Local objects
@@ -494,22 +495,15 @@ API_MOD_IOCTL(LOOP, void *device_handle, int request, void *arg)
                 }
                 break;
 
-        default: //IOCTL_LOOP__CLIENT_REQUEST(n)
-                if (sys_device_is_locked(&hdl->host_lock)) {
-                        hdl->action.cmd           = LOOP_CMD__IOCTL_REQUEST;
-                        hdl->action.arg.ioctl.arg = arg;
-                        hdl->action.arg.ioctl.rq  = request;
-
-                        submit_request(hdl);
-
-                        err = wait_for_response(hdl, REQUEST_TIMEOUT);
-                        if (!err) {
-                                err = hdl->action.err;
-                        }
-                } else {
-                        err = ESRCH;
+        case IOCTL_STORAGE__DISCARD:
+                if (arg) {
+                        err = client_request(hdl, request, arg);
                 }
                 break;
+
+        default: //IOCTL_LOOP__CLIENT_REQUEST(n)
+                err = client_request(hdl, request, arg);
+                break;
         }
 
         return err;
@@ -640,6 +634,38 @@ static int wait_for_request(loop_t *hdl, u32_t timeout)
         return sys_flag_wait(hdl->flag, FLAG_REQUEST, timeout);
 }
 
+//==============================================================================
+/**
+ * @brief  Function pass client ioctl request to the host and wait for
+ *         response.
+ *
+ * @param  hdl          driver handle
+ * @param  request      ioctl request
+ * @param  arg          request argument
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+static int client_request(loop_t *hdl, int request, void *arg)
+{
+        int err = ESRCH;
+
+        if (sys_device_is_locked(&hdl->host_lock)) {
+                hdl->action.cmd           = LOOP_CMD__IOCTL_REQUEST;
+                hdl->action.arg.ioctl.arg = arg;
+                hdl->action.arg.ioctl.rq  = request;
+
+                submit_request(hdl);
+
+                err = wait_for_response(hdl, REQUEST_TIMEOUT);
+                if (!err) {
+                        err = hdl->action.err;
+                }
+        }
+
+        return err;
+}
+
 /*==============================================================================
   End of file
 ==============================================================================*/
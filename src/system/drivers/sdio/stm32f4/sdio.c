@@ -46,6 +46,8 @@ Brief   SD Card Interface Driver.
 #define CARD_DT_CK_TIMEOUT              0xFFFFFF
 #define TRANSACTION_TIMEOUT             (2 * (_SDIO_CFG_CARD_TIMEOUT))
 #define COMMAND_TIMEOUT                 ((_SDIO_CFG_CARD_TIMEOUT) / 1)
+#define ERASE_CHUNK                     8192
+#define ERASE_TIMEOUT                   2000
 
 #define DMA_MAJOR                       1
 #define DMA_CHANNEL                     4
@@ -142,6 +144,7 @@ static int card_send_cmd(uint32_t cmd, cmd_resp_t resp, uint32_t arg);
 static int card_get_response(SD_response_t *resp, resp_t type);
 static int card_read_sectors(SDIO_t *hdl, u8_t *dst, size_t count, u32_t address, size_t *rdsec);
 static int card_write_sectors(SDIO_t *hdl, const u8_t *src, size_t count, u32_t address, size_t *wrsec);
+static int card_discard(SDIO_t *hdl, const STORAGE_discard_t *range);
 static int card_transfer_block(SDIO_t *hdl, uint32_t cmd, uint32_t address, u8_t *buf, size_t count, dir_t dir);
 static int MBR_detect_partitions(SDIO_t *hdl);
 
@@ -449,8 +452,6 @@ API_MOD_READ(SDIO,
 //==============================================================================
 API_MOD_IOCTL(SDIO, void *device_handle, int request, void *arg)
 {
-        UNUSED_ARG1(arg);
-
         SDIO_t *hdl = device_handle;
 
         int err = EBADRQC;
@@ -478,6 +479,19 @@ API_MOD_IOCTL(SDIO, void *device_handle, int request, void *arg)
                 break;
         }
 
+        case IOCTL_SDIO__DISCARD: {
+                if (!arg) {
+                        return EINVAL;
+                }
+
+                err = sys_mutex_lock(hdl->ctrl->protect, MAX_DELAY_MS);
+                if (!err) {
+                        err = card_discard(hdl, arg);
+                        sys_mutex_unlock(hdl->ctrl->protect);
+                }
+                break;
+        }
+
         default:
                 return EBADRQC;
         }
@@ -950,6 +964,71 @@ static int card_write_sectors(SDIO_t *hdl, const u8_t *src, size_t count, u32_t
         return err;
 }
 
+//==============================================================================
+/**
+ * @brief  Function discard sectors of card (erase by CMD32/CMD33/CMD38). The
+ *         range is erased in chunks to keep busy time of each erase command
+ *         short.
+ *
+ * @param  hdl          module handle
+ * @param  range        range to discard (relative to partition)
+ *
+ * @return One of errno value (errno.h).
+ */
+//==============================================================================
+static int card_discard(SDIO_t *hdl, const STORAGE_discard_t *range)
+{
+        part_t *part  = &hdl->ctrl->part[hdl->minor];
+        u64_t   first = (range->offset + SECTOR_SIZE - 1) / SECTOR_SIZE;
+        u64_t   end   = min((range->offset + range->size) / SECTOR_SIZE, cast(u64_t, part->size));
+
+        if (!hdl->ctrl->initialized) {
+                return EIO;
+
+        } else if (hdl->ctrl->card.type == SD_TYPE__MMC) {
+                return ENOTSUP;
+        }
+
+        int err = ESUCC;
+        SD_response_t resp;
+
+        while (!err && (first < end)) {
+                u32_t start = part->offset + first;
+                u32_t last  = part->offset + min(end, first + ERASE_CHUNK) - 1;
+
+                if (hdl->ctrl->card.type == SD_TYPE__SD1) {
+                        start *= SECTOR_SIZE;
+                        last  *= SECTOR_SIZE;
+                }
+
+                catcherr(err = card_send_cmd(SD_CMD__CMD32, CMD_RESP_SHORT, start), exit);
+                catcherr(err = card_get_response(&resp, RESP_R1), exit);
+
+                catcherr(err = card_send_cmd(SD_CMD__CMD33, CMD_RESP_SHORT, last), exit);
+                catcherr(err = card_get_response(&resp, RESP_R1), exit);
+
+                catcherr(err = card_send_cmd(SD_CMD__CMD38, CMD_RESP_SHORT, 0), exit);
+                catcherr(err = card_get_response(&resp, RESP_R1b), exit);
+
+                u32_t timer = sys_time_get_reference();
+                do {
+                        if (sys_time_is_expired(timer, ERASE_TIMEOUT)) {
+                                err = ETIME;
+                                goto exit;
+                        }
+
+                        sys_sleep_ms(1);
+                        catcherr(err = card_send_cmd(SD_CMD__CMD13, CMD_RESP_SHORT, hdl->ctrl->RCA), exit);
+                        catcherr(err = card_get_response(&resp, RESP_R1b), exit);
+                } while (!(resp.RESPONSE[0] & 0x100));
+
+                first += ERASE_CHUNK;
+        }
+
+        exit:
+        return err;
+}
+
 //==============================================================================
 /**
  * @brief  Function transfer block to or from card.
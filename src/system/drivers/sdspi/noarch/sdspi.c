@@ -39,6 +39,8 @@
 /*==============================================================================
   Local symbolic constants/macros
 ==============================================================================*/
+#define ERASE_CHUNK             8192
+#define ERASE_TIMEOUT           2000
 
 /*==============================================================================
   Local types, enums definitions
@@ -96,6 +98,7 @@ static ssize_t  card_write_partial_sectors (SDSPI_t *hdl, const u8_t *src, size_
 static int      card_initialize            (SDSPI_t *hdl);
 static int      card_read                  (SDSPI_t *hdl, u8_t *dst, size_t count, u64_t lseek, size_t *rdcnt);
 static int      card_write                 (SDSPI_t *hdl, const u8_t *src, size_t count, u64_t lseek, size_t *wrcnt);
+static int      card_discard               (SDSPI_t *hdl, const STORAGE_discard_t *range);
 static int      MBR_detect_partitions      (SDSPI_t *hdl);
 
 /*==============================================================================
@@ -384,6 +387,19 @@ API_MOD_IOCTL(SDSPI, void *device_handle, int request, void *arg)
                 break;
         }
 
+        case IOCTL_SDSPI__DISCARD: {
+                if (!arg) {
+                        return EINVAL;
+                }
+
+                err = sys_mutex_lock(hdl->stg->protect_mtx, MAX_DELAY_MS);
+                if (!err) {
+                        err = card_discard(hdl, arg);
+                        sys_mutex_unlock(hdl->stg->protect_mtx);
+                }
+                break;
+        }
+
         default:
                 return EBADRQC;
         }
@@ -1154,6 +1170,67 @@ static int card_write(SDSPI_t *hdl, const u8_t *src, size_t count, u64_t lseek,
         }
 }
 
+//==============================================================================
+/**
+ * @brief Discard sectors of card (erase by CMD32/CMD33/CMD38). The range is
+ *        erased in chunks to keep busy time of each erase command short.
+ *
+ * @param[in]  hdl              driver's memory handle
+ * @param[in]  range            range to discard (relative to partition)
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+static int card_discard(SDSPI_t *hdl, const STORAGE_discard_t *range)
+{
+        part_t *part  = &hdl->stg->part[hdl->minor];
+        u64_t   first = (range->offset + SECTOR_SIZE - 1) / SECTOR_SIZE;
+        u64_t   end   = min((range->offset + range->size) / SECTOR_SIZE, cast(u64_t, part->size));
+
+        if (hdl->stg->initialized == false) {
+                return EIO;
+
+        } else if (hdl->stg->type.type == SD_TYPE__MMC) {
+                return ENOTSUP;
+        }
+
+        int err = ESUCC;
+
+        while (!err && (first < end)) {
+                u32_t start = part->offset + first;
+                u32_t last  = part->offset + min(end, first + ERASE_CHUNK) - 1;
+
+                if (!hdl->stg->type.block) {
+                        start *= SECTOR_SIZE;
+                        last  *= SECTOR_SIZE;
+                }
+
+                if (  card_send_cmd(hdl, SD_CMD__CMD32, start) == 0
+                   && card_send_cmd(hdl, SD_CMD__CMD33, last)  == 0
+                   && card_send_cmd(hdl, SD_CMD__CMD38, 0)     == 0 ) {
+
+                        /* card holds data line low until erase is finished */
+                        u32_t timer = sys_time_get_reference();
+                        while (SPI_transive(hdl, 0xFF) != 0xFF) {
+                                if (sys_time_is_expired(timer, ERASE_TIMEOUT)) {
+                                        err = ETIME;
+                                        break;
+                                }
+
+                                sys_sleep_ms(1);
+                        }
+                } else {
+                        err = EIO;
+                }
+
+                first += ERASE_CHUNK;
+        }
+
+        SPI_deselect_card(hdl);
+
+        return err;
+}
+
 //==============================================================================
 /**
  * @brief Function detect partitions
@@ -207,6 +207,7 @@ mount("fatfs", "/dev/sda1", "/mnt", "");
   Include files
 ==============================================================================*/
 #include "drivers/ioctl_macros.h"
+#include "drivers/class/storage/ioctl.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -237,6 +238,14 @@ extern "C" {
  */
 #define IOCTL_SDSPI__READ_MBR           IOCTL_STORAGE__READ_MBR
 
+/**
+ *  @brief  Discard (erase) sectors of card (OS storage request).
+ *  @param  [WR] @ref STORAGE_discard_t * range to discard
+ *  @return On success 0 is returned.
+ *          On error -1 is returned and @ref errno is set.
+ */
+#define IOCTL_SDSPI__DISCARD            IOCTL_STORAGE__DISCARD
+
 /*==============================================================================
   Exported object types
 ==============================================================================*/
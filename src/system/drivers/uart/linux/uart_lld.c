@@ -0,0 +1,229 @@
+/*=========================================================================*//**
+@file    uart_lld.c
+
+@author  Daniel Zorychta
+
+@brief   UART driver backed by the console of the Linux host process
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include "drivers/driver.h"
+#if defined(ARCH_linux)
+#include "uart.h"
+#include "uart_ioctl.h"
+#include "linux/uart_cfg.h"
+#include "linux/host.h"
+
+/*==============================================================================
+  Local symbolic constants/macros
+==============================================================================*/
+
+/*==============================================================================
+  Local types, enums definitions
+==============================================================================*/
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+static bool IRQ_Rx_handle(u8_t major);
+static void CONSOLE_IRQHandler(void);
+
+/*==============================================================================
+  Local object definitions
+==============================================================================*/
+static bool rx_hold[_UART_COUNT];
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+//==============================================================================
+/**
+ * @brief Function open host console and attach its interrupt.
+ *
+ * @param[in] major             UART number
+ *
+ * @return One of errno value
+ */
+//==============================================================================
+int _UART_LLD__turn_on(u8_t major)
+{
+        rx_hold[major] = false;
+
+        _host_console_open();
+        _host_irq_attach(_HOST_IRQ_CONSOLE, CONSOLE_IRQHandler);
+
+        return ESUCC;
+}
+
+//==============================================================================
+/**
+ * @brief Function detach console interrupt.
+ *
+ * @param[in] major             UART number
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+int _UART_LLD__turn_off(u8_t major)
+{
+        UNUSED_ARG1(major);
+
+        _host_irq_attach(_HOST_IRQ_CONSOLE, NULL);
+
+        return ESUCC;
+}
+
+//==============================================================================
+/**
+ * @brief Function transmit currently setup buffer. Host console is written
+ *        synchronously, thus transmission is finished immediately.
+ *
+ * @param major         UART number
+ */
+//==============================================================================
+void _UART_LLD__transmit(u8_t major)
+{
+        struct Tx_buffer *tx = &_UART_mem[major]->Tx_buffer;
+
+        _host_console_write(tx->src_ptr, tx->data_size);
+
+        tx->src_ptr  += tx->data_size;
+        tx->data_size = 0;
+
+        sys_semaphore_signal(_UART_mem[major]->write_ready_sem);
+}
+
+//==============================================================================
+/**
+ * @brief Function abort pending transmission.
+ *
+ * @param major         UART number
+ */
+//==============================================================================
+void _UART_LLD__abort_trasmission(u8_t major)
+{
+        UNUSED_ARG1(major);
+}
+
+//==============================================================================
+/**
+ * @brief Function resume byte receiving. Bytes that wait in host console
+ *        buffer are moved to the FIFO at once.
+ *
+ * @param major         UART number
+ */
+//==============================================================================
+void _UART_LLD__rx_resume(u8_t major)
+{
+        _host_irq_disable();
+        rx_hold[major] = false;
+        bool yield = IRQ_Rx_handle(major);
+        _host_irq_enable();
+
+        if (yield) {
+                sys_thread_yield();
+        }
+}
+
+//==============================================================================
+/**
+ * @brief Function hold byte receiving.
+ *
+ * @param major         UART number
+ */
+//==============================================================================
+void _UART_LLD__rx_hold(u8_t major)
+{
+        rx_hold[major] = true;
+}
+
+//==============================================================================
+/**
+ * @brief Function configure selected UART. Console has no line parameters.
+ *
+ * @param major         major device number
+ * @param config        configuration structure
+ */
+//==============================================================================
+void _UART_LLD__configure(u8_t major, const struct UART_config *config)
+{
+        UNUSED_ARG1(config);
+
+        _UART_LLD__rx_resume(major);
+}
+
+//==============================================================================
+/**
+ * @brief Function move received bytes from host console to the FIFO.
+ *
+ * @param major         major device number
+ *
+ * @return If thread should be yielded then true is returned.
+ */
+//==============================================================================
+static bool IRQ_Rx_handle(u8_t major)
+{
+        struct UART_mem *hdl = _UART_mem[major];
+
+        if (!hdl || rx_hold[major]) {
+                return false;
+        }
+
+        int received = 0;
+        while (hdl->Rx_FIFO.buffer_level < _UART_RX_BUFFER_SIZE) {
+                u8_t data;
+                if (_host_console_read(&data, 1) == 0) {
+                        break;
+                }
+
+                if (_UART_FIFO__write(&hdl->Rx_FIFO, &data)) {
+                        received++;
+                }
+        }
+
+        // set receive semaphore to number of received bytes
+        bool yield = received > 0;
+
+        while (received--) {
+                sys_semaphore_signal_from_ISR(hdl->data_read_sem, NULL);
+        }
+
+        return yield;
+}
+
+//==============================================================================
+/**
+ * @brief Console input interrupt.
+ */
+//==============================================================================
+static void CONSOLE_IRQHandler(void)
+{
+        sys_thread_yield_from_ISR(IRQ_Rx_handle(_UART1));
+}
+
+#endif
+/*==============================================================================
+  End of file
+==============================================================================*/
@@ -58,6 +58,8 @@
 #include "efr32/uart_cfg.h"
 #include "efr32/efr32xx.h"
 #include "efr32/lib/em_cmu.h"
+#elif defined(ARCH_linux)
+#include "linux/uart_cfg.h"
 #endif
 
 #ifdef __cplusplus
@@ -223,6 +225,11 @@ enum {
 };
 #elif defined(ARCH_efr32)
 #define _UART_COUNT USART_COUNT
+#elif defined(ARCH_linux)
+enum {
+        _UART1,
+        _UART_COUNT
+};
 #endif
 
 
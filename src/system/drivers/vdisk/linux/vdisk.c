@@ -0,0 +1,454 @@
+/*=========================================================================*//**
+@file    vdisk.c
+
+@author  Daniel Zorychta
+
+@brief   Virtual disk driver. Image file of Linux host is used as storage.
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include "drivers/driver.h"
+#if defined(ARCH_linux)
+#include "linux/host.h"
+#include "../vdisk_ioctl.h"
+
+/*==============================================================================
+  Local macros
+==============================================================================*/
+#define MUTEX_TIMEOUT   MAX_DELAY_MS
+#define PATH_LEN        128
+
+/*==============================================================================
+  Local object types
+==============================================================================*/
+typedef struct {
+        mutex_t *mtx;
+        int      fd;
+        bool     read_only;
+        u64_t    size;
+        char     path[PATH_LEN];
+} VDISK_t;
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+static int configure(VDISK_t *hdl, const char *path, bool read_only);
+
+/*==============================================================================
+  Local objects
+==============================================================================*/
+MODULE_NAME(VDISK);
+
+/*==============================================================================
+  Exported objects
+==============================================================================*/
+
+/*==============================================================================
+  External objects
+==============================================================================*/
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+
+//==============================================================================
+/**
+ * @brief Initialize device
+ *
+ * @param[out]          **device_handle        device allocated memory
+ * @param[in ]            major                major device number
+ * @param[in ]            minor                minor device number
+ * @param[in ]            config               optional module configuration
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+API_MOD_INIT(VDISK, void **device_handle, u8_t major, u8_t minor, const void *config)
+{
+        UNUSED_ARG1(major);
+
+        if (minor != 0) {
+                return ENODEV;
+        }
+
+        int err = sys_zalloc(sizeof(VDISK_t), device_handle);
+        if (!err) {
+                VDISK_t *hdl = *device_handle;
+                hdl->fd = -1;
+
+                err = sys_mutex_create(MUTEX_TYPE_RECURSIVE, &hdl->mtx);
+
+                if (!err && config) {
+                        const VDISK_config_t *cfg = config;
+                        err = configure(hdl, cfg->path, cfg->read_only);
+                }
+
+                if (err) {
+                        if (hdl->mtx) {
+                                sys_mutex_destroy(hdl->mtx);
+                        }
+
+                        sys_free(device_handle);
+                }
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief Release device
+ *
+ * @param[in ]          *device_handle          device allocated memory
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+API_MOD_RELEASE(VDISK, void *device_handle)
+{
+        VDISK_t *hdl = device_handle;
+
+        int err = sys_mutex_lock(hdl->mtx, 0);
+        if (!err) {
+                mutex_t *mtx = hdl->mtx;
+                hdl->mtx = 0;
+                sys_mutex_unlock(mtx);
+                sys_mutex_destroy(mtx);
+
+                if (hdl->fd >= 0) {
+                        _host_file_close(hdl->fd);
+                }
+
+                memset(hdl, 0, sizeof(VDISK_t));
+                sys_free(&device_handle);
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief Open device
+ *
+ * @param[in ]          *device_handle          device allocated memory
+ * @param[in ]           flags                  file operation flags (O_RDONLY, O_WRONLY, O_RDWR)
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+API_MOD_OPEN(VDISK, void *device_handle, u32_t flags)
+{
+        VDISK_t *hdl = device_handle;
+
+        if (hdl->read_only && (flags & (O_WRONLY | O_RDWR))) {
+                return EROFS;
+        }
+
+        return ESUCC;
+}
+
+//==============================================================================
+/**
+ * @brief Close device
+ *
+ * @param[in ]          *device_handle          device allocated memory
+ * @param[in ]           force                  device force close (true)
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+API_MOD_CLOSE(VDISK, void *device_handle, bool force)
+{
+        UNUSED_ARG2(device_handle, force);
+        return ESUCC;
+}
+
+//==============================================================================
+/**
+ * @brief Write data to device
+ *
+ * @param[in ]          *device_handle          device allocated memory
+ * @param[in ]          *src                    data source
+ * @param[in ]           count                  number of bytes to write
+ * @param[in ][out]     *fpos                   file position
+ * @param[out]          *wrcnt                  number of written bytes
+ * @param[in ]           fattr                  file attributes
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+API_MOD_WRITE(VDISK,
+              void             *device_handle,
+              const u8_t       *src,
+              size_t            count,
+              fpos_t           *fpos,
+              size_t           *wrcnt,
+              struct vfs_fattr  fattr)
+{
+        UNUSED_ARG1(fattr);
+
+        VDISK_t *hdl = device_handle;
+
+        int err = sys_mutex_lock(hdl->mtx, MUTEX_TIMEOUT);
+        if (!err) {
+                if (hdl->fd < 0) {
+                        err = ENOMEDIUM;
+
+                } else if (hdl->read_only) {
+                        err = EROFS;
+
+                } else if (*fpos >= hdl->size) {
+                        err = ENOSPC;
+
+                } else {
+                        count = min(count, hdl->size - *fpos);
+
+                        int n = _host_file_write(hdl->fd, src, count, *fpos);
+                        if (n >= 0) {
+                                *wrcnt = n;
+                        } else {
+                                err = EIO;
+                        }
+                }
+
+                sys_mutex_unlock(hdl->mtx);
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief Read data from device
+ *
+ * @param[in ]          *device_handle          device allocated memory
+ * @param[out]          *dst                    data destination
+ * @param[in ]           count                  number of bytes to read
+ * @param[in ][out]     *fpos                   file position
+ * @param[out]          *rdcnt                  number of read bytes
+ * @param[in ]           fattr                  file attributes
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+API_MOD_READ(VDISK,
+             void            *device_handle,
+             u8_t            *dst,
+             size_t           count,
+             fpos_t          *fpos,
+             size_t          *rdcnt,
+             struct vfs_fattr fattr)
+{
+        UNUSED_ARG1(fattr);
+
+        VDISK_t *hdl = device_handle;
+
+        int err = sys_mutex_lock(hdl->mtx, MUTEX_TIMEOUT);
+        if (!err) {
+                if (hdl->fd < 0) {
+                        err = ENOMEDIUM;
+
+                } else if (*fpos < hdl->size) {
+                        count = min(count, hdl->size - *fpos);
+
+                        int n = _host_file_read(hdl->fd, dst, count, *fpos);
+                        if (n >= 0) {
+                                *rdcnt = n;
+                        } else {
+                                err = EIO;
+                        }
+                } else {
+                        *rdcnt = 0;
+                }
+
+                sys_mutex_unlock(hdl->mtx);
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief IO control
+ *
+ * @param[in ]          *device_handle          device allocated memory
+ * @param[in ]           request                request
+ * @param[in ][out]     *arg                    request's argument
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+API_MOD_IOCTL(VDISK, void *device_handle, int request, void *arg)
+{
+        VDISK_t *hdl = device_handle;
+        int      err = EINVAL;
+
+        switch (request) {
+        case IOCTL_VDISK__CONFIGURE_STR:
+                if (arg) {
+                        char path[PATH_LEN];
+                        if (sys_stropt_get_string_copy(arg, "path", path, sizeof(path))) {
+                                bool ro = sys_stropt_get_bool(arg, "read_only", false);
+                                err = configure(hdl, path, ro);
+                        }
+                }
+                break;
+
+        case IOCTL_VDISK__CONFIGURE:
+                if (arg) {
+                        const VDISK_config_t *cfg = arg;
+                        err = configure(hdl, cfg->path, cfg->read_only);
+                }
+                break;
+
+        case IOCTL_VDISK__INITIALIZE:
+                err = configure(hdl, hdl->path, hdl->read_only);
+                break;
+
+        case IOCTL_VDISK__DISCARD:
+                if (arg) {
+                        const STORAGE_discard_t *range = arg;
+
+                        err = sys_mutex_lock(hdl->mtx, MUTEX_TIMEOUT);
+                        if (!err) {
+                                if (hdl->fd < 0) {
+                                        err = ENOMEDIUM;
+                                } else if (hdl->read_only) {
+                                        err = EROFS;
+                                } else if (_host_file_discard(hdl->fd, range->offset, range->size) != 0) {
+                                        err = ENOTSUP;
+                                }
+
+                                sys_mutex_unlock(hdl->mtx);
+                        }
+                }
+                break;
+
+        default:
+                err = EBADRQC;
+                break;
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief Flush device
+ *
+ * @param[in ]          *device_handle          device allocated memory
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+API_MOD_FLUSH(VDISK, void *device_handle)
+{
+        VDISK_t *hdl = device_handle;
+
+        int err = sys_mutex_lock(hdl->mtx, MUTEX_TIMEOUT);
+        if (!err) {
+                if (hdl->fd >= 0 && !hdl->read_only) {
+                        err = _host_file_sync(hdl->fd) == 0 ? ESUCC : EIO;
+                }
+
+                sys_mutex_unlock(hdl->mtx);
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief Device information
+ *
+ * @param[in ]          *device_handle          device allocated memory
+ * @param[out]          *device_stat            device status
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+API_MOD_STAT(VDISK, void *device_handle, struct vfs_dev_stat *device_stat)
+{
+        VDISK_t *hdl = device_handle;
+
+        device_stat->st_size = hdl->size;
+
+        return ESUCC;
+}
+
+//==============================================================================
+/**
+ * @brief  Function open selected image file.
+ *
+ * @param  hdl          driver handle
+ * @param  path         host path of image
+ * @param  read_only    open image in read only mode
+ *
+ * @return One of errno value (errno.h).
+ */
+//==============================================================================
+static int configure(VDISK_t *hdl, const char *path, bool read_only)
+{
+        if (!path || strlen(path) >= PATH_LEN) {
+                return EINVAL;
+        }
+
+        int err = sys_mutex_lock(hdl->mtx, MUTEX_TIMEOUT);
+        if (!err) {
+                if (hdl->path != path) {
+                        strlcpy(hdl->path, path, sizeof(hdl->path));
+                }
+
+                if (hdl->fd >= 0) {
+                        _host_file_close(hdl->fd);
+                        hdl->fd   = -1;
+                        hdl->size = 0;
+                }
+
+                int fd = _host_file_open(hdl->path, read_only);
+                if (fd >= 0) {
+                        int64_t size = _host_file_size(fd);
+                        if (size >= 0) {
+                                hdl->fd        = fd;
+                                hdl->size      = size;
+                                hdl->read_only = read_only;
+                        } else {
+                                _host_file_close(fd);
+                                err = EIO;
+                        }
+                } else {
+                        err = ENOENT;
+                }
+
+                sys_mutex_unlock(hdl->mtx);
+        }
+
+        return err;
+}
+
+#endif
+/*==============================================================================
+  End of file
+==============================================================================*/
@@ -0,0 +1,163 @@
+/*=========================================================================*//**
+@file    vdisk_ioctl.h
+
+@author  Daniel Zorychta
+
+@brief   Virtual disk driver (Linux host image file).
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+/**
+@defgroup drv-vdisk VDISK Driver (Virtual disk)
+
+\section drv-vdisk-desc Description
+Driver exposes an image file of the Linux host as a block device. The driver is
+available only when the system is built as a Linux host process, it is used to
+run file systems (e.g. FAT, ext4) without real storage hardware.
+
+Device (drivers) connection table
+| Grade | Device       | In                  | Out              |
+| ----: | :----------- | :------------------ | :--------------- |
+| 0     | Image file   | -                   | Host file        |
+| 1     | VDISK driver | Host file           | /dev/vda         |
+| 2     | File system  | /dev/vda            | /mnt             |
+
+\section drv-vdisk-sup-arch Supported architectures
+\li linux
+
+\section drv-vdisk-ddesc Details
+\subsection drv-vdisk-ddesc-num Meaning of major and minor numbers
+Major number selects an image. Only minor number set to 0 is accepted by driver.
+
+\subsection drv-vdisk-ddesc-init Driver initialization
+To initialize driver the following code can be used:
+
+@code
+static const VDISK_config_t vda_cfg = {
+        .path      = "fat.img",
+        .read_only = false,
+};
+
+driver_init2("VDISK", 0, 0, "/dev/vda", &vda_cfg);
+@endcode
+
+\subsection drv-vdisk-ddesc-release Driver release
+To release driver the following code can be used:
+@code
+driver_release("VDISK", 0, 0);
+@endcode
+
+\subsection drv-vdisk-ddesc-cfg Driver configuration
+Driver can be configured at initialization or by ioctl() function. String
+configuration accepts "path" and "read_only" options, e.g.:
+@code
+ioctl(fileno(dev), IOCTL_VDISK__CONFIGURE_STR, "path=ext4.img,read_only=0");
+@endcode
+
+\subsection drv-vdisk-ddesc-write Data write
+Data to the driver can be written in the same way as regular file. Data is
+written directly to the image file at the file position.
+
+\subsection drv-vdisk-ddesc-read Data read
+Data can be read in the same way as regular file. Image is not extended by
+reads beyond its end, these bytes are read as zeros.
+
+@{
+*/
+
+#ifndef _VDISK_IOCTL_H_
+#define _VDISK_IOCTL_H_
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include "drivers/ioctl_macros.h"
+#include "drivers/class/device/ioctl.h"
+#include "drivers/class/storage/ioctl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*==============================================================================
+  Exported macros
+==============================================================================*/
+/**
+ * @brief  Virtual disk configuration.
+ * @param  [WR] @ref VDISK_config_t*            driver configuration.
+ * @return On success 0 is returned, otherwise -1 and @ref errno code is set.
+ */
+#define IOCTL_VDISK__CONFIGURE          _IOW(VDISK, 0x00, VDISK_config_t*)
+
+/**
+ * @brief  Virtual disk configuration by using string.
+ * @param  [WR] const char*             configuration string
+ * @return On success 0 is returned, otherwise -1 and @ref errno code is set.
+ */
+#define IOCTL_VDISK__CONFIGURE_STR      IOCTL_DEVICE__CONFIGURE_STR
+
+/**
+ * @brief  Virtual disk initialization (image is reopened).
+ * @param  None
+ * @return On success 0 is returned, otherwise -1 and @ref errno code is set.
+ */
+#define IOCTL_VDISK__INITIALIZE         IOCTL_STORAGE__INITIALIZE
+
+/**
+ * @brief  Discard selected range of the image (hole is punched in host file).
+ * @param  [WR] @ref STORAGE_discard_t*         range to discard
+ * @return On success 0 is returned, otherwise -1 and @ref errno code is set.
+ */
+#define IOCTL_VDISK__DISCARD            IOCTL_STORAGE__DISCARD
+
+/*==============================================================================
+  Exported object types
+==============================================================================*/
+/**
+ * Type represent driver configuration.
+ */
+typedef struct {
+        const char *path;               /*!< Host path of image file.*/
+        bool        read_only;          /*!< Open image in read only mode.*/
+} VDISK_config_t;
+
+/*==============================================================================
+  Exported objects
+==============================================================================*/
+
+/*==============================================================================
+  Exported functions
+==============================================================================*/
+
+/*==============================================================================
+  Exported inline functions
+==============================================================================*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _VDISK_IOCTL_H_ */
+/**@}*/
+/*==============================================================================
+  End of file
+==============================================================================*/
@@ -6,6 +6,7 @@ Regfile_name="fs_registration.c"
 
 # variables
 list=
+path=
 
 #-------------------------------------------------------------------------------
 # @brief  Check incoming arguments
@@ -33,6 +34,17 @@ function get_list()
     echo $(ls -F "$1" | grep -P '/|@' | sed 's/\///g' | sed 's/@//g')
 }
 
+#-------------------------------------------------------------------------------
+# @brief  Checks if file system implements optional function
+# @param  file system name
+# @param  function macro suffix (e.g. READV)
+# @return 0 if function is implemented
+#-------------------------------------------------------------------------------
+function has_func()
+{
+    grep -rqs "API_FS_$2($1" "$path/$1"
+}
+
 #-------------------------------------------------------------------------------
 # @brief  Creates Makefile
 # @param  None
@@ -74,9 +86,18 @@ function create_registration_file()
         echo '    extern API_FS_CLOSE('$fs', void*, void*, bool);'
         echo '    extern API_FS_WRITE('$fs', void*, void*, const u8_t*, size_t, fpos_t*, size_t*, struct vfs_fattr);'
         echo '    extern API_FS_READ('$fs', void*, void*, u8_t*, size_t, fpos_t*, size_t*, struct vfs_fattr);'
+        if has_func $fs WRITEV; then
+        echo '    extern API_FS_WRITEV('$fs', void*, void*, const struct iovec*, int, fpos_t*, size_t*, struct vfs_fattr);'
+        fi
+        if has_func $fs READV; then
+        echo '    extern API_FS_READV('$fs', void*, void*, const struct iovec*, int, fpos_t*, size_t*, struct vfs_fattr);'
+        fi
         echo '    extern API_FS_IOCTL('$fs', void*, void*, int, void*);'
         echo '    extern API_FS_FLUSH('$fs', void*, void*);'
         echo '    extern API_FS_SYNC('$fs', void*);'
+        if has_func $fs DIRTY; then
+        echo '    extern API_FS_DIRTY('$fs', void*);'
+        fi
         echo '    extern API_FS_MKNOD('$fs', void*, const char*, const dev_t);'
         echo '    extern API_FS_OPENDIR('$fs', void*, const char*, struct vfs_dir*);'
         echo '    extern API_FS_CLOSEDIR('$fs', void*, struct vfs_dir*);'
@@ -122,7 +143,19 @@ function create_registration_file()
         echo '                 .fs_ioctl   = _'$fs'_ioctl,'
         echo '                 .fs_flush   = _'$fs'_flush,'
         echo '                 .fs_write   = _'$fs'_write,'
+        if has_func $fs WRITEV; then
+        echo '                 .fs_writev  = _'$fs'_writev,'
+        fi
+        if has_func $fs READV; then
+        echo '                 .fs_readv   = _'$fs'_readv,'
+        fi
         echo '                 .fs_sync    = _'$fs'_sync,'
+        if has_func $fs DIRTY; then
+        echo '                 .fs_dirty   = _'$fs'_dirty,'
+        fi
+        if has_func $fs NOCACHE; then
+        echo '                 .fs_nocache = true,'
+        fi
         echo '                 .fs_mknod   = _'$fs'_mknod,'
         echo '                 .fs_opendir = _'$fs'_opendir,'
         echo '                 .fs_closedir= _'$fs'_closedir,'
@@ -170,6 +203,7 @@ function main()
 {
     check_args "$1" "$2"
 
+    path="$1"
     list=$(get_list "$1")
 
     create_makefile > "$2/$Makefile_name"
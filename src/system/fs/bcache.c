@@ -0,0 +1,1027 @@
+/*=========================================================================*//**
+@file    bcache.c
+
+@author  Daniel Zorychta
+
+@brief   Block device buffer cache.
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <string.h>
+#include <stdlib.h>
+#include "config.h"
+#include "fs/bcache.h"
+#include "mm/mm.h"
+#include "lib/cast.h"
+#include "kernel/errno.h"
+#include "kernel/kwrapper.h"
+#include "dnx/misc.h"
+#include "drivers/class/storage/ioctl.h"
+
+/*==============================================================================
+  Local macros
+==============================================================================*/
+#if __OS_BLOCK_CACHE_SIZE__ > 0
+#define BCACHE_SIZE             __OS_BLOCK_CACHE_SIZE__
+#define BCACHE_BUCKETS          BCACHE_SIZE
+#define BLOCK_SIZE              _BCACHE_BLOCK_SIZE
+#define BYPASS_SIZE             (8 * BLOCK_SIZE)
+#define BURST                   ((__OS_BLOCK_CACHE_BURST__ < BCACHE_SIZE / 2) ? __OS_BLOCK_CACHE_BURST__ \
+                                : ((BCACHE_SIZE / 2) ? (BCACHE_SIZE / 2) : 1))
+#define STREAMS                 4
+#define MEM_RESERVE             (_mm_get_mem_size() / 8)
+#define LOCK_TIMEOUT            MAX_DELAY_MS
+#endif
+
+/*==============================================================================
+  Local object types
+==============================================================================*/
+#if __OS_BLOCK_CACHE_SIZE__ > 0
+/*
+ * Cached block. Block maps device file and block number (LBA) to the block
+ * data. The block is owned by the hash chain and the LRU list.
+ */
+typedef struct block {
+        struct block *hnext;            //!< next block of hash chain
+        struct block *newer;            //!< LRU list: more recently used block
+        struct block *older;            //!< LRU list: less recently used block
+        FILE         *file;             //!< device file
+        u64_t         lba;              //!< block number
+        bool          dirty;            //!< block modified, not written to device
+        u8_t          buf[BLOCK_SIZE];  //!< block data
+} block_t;
+
+/*
+ * Sequential read stream. Stream is matched when block next to the last
+ * read block of the same device is requested. Streams are tracked per
+ * device, so a few files read at the same time are detected separately.
+ */
+typedef struct {
+        FILE         *file;             //!< device file
+        u64_t         next;             //!< next expected block
+        u32_t         stamp;            //!< last access (stream replacement)
+        u8_t          window;           //!< read-ahead window [blocks]
+} stream_t;
+#endif
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+#if __OS_BLOCK_CACHE_SIZE__ > 0
+static block_t **bucket_of  (FILE *file, u64_t lba);
+static block_t *lookup      (FILE *file, u64_t lba);
+static block_t *find        (FILE *file, u64_t lba);
+static stream_t *get_stream (FILE *file, u64_t lba, bool *sequential);
+static int      load_blocks (FILE *file, u64_t lba, size_t count);
+static u8_t    *stage_buffer(void);
+static void     attach      (block_t *blk, FILE *file, u64_t lba);
+static void     detach      (block_t *blk);
+static block_t *new_block   (void);
+static void     free_block  (block_t *blk);
+static int      write_back  (block_t *blk);
+static int      dev_read    (FILE *file, void *buf, size_t size, u64_t offset, size_t *rdcnt);
+static int      dev_write   (FILE *file, const void *buf, size_t size, u64_t offset, size_t *wrcnt);
+static int      compare_lba (const void *a, const void *b);
+#endif
+static int      dev_ioctl   (FILE *file, int rq, ...);
+
+/*==============================================================================
+  Local objects
+==============================================================================*/
+#if __OS_BLOCK_CACHE_SIZE__ > 0
+static struct {
+        mutex_t  *mtx;
+        block_t  *bucket[BCACHE_BUCKETS];
+        block_t  *newest;
+        block_t  *oldest;
+        size_t    count;
+        u8_t     *stage;
+        stream_t  stream[STREAMS];
+        u32_t     stamp;
+} bcache;
+#endif
+
+/*==============================================================================
+  Exported objects
+==============================================================================*/
+
+/*==============================================================================
+  External objects
+==============================================================================*/
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+#if __OS_BLOCK_CACHE_SIZE__ > 0
+
+//==============================================================================
+/**
+ * @brief  Function initialize block cache. Blocks are allocated on demand
+ *         from cache memory.
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+int _bcache_init(void)
+{
+        return _mutex_create(MUTEX_TYPE_NORMAL, &bcache.mtx);
+}
+
+//==============================================================================
+/**
+ * @brief  Function read data from device file through the cache. Large
+ *         transfers of not cached blocks are read directly to the buffer to
+ *         not evict metadata blocks by bulk file data.
+ *
+ * @param  file         device file
+ * @param  buf          destination buffer
+ * @param  size         number of bytes to read
+ * @param  offset       device offset
+ * @param  rdcnt        number of read bytes
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+int _bcache_read(FILE *file, void *buf, size_t size, u64_t offset, size_t *rdcnt)
+{
+        if (!file || !buf || !rdcnt) {
+                return EINVAL;
+        }
+
+        *rdcnt = 0;
+
+        int err = _mutex_lock(bcache.mtx, LOCK_TIMEOUT);
+        if (err) {
+                return err;
+        }
+
+        u8_t *dst = buf;
+
+        while (!err && size) {
+                u64_t     lba    = offset / BLOCK_SIZE;
+                size_t    seek   = offset % BLOCK_SIZE;
+                size_t    n      = min(BLOCK_SIZE - seek, size);
+                block_t  *blk    = find(file, lba);
+                bool      seq    = false;
+                stream_t *stream = get_stream(file, lba, &seq);
+
+                if (!blk && (seek == 0) && (size >= BYPASS_SIZE)) {
+                        size_t run = 1;
+                        while (((run + 1) * BLOCK_SIZE <= size) && !lookup(file, lba + run)) {
+                                run++;
+                        }
+
+                        n = run * BLOCK_SIZE;
+
+                        size_t cnt = 0;
+                        err = dev_read(file, dst, n, offset, &cnt);
+                        *rdcnt += cnt;
+
+                        stream->next = lba + run;
+
+                        if (!err && (cnt < n)) {
+                                break;
+                        }
+
+                } else {
+                        if (!blk) {
+                                /* sequential access: enlarge read-ahead window */
+                                if (seq) {
+                                        stream->window = min(BURST, max(2, stream->window * 2));
+                                } else {
+                                        stream->window = 1;
+                                }
+
+                                err = load_blocks(file, lba, max(stream->window, (seek + size + BLOCK_SIZE - 1) / BLOCK_SIZE));
+                                blk = find(file, lba);
+                        }
+
+                        if (!err && !blk) {
+                                /* no memory for cache or end of device: read directly */
+                                size_t cnt = 0;
+                                err = dev_read(file, dst, n, offset, &cnt);
+                                *rdcnt += cnt;
+
+                                if (!err && (cnt < n)) {
+                                        break;
+                                }
+                        }
+
+                        stream->next = lba + 1;
+                }
+
+                if (!err && blk) {
+                        memcpy(dst, &blk->buf[seek], n);
+                        *rdcnt += n;
+                }
+
+                dst    += n;
+                offset += n;
+                size   -= n;
+        }
+
+        _mutex_unlock(bcache.mtx);
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function write data to device file through the cache. Written
+ *         blocks are marked as dirty and are written to the device by sync
+ *         or when are evicted. Large transfers of not cached blocks are
+ *         written directly to the device.
+ *
+ * @param  file         device file
+ * @param  buf          source buffer
+ * @param  size         number of bytes to write
+ * @param  offset       device offset
+ * @param  wrcnt        number of written bytes
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+int _bcache_write(FILE *file, const void *buf, size_t size, u64_t offset, size_t *wrcnt)
+{
+        if (!file || !buf || !wrcnt) {
+                return EINVAL;
+        }
+
+        *wrcnt = 0;
+
+        int err = _mutex_lock(bcache.mtx, LOCK_TIMEOUT);
+        if (err) {
+                return err;
+        }
+
+        const u8_t *src = buf;
+
+        while (!err && size) {
+                u64_t   lba  = offset / BLOCK_SIZE;
+                size_t  seek = offset % BLOCK_SIZE;
+                size_t  n    = min(BLOCK_SIZE - seek, size);
+                block_t *blk = find(file, lba);
+
+                if (!blk && (seek == 0) && (size >= BYPASS_SIZE)) {
+                        size_t run = 1;
+                        while (((run + 1) * BLOCK_SIZE <= size) && !lookup(file, lba + run)) {
+                                run++;
+                        }
+
+                        n = run * BLOCK_SIZE;
+
+                        size_t cnt = 0;
+                        err = dev_write(file, src, n, offset, &cnt);
+                        *wrcnt += cnt;
+
+                        if (!err && (cnt < n)) {
+                                break;
+                        }
+
+                } else if (!blk) {
+                        blk = new_block();
+
+                        if (blk) {
+                                /* partially written block must be loaded first */
+                                if (n < BLOCK_SIZE) {
+                                        size_t cnt = 0;
+                                        err = dev_read(file, blk->buf, BLOCK_SIZE, lba * BLOCK_SIZE, &cnt);
+                                        if (!err && (cnt < BLOCK_SIZE)) {
+                                                err = ENOSPC;
+                                        }
+                                }
+
+                                if (!err) {
+                                        attach(blk, file, lba);
+                                } else {
+                                        free_block(blk);
+                                        blk = NULL;
+                                }
+                        } else {
+                                /* no memory for cache: write directly */
+                                size_t cnt = 0;
+                                err = dev_write(file, src, n, offset, &cnt);
+                                *wrcnt += cnt;
+
+                                if (!err && (cnt < n)) {
+                                        break;
+                                }
+                        }
+                }
+
+                if (!err && blk) {
+                        memcpy(&blk->buf[seek], src, n);
+                        blk->dirty = true;
+                        *wrcnt += n;
+                }
+
+                src    += n;
+                offset += n;
+                size   -= n;
+        }
+
+        _mutex_unlock(bcache.mtx);
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function write modified blocks of selected device to the device.
+ *         Numbers of modified blocks are collected once, sorted and blocks
+ *         are written in ascending order in a single pass. The cache is
+ *         unlocked between device requests, so devices can be synchronized
+ *         in parallel and cache users are not stalled for the whole
+ *         synchronization. If memory for block numbers is not available then
+ *         blocks are written in LRU order with locked cache.
+ *
+ * @param  file         device file (NULL: all devices)
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+int _bcache_sync(FILE *file)
+{
+        int err = _mutex_lock(bcache.mtx, LOCK_TIMEOUT);
+        if (err) {
+                return err;
+        }
+
+        u64_t  *lba   = NULL;
+        size_t  count = 0;
+
+        if (file) {
+                for (block_t *blk = bcache.oldest; blk; blk = blk->newer) {
+                        if (blk->dirty && (blk->file == file)) {
+                                count++;
+                        }
+                }
+
+                if (count > 1) {
+                        _kmalloc(_MM_KRN, count * sizeof(u64_t), NULL, 0, 0, cast(void**, &lba));
+                }
+        }
+
+        if (lba) {
+                size_t n = 0;
+
+                for (block_t *blk = bcache.oldest; blk; blk = blk->newer) {
+                        if (blk->dirty && (blk->file == file)) {
+                                lba[n++] = blk->lba;
+                        }
+                }
+
+                _mutex_unlock(bcache.mtx);
+
+                qsort(lba, n, sizeof(u64_t), compare_lba);
+
+                for (size_t i = 0; i < n; i++) {
+                        int result = _mutex_lock(bcache.mtx, LOCK_TIMEOUT);
+                        if (result) {
+                                err = result;
+                                break;
+                        }
+
+                        // block can be written with previous burst or evicted
+                        block_t *blk = lookup(file, lba[i]);
+                        if (blk && blk->dirty) {
+                                result = write_back(blk);
+                                if (result) {
+                                        err = result;
+                                }
+                        }
+
+                        _mutex_unlock(bcache.mtx);
+                }
+
+                _kfree(_MM_KRN, cast(void**, &lba));
+
+        } else {
+                for (block_t *blk = bcache.oldest; blk; blk = blk->newer) {
+                        if (blk->dirty && (!file || (blk->file == file))) {
+                                int result = write_back(blk);
+                                if (result) {
+                                        err = result;
+                                }
+                        }
+                }
+
+                _mutex_unlock(bcache.mtx);
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function check if selected device has modified blocks. Function does
+ *         not wait for the cache; busy cache is reported as modified.
+ *
+ * @param  file         device file
+ *
+ * @return If device has modified blocks then true is returned, otherwise false.
+ */
+//==============================================================================
+bool _bcache_dirty(FILE *file)
+{
+        bool dirty = true;
+
+        if (_mutex_lock(bcache.mtx, 0) == ESUCC) {
+                dirty = false;
+
+                for (block_t *blk = bcache.oldest; blk && !dirty; blk = blk->newer) {
+                        dirty = blk->dirty && (blk->file == file);
+                }
+
+                _mutex_unlock(bcache.mtx);
+        }
+
+        return dirty;
+}
+
+//==============================================================================
+/**
+ * @brief  Function write modified blocks of selected device and remove all
+ *         blocks of device from the cache. Function is called when device
+ *         file is closed.
+ *
+ * @param  file         device file
+ */
+//==============================================================================
+void _bcache_release(FILE *file)
+{
+        if (_mutex_lock(bcache.mtx, LOCK_TIMEOUT) == ESUCC) {
+                block_t *blk = bcache.oldest;
+
+                while (blk) {
+                        block_t *newer = blk->newer;
+
+                        if (blk->file == file) {
+                                if (blk->dirty) {
+                                        write_back(blk);
+                                }
+
+                                detach(blk);
+                                free_block(blk);
+                        }
+
+                        blk = newer;
+                }
+
+                for (size_t i = 0; i < STREAMS; i++) {
+                        if (bcache.stream[i].file == file) {
+                                memset(&bcache.stream[i], 0, sizeof(stream_t));
+                        }
+                }
+
+                _mutex_unlock(bcache.mtx);
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function release cache memory. Modified blocks are written to the
+ *         device first. Function is called when system is low on memory.
+ */
+//==============================================================================
+void _bcache_shrink(void)
+{
+        if (_mutex_lock(bcache.mtx, LOCK_TIMEOUT) == ESUCC) {
+                block_t *blk = bcache.oldest;
+
+                while (blk) {
+                        block_t *newer = blk->newer;
+
+                        if (!blk->dirty || (write_back(blk) == ESUCC)) {
+                                detach(blk);
+                                free_block(blk);
+                        }
+
+                        blk = newer;
+                }
+
+                if (bcache.stage) {
+                        _kfree(_MM_CACHE, cast(void**, &bcache.stage));
+                }
+
+                _mutex_unlock(bcache.mtx);
+        }
+}
+
+#endif
+
+//==============================================================================
+/**
+ * @brief  Function discard range of device (TRIM). Cached blocks of the
+ *         range are removed without write back and the request is passed to
+ *         the device driver.
+ *
+ * @param  file         device file
+ * @param  offset       device offset
+ * @param  size         number of bytes to discard
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+int _bcache_discard(FILE *file, u64_t offset, u64_t size)
+{
+        if (!file || !size) {
+                return EINVAL;
+        }
+
+#if __OS_BLOCK_CACHE_SIZE__ > 0
+        u64_t first = (offset + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        u64_t end   = (offset + size) / BLOCK_SIZE;
+
+        int err = _mutex_lock(bcache.mtx, LOCK_TIMEOUT);
+        if (err) {
+                return err;
+        }
+
+        block_t *blk = bcache.oldest;
+
+        while (blk) {
+                block_t *newer = blk->newer;
+
+                if ((blk->file == file) && (blk->lba >= first) && (blk->lba < end)) {
+                        detach(blk);
+                        free_block(blk);
+                }
+
+                blk = newer;
+        }
+
+        _mutex_unlock(bcache.mtx);
+#endif
+
+        STORAGE_discard_t range = {.offset = offset, .size = size};
+        return dev_ioctl(file, IOCTL_STORAGE__DISCARD, &range);
+}
+
+#if __OS_BLOCK_CACHE_SIZE__ > 0
+
+//==============================================================================
+/**
+ * @brief  Function calculate hash bucket of selected block.
+ *
+ * @param  file         device file
+ * @param  lba          block number
+ *
+ * @return Bucket reference.
+ */
+//==============================================================================
+static inline block_t **bucket_of(FILE *file, u64_t lba)
+{
+        u32_t hash = cast(u32_t, cast(uintptr_t, file) >> 2) ^ cast(u32_t, lba * 2654435761U);
+        return &bcache.bucket[hash % BCACHE_BUCKETS];
+}
+
+//==============================================================================
+/**
+ * @brief  Function search selected block. LRU order is not changed.
+ *
+ * @param  file         device file
+ * @param  lba          block number
+ *
+ * @return Found block or NULL.
+ */
+//==============================================================================
+static block_t *lookup(FILE *file, u64_t lba)
+{
+        for (block_t *blk = *bucket_of(file, lba); blk; blk = blk->hnext) {
+                if (blk->file == file && blk->lba == lba) {
+                        return blk;
+                }
+        }
+
+        return NULL;
+}
+
+//==============================================================================
+/**
+ * @brief  Function search selected block. Found block becomes the most
+ *         recently used.
+ *
+ * @param  file         device file
+ * @param  lba          block number
+ *
+ * @return Found block or NULL.
+ */
+//==============================================================================
+static block_t *find(FILE *file, u64_t lba)
+{
+        block_t *blk = lookup(file, lba);
+
+        if (blk && (bcache.newest != blk)) {
+                detach(blk);
+                attach(blk, file, lba);
+        }
+
+        return blk;
+}
+
+//==============================================================================
+/**
+ * @brief  Function find read stream of selected block. If block does not
+ *         continue any stream then the least recently used stream is
+ *         replaced.
+ *
+ * @param  file         device file
+ * @param  lba          requested block
+ * @param  sequential   true if block continues stream
+ *
+ * @return Stream object.
+ */
+//==============================================================================
+static stream_t *get_stream(FILE *file, u64_t lba, bool *sequential)
+{
+        stream_t *victim = &bcache.stream[0];
+
+        bcache.stamp++;
+
+        for (size_t i = 0; i < STREAMS; i++) {
+                stream_t *stream = &bcache.stream[i];
+
+                if (stream->file == file) {
+                        if (stream->next == lba) {
+                                *sequential   = true;
+                                stream->stamp = bcache.stamp;
+                                return stream;
+
+                        } else if (stream->next == lba + 1) {
+                                /* last block read again */
+                                stream->stamp = bcache.stamp;
+                                return stream;
+                        }
+                }
+
+                if ((bcache.stamp - stream->stamp) > (bcache.stamp - victim->stamp)) {
+                        victim = stream;
+                }
+        }
+
+        victim->file   = file;
+        victim->next   = lba;
+        victim->stamp  = bcache.stamp;
+        victim->window = 0;
+
+        return victim;
+}
+
+//==============================================================================
+/**
+ * @brief  Function load not cached blocks to the cache by single device
+ *         transfer. Loading stops at first block that is already cached.
+ *
+ * @param  file         device file
+ * @param  lba          first block
+ * @param  count        number of blocks to load (read-ahead window)
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+static int load_blocks(FILE *file, u64_t lba, size_t count)
+{
+        block_t *blk[BURST];
+        size_t   n = 1;
+
+        count = min(count, BURST);
+
+        while ((n < count) && !lookup(file, lba + n)) {
+                n++;
+        }
+
+        u8_t *buf = (n > 1) ? stage_buffer() : NULL;
+        if (!buf) {
+                n = 1;
+        }
+
+        /* blocks are allocated first because eviction can use stage buffer */
+        size_t got = 0;
+        for (; got < n; got++) {
+                blk[got] = new_block();
+                if (!blk[got]) {
+                        break;
+                }
+        }
+
+        if (got == 0) {
+                return ESUCC;
+
+        } else if (got == 1) {
+                buf = blk[0]->buf;
+        }
+
+        size_t cnt = 0;
+        int    err = dev_read(file, buf, got * BLOCK_SIZE, lba * BLOCK_SIZE, &cnt);
+
+        /* the requested block is attached as the most recently used one */
+        for (size_t i = got; i > 0; i--) {
+                block_t *b = blk[i - 1];
+
+                if (!err && (cnt >= i * BLOCK_SIZE)) {
+                        if (got > 1) {
+                                memcpy(b->buf, &buf[(i - 1) * BLOCK_SIZE], BLOCK_SIZE);
+                        }
+
+                        attach(b, file, lba + i - 1);
+                } else {
+                        free_block(b);
+                }
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function return buffer used for multi-block transfers. Buffer is
+ *         allocated on first use and released when cache is shrunk.
+ *
+ * @return Buffer of BURST blocks or NULL if memory is not available.
+ */
+//==============================================================================
+static u8_t *stage_buffer(void)
+{
+        if (!bcache.stage) {
+                void *buf = NULL;
+                if (_kmalloc(_MM_CACHE, BURST * BLOCK_SIZE, NULL, 0, 0, &buf) == ESUCC) {
+                        bcache.stage = buf;
+                }
+        }
+
+        return bcache.stage;
+}
+
+//==============================================================================
+/**
+ * @brief  Function add block to hash chain and as the most recently used
+ *         block to the LRU list.
+ *
+ * @param  blk          block
+ * @param  file         device file
+ * @param  lba          block number
+ */
+//==============================================================================
+static void attach(block_t *blk, FILE *file, u64_t lba)
+{
+        block_t **bucket = bucket_of(file, lba);
+
+        blk->file  = file;
+        blk->lba   = lba;
+        blk->hnext = *bucket;
+        *bucket    = blk;
+
+        blk->older = bcache.newest;
+        blk->newer = NULL;
+
+        if (bcache.newest) {
+                bcache.newest->newer = blk;
+        } else {
+                bcache.oldest = blk;
+        }
+
+        bcache.newest = blk;
+}
+
+//==============================================================================
+/**
+ * @brief  Function remove block from hash chain and LRU list.
+ *
+ * @param  blk          block
+ */
+//==============================================================================
+static void detach(block_t *blk)
+{
+        block_t **entry = bucket_of(blk->file, blk->lba);
+
+        while (*entry && (*entry != blk)) {
+                entry = &(*entry)->hnext;
+        }
+
+        if (*entry) {
+                *entry = blk->hnext;
+        }
+
+        if (blk->newer) {
+                blk->newer->older = blk->older;
+        } else {
+                bcache.newest = blk->older;
+        }
+
+        if (blk->older) {
+                blk->older->newer = blk->newer;
+        } else {
+                bcache.oldest = blk->newer;
+        }
+
+        blk->hnext = NULL;
+        blk->newer = NULL;
+        blk->older = NULL;
+}
+
+//==============================================================================
+/**
+ * @brief  Function allocate new block. If cache is full or system is low
+ *         on memory then the least recently used block is reused.
+ *
+ * @return Not linked block or NULL if block is not available.
+ */
+//==============================================================================
+static block_t *new_block(void)
+{
+        block_t *blk = NULL;
+
+        if ((bcache.count < BCACHE_SIZE) && (_mm_get_mem_free() > MEM_RESERVE)) {
+                if (_kmalloc(_MM_CACHE, sizeof(block_t), NULL, 0, 0,
+                             cast(void**, &blk)) == ESUCC) {
+                        bcache.count++;
+                        blk->dirty = false;
+                        return blk;
+                }
+        }
+
+        blk = bcache.oldest;
+
+        if (blk) {
+                if (blk->dirty && write_back(blk) != ESUCC) {
+                        return NULL;
+                }
+
+                detach(blk);
+        }
+
+        return blk;
+}
+
+//==============================================================================
+/**
+ * @brief  Function free not linked block.
+ *
+ * @param  blk          block
+ */
+//==============================================================================
+static void free_block(block_t *blk)
+{
+        _kfree(_MM_CACHE, cast(void**, &blk));
+        bcache.count--;
+}
+
+//==============================================================================
+/**
+ * @brief  Function write modified block to the device. Adjacent modified
+ *         blocks of the same device are written by the same transfer.
+ *
+ * @param  blk          block
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+static int write_back(block_t *blk)
+{
+        FILE   *file  = blk->file;
+        u64_t   first = blk->lba;
+        size_t  n     = 1;
+        u8_t   *buf   = (BURST > 1) ? stage_buffer() : NULL;
+
+        if (buf) {
+                block_t *b;
+
+                while ((n < BURST) && (first > 0) && (b = lookup(file, first - 1)) && b->dirty) {
+                        first--;
+                        n++;
+                }
+
+                while ((n < BURST) && (b = lookup(file, first + n)) && b->dirty) {
+                        n++;
+                }
+        }
+
+        if (n == 1) {
+                buf = blk->buf;
+        } else {
+                for (size_t i = 0; i < n; i++) {
+                        memcpy(&buf[i * BLOCK_SIZE], lookup(file, first + i)->buf, BLOCK_SIZE);
+                }
+        }
+
+        size_t wrcnt = 0;
+        int err = dev_write(file, buf, n * BLOCK_SIZE, first * BLOCK_SIZE, &wrcnt);
+
+        if (!err && (wrcnt == n * BLOCK_SIZE)) {
+                for (size_t i = 0; i < n; i++) {
+                        lookup(file, first + i)->dirty = false;
+                }
+        } else if (!err) {
+                err = ENOSPC;
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function read data directly from device file.
+ *
+ * @param  file         device file
+ * @param  buf          destination buffer
+ * @param  size         number of bytes to read
+ * @param  offset       device offset
+ * @param  rdcnt        number of read bytes
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+static int dev_read(FILE *file, void *buf, size_t size, u64_t offset, size_t *rdcnt)
+{
+        struct iovec iov = {.iov_base = buf, .iov_len = size};
+        i64_t        pos = offset;
+        return _vfs_fpreadv(file, &iov, 1, &pos, rdcnt);
+}
+
+//==============================================================================
+/**
+ * @brief  Function write data directly to device file.
+ *
+ * @param  file         device file
+ * @param  buf          source buffer
+ * @param  size         number of bytes to write
+ * @param  offset       device offset
+ * @param  wrcnt        number of written bytes
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+static int dev_write(FILE *file, const void *buf, size_t size, u64_t offset, size_t *wrcnt)
+{
+        struct iovec iov = {.iov_base = cast(void*, buf), .iov_len = size};
+        i64_t        pos = offset;
+        return _vfs_fpwritev(file, &iov, 1, &pos, wrcnt);
+}
+
+//==============================================================================
+/**
+ * @brief  Function compare block numbers (qsort callback).
+ *
+ * @param  a            first block number
+ * @param  b            second block number
+ *
+ * @return Negative, zero or positive value if first number is less, equal or
+ *         greater than second number.
+ */
+//==============================================================================
+static int compare_lba(const void *a, const void *b)
+{
+        u64_t lba_a = *cast(const u64_t*, a);
+        u64_t lba_b = *cast(const u64_t*, b);
+
+        return (lba_a > lba_b) - (lba_a < lba_b);
+}
+
+#endif
+
+//==============================================================================
+/**
+ * @brief  Function send request directly to device file.
+ *
+ * @param  file         device file
+ * @param  rq           request
+ * @param  ...          request argument
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+static int dev_ioctl(FILE *file, int rq, ...)
+{
+        va_list arg;
+        va_start(arg, rq);
+        int err = _vfs_vfioctl(file, rq, arg);
+        va_end(arg);
+        return err;
+}
+
+/*==============================================================================
+  End of file
+==============================================================================*/
@@ -0,0 +1,454 @@
+/*=========================================================================*//**
+@file    dcache.c
+
+@author  Daniel Zorychta
+
+@brief   VFS lookup cache (dentry cache).
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <string.h>
+#include "config.h"
+#include "fs/dcache.h"
+#include "mm/mm.h"
+#include "lib/cast.h"
+#include "kernel/errno.h"
+#include "kernel/kwrapper.h"
+#include "dnx/misc.h"
+
+#if __OS_VFS_DENTRY_CACHE_SIZE__ > 0
+
+/*==============================================================================
+  Local macros
+==============================================================================*/
+#define DCACHE_SIZE             __OS_VFS_DENTRY_CACHE_SIZE__
+#define DCACHE_BUCKETS          DCACHE_SIZE
+#define LOCK_TIMEOUT            MAX_DELAY_MS
+
+/*==============================================================================
+  Local object types
+==============================================================================*/
+/*
+ * Cache entry. Entry maps file system and path in the file system to the
+ * lookup result: attributes of directory or regular file (positive entry) or
+ * ENOENT error (negative entry). Attributes of regular file are valid until
+ * any file of the file system is modified (file generation is changed). The
+ * entry is owned by the hash chain and the LRU list.
+ */
+typedef struct dentry {
+        struct dentry *hnext;           //!< next entry of hash chain
+        struct dentry *newer;           //!< LRU list: more recently used entry
+        struct dentry *older;           //!< LRU list: less recently used entry
+        void          *fs;              //!< file system (NULL: entry not used)
+        u32_t          hash;            //!< path hash
+        u8_t           len;             //!< path length (without ending slash)
+        u32_t          fgen;            //!< file generation of file system (regular file)
+        int            err;             //!< lookup result (ESUCC or ENOENT)
+        struct stat    stat;            //!< directory or regular file attributes
+        char           path[_DCACHE_PATH_LEN];
+} dentry_t;
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+static bool      make_key  (void *fs, const char *path, u32_t *hash, size_t *len);
+static dentry_t *find      (void *fs, const char *path, u32_t hash, size_t len);
+static void      unhash    (dentry_t *entry);
+static void      touch     (dentry_t *entry);
+static bool      is_related(const dentry_t *entry, const char *path, size_t len);
+
+/*==============================================================================
+  Local objects
+==============================================================================*/
+static struct {
+        mutex_t  *mtx;
+        dentry_t *entry;
+        dentry_t *bucket[DCACHE_BUCKETS];
+        dentry_t *newest;
+        dentry_t *oldest;
+        u32_t     gen;
+} dcache;
+
+/*==============================================================================
+  Exported objects
+==============================================================================*/
+
+/*==============================================================================
+  External objects
+==============================================================================*/
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+
+//==============================================================================
+/**
+ * @brief  Function initialize lookup cache. All entries are allocated at once
+ *         and are linked in the LRU list.
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+int _dcache_init(void)
+{
+        int err = _mutex_create(MUTEX_TYPE_NORMAL, &dcache.mtx);
+        if (!err) {
+                err = _kzalloc(_MM_FS, DCACHE_SIZE * sizeof(dentry_t), NULL, 0, 0,
+                               cast(void**, &dcache.entry));
+                if (!err) {
+                        for (size_t i = 0; i < DCACHE_SIZE; i++) {
+                                dentry_t *entry = &dcache.entry[i];
+                                entry->older = (i + 1 < DCACHE_SIZE) ? &entry[1] : NULL;
+                                entry->newer = (i > 0) ? &entry[-1] : NULL;
+                        }
+
+                        dcache.newest = &dcache.entry[0];
+                        dcache.oldest = &dcache.entry[DCACHE_SIZE - 1];
+                } else {
+                        _mutex_destroy(dcache.mtx);
+                        dcache.mtx = NULL;
+                }
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function search lookup result of selected path. Function returns
+ *         invalidation generation that shall be passed to _dcache_insert()
+ *         when the path is looked up in file system.
+ *
+ * @param  fs           file system
+ * @param  path         path in file system
+ * @param  fgen         current file generation of file system
+ * @param  stat         cached attributes (positive entry)
+ * @param  err          cached lookup result
+ * @param  gen          invalidation generation
+ *
+ * @return If entry exist then true is returned, otherwise false.
+ */
+//==============================================================================
+bool _dcache_lookup(void *fs, const char *path, u32_t fgen, struct stat *stat, int *err, u32_t *gen)
+{
+        u32_t  hash;
+        size_t len;
+        bool   found = false;
+
+        *gen = dcache.gen;
+
+        if (dcache.mtx && make_key(fs, path, &hash, &len)) {
+                if (_mutex_lock(dcache.mtx, LOCK_TIMEOUT) == ESUCC) {
+
+                        dentry_t *entry = find(fs, path, hash, len);
+
+                        if (  entry && (entry->err == ESUCC)
+                           && S_ISREG(entry->stat.st_mode) && (entry->fgen != fgen) ) {
+
+                                unhash(entry);
+                                entry = NULL;
+                        }
+
+                        if (entry) {
+                                touch(entry);
+
+                                *err = entry->err;
+                                if (entry->err == ESUCC) {
+                                        *stat = entry->stat;
+                                }
+
+                                found = true;
+                        }
+
+                        _mutex_unlock(dcache.mtx);
+                }
+        }
+
+        return found;
+}
+
+//==============================================================================
+/**
+ * @brief  Function add lookup result of selected path. Directories, regular
+ *         files and not existing paths are cached; attributes of other files
+ *         (devices, FIFOs) are changed outside the file system. The least
+ *         recently used entry is reused. Result is dropped if any path was
+ *         invalidated since lookup start.
+ *
+ * @param  fs           file system
+ * @param  path         path in file system
+ * @param  fgen         file generation of file system read before lookup
+ * @param  gen          invalidation generation returned by _dcache_lookup()
+ * @param  err          lookup result
+ * @param  stat         path attributes (if lookup succeeded)
+ */
+//==============================================================================
+void _dcache_insert(void *fs, const char *path, u32_t fgen, u32_t gen, int err, const struct stat *stat)
+{
+        u32_t  hash;
+        size_t len;
+
+        if (err == ESUCC) {
+                if (!S_ISDIR(stat->st_mode) && !S_ISREG(stat->st_mode)) {
+                        return;
+                }
+        } else if (err != ENOENT) {
+                return;
+        }
+
+        if (dcache.mtx && make_key(fs, path, &hash, &len)) {
+                if (_mutex_lock(dcache.mtx, LOCK_TIMEOUT) == ESUCC) {
+
+                        dentry_t *entry = NULL;
+
+                        if (gen == dcache.gen) {
+                                entry = find(fs, path, hash, len);
+                                if (!entry) {
+                                        entry = dcache.oldest;
+                                        unhash(entry);
+
+                                        entry->fs    = fs;
+                                        entry->hash  = hash;
+                                        entry->len   = len;
+                                        memcpy(entry->path, path, len);
+
+                                        entry->hnext = dcache.bucket[hash % DCACHE_BUCKETS];
+                                        dcache.bucket[hash % DCACHE_BUCKETS] = entry;
+                                }
+                        }
+
+                        if (entry) {
+                                entry->fgen = fgen;
+                                entry->err  = err;
+                                if (err == ESUCC) {
+                                        entry->stat = *stat;
+                                }
+
+                                touch(entry);
+                        }
+
+                        _mutex_unlock(dcache.mtx);
+                }
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function invalidate entries of path that was modified. Entries of
+ *         path, its parents and its children are removed.
+ *
+ * @param  fs           file system
+ * @param  path         modified path (NULL: all entries of file system)
+ */
+//==============================================================================
+void _dcache_invalidate(void *fs, const char *path)
+{
+        size_t len = 0;
+
+        if (path) {
+                len = strlen(path);
+                if (len && (path[len - 1] == '/')) {
+                        len--;
+                }
+        }
+
+        if (dcache.mtx && (_mutex_lock(dcache.mtx, LOCK_TIMEOUT) == ESUCC)) {
+
+                dcache.gen++;
+
+                for (size_t i = 0; i < DCACHE_SIZE; i++) {
+                        dentry_t *entry = &dcache.entry[i];
+
+                        if (  (entry->fs == fs)
+                           && ((path == NULL) || is_related(entry, path, len)) ) {
+
+                                unhash(entry);
+                        }
+                }
+
+                _mutex_unlock(dcache.mtx);
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function calculate key of path. Ending slash is not a part of key.
+ *
+ * @param  fs           file system
+ * @param  path         path
+ * @param  hash         path hash
+ * @param  len          path length
+ *
+ * @return If path can be cached then true is returned, otherwise false.
+ */
+//==============================================================================
+static bool make_key(void *fs, const char *path, u32_t *hash, size_t *len)
+{
+        size_t n = strlen(path);
+        if (n && (path[n - 1] == '/')) {
+                n--;
+        }
+
+        if (n < _DCACHE_PATH_LEN) {
+                u32_t h = 2166136261U ^ cast(u32_t, cast(uintptr_t, fs));
+
+                for (size_t i = 0; i < n; i++) {
+                        h = (h ^ cast(u8_t, path[i])) * 16777619U;
+                }
+
+                *hash = h;
+                *len  = n;
+                return true;
+        } else {
+                return false;
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function find entry. Function shall be called with locked mutex.
+ *
+ * @param  fs           file system
+ * @param  path         path
+ * @param  hash         path hash
+ * @param  len          path length
+ *
+ * @return Found entry or NULL.
+ */
+//==============================================================================
+static dentry_t *find(void *fs, const char *path, u32_t hash, size_t len)
+{
+        for (dentry_t *entry = dcache.bucket[hash % DCACHE_BUCKETS];
+             entry; entry = entry->hnext) {
+
+                if (  (entry->hash == hash)
+                   && (entry->fs   == fs)
+                   && (entry->len  == len)
+                   && (memcmp(entry->path, path, len) == 0) ) {
+
+                        return entry;
+                }
+        }
+
+        return NULL;
+}
+
+//==============================================================================
+/**
+ * @brief  Function remove entry from hash chain and move entry to the end of
+ *         LRU list (entry is reused as first). Function shall be called with
+ *         locked mutex.
+ *
+ * @param  entry        entry to remove
+ */
+//==============================================================================
+static void unhash(dentry_t *entry)
+{
+        if (entry->fs) {
+                dentry_t **pentry = &dcache.bucket[entry->hash % DCACHE_BUCKETS];
+
+                while (*pentry) {
+                        if (*pentry == entry) {
+                                *pentry = entry->hnext;
+                                break;
+                        }
+
+                        pentry = &(*pentry)->hnext;
+                }
+
+                entry->hnext = NULL;
+                entry->fs    = NULL;
+
+                if (entry != dcache.oldest) {
+                        // unlink
+                        entry->older->newer = entry->newer;
+                        if (entry->newer) {
+                                entry->newer->older = entry->older;
+                        } else {
+                                dcache.newest = entry->older;
+                        }
+
+                        // link as the oldest
+                        entry->newer = dcache.oldest;
+                        entry->older = NULL;
+                        dcache.oldest->older = entry;
+                        dcache.oldest = entry;
+                }
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function move entry to the beginning of LRU list. Function shall
+ *         be called with locked mutex.
+ *
+ * @param  entry        used entry
+ */
+//==============================================================================
+static void touch(dentry_t *entry)
+{
+        if (entry != dcache.newest) {
+                // unlink
+                entry->newer->older = entry->older;
+                if (entry->older) {
+                        entry->older->newer = entry->newer;
+                } else {
+                        dcache.oldest = entry->newer;
+                }
+
+                // link as the newest
+                entry->older = dcache.newest;
+                entry->newer = NULL;
+                dcache.newest->newer = entry;
+                dcache.newest = entry;
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function check if entry is parent or child of selected path.
+ *
+ * @param  entry        entry
+ * @param  path         path
+ * @param  len          path length (without ending slash)
+ *
+ * @return If entry is related to path then true is returned, otherwise false.
+ */
+//==============================================================================
+static bool is_related(const dentry_t *entry, const char *path, size_t len)
+{
+        const char *shorter = entry->len < len ? entry->path : path;
+        const char *longer  = entry->len < len ? path : entry->path;
+        size_t      n       = min(entry->len, len);
+
+        return (memcmp(shorter, longer, n) == 0)
+            && ((entry->len == len) || (longer[n] == '/') || (n == 0));
+}
+
+#endif /* __OS_VFS_DENTRY_CACHE_SIZE__ > 0 */
+
+/*==============================================================================
+  End of file
+==============================================================================*/
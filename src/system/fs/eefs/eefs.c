@@ -64,8 +64,10 @@ Brief    EEPROM File System. File system for small memories 1-64KiB EEPROM.
 
 #define NAME_LEN                        21      // note: modify with care
 
-#define cache_get_block(sys_cache)      cast(block_cached_t*, &sys_cache[1])->block
-#define cache_get_block_num(sys_cache)  cast(block_cached_t*, &sys_cache[1])->block_num
+#define CACHE_BLOCKS                    __EEFS_CFG_CACHE_BLOCKS__
+#define BITMAP_BLOCKS_MAX               64
+#define MAIN_BITMAP_SIZE                sizeof(((block_main_t*)0)->bitmap)
+#define BITMAP_SIZE                     sizeof(((block_bitmap_t*)0)->map)
 
 #define FLAG_SYNC                       (1<<0)
 #define FLAG_RDONLY                     (1<<1)
@@ -241,18 +243,38 @@ typedef struct {
         block_t buf;
 } block_buf_t;
 
+/**
+ * Cached block. Block is kept with valid checksum.
+ */
+typedef struct {
+        u16_t   num;            //!< block number
+        bool    valid;          //!< block contains data
+        bool    dirty;          //!< block modified, not written to memory
+        u32_t   stamp;          //!< last access (LRU replacement)
+        block_t buf;            //!< block data
+} cache_block_t;
+
 /**
  * File system handle.
  */
 typedef struct {
-        FILE        *srcdev;
-        mutex_t     *lock_mtx;
-        dir_desc_t  *open_dirs;
-        file_desc_t *open_files;
-        uint16_t     root_dir_block;
-        block_buf_t  block;
-        block_buf_t  tmpblock;
-        u8_t         flag;
+        FILE          *srcdev;
+        mutex_t       *lock_mtx;
+        dir_desc_t    *open_dirs;
+        file_desc_t   *open_files;
+        uint16_t       root_dir_block;
+        block_buf_t    block;
+        block_buf_t    tmpblock;
+        u8_t           flag;
+        u16_t          blocks;          //!< number of memory blocks
+        u8_t           bitmap_blocks;   //!< number of bitmap blocks
+        u8_t          *bitmap;          //!< empty block bitmap (main and bitmap blocks)
+        u8_t           bitmap_dirty[CEILING(1 + BITMAP_BLOCKS_MAX, 8)]; //!< modified bitmap blocks
+        u16_t          alloc_next;      //!< next-fit allocation cursor
+        u32_t          stamp;           //!< cache access counter
+#if CACHE_BLOCKS > 0
+        cache_block_t  cache[CACHE_BLOCKS];
+#endif
 } EEFS_t;
 
 /*==============================================================================
@@ -261,6 +283,12 @@ typedef struct {
 static uint16_t fletcher16(uint8_t const *data, size_t bytes);
 static int block_read(EEFS_t *hdl, block_buf_t *blk);
 static int block_write(EEFS_t *hdl, block_buf_t *blk);
+static int dev_block_read(EEFS_t *hdl, u16_t num, block_t *buf);
+static int dev_block_write(EEFS_t *hdl, u16_t num, const block_t *buf);
+static int cache_put(EEFS_t *hdl, u16_t num, const block_t *buf, bool dirty);
+static int cache_flush(EEFS_t *hdl);
+static bool cache_is_dirty(EEFS_t *hdl);
+static int fs_sync(EEFS_t *hdl);
 static bool is_entry_item_used(dir_entry_t *entry);
 static int block_load(EEFS_t *hdl, const char *path);
 static int block_load_by_type(EEFS_t *hdl, const char *path, uint32_t type);
@@ -270,6 +298,9 @@ static int bmp_block_alloc_ctrl(EEFS_t *hdl, uint16_t blknum, bool allocate);
 static int bmp_block_alloc(EEFS_t *hdl, uint16_t blknum);
 static int bmp_block_free(EEFS_t *hdl, uint16_t blknum);
 static int bmp_get_used_blocks(EEFS_t *hdl, uint16_t *blkused);
+static int bmp_load(EEFS_t *hdl);
+static int bmp_commit(EEFS_t *hdl);
+static bool bmp_is_dirty(EEFS_t *hdl);
 static const char *path_get_next_item(const char *path, char **name, size_t *len, bool *last);
 static const char *path_get_last_slash(const char *path);
 static int path_alloc_dirname(const char *path, char **path_base);
@@ -326,9 +357,15 @@ API_FS_INIT(eefs, void **fs_handle, const char *src_path, const char *opts)
 
                         if (  hdl->block.buf.main.magic         == BLOCK_MAGIC_MAIN
                            && hdl->block.buf.main.blocks        >= 8
-                           && hdl->block.buf.main.bitmap_blocks <= 64 ) {
+                           && hdl->block.buf.main.bitmap_blocks <= BITMAP_BLOCKS_MAX ) {
 
                                 hdl->root_dir_block = 1 + hdl->block.buf.main.bitmap_blocks;
+                                hdl->alloc_next     = hdl->root_dir_block + 1;
+
+                                err = bmp_load(hdl);
+                                if (err) {
+                                        goto finish;
+                                }
 
                                 if (!isstrempty(opts)) {
                                         if (sys_stropt_is_flag(opts, "sync")) {
@@ -358,6 +395,10 @@ API_FS_INIT(eefs, void **fs_handle, const char *src_path, const char *opts)
                                 sys_mutex_destroy(hdl->lock_mtx);
                         }
 
+                        if (hdl->bitmap) {
+                                sys_free(cast(void*, &hdl->bitmap));
+                        }
+
                         sys_free(fs_handle);
                 }
         }
@@ -382,7 +423,12 @@ API_FS_RELEASE(eefs, void *fs_handle)
         if (!err) {
                 if ((hdl->open_files == NULL) && (hdl->open_dirs == NULL)) {
 
+                        if (fs_sync(hdl) != ESUCC) {
+                                DBG("release: unable to write modified blocks");
+                        }
+
                         sys_fclose(hdl->srcdev);
+                        sys_free(cast(void*, &hdl->bitmap));
 
                         mutex_t *mtx = hdl->lock_mtx;
 
@@ -978,17 +1024,12 @@ API_FS_STATFS(eefs, void *fs_handle, struct statfs *statfs)
 
         int err = sys_mutex_lock(hdl->lock_mtx, BUSY_TIMEOUT);
         if (!err) {
+                statfs->f_blocks = hdl->blocks;
 
-                hdl->block.num = 0;
-                err = block_read(hdl, &hdl->block);
+                u16_t blkused = 0;
+                err = bmp_get_used_blocks(hdl, &blkused);
                 if (!err) {
-                        statfs->f_blocks = hdl->block.buf.main.blocks;
-
-                        u16_t blkused = 0;
-                        err = bmp_get_used_blocks(hdl, &blkused);
-                        if (!err) {
-                                statfs->f_bfree = statfs->f_blocks - blkused;
-                        }
+                        statfs->f_bfree = statfs->f_blocks - blkused;
                 }
 
                 sys_mutex_unlock(hdl->lock_mtx);
@@ -1368,7 +1409,8 @@ API_FS_FLUSH(eefs, void *fs_handle, void *fhdl)
 
 //==============================================================================
 /**
- * @brief Synchronize all buffers to a medium.
+ * @brief Synchronize all buffers to a medium. Modified bitmap blocks and
+ *        cached blocks are written to the memory.
  *
  * @param[in ]          *fs_handle              file system allocated memory
  *
@@ -1377,9 +1419,38 @@ API_FS_FLUSH(eefs, void *fs_handle, void *fhdl)
 //==============================================================================
 API_FS_SYNC(eefs, void *fs_handle)
 {
-        UNUSED_ARG1(fs_handle);
+        EEFS_t *hdl = fs_handle;
 
-        return ESUCC;
+        int err = sys_mutex_lock(hdl->lock_mtx, BUSY_TIMEOUT);
+        if (!err) {
+                err = fs_sync(hdl);
+                sys_mutex_unlock(hdl->lock_mtx);
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief Check if file system has data to synchronize.
+ *
+ * @param[in ]          *fs_handle              file system allocated memory
+ *
+ * @return True if file system is modified, otherwise false.
+ */
+//==============================================================================
+API_FS_DIRTY(eefs, void *fs_handle)
+{
+        EEFS_t *hdl = fs_handle;
+
+        bool dirty = true;
+
+        if (sys_mutex_lock(hdl->lock_mtx, 0) == ESUCC) {
+                dirty = bmp_is_dirty(hdl) || cache_is_dirty(hdl);
+                sys_mutex_unlock(hdl->lock_mtx);
+        }
+
+        return dirty || sys_bdirty(hdl->srcdev);
 }
 
 //==============================================================================
@@ -1428,21 +1499,21 @@ static uint16_t fletcher16(uint8_t const *data, size_t bytes)
 //==============================================================================
 static int block_read(EEFS_t *hdl, block_buf_t *blk)
 {
-        memset(&blk->buf, 0, 128);
+#if CACHE_BLOCKS > 0
+        for (u8_t i = 0; i < CACHE_BLOCKS; i++) {
+                cache_block_t *cblk = &hdl->cache[i];
 
-        size_t rdcnt = 0;
-        sys_fseek(hdl->srcdev, blk->num * BLOCK_SIZE, SEEK_SET);
-        int err = sys_fread(&blk->buf, BLOCK_SIZE, &rdcnt, hdl->srcdev);
+                if (cblk->valid && cblk->num == blk->num) {
+                        cblk->stamp = ++hdl->stamp;
+                        memcpy(&blk->buf, &cblk->buf, sizeof(blk->buf));
+                        return ESUCC;
+                }
+        }
+#endif
 
+        int err = dev_block_read(hdl, blk->num, &blk->buf);
         if (!err) {
-                u16_t chsum  = fletcher16(blk->buf.chsum.buf, sizeof(blk->buf.chsum.buf));
-                      chsum ^= blk->num;
-
-                err = (chsum == blk->buf.chsum.checksum) ? ESUCC : EILSEQ;
-
-                if (err) {
-                        DBG("Block %d checksum fail", blk->num);
-                }
+                err = cache_put(hdl, blk->num, &blk->buf, false);
         }
 
         return err;
@@ -1451,6 +1522,9 @@ static int block_read(EEFS_t *hdl, block_buf_t *blk)
 //==============================================================================
 /**
  * @brief Function write block to memory. Function uses caching subsystem.
+ *        Block is written to the memory immediately if write-through mode
+ *        is selected ("sync" option), otherwise block is written at cache
+ *        eviction or file system synchronization.
  *
  * @param  hdl          FS handle.
  * @param  blk          block to write.
@@ -1468,10 +1542,208 @@ static int block_write(EEFS_t *hdl, block_buf_t *blk)
                                                      sizeof(blk->buf.chsum.buf))
                                         ^ blk->num;
 
-                size_t wrcnt = 0;
-                sys_fseek(hdl->srcdev, blk->num * BLOCK_SIZE, SEEK_SET);
-                return sys_fwrite(&blk->buf, BLOCK_SIZE, &wrcnt, hdl->srcdev);
+                if ((CACHE_BLOCKS == 0) || (hdl->flag & FLAG_SYNC)) {
+                        int err = dev_block_write(hdl, blk->num, &blk->buf);
+                        if (!err) {
+                                err = cache_put(hdl, blk->num, &blk->buf, false);
+                        }
+
+                        return err;
+
+                } else {
+                        return cache_put(hdl, blk->num, &blk->buf, true);
+                }
+        }
+}
+
+//==============================================================================
+/**
+ * @brief Function read block directly from memory and verify checksum.
+ *
+ * @param  hdl          FS handle.
+ * @param  num          block number.
+ * @param  buf          block buffer.
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+static int dev_block_read(EEFS_t *hdl, u16_t num, block_t *buf)
+{
+        memset(buf, 0, BLOCK_SIZE);
+
+        size_t rdcnt = 0;
+        int err = sys_bread(buf, BLOCK_SIZE, num * BLOCK_SIZE, &rdcnt, hdl->srcdev);
+
+        if (!err) {
+                u16_t chsum  = fletcher16(buf->chsum.buf, sizeof(buf->chsum.buf));
+                      chsum ^= num;
+
+                err = (chsum == buf->chsum.checksum) ? ESUCC : EILSEQ;
+
+                if (err) {
+                        DBG("Block %d checksum fail", num);
+                }
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief Function write block directly to memory. Checksum shall be already
+ *        calculated.
+ *
+ * @param  hdl          FS handle.
+ * @param  num          block number.
+ * @param  buf          block buffer.
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+static int dev_block_write(EEFS_t *hdl, u16_t num, const block_t *buf)
+{
+        size_t wrcnt = 0;
+        return sys_bwrite(buf, BLOCK_SIZE, num * BLOCK_SIZE, &wrcnt, hdl->srcdev);
+}
+
+//==============================================================================
+/**
+ * @brief Function put block to the cache. If block is not cached then the
+ *        least recently used entry is replaced (modified entry is written
+ *        to the memory first).
+ *
+ * @param  hdl          FS handle.
+ * @param  num          block number.
+ * @param  buf          block buffer (with valid checksum).
+ * @param  dirty        block is modified and not written to the memory.
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+static int cache_put(EEFS_t *hdl, u16_t num, const block_t *buf, bool dirty)
+{
+#if CACHE_BLOCKS > 0
+        cache_block_t *cblk = &hdl->cache[0];
+
+        for (u8_t i = 0; i < CACHE_BLOCKS; i++) {
+                cache_block_t *c = &hdl->cache[i];
+
+                if (c->valid && c->num == num) {
+                        cblk = c;
+                        break;
+
+                } else if (!c->valid) {
+                        if (cblk->valid) {
+                                cblk = c;
+                        }
+
+                } else if (cblk->valid && c->stamp < cblk->stamp) {
+                        cblk = c;
+                }
+        }
+
+        if (cblk->valid && cblk->num != num && cblk->dirty) {
+                int err = dev_block_write(hdl, cblk->num, &cblk->buf);
+                if (err) {
+                        return err;
+                }
+        }
+
+        cblk->dirty = (cblk->valid && cblk->num == num && cblk->dirty) || dirty;
+        cblk->valid = true;
+        cblk->num   = num;
+        cblk->stamp = ++hdl->stamp;
+        memcpy(&cblk->buf, buf, sizeof(cblk->buf));
+#else
+        UNUSED_ARG4(hdl, num, buf, dirty);
+#endif
+        return ESUCC;
+}
+
+//==============================================================================
+/**
+ * @brief Function write all modified cached blocks to the memory. Blocks are
+ *        written in ascending order.
+ *
+ * @param  hdl          FS handle.
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+static int cache_flush(EEFS_t *hdl)
+{
+        int err = ESUCC;
+
+#if CACHE_BLOCKS > 0
+        while (!err) {
+                cache_block_t *cblk = NULL;
+
+                for (u8_t i = 0; i < CACHE_BLOCKS; i++) {
+                        cache_block_t *c = &hdl->cache[i];
+
+                        if (c->valid && c->dirty && (!cblk || c->num < cblk->num)) {
+                                cblk = c;
+                        }
+                }
+
+                if (cblk) {
+                        err = dev_block_write(hdl, cblk->num, &cblk->buf);
+                        if (!err) {
+                                cblk->dirty = false;
+                        }
+                } else {
+                        break;
+                }
+        }
+#else
+        UNUSED_ARG1(hdl);
+#endif
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief Function check if cache contains modified blocks.
+ *
+ * @param  hdl          FS handle.
+ *
+ * @return If cache contains modified blocks then true is returned.
+ */
+//==============================================================================
+static bool cache_is_dirty(EEFS_t *hdl)
+{
+#if CACHE_BLOCKS > 0
+        for (u8_t i = 0; i < CACHE_BLOCKS; i++) {
+                if (hdl->cache[i].valid && hdl->cache[i].dirty) {
+                        return true;
+                }
+        }
+#else
+        UNUSED_ARG1(hdl);
+#endif
+        return false;
+}
+
+//==============================================================================
+/**
+ * @brief Function write modified bitmap and cached blocks to the memory.
+ *
+ * @param  hdl          FS handle.
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+static int fs_sync(EEFS_t *hdl)
+{
+        int err = bmp_commit(hdl);
+        if (!err) {
+                err = cache_flush(hdl);
+                if (!err) {
+                        err = sys_bsync(hdl->srcdev);
+                }
         }
+
+        return err;
 }
 
 //==============================================================================
@@ -1678,142 +1950,209 @@ static int block_get_file_stat(EEFS_t *hdl, struct stat *stat)
 
 //==============================================================================
 /**
- * @brief  Function find empty block by using bitmap.
+ * @brief  Function return bitmap block number that contains selected bitmap
+ *         byte.
+ *
+ * @param  byte         bitmap byte index
+ *
+ * @return Bitmap block number (0 - main block).
+ */
+//==============================================================================
+static inline u8_t bmp_byte_block(u16_t byte)
+{
+        return (byte < MAIN_BITMAP_SIZE) ? 0 : 1 + ((byte - MAIN_BITMAP_SIZE) / BITMAP_SIZE);
+}
+
+//==============================================================================
+/**
+ * @brief  Function load bitmap (main and bitmap blocks) to the RAM. Main block
+ *         should be loaded to the hdl->block buffer.
  *
  * @param  hdl          EEFS handle
- * @param  blknum       found empty block
  *
  * @return One of errno value.
  */
 //==============================================================================
-static int bmp_block_find_empty(EEFS_t *hdl, uint16_t *blknum)
+static int bmp_load(EEFS_t *hdl)
 {
-        hdl->tmpblock.num = MAIN_BLOCK_ADDR;
-        int err = block_read(hdl, &hdl->tmpblock);
+        hdl->blocks        = hdl->block.buf.main.blocks;
+        hdl->bitmap_blocks = hdl->block.buf.main.bitmap_blocks;
+
+        size_t size = MAIN_BITMAP_SIZE + (hdl->bitmap_blocks * BITMAP_SIZE);
+
+        if (cast(size_t, CEILING(hdl->blocks, 8)) > size) {
+                return EMEDIUMTYPE;
+        }
+
+        int err = sys_malloc(size, cast(void**, &hdl->bitmap));
         if (!err) {
+                memcpy(hdl->bitmap, hdl->block.buf.main.bitmap, MAIN_BITMAP_SIZE);
 
-                if (hdl->tmpblock.buf.main.magic != BLOCK_MAGIC_MAIN) {
-                        err = EILSEQ;
-                        goto finish;
+                for (u8_t i = 1; !err && i <= hdl->bitmap_blocks; i++) {
+                        hdl->tmpblock.num = i;
+                        err = dev_block_read(hdl, i, &hdl->tmpblock.buf);
+                        if (!err) {
+                                if (hdl->tmpblock.buf.bitmap.magic == BLOCK_MAGIC_BITMAP) {
+                                        memcpy(&hdl->bitmap[MAIN_BITMAP_SIZE + ((i - 1) * BITMAP_SIZE)],
+                                               hdl->tmpblock.buf.bitmap.map, BITMAP_SIZE);
+                                } else {
+                                        DBG("Invalid bitmap block");
+                                        err = EILSEQ;
+                                }
+                        }
                 }
+        }
 
-                uint16_t blks    = hdl->tmpblock.buf.main.blocks;
-                uint16_t bmpblks = hdl->tmpblock.buf.main.bitmap_blocks;
-                uint8_t *bmp     = hdl->tmpblock.buf.main.bitmap;
-                uint8_t  bsz     = sizeof(hdl->tmpblock.buf.main.bitmap);
-                uint8_t  bmpnext = 1;
+        return err;
+}
 
-                *blknum = 0;
+//==============================================================================
+/**
+ * @brief  Function write modified bitmap blocks to the memory. Local buffer
+ *         is used to not destroy handle's buffers.
+ *
+ * @param  hdl          EEFS handle
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+static int bmp_commit(EEFS_t *hdl)
+{
+        int err = ESUCC;
 
-                do {
-                        for (u8_t i = 0; i < bsz && blks > 0; i++, blks -= 8) {
-                                if (bmp[i] == 0) {
-                                        continue;
-                                }
+        for (u8_t i = 0; !err && i <= hdl->bitmap_blocks; i++) {
 
-                                for (u8_t bit = 0; bit < 8; bit++) {
-                                        if ((bmp[i] >> bit) & 1) {
-                                                *blknum += (i * 8) + bit;
-                                                goto finish;
-                                        }
-                                }
-                        }
+                if (!(hdl->bitmap_dirty[i / 8] & (1 << (i % 8)))) {
+                        continue;
+                }
 
-                        if (bmpblks && blks > 0) {
-                                *blknum += (bsz * 8);
+                block_buf_t blk;
+                blk.num = i;
 
-                                hdl->tmpblock.num = bmpnext;
-                                err = block_read(hdl, &hdl->tmpblock);
-                                if (!err) {
-                                        if (hdl->block.buf.bitmap.magic == BLOCK_MAGIC_BITMAP) {
-                                                bmp = hdl->block.buf.bitmap.map;
-                                                bsz = sizeof(hdl->block.buf.bitmap.map);
-                                                bmpnext++;
-                                        } else {
-                                                DBG("Invalid bitmap block");
-                                                err = EILSEQ;
-                                        }
-                                }
+                err = block_read(hdl, &blk);
+                if (!err) {
+                        if (i == MAIN_BLOCK_ADDR) {
+                                memcpy(blk.buf.main.bitmap, hdl->bitmap, MAIN_BITMAP_SIZE);
+                        } else {
+                                memcpy(blk.buf.bitmap.map,
+                                       &hdl->bitmap[MAIN_BITMAP_SIZE + ((i - 1) * BITMAP_SIZE)],
+                                       BITMAP_SIZE);
                         }
 
-                        if (*blknum == 0) {
-                                err = ENOSPC;
+                        err = block_write(hdl, &blk);
+                        if (!err) {
+                                hdl->bitmap_dirty[i / 8] &= ~(1 << (i % 8));
                         }
-                } while (!err && bmpblks--);
+                }
         }
 
-        finish:
         return err;
 }
 
 //==============================================================================
 /**
- * @brief  Function allocate/release block.
+ * @brief  Function check if bitmap contains changes not written to memory.
  *
  * @param  hdl          EEFS handle
- * @param  blknum       block number to allocate/release
- * @param  allocate     allocate block if true, otherwise release
+ *
+ * @return If bitmap is modified then true is returned.
+ */
+//==============================================================================
+static bool bmp_is_dirty(EEFS_t *hdl)
+{
+        for (u8_t i = 0; i < ARRAY_SIZE(hdl->bitmap_dirty); i++) {
+                if (hdl->bitmap_dirty[i]) {
+                        return true;
+                }
+        }
+
+        return false;
+}
+
+//==============================================================================
+/**
+ * @brief  Function find empty block by using bitmap. Search starts from the
+ *         next-fit cursor (block after the last allocated one) and wraps at the
+ *         end of memory, so writes are spread over all blocks.
+ *
+ * @param  hdl          EEFS handle
+ * @param  blknum       found empty block
  *
  * @return One of errno value.
  */
 //==============================================================================
-static int bmp_block_alloc_ctrl(EEFS_t *hdl, uint16_t blknum, bool allocate)
+static int bmp_block_find_empty(EEFS_t *hdl, uint16_t *blknum)
 {
-        hdl->tmpblock.num = MAIN_BLOCK_ADDR;
-        int err = block_read(hdl, &hdl->tmpblock);
-        if (!err) {
+        u16_t first = hdl->root_dir_block + 1;
+        u16_t blk   = hdl->alloc_next;
 
-                if (hdl->tmpblock.buf.main.magic != BLOCK_MAGIC_MAIN) {
-                        err = EILSEQ;
-                        goto finish;
-                }
+        if (blk < first || blk >= hdl->blocks) {
+                blk = first;
+        }
 
-                if (blknum >= hdl->tmpblock.buf.main.blocks) {
-                        err = ENOSPC;
-                        goto finish;
-                }
+        for (u16_t n = first; n < hdl->blocks; n++) {
 
-                u16_t bmpblk = 0;
-                u8_t  blkidx = (blknum / 8);
-                u8_t  blkbit = (blknum % 8);
-                u8_t *bmp    = hdl->tmpblock.buf.main.bitmap;
+                u8_t byte = hdl->bitmap[blk / 8];
 
-                if (blkidx >= sizeof(hdl->tmpblock.buf.main.bitmap)) {
+                if (byte == 0 && (blk % 8) == 0) {
+                        // entire byte allocated
+                        n   += 7;
+                        blk += 7;
 
-                        blkidx -= sizeof(hdl->tmpblock.buf.main.bitmap);
-                        bmpblk  = (blkidx / sizeof(hdl->tmpblock.buf.bitmap.map));
-                        blkidx -= bmpblk * sizeof(hdl->tmpblock.buf.bitmap.map);
-                        bmpblk += 1;
+                } else if ((byte >> (blk % 8)) & 1) {
+                        *blknum = blk;
+                        return ESUCC;
+                }
 
-                        if (bmpblk <= hdl->tmpblock.buf.main.bitmap_blocks) {
-                                hdl->tmpblock.num = bmpblk;
-                                err = block_read(hdl, &hdl->tmpblock);
-                                if (!err) {
-                                        bmp = hdl->tmpblock.buf.bitmap.map;
-                                }
-                        } else {
-                                err = ENOSPC;
-                        }
+                if (++blk >= hdl->blocks) {
+                        blk = first;
                 }
+        }
 
-                if (!err) {
-                        if (allocate && !(bmp[blkidx] & (1 << blkbit))) {
-                                err = EADDRINUSE;
+        return ENOSPC;
+}
 
-                        } else {
-                                if (allocate) {
-                                        bmp[blkidx] &= ~(1 << blkbit);
-                                } else {
-                                        bmp[blkidx] |= (1 << blkbit);
-                                }
+//==============================================================================
+/**
+ * @brief  Function allocate/release block. Bitmap is modified in the RAM and
+ *         written to the memory at synchronization (or immediately if "sync"
+ *         option is used).
+ *
+ * @param  hdl          EEFS handle
+ * @param  blknum       block number to allocate/release
+ * @param  allocate     allocate block if true, otherwise release
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+static int bmp_block_alloc_ctrl(EEFS_t *hdl, uint16_t blknum, bool allocate)
+{
+        if (hdl->flag & FLAG_RDONLY) {
+                return EROFS;
+        }
 
-                                err = block_write(hdl, &hdl->tmpblock);
-                        }
-                }
+        if (blknum >= hdl->blocks) {
+                return ENOSPC;
         }
 
-        finish:
-        return err;
+        u16_t blkidx = (blknum / 8);
+        u8_t  blkbit = (blknum % 8);
+
+        if (allocate && !(hdl->bitmap[blkidx] & (1 << blkbit))) {
+                return EADDRINUSE;
+        }
+
+        if (allocate) {
+                hdl->bitmap[blkidx] &= ~(1 << blkbit);
+                hdl->alloc_next = blknum + 1;
+        } else {
+                hdl->bitmap[blkidx] |= (1 << blkbit);
+        }
+
+        u8_t bmpblk = bmp_byte_block(blkidx);
+        hdl->bitmap_dirty[bmpblk / 8] |= (1 << (bmpblk % 8));
+
+        return (hdl->flag & FLAG_SYNC) ? bmp_commit(hdl) : ESUCC;
 }
 
 //==============================================================================
@@ -1858,57 +2197,15 @@ static int bmp_block_free(EEFS_t *hdl, uint16_t blknum)
 //==============================================================================
 static int bmp_get_used_blocks(EEFS_t *hdl, uint16_t *blkused)
 {
-        hdl->tmpblock.num = MAIN_BLOCK_ADDR;
-        int err = block_read(hdl, &hdl->tmpblock);
-        if (!err) {
+        *blkused = 0;
 
-                if (hdl->tmpblock.buf.main.magic != BLOCK_MAGIC_MAIN) {
-                        err = EILSEQ;
-                        goto finish;
+        for (u16_t blk = 0; blk < hdl->blocks; blk++) {
+                if (!((hdl->bitmap[blk / 8] >> (blk % 8)) & 1)) {
+                        (*blkused)++;
                 }
-
-                uint16_t blks    = hdl->tmpblock.buf.main.blocks;
-                uint16_t bmpblks = hdl->tmpblock.buf.main.bitmap_blocks;
-                uint8_t *bmp     = hdl->tmpblock.buf.main.bitmap;
-                uint8_t  bsz     = sizeof(hdl->tmpblock.buf.main.bitmap);
-                uint8_t  bmpnext = 1;
-
-                do {
-                        for (u8_t i = 0; i < bsz && blks > 0; i++, blks -= 8) {
-                                u8_t ones;
-
-                                if (bmp[i] == 0xFF) {
-                                        ones = 8;
-                                } else if (bmp[i] == 0) {
-                                        ones = 0;
-                                } else {
-                                        ones = ((bmp[i] >> 7) & 1)
-                                             + ((bmp[i] >> 6) & 1)
-                                             + ((bmp[i] >> 5) & 1)
-                                             + ((bmp[i] >> 4) & 1)
-                                             + ((bmp[i] >> 3) & 1)
-                                             + ((bmp[i] >> 2) & 1)
-                                             + ((bmp[i] >> 1) & 1)
-                                             + ((bmp[i] >> 0) & 1);
-                                }
-
-                                *blkused += (8 - ones);
-                        }
-
-                        if (bmpblks) {
-                                hdl->tmpblock.num = bmpnext;
-                                err = block_read(hdl, &hdl->tmpblock);
-                                if (!err) {
-                                        bmp = hdl->tmpblock.buf.bitmap.map;
-                                        bsz = sizeof(hdl->tmpblock.buf.bitmap.map);
-                                        bmpnext++;
-                                }
-                        }
-                } while (!err && bmpblks--);
         }
 
-        finish:
-        return err;
+        return ESUCC;
 }
 
 //==============================================================================
@@ -37,6 +37,9 @@ Brief   EXT4 file system
 #define SECTOR_SIZE     512
 #define LOCK_TIMEOUT    MAX_DELAY_MS
 
+/* running transaction is committed inline when twice larger than threshold */
+#define COMMIT_LIMIT    (2 * __EXT4FS_CFG_COMMIT_BLOCKS__)
+
 /*==============================================================================
   Local object types
 ==============================================================================*/
@@ -48,6 +51,9 @@ typedef struct {
         mutex_t                   *fs_mutex;
         u8_t                       buf[SECTOR_SIZE];
         u32_t                      open_files;
+        sem_t                     *commit_sem;
+        tid_t                      commit_thread;
+        u32_t                      commit_interval;
 } ext4fs_t;
 
 /*==============================================================================
@@ -55,10 +61,14 @@ typedef struct {
 ==============================================================================*/
 static void file_opened(ext4fs_t *hdl);
 static void file_closed(ext4fs_t *hdl);
+static int  commit_start(ext4fs_t *hdl);
+static void commit_stop(ext4fs_t *hdl);
+static void commit_thread(void *arg);
 static int bopen(struct ext4_blockdev *bdev);
 static int bclose(struct ext4_blockdev *bdev);
 static int bread(struct ext4_blockdev *bdev, void *buf, uint64_t blk_id, uint32_t blk_cnt);
 static int bwrite(struct ext4_blockdev *bdev, const void *buf, uint64_t blk_id, uint32_t blk_cnt);
+static int bdiscard(struct ext4_blockdev *bdev, uint64_t blk_id, uint64_t blk_cnt);
 static int bdev_lock(struct ext4_blockdev *bdev);
 static int bdev_unlock(struct ext4_blockdev *bdev);
 static void mp_lock(void *p_user);
@@ -120,6 +130,7 @@ API_FS_INIT(ext4fs, void **fs_handle, const char *src_path, const char *opts)
                 hdl->bdif.close    = bclose;
                 hdl->bdif.lock     = bdev_lock;
                 hdl->bdif.unlock   = bdev_unlock;
+                hdl->bdif.discard  = __EXT4FS_CFG_DISCARD__ ? bdiscard : NULL;
                 hdl->bdif.ph_bsize = SECTOR_SIZE;
                 hdl->bdif.ph_bbuf  = hdl->buf;
                 hdl->bdif.ph_bcnt  = st.st_size / SECTOR_SIZE;
@@ -139,6 +150,12 @@ API_FS_INIT(ext4fs, void **fs_handle, const char *src_path, const char *opts)
 
                         if (read_only) {
                                 printk("EXTFS: read only file system");
+                        } else {
+                                hdl->commit_interval = max(0, sys_stropt_get_int(opts, "commit",
+                                                                                 __EXT4FS_CFG_COMMIT_INTERVAL__));
+                                if (hdl->commit_interval && commit_start(hdl) != ESUCC) {
+                                        printk("EXTFS: synchronous commit");
+                                }
                         }
                 }
 
@@ -174,6 +191,8 @@ API_FS_RELEASE(ext4fs, void *fs_handle)
         int       err = EBUSY;
 
         if (hdl->open_files == 0) {
+                commit_stop(hdl);
+
                 err = ext4_cache_write_back(false, hdl->mp);
                 if (err) goto finish;
 
@@ -299,6 +318,11 @@ API_FS_WRITE(ext4fs,
                 if (sys_gettime(&mtime) == ESUCC) {
                         ext4_mtime_set(NULL, fhdl, mtime, hdl->mp);
                 }
+
+                if (  hdl->commit_sem
+                   && ext4_journal_pending(hdl->mp) >= __EXT4FS_CFG_COMMIT_BLOCKS__) {
+                        sys_semaphore_signal(hdl->commit_sem);
+                }
         }
 
         return err;
@@ -352,9 +376,22 @@ API_FS_READ(ext4fs,
 //==============================================================================
 API_FS_IOCTL(ext4fs, void *fs_handle, void *fhdl, int request, void *arg)
 {
-        UNUSED_ARG4(fs_handle, fhdl, request, arg);
+        ext4fs_t *hdl = fs_handle;
 
-        return ENOTSUP;
+        switch (request) {
+        case IOCTL_VFS__FALLOCATE: {
+                const struct vfs_fallocate *range = arg;
+                return ext4_fallocate(fhdl, range->offset, range->len);
+        }
+
+        case IOCTL_VFS__FSTRIM: {
+                struct vfs_fstrim *fstrim = arg;
+                return ext4_trim(hdl->mp, fstrim->min_len, &fstrim->trimmed);
+        }
+
+        default:
+                return ENOTSUP;
+        }
 }
 
 //==============================================================================
@@ -369,9 +406,14 @@ API_FS_IOCTL(ext4fs, void *fs_handle, void *fhdl, int request, void *arg)
 //==============================================================================
 API_FS_FLUSH(ext4fs, void *fs_handle, void *fhdl)
 {
-        UNUSED_ARG2(fs_handle, fhdl);
+        ext4fs_t *hdl = fs_handle;
 
-        return ESUCC;
+        int err = ext4_fsync(fhdl);
+        if (!err) {
+                err = sys_bsync(hdl->dev);
+        }
+
+        return err;
 }
 
 //==============================================================================
@@ -768,9 +810,37 @@ API_FS_SYNC(ext4fs, void *fs_handle)
                 ext4_cache_write_back(__EXT4FS_CFG_WR_BUF_STRATEGY__, hdl->mp);
         }
 
+        if (!err) {
+                err = sys_bsync(hdl->dev);
+        }
+
         return err;
 }
 
+//==============================================================================
+/**
+ * @brief Check if file system has data to synchronize. Function does not wait
+ *        for the file system; busy file system is reported as modified.
+ *
+ * @param[in ]          *fs_handle              file system allocated memory
+ *
+ * @return True if file system is modified, otherwise false.
+ */
+//==============================================================================
+API_FS_DIRTY(ext4fs, void *fs_handle)
+{
+        ext4fs_t *hdl = fs_handle;
+
+        bool dirty = true;
+
+        if (sys_mutex_lock(hdl->fs_mutex, 0) == ESUCC) {
+                dirty = ext4_cache_dirty(hdl->mp);
+                sys_mutex_unlock(hdl->fs_mutex);
+        }
+
+        return dirty || sys_bdirty(hdl->dev);
+}
+
 //==============================================================================
 /**
  * @brief  Function increase open files counter.
@@ -801,6 +871,92 @@ static void file_closed(ext4fs_t *hdl)
         }
 }
 
+//==============================================================================
+/**
+ * @brief  Function starts background commit thread. Operations are grouped
+ *         in a single journal transaction which is committed by the thread
+ *         periodically or when transaction size reaches the threshold.
+ *
+ * @param  hdl          file system handle.
+ *
+ * @return One of errno value (errno.h).
+ */
+//==============================================================================
+static int commit_start(ext4fs_t *hdl)
+{
+        static const thread_attr_t attr = {
+                .priority    = PRIORITY_NORMAL,
+                .stack_depth = STACK_DEPTH_LOW,
+                .detached    = true
+        };
+
+        int err = sys_semaphore_create(1, 0, &hdl->commit_sem);
+        if (!err) {
+                err = sys_thread_create(commit_thread, &attr, hdl, &hdl->commit_thread);
+                if (!err) {
+                        err = ext4_journal_group(hdl->mp, COMMIT_LIMIT);
+                        if (err) {
+                                sys_thread_destroy(hdl->commit_thread);
+                        }
+                }
+
+                if (err) {
+                        sys_semaphore_destroy(hdl->commit_sem);
+                        hdl->commit_sem = NULL;
+                }
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function stops background commit thread. Running transaction is
+ *         committed.
+ *
+ * @param  hdl          file system handle.
+ */
+//==============================================================================
+static void commit_stop(ext4fs_t *hdl)
+{
+        if (hdl->commit_sem) {
+                /* thread does not own the mutex when is killed */
+                if (sys_mutex_lock(hdl->fs_mutex, LOCK_TIMEOUT) == ESUCC) {
+                        sys_thread_destroy(hdl->commit_thread);
+                        ext4_journal_group(hdl->mp, 0);
+                        sys_mutex_unlock(hdl->fs_mutex);
+                }
+
+                sys_semaphore_destroy(hdl->commit_sem);
+                hdl->commit_sem = NULL;
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Background commit thread. Commit point is the only place where
+ *         block cache is flushed to the device (barrier).
+ *
+ * @param  arg          file system handle.
+ */
+//==============================================================================
+static void commit_thread(void *arg)
+{
+        ext4fs_t *hdl = arg;
+
+        for (;;) {
+                sys_semaphore_wait(hdl->commit_sem, hdl->commit_interval);
+
+                if (sys_mutex_lock(hdl->fs_mutex, LOCK_TIMEOUT) == ESUCC) {
+                        if (ext4_cache_flush(hdl->mp) == ESUCC) {
+                                sys_bsync(hdl->dev);
+                        }
+
+                        sys_mutex_unlock(hdl->fs_mutex);
+                }
+        }
+}
+
 //==============================================================================
 /**
  * @brief  Function open block device. Not used, block opened at FS init.
@@ -848,8 +1004,8 @@ static int bread(struct ext4_blockdev *bdev, void *buf, uint64_t blk_id, uint32_
         ext4fs_t *hdl = bdev->bdif->p_user;
 
         size_t rdcnt = 0;
-        sys_fseek(hdl->dev, blk_id * bdev->bdif->ph_bsize, SEEK_SET);
-        return sys_fread(buf, bdev->bdif->ph_bsize * blk_cnt, &rdcnt, hdl->dev);
+        return sys_bread(buf, bdev->bdif->ph_bsize * blk_cnt,
+                         blk_id * bdev->bdif->ph_bsize, &rdcnt, hdl->dev);
 }
 
 //==============================================================================
@@ -869,8 +1025,27 @@ static int bwrite(struct ext4_blockdev *bdev, const void *buf, uint64_t blk_id,
         ext4fs_t *hdl = bdev->bdif->p_user;
 
         size_t wrcnt = 0;
-        sys_fseek(hdl->dev, blk_id * bdev->bdif->ph_bsize, SEEK_SET);
-        return sys_fwrite(buf, bdev->bdif->ph_bsize * blk_cnt, &wrcnt, hdl->dev);
+        return sys_bwrite(buf, bdev->bdif->ph_bsize * blk_cnt,
+                          blk_id * bdev->bdif->ph_bsize, &wrcnt, hdl->dev);
+}
+
+//==============================================================================
+/**
+ * @brief  Function discard selected blocks (TRIM).
+ *
+ * @param  bdev         block device.
+ * @param  blk_id       block ID (start block).
+ * @param  blk_cnt      number of blocks to discard.
+ *
+ * @return One of errno value (errno.h).
+ */
+//==============================================================================
+static int bdiscard(struct ext4_blockdev *bdev, uint64_t blk_id, uint64_t blk_cnt)
+{
+        ext4fs_t *hdl = bdev->bdif->p_user;
+
+        return sys_bdiscard(blk_id * bdev->bdif->ph_bsize,
+                            blk_cnt * bdev->bdif->ph_bsize, hdl->dev);
 }
 
 //==============================================================================
@@ -84,6 +84,9 @@ typedef struct ext4_file {
 
 	/**@brief   Actual file position.*/
 	uint64_t fpos;
+
+	/**@brief   Sequence number of transaction which modified the file.*/
+	uint64_t trans_seq;
 } ext4_file;
 
 /*****************************DIRECTORY DESCRIPTOR***************************/
@@ -153,6 +156,24 @@ int ext4_journal_start(struct ext4_mountpoint *mount_point);
  * @return  Standard error code. */
 int ext4_journal_stop(struct ext4_mountpoint *mount_point);
 
+/**@brief   Group commit mode. Operations are collected in a single running
+ *          transaction which is committed at commit point
+ *          (@ref ext4_cache_flush, @ref ext4_fsync) or when the number
+ *          of its dirty blocks reaches the limit.
+ *
+ * @param   mount_pount Mount point.
+ * @param   max_blocks  Dirty blocks limit, 0: commit every operation.
+ *
+ * @return  Standard error code. */
+int ext4_journal_group(struct ext4_mountpoint *mp, uint32_t max_blocks);
+
+/**@brief   Number of dirty blocks of running (not committed) transaction.
+ *
+ * @param   mount_pount Mount point.
+ *
+ * @return  Number of blocks. */
+uint32_t ext4_journal_pending(struct ext4_mountpoint *mp);
+
 /**@brief   Journal recovery.
  * @warning Must be called after @ref ext4_mount.
  *
@@ -240,13 +261,21 @@ int ext4_get_sblock(struct ext4_mountpoint *mount_point, struct ext4_sblock **sb
 int ext4_cache_write_back(bool on, struct ext4_mountpoint *mp);
 
 
-/**@brief   Force cache flush.
+/**@brief   Force cache flush. Running transaction is committed before.
  *
  * @param   mount_pount Mount point.
  *
  * @return  Standard error code. */
 int ext4_cache_flush(struct ext4_mountpoint *mp);
 
+/**@brief   Check if mount point has data to write: dirty cached blocks or
+ *          operations of running transaction.
+ *
+ * @param   mount_pount Mount point.
+ *
+ * @return  True if data are not written to the block device. */
+bool ext4_cache_dirty(struct ext4_mountpoint *mp);
+
 /********************************FILE OPERATIONS*****************************/
 
 /**@brief   Remove file by path.
@@ -308,6 +337,15 @@ int ext4_fopen2(ext4_file *file, const char *path, int flags, struct ext4_mountp
  * @return  Standard error code.*/
 int ext4_fclose(ext4_file *file);
 
+/**@brief   File synchronization. Nothing is written when the file was not
+ *          modified after the last commit point, otherwise the running
+ *          transaction is committed and the cache is flushed.
+ *
+ * @param   file File handle.
+ *
+ * @return  Standard error code.*/
+int ext4_fsync(ext4_file *file);
+
 
 /**@brief   File truncate function.
  *
@@ -317,6 +355,28 @@ int ext4_fclose(ext4_file *file);
  * @return  Standard error code.*/
 int ext4_ftruncate(ext4_file *file, uint64_t size);
 
+/**@brief   Discard free blocks of the filesystem (TRIM).
+ *
+ * @param   mp      Mount point.
+ * @param   min_len Minimal length of discarded free run (bytes).
+ * @param   trimmed Number of discarded bytes.
+ *
+ * @return  Standard error code.*/
+int ext4_trim(struct ext4_mountpoint *mp, uint64_t min_len,
+	      uint64_t *trimmed);
+
+/**@brief   File space preallocation function. Data blocks of the given
+ *          range are allocated (as contiguous as possible) and the file
+ *          size is extended to the end of the range. Contents of newly
+ *          allocated blocks are not initialized.
+ *
+ * @param   file   File handle.
+ * @param   offset Start of the range.
+ * @param   len    Length of the range.
+ *
+ * @return  Standard error code.*/
+int ext4_fallocate(ext4_file *file, uint64_t offset, uint64_t len);
+
 /**@brief   Read data from file.
  *
  * @param   file File handle.
@@ -110,6 +110,22 @@ int ext4_balloc_alloc_block(struct ext4_inode_ref *inode_ref,
 int ext4_balloc_try_alloc_block(struct ext4_inode_ref *inode_ref,
 				ext4_fsblk_t baddr, bool *free);
 
+/**@brief   Discard or drop blocks freed by the current transaction.
+ *          Freed blocks must not be discarded before the transaction is
+ *          committed, because the journal recovery can bring them back.
+ * @param   fs filesystem descriptor
+ * @param   commit true: discard blocks (transaction committed),
+ *                 false: forget blocks (transaction aborted)*/
+void ext4_balloc_discard_flush(struct ext4_fs *fs, bool commit);
+
+/**@brief   Discard all free block runs of the filesystem.
+ * @param   fs filesystem descriptor
+ * @param   min_blocks minimal length of discarded run
+ * @param   trimmed number of discarded blocks
+ * @return  standard error code*/
+int ext4_balloc_trim(struct ext4_fs *fs, uint32_t min_blocks,
+		     uint64_t *trimmed);
+
 #ifdef __cplusplus
 }
 #endif
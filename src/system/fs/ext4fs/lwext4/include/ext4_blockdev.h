@@ -80,6 +80,14 @@ struct ext4_blockdev_iface {
 	 * @param   bdev block device.*/
 	int (*unlock)(struct ext4_blockdev *bdev);
 
+	/**@brief   Block discard (TRIM) function. Informs device that data of
+	 *          blocks is not used anymore. Not mandatory field.
+	 * @param   bdev block device
+	 * @param   blk_id block id
+	 * @param   blk_cnt block count*/
+	int (*discard)(struct ext4_blockdev *bdev, uint64_t blk_id,
+		       uint64_t blk_cnt);
+
 	/**@brief   Block size (bytes): physical*/
 	uint32_t ph_bsize;
 
@@ -227,6 +235,14 @@ int ext4_blocks_get_direct(struct ext4_blockdev *bdev, void *buf, uint64_t lba,
 int ext4_blocks_set_direct(struct ext4_blockdev *bdev, const void *buf,
 			   uint64_t lba, uint32_t cnt);
 
+/**@brief   Block discard procedure (without cache)
+ * @param   bdev block device descriptor
+ * @param   lba logical block address
+ * @param   cnt block count
+ * @return  standard error code, ENOTSUP if device does not support discard*/
+int ext4_blocks_discard(struct ext4_blockdev *bdev, uint64_t lba,
+			uint64_t cnt);
+
 /**@brief   Write to block device (by direct address).
  * @param   bdev block device descriptor
  * @param   off byte offset in block device
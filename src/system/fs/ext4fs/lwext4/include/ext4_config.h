@@ -160,6 +160,12 @@ extern "C" {
 #endif
 
 
+/**@brief Number of freed block ranges which are discarded after transaction
+ *        commit. Value 0 disables discard of freed blocks*/
+#ifndef CONFIG_DISCARD_RANGES
+#define CONFIG_DISCARD_RANGES (__EXT4FS_CFG_DISCARD__ ? 8 : 0)
+#endif
+
 /**@brief Unaligned access switch on/off*/
 #ifndef CONFIG_UNALIGNED_ACCESS
 #define CONFIG_UNALIGNED_ACCESS 0
@@ -67,6 +67,15 @@ struct ext4_fs {
 	struct jbd_fs *jbd_fs;
 	struct jbd_journal *jbd_journal;
 	struct jbd_trans *curr_trans;
+
+#if CONFIG_DISCARD_RANGES
+	/**@brief Blocks freed by current transaction, discarded on commit*/
+	struct {
+		ext4_fsblk_t first;
+		uint32_t count;
+	} discard[CONFIG_DISCARD_RANGES];
+	uint32_t discard_cnt;
+#endif
 };
 
 struct ext4_block_group_ref {
@@ -52,6 +52,8 @@
 #include <ext4_dir_idx.h>
 #include <ext4_xattr.h>
 #include <ext4_journal.h>
+#include <ext4_extent.h>
+#include <ext4_balloc.h>
 
 
 #include <stdlib.h>
@@ -95,6 +97,21 @@ struct ext4_mountpoint {
 	/**@brief   Block cache.*/
 	struct ext4_bcache bc;
 
+	/**@brief   Dirty blocks limit of grouped transaction. Transaction is
+	 *          kept running after operation until commit point
+	 *          (@ref ext4_cache_flush) or until the limit is reached.
+	 *          0: every operation is committed.*/
+	uint32_t trans_max_blocks;
+
+	/**@brief   Number of operations in running transaction.*/
+	uint32_t trans_ops;
+
+	/**@brief   Sequence number of running transaction.*/
+	uint64_t trans_seq;
+
+	/**@brief   Changes older than this sequence are on the device.*/
+	uint64_t stable_seq;
+
 	/**@brief   User pointer.*/
 	void *user;
 };
@@ -325,6 +342,8 @@ int ext4_mount(struct ext4_blockdev *bdev, struct ext4_mountpoint **mount_point,
 	}
 
 	mp->user = p_user;
+	mp->trans_seq = 1;
+	mp->stable_seq = 1;
 
 	r = ext4_block_init(bd);
 	if (r != EOK)
@@ -538,7 +557,7 @@ Finish:
 }
 
 __unused
-static int __ext4_trans_stop(struct ext4_mountpoint *mp)
+static int __ext4_trans_commit(struct ext4_mountpoint *mp)
 {
 	int r = EOK;
 
@@ -547,18 +566,44 @@ static int __ext4_trans_stop(struct ext4_mountpoint *mp)
 		struct jbd_trans *trans = mp->fs.curr_trans;
 		r = jbd_journal_commit_trans(journal, trans);
 		mp->fs.curr_trans = NULL;
+		mp->trans_ops = 0;
+		mp->trans_seq++;
+		ext4_balloc_discard_flush(&mp->fs, r == EOK);
 	}
 	return r;
 }
 
+__unused
+static int __ext4_trans_stop(struct ext4_mountpoint *mp)
+{
+	if (mp->fs.jbd_journal && mp->fs.curr_trans) {
+		/*Grouped transaction is kept running until commit point*/
+		if (mp->fs.curr_trans->data_cnt < (int)mp->trans_max_blocks) {
+			mp->trans_ops++;
+			return EOK;
+		}
+	}
+
+	return __ext4_trans_commit(mp);
+}
+
 __unused
 static void __ext4_trans_abort(struct ext4_mountpoint *mp)
 {
 	if (mp->fs.jbd_journal && mp->fs.curr_trans) {
+		/*Operations completed before in the grouped transaction can
+		 * not be dropped, so the transaction is committed including
+		 * changes of the failed operation (as without journal).*/
+		if (mp->trans_ops) {
+			__ext4_trans_commit(mp);
+			return;
+		}
+
 		struct jbd_journal *journal = mp->fs.jbd_journal;
 		struct jbd_trans *trans = mp->fs.curr_trans;
 		jbd_journal_free_trans(journal, trans, true);
 		mp->fs.curr_trans = NULL;
+		ext4_balloc_discard_flush(&mp->fs, false);
 	}
 }
 
@@ -575,11 +620,46 @@ int ext4_journal_stop(struct ext4_mountpoint *mount_point __unused)
 {
 	int r = EOK;
 #if CONFIG_JOURNALING_ENABLE
+	if (mount_point)
+		__ext4_trans_commit(mount_point);
+
 	r = __ext4_journal_stop(mount_point);
 #endif
 	return r;
 }
 
+int ext4_journal_group(struct ext4_mountpoint *mp __unused,
+		       uint32_t max_blocks __unused)
+{
+	int r = EOK;
+#if CONFIG_JOURNALING_ENABLE
+	if (!mp)
+		return ENOENT;
+
+	EXT4_MP_LOCK(mp);
+	mp->trans_max_blocks = max_blocks;
+	if (!max_blocks)
+		r = __ext4_trans_commit(mp);
+	EXT4_MP_UNLOCK(mp);
+#endif
+	return r;
+}
+
+uint32_t ext4_journal_pending(struct ext4_mountpoint *mp __unused)
+{
+	uint32_t blocks = 0;
+#if CONFIG_JOURNALING_ENABLE
+	if (!mp)
+		return 0;
+
+	EXT4_MP_LOCK(mp);
+	if (mp->fs.curr_trans)
+		blocks = mp->fs.curr_trans->data_cnt;
+	EXT4_MP_UNLOCK(mp);
+#endif
+	return blocks;
+}
+
 int ext4_recover(struct ext4_mountpoint *mount_point __unused)
 {
 	int r = EOK;
@@ -614,6 +694,32 @@ static void ext4_trans_abort(struct ext4_mountpoint *mp __unused)
 #endif
 }
 
+static int ext4_trans_commit(struct ext4_mountpoint *mp __unused)
+{
+	int r = EOK;
+#if CONFIG_JOURNALING_ENABLE
+	r = __ext4_trans_commit(mp);
+#endif
+	return r;
+}
+
+/**@brief   Commit point: commit running transaction and write all
+ *          delayed blocks to the device.*/
+static int ext4_flush_no_lock(struct ext4_mountpoint *mp)
+{
+	int r = ext4_trans_commit(mp);
+	if (r != EOK)
+		return r;
+
+	r = ext4_block_cache_flush(mp->fs.bdev);
+	if (r != EOK)
+		return r;
+
+	mp->trans_seq++;
+	mp->stable_seq = mp->trans_seq;
+	return EOK;
+}
+
 
 int ext4_mount_point_stats(struct ext4_mountpoint *mp,
 			   struct ext4_mount_stats *stats)
@@ -1311,6 +1417,19 @@ int ext4_cache_write_back(bool on, struct ext4_mountpoint *mp)
 	return ret;
 }
 
+bool ext4_cache_dirty(struct ext4_mountpoint *mp)
+{
+	bool dirty;
+
+	if (!mp)
+		return false;
+
+	EXT4_MP_LOCK(mp);
+	dirty = !SLIST_EMPTY(&mp->bc.dirty_list) || mp->trans_ops;
+	EXT4_MP_UNLOCK(mp);
+	return dirty;
+}
+
 int ext4_cache_flush(struct ext4_mountpoint *mp)
 {
 	int ret;
@@ -1319,11 +1438,25 @@ int ext4_cache_flush(struct ext4_mountpoint *mp)
 		return ENOENT;
 
 	EXT4_MP_LOCK(mp);
-	ret = ext4_block_cache_flush(mp->fs.bdev);
+	ret = ext4_flush_no_lock(mp);
 	EXT4_MP_UNLOCK(mp);
 	return ret;
 }
 
+int ext4_fsync(ext4_file *file)
+{
+	int r = EOK;
+
+	ext4_assert(file && file->mp);
+
+	EXT4_MP_LOCK(file->mp);
+	if (file->trans_seq >= file->mp->stable_seq)
+		r = ext4_flush_no_lock(file->mp);
+	EXT4_MP_UNLOCK(file->mp);
+
+	return r;
+}
+
 int ext4_fremove(const char *path, struct ext4_mountpoint *mp)
 {
 	ext4_file f;
@@ -1460,6 +1593,7 @@ int ext4_fopen2(ext4_file *file, const char *path, int flags, struct ext4_mountp
 		ext4_trans_start(mp);
 
 	r = ext4_generic_open2(file, path, flags, filetype, NULL, NULL, mp);
+	file->trans_seq = (flags & (O_CREAT | O_TRUNC)) ? mp->trans_seq : 0;
 
 	if (flags & O_CREAT) {
 		if (r == EOK)
@@ -1544,6 +1678,7 @@ int ext4_ftruncate(ext4_file *f, uint64_t size)
 	EXT4_MP_LOCK(f->mp);
 
 	ext4_trans_start(f->mp);
+	f->trans_seq = f->mp->trans_seq;
 	r = ext4_ftruncate_no_lock(f, size);
 	if (r != EOK)
 		ext4_trans_abort(f->mp);
@@ -1554,6 +1689,112 @@ int ext4_ftruncate(ext4_file *f, uint64_t size)
 	return r;
 }
 
+int ext4_trim(struct ext4_mountpoint *mp, uint64_t min_len,
+	      uint64_t *trimmed)
+{
+	int r;
+	uint32_t block_size;
+	uint64_t min_blocks;
+	uint64_t blocks = 0;
+
+	if (!mp)
+		return ENOENT;
+
+	if (mp->fs.read_only)
+		return EROFS;
+
+	EXT4_MP_LOCK(mp);
+	block_size = ext4_sb_get_block_size(&mp->fs.sb);
+	min_blocks = (min_len + block_size - 1) / block_size;
+	if (min_blocks > UINT32_MAX)
+		min_blocks = UINT32_MAX;
+
+	/*Blocks freed by running transaction must not be discarded*/
+	r = ext4_trans_commit(mp);
+	if (r == EOK)
+		r = ext4_balloc_trim(&mp->fs, (uint32_t)min_blocks, &blocks);
+	*trimmed = blocks * block_size;
+	EXT4_MP_UNLOCK(mp);
+
+	return r;
+}
+
+int ext4_fallocate(ext4_file *file, uint64_t offset, uint64_t len)
+{
+	int r, rr;
+	uint32_t block_size;
+	ext4_lblk_t iblk, iblk_end;
+	struct ext4_inode_ref ref;
+
+	ext4_assert(file && file->mp);
+
+	if (file->mp->fs.read_only)
+		return EROFS;
+
+	if (file->flags & O_RDONLY)
+		return EPERM;
+
+	if (!len)
+		return EINVAL;
+
+	EXT4_MP_LOCK(file->mp);
+	ext4_trans_start(file->mp);
+	file->trans_seq = file->mp->trans_seq;
+
+	struct ext4_fs *const fs = &file->mp->fs;
+	struct ext4_sblock *const sb = &file->mp->fs.sb;
+
+	r = ext4_fs_get_inode_ref(fs, file->inode, &ref);
+	if (r != EOK) {
+		ext4_trans_abort(file->mp);
+		EXT4_MP_UNLOCK(file->mp);
+		return r;
+	}
+
+	block_size = ext4_sb_get_block_size(sb);
+	iblk = (ext4_lblk_t)(offset / block_size);
+	iblk_end = (ext4_lblk_t)((offset + len + block_size - 1) / block_size);
+
+#if CONFIG_EXTENT_ENABLE
+	if (ext4_sb_feature_incom(sb, EXT4_FINCOM_EXTENTS) &&
+	    ext4_inode_has_flag(ref.inode, EXT4_INODE_FLAG_EXTENTS)) {
+		/*Allocate whole free runs, one extent per call*/
+		while (iblk < iblk_end) {
+			uint32_t cnt = 0;
+			r = ext4_extent_get_blocks(&ref, iblk, iblk_end - iblk,
+						   NULL, true, &cnt);
+			if (r != EOK)
+				break;
+
+			iblk += cnt;
+		}
+	} else
+#endif
+	{
+		/*Block mapped files are not supported*/
+		r = ENOTSUP;
+	}
+
+	file->fsize = ext4_inode_get_size(sb, ref.inode);
+	if (r == EOK && offset + len > file->fsize) {
+		file->fsize = offset + len;
+		ext4_inode_set_size(ref.inode, file->fsize);
+		ref.dirty = true;
+	}
+
+	rr = ext4_fs_put_inode_ref(&ref);
+	if (r == EOK)
+		r = rr;
+
+	if (r != EOK)
+		ext4_trans_abort(file->mp);
+	else
+		ext4_trans_stop(file->mp);
+
+	EXT4_MP_UNLOCK(file->mp);
+	return r;
+}
+
 int ext4_fread(ext4_file *file, void *buf, size_t size, size_t *rcnt)
 {
 	uint32_t unalg;
@@ -1742,6 +1983,7 @@ int ext4_fwrite(ext4_file *file, const void *buf, size_t size, size_t *wcnt)
 
 	EXT4_MP_LOCK(file->mp);
 	ext4_trans_start(file->mp);
+	file->trans_seq = file->mp->trans_seq;
 
 	struct ext4_fs *const fs = &file->mp->fs;
 	struct ext4_sblock *const sb = &file->mp->fs.sb;
@@ -2211,6 +2453,8 @@ int ext4_mtime_set(const char *path, ext4_file *file, uint32_t mtime, struct ext
 	        r = ext4_fs_get_inode_ref(&mp->fs, file->inode, &inode_ref);
                 if (r != EOK)
                         goto Finish;
+
+	        file->trans_seq = mp->trans_seq;
 	} else {
 	        r = EINVAL;
 	        goto Finish;
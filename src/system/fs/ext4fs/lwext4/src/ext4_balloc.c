@@ -53,6 +53,107 @@
 #include <ext4_bitmap.h>
 #include <ext4_inode.h>
 
+#if CONFIG_DISCARD_RANGES
+/**@brief Queue freed blocks to be discarded. Blocks are discarded
+ *        immediately when no transaction is running.
+ * @param fs filesystem descriptor
+ * @param first first freed block
+ * @param count number of freed blocks
+ */
+static void ext4_balloc_discard_queue(struct ext4_fs *fs, ext4_fsblk_t first,
+				      uint32_t count)
+{
+	uint32_t i;
+
+	if (!fs->bdev->bdif->discard)
+		return;
+
+	if (!fs->curr_trans) {
+		ext4_blocks_discard(fs->bdev, first, count);
+		return;
+	}
+
+	for (i = 0; i < fs->discard_cnt; i++) {
+		if (fs->discard[i].first + fs->discard[i].count == first) {
+			fs->discard[i].count += count;
+			return;
+		}
+
+		if (first + count == fs->discard[i].first) {
+			fs->discard[i].first = first;
+			fs->discard[i].count += count;
+			return;
+		}
+	}
+
+	/*If there is no free range slot then the blocks are not discarded.
+	 * This is harmless, the discard is only a hint for the device.*/
+	if (fs->discard_cnt < CONFIG_DISCARD_RANGES) {
+		fs->discard[fs->discard_cnt].first = first;
+		fs->discard[fs->discard_cnt].count = count;
+		fs->discard_cnt++;
+	}
+}
+
+/**@brief Remove allocated block from discard queue. The block freed and
+ *        allocated again by the same transaction must not be discarded.
+ * @param fs filesystem descriptor
+ * @param baddr allocated block
+ */
+static void ext4_balloc_discard_cancel(struct ext4_fs *fs, ext4_fsblk_t baddr)
+{
+	uint32_t i;
+
+	for (i = 0; i < fs->discard_cnt; i++) {
+		ext4_fsblk_t first = fs->discard[i].first;
+		ext4_fsblk_t end = first + fs->discard[i].count;
+
+		if (baddr < first || baddr >= end)
+			continue;
+
+		if (baddr == first) {
+			fs->discard[i].first++;
+			fs->discard[i].count--;
+		} else if (baddr == end - 1) {
+			fs->discard[i].count--;
+		} else {
+			fs->discard[i].count = baddr - first;
+
+			if (fs->discard_cnt < CONFIG_DISCARD_RANGES) {
+				fs->discard[fs->discard_cnt].first = baddr + 1;
+				fs->discard[fs->discard_cnt].count =
+					end - baddr - 1;
+				fs->discard_cnt++;
+			}
+		}
+
+		if (fs->discard[i].count == 0)
+			fs->discard[i] = fs->discard[--fs->discard_cnt];
+
+		return;
+	}
+}
+#else
+#define ext4_balloc_discard_queue(fs, first, count)
+#define ext4_balloc_discard_cancel(fs, baddr)
+#endif
+
+void ext4_balloc_discard_flush(struct ext4_fs *fs __unused,
+			       bool commit __unused)
+{
+#if CONFIG_DISCARD_RANGES
+	uint32_t i;
+
+	if (commit) {
+		for (i = 0; i < fs->discard_cnt; i++)
+			ext4_blocks_discard(fs->bdev, fs->discard[i].first,
+					    fs->discard[i].count);
+	}
+
+	fs->discard_cnt = 0;
+#endif
+}
+
 /**@brief Compute number of block group from block address.
  * @param sb superblock pointer.
  * @param baddr Absolute address of block.
@@ -226,6 +327,8 @@ int ext4_balloc_free_block(struct ext4_inode_ref *inode_ref, ext4_fsblk_t baddr)
 	ext4_bcache_invalidate_lba(fs->bdev->bc, baddr, 1);
 	/* Release block group reference */
 	rc = ext4_fs_put_block_group_ref(&bg_ref);
+	if (rc == EOK)
+		ext4_balloc_discard_queue(fs, baddr, 1);
 
 	return rc;
 }
@@ -346,6 +449,8 @@ int ext4_balloc_free_blocks(struct ext4_inode_ref *inode_ref,
 	/*All blocks should be released*/
 	ext4_assert(count == 0);
 
+	ext4_balloc_discard_queue(fs, start_block, blk_cnt);
+
 	return rc;
 }
 
@@ -574,6 +679,8 @@ success:
 	bg_ref.dirty = true;
 	r = ext4_fs_put_block_group_ref(&bg_ref);
 
+	ext4_balloc_discard_cancel(inode_ref->fs, alloc);
+
 	*fblock = alloc;
 	return r;
 }
@@ -656,10 +763,91 @@ int ext4_balloc_try_alloc_block(struct ext4_inode_ref *inode_ref,
 
 	bg_ref.dirty = true;
 
+	ext4_balloc_discard_cancel(fs, baddr);
+
 terminate:
 	return ext4_fs_put_block_group_ref(&bg_ref);
 }
 
+int ext4_balloc_trim(struct ext4_fs *fs, uint32_t min_blocks,
+		     uint64_t *trimmed)
+{
+	int r = EOK;
+	struct ext4_sblock *sb = &fs->sb;
+	uint32_t bg_count = ext4_block_group_cnt(sb);
+	uint32_t bgid;
+
+	*trimmed = 0;
+
+	if (!fs->bdev->bdif->discard)
+		return ENOTSUP;
+
+	if (min_blocks == 0)
+		min_blocks = 1;
+
+	for (bgid = 0; bgid < bg_count; bgid++) {
+		struct ext4_block_group_ref bg_ref;
+		struct ext4_block b;
+
+		r = ext4_fs_get_block_group_ref(fs, bgid, &bg_ref);
+		if (r != EOK)
+			return r;
+
+		struct ext4_bgroup *bg = bg_ref.block_group;
+		if (ext4_bg_get_free_blocks_count(bg, sb) < min_blocks) {
+			ext4_fs_put_block_group_ref(&bg_ref);
+			continue;
+		}
+
+		/* Load block with bitmap */
+		r = ext4_trans_block_get(fs->bdev, &b,
+					 ext4_bg_get_block_bitmap(bg, sb));
+		if (r != EOK) {
+			ext4_fs_put_block_group_ref(&bg_ref);
+			return r;
+		}
+
+		ext4_fsblk_t first_in_bg = ext4_balloc_get_block_of_bgid(sb, bgid);
+		uint32_t idx = ext4_fs_addr_to_idx_bg(sb, first_in_bg);
+		uint32_t blk_in_bg = ext4_blocks_in_group_cnt(sb, bgid);
+		uint32_t start = 0;
+		bool in_run = false;
+
+		/* Find free runs, the index past the last block ends run */
+		for (; idx <= blk_in_bg; idx++) {
+			if (idx < blk_in_bg && ext4_bmap_is_bit_clr(b.data, idx)) {
+				if (!in_run) {
+					start = idx;
+					in_run = true;
+				}
+				continue;
+			}
+
+			if (in_run && (idx - start >= min_blocks)) {
+				ext4_fsblk_t addr;
+				addr = ext4_fs_bg_idx_to_addr(sb, start, bgid);
+				if (ext4_blocks_discard(fs->bdev, addr,
+							idx - start) == EOK)
+					*trimmed += idx - start;
+			}
+
+			in_run = false;
+		}
+
+		r = ext4_block_set(fs->bdev, &b);
+		if (r != EOK) {
+			ext4_fs_put_block_group_ref(&bg_ref);
+			return r;
+		}
+
+		r = ext4_fs_put_block_group_ref(&bg_ref);
+		if (r != EOK)
+			return r;
+	}
+
+	return r;
+}
+
 /**
  * @}
  */
@@ -499,10 +499,37 @@ static ext4_fsblk_t ext4_new_meta_blocks(struct ext4_inode_ref *inode_ref,
 					 uint32_t *count, int *errp)
 {
 	ext4_fsblk_t block = 0;
+	uint32_t n = 1;
 
 	*errp = ext4_allocate_single_block(inode_ref, goal, &block);
+
+	/* Try to grow the run with blocks directly behind the first one so
+	 * that multi-block requests end up in a single extent. */
+	if (*errp == EOK && count) {
+		uint64_t blocks = ext4_sb_get_blocks_cnt(&inode_ref->fs->sb);
+		uint32_t want = *count;
+		bool free = true;
+
+		if (want > EXT_INIT_MAX_LEN)
+			want = EXT_INIT_MAX_LEN;
+
+		while (n < want && block + n < blocks) {
+			*errp = ext4_balloc_try_alloc_block(inode_ref,
+							    block + n, &free);
+			if (*errp != EOK || !free)
+				break;
+			n++;
+		}
+
+		if (*errp != EOK) {
+			ext4_balloc_free_blocks(inode_ref, block, n);
+			block = 0;
+			n = 0;
+		}
+	}
+
 	if (count)
-		*count = 1;
+		*count = n;
 	return block;
 }
 
@@ -37,6 +37,15 @@
 ==============================================================================*/
 #define MUTEX_TIMEOUT   5000
 
+/** file status flags of libfat: file modified and file buffer not written */
+#define FIL_UNSYNCED    (0x40 | 0x80)
+
+/** minimal file size [clusters] for which cluster link map is created */
+#define CLMT_MIN_CLUSTERS       8
+
+/** number of spare fragments in created cluster link map */
+#define CLMT_SPARE_FRAGMENTS    4
+
 /*==============================================================================
   Local types, enums definitions
 ==============================================================================*/
@@ -45,6 +54,14 @@ struct fatdir {
         char name[(FF_MAX_LFN + 1) * sizeof(TCHAR)];
 };
 
+struct fatfile {
+        FIL      fil;
+        DWORD   *clmt;                  //!< cluster link map table (fast seek)
+        size_t   clmt_size;             //!< number of table items
+        DWORD    clmt_clusters;         //!< number of clusters mapped by table
+        bool     clmt_denied;           //!< table not created (budget exceeded)
+};
+
 struct fatfs {
         FILE    *fsfile;
         FATFS    fatfs;
@@ -52,6 +69,9 @@ struct fatfs {
         mutex_t *mutex;
         int      opened_dirs;
         bool     read_only;
+        bool     fast_seek;
+        size_t   clmt_budget;
+        size_t   clmt_used;
 };
 
 /*==============================================================================
@@ -60,6 +80,12 @@ struct fatfs {
 static int    faterr_2_errno(FRESULT fresult);
 static time_t time_fat2unix(uint32_t fattime);
 static int    cmp_ptr(const void *a, const void *b);
+static void   clmt_create(struct fatfs *hdl, struct fatfile *file);
+static void   clmt_delete(struct fatfs *hdl, struct fatfile *file);
+static int    clmt_append(struct fatfs *hdl, struct fatfile *file, DWORD clust);
+static int    write_extend(struct fatfs *hdl, struct fatfile *file, const u8_t *src, size_t count, size_t *wrcnt);
+static int    fallocate(struct fatfs *hdl, struct fatfile *file, const struct vfs_fallocate *range);
+static int    fstrim(struct fatfs *hdl, struct vfs_fstrim *fstrim);
 
 /*==============================================================================
   Local object definitions
@@ -77,6 +103,12 @@ static int    cmp_ptr(const void *a, const void *b);
 /**
  * @brief Initialize file system
  *
+ * Supported options:
+ * @arg ro              read only file system
+ * @arg fastseek        enable fast seek: cluster link map is created on first
+ *                      seek in large files
+ * @arg clmt=<bytes>    memory budget of all cluster link maps
+ *
  * @param[out]          **fs_handle             file system allocated memory
  * @param[in ]           *src_path              file source path
  * @param[in ]           *opts                  file system options (can be NULL)
@@ -86,13 +118,13 @@ static int    cmp_ptr(const void *a, const void *b);
 //==============================================================================
 API_FS_INIT(fatfs, void **fs_handle, const char *src_path, const char *opts)
 {
-        UNUSED_ARG1(opts);
-
         int err = sys_zalloc(sizeof(struct fatfs), fs_handle);
         if (!err) {
                 struct fatfs *hdl = *fs_handle;
 
-                hdl->read_only = sys_stropt_is_flag(opts, "ro");
+                hdl->read_only   = sys_stropt_is_flag(opts, "ro");
+                hdl->fast_seek   = sys_stropt_is_flag(opts, "fastseek");
+                hdl->clmt_budget = max(0, sys_stropt_get_int(opts, "clmt", __FATFS_CLMT_BUDGET__));
 
                 err = sys_llist_create(cmp_ptr, NULL, &hdl->file_list);
 
@@ -179,12 +211,12 @@ API_FS_OPEN(fatfs, void *fs_handle, void **fhdl, fpos_t *fpos, const char *path,
 {
         struct fatfs *hdl = fs_handle;
 
-        int err = sys_zalloc(sizeof(FIL), fhdl);
+        int err = sys_zalloc(sizeof(struct fatfile), fhdl);
         if (err) {
                 return err;
         }
 
-        FIL *fat_file = *fhdl;
+        FIL *fat_file = &cast(struct fatfile*, *fhdl)->fil;
 
         u8_t fat_mode = 0;
 
@@ -258,7 +290,8 @@ API_FS_CLOSE(fatfs, void *fs_handle, void *fhdl, bool force)
 
         struct fatfs *hdl = fs_handle;
 
-        FIL *fatfile = fhdl;
+        struct fatfile *file    = fhdl;
+        FIL            *fatfile = &file->fil;
 
         int err = sys_mutex_lock(hdl->mutex, MUTEX_TIMEOUT);
         if (!err) {
@@ -266,6 +299,7 @@ API_FS_CLOSE(fatfs, void *fs_handle, void *fhdl, bool force)
                 if (!err or hdl->read_only) {
                         int pos = sys_llist_find_begin(hdl->file_list, fatfile);
                         sys_llist_take(hdl->file_list, pos);
+                        clmt_delete(hdl, file);
                         sys_free(&fhdl);
                         err = 0;
                 }
@@ -302,22 +336,35 @@ API_FS_WRITE(fatfs,
 {
         UNUSED_ARG1(fattr);
 
-        struct fatfs *hdl = fs_handle;
-        FIL *fat_file = fhdl;
-        int  err      = EROFS;
+        struct fatfs   *hdl      = fs_handle;
+        struct fatfile *file     = fhdl;
+        FIL            *fat_file = &file->fil;
+        int             err      = EROFS;
 
         if (not hdl->read_only) {
+                /* fast seek can not move file pointer behind end of file */
+                if (file->clmt && (*fpos > f_size(fat_file))) {
+                        clmt_delete(hdl, file);
+                }
+
                 if (f_tell(fat_file) != (u32_t)*fpos) {
+                        clmt_create(hdl, file);
                         err = faterr_2_errno(f_lseek(fat_file, (u32_t)*fpos));
                 } else {
                         err = ESUCC;
                 }
 
                 if (!err) {
-                        uint n = 0;
-                        err = faterr_2_errno(f_write(fat_file, src, count, &n));
-                        if (!err) {
-                                *wrcnt = n;
+                        DWORD bcs = cast(DWORD, hdl->fatfs.csize) * FF_MIN_SS;
+
+                        if (file->clmt && (*fpos + count > cast(u64_t, file->clmt_clusters) * bcs)) {
+                                err = write_extend(hdl, file, src, count, wrcnt);
+                        } else {
+                                uint n = 0;
+                                err = faterr_2_errno(f_write(fat_file, src, count, &n));
+                                if (!err) {
+                                        *wrcnt = n;
+                                }
                         }
                 }
         }
@@ -349,12 +396,15 @@ API_FS_READ(fatfs,
             size_t          *rdcnt,
             struct vfs_fattr fattr)
 {
-        UNUSED_ARG2(fs_handle, fattr);
+        UNUSED_ARG1(fattr);
 
-        FIL *fat_file = fhdl;
-        int  err      = ESUCC;
+        struct fatfs   *hdl      = fs_handle;
+        struct fatfile *file     = fhdl;
+        FIL            *fat_file = &file->fil;
+        int             err      = ESUCC;
 
         if (f_tell(fat_file) != (u32_t)*fpos) {
+                clmt_create(hdl, file);
                 err = faterr_2_errno(f_lseek(fat_file, (u32_t)*fpos));
         }
 
@@ -383,12 +433,27 @@ API_FS_READ(fatfs,
 //==============================================================================
 API_FS_IOCTL(fatfs, void *fs_handle, void *fhdl, int request, void *arg)
 {
-        UNUSED_ARG1(fs_handle);
-        UNUSED_ARG1(fhdl);
-        UNUSED_ARG1(request);
-        UNUSED_ARG1(arg);
+        struct fatfs   *hdl  = fs_handle;
+        struct fatfile *file = fhdl;
 
-        return ENOTSUP;
+        switch (request) {
+        case IOCTL_VFS__FALLOCATE:
+                if (hdl->read_only) {
+                        return EROFS;
+                } else {
+                        return fallocate(hdl, file, arg);
+                }
+
+        case IOCTL_VFS__FSTRIM:
+                if (hdl->read_only) {
+                        return EROFS;
+                } else {
+                        return fstrim(hdl, arg);
+                }
+
+        default:
+                return ENOTSUP;
+        }
 }
 
 //==============================================================================
@@ -405,7 +470,7 @@ API_FS_FLUSH(fatfs, void *fs_handle, void *fhdl)
 {
         UNUSED_ARG1(fs_handle);
 
-        FIL *fat_file = fhdl;
+        FIL *fat_file = &cast(struct fatfile*, fhdl)->fil;
         return faterr_2_errno(f_sync(fat_file));
 }
 
@@ -687,7 +752,7 @@ API_FS_FSTAT(fatfs, void *fs_handle, void *fhdl, struct stat *stat)
 {
         UNUSED_ARG1(fs_handle);
 
-        FIL *fat_file = fhdl;
+        FIL *fat_file = &cast(struct fatfile*, fhdl)->fil;
 
         stat->st_dev   = 0;
         stat->st_gid   = 0;
@@ -804,12 +869,50 @@ API_FS_SYNC(fatfs, void *fs_handle)
                         sys_mutex_unlock(hdl->mutex);
                 }
 
+                if (!err) {
+                        err = sys_bsync(hdl->fsfile);
+                }
+
                 return err;
         } else {
                 return ESUCC;
         }
 }
 
+//==============================================================================
+/**
+ * @brief Check if file system has data to synchronize. Function does not wait
+ *        for the file system; busy file system is reported as modified.
+ *
+ * @param[in ]          *fs_handle              file system allocated memory
+ *
+ * @return True if file system is modified, otherwise false.
+ */
+//==============================================================================
+API_FS_DIRTY(fatfs, void *fs_handle)
+{
+        struct fatfs *hdl = fs_handle;
+
+        if (hdl->read_only) {
+                return false;
+        }
+
+        bool dirty = true;
+
+        if (sys_mutex_lock(hdl->mutex, 0) == ESUCC) {
+
+                dirty = hdl->fatfs.wflag || (hdl->fatfs.fsi_flag == 1);
+
+                sys_llist_foreach(FIL*, f, hdl->file_list) {
+                        dirty = dirty || (f->flag & FIL_UNSYNCED);
+                }
+
+                sys_mutex_unlock(hdl->mutex);
+        }
+
+        return dirty || sys_bdirty(hdl->fsfile);
+}
+
 //==============================================================================
 /**
  * @brief Function handle libfat errors and translate to errno
@@ -890,6 +993,275 @@ static int cmp_ptr(const void *a, const void *b)
         }
 }
 
+//==============================================================================
+/**
+ * @brief  Function create cluster link map table of file (fast seek). Table
+ *         is created only if fast seek is enabled, file is large enough and
+ *         memory budget of file system is not exceeded.
+ *
+ * @param  hdl          file system handle
+ * @param  file         file
+ */
+//==============================================================================
+static void clmt_create(struct fatfs *hdl, struct fatfile *file)
+{
+        FIL  *fp  = &file->fil;
+        DWORD bcs = cast(DWORD, hdl->fatfs.csize) * FF_MIN_SS;
+
+        if (  !hdl->fast_seek || file->clmt || file->clmt_denied
+           || (f_size(fp) < cast(FSIZE_t, CLMT_MIN_CLUSTERS) * bcs) ) {
+                return;
+        }
+
+        /* calculate required table size */
+        DWORD probe[4] = {ARRAY_SIZE(probe)};
+        fp->cltbl = probe;
+        FRESULT fr = f_lseek(fp, CREATE_LINKMAP);
+        fp->cltbl = NULL;
+
+        if ((fr != FR_OK) && (fr != FR_NOT_ENOUGH_CORE)) {
+                return;
+        }
+
+        size_t size  = probe[0] + (2 * CLMT_SPARE_FRAGMENTS);
+        size_t bytes = size * sizeof(DWORD);
+        bool   fit   = false;
+
+        sys_critical_section_begin();
+        if (hdl->clmt_used + bytes <= hdl->clmt_budget) {
+                hdl->clmt_used += bytes;
+                fit = true;
+        }
+        sys_critical_section_end();
+
+        if (!fit || sys_zalloc(bytes, cast(void**, &file->clmt)) != ESUCC) {
+                if (fit) {
+                        sys_critical_section_begin();
+                        hdl->clmt_used -= bytes;
+                        sys_critical_section_end();
+                }
+
+                file->clmt_denied = true;
+                return;
+        }
+
+        file->clmt[0]   = size;
+        file->clmt_size = size;
+        fp->cltbl       = file->clmt;
+
+        if (f_lseek(fp, CREATE_LINKMAP) == FR_OK) {
+                file->clmt_clusters = 0;
+                for (DWORD i = 1; file->clmt[i]; i += 2) {
+                        file->clmt_clusters += file->clmt[i];
+                }
+        } else {
+                clmt_delete(hdl, file);
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function delete cluster link map table of file (fast seek disabled).
+ *
+ * @param  hdl          file system handle
+ * @param  file         file
+ */
+//==============================================================================
+static void clmt_delete(struct fatfs *hdl, struct fatfile *file)
+{
+        if (file->clmt) {
+                file->fil.cltbl = NULL;
+
+                sys_free(cast(void**, &file->clmt));
+
+                sys_critical_section_begin();
+                hdl->clmt_used -= file->clmt_size * sizeof(DWORD);
+                sys_critical_section_end();
+
+                file->clmt_size     = 0;
+                file->clmt_clusters = 0;
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function append cluster to the cluster link map table. Cluster
+ *         adjacent to the last fragment enlarges the fragment, otherwise new
+ *         fragment is added to the spare table space.
+ *
+ * @param  hdl          file system handle
+ * @param  file         file
+ * @param  clust        appended cluster
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+static int clmt_append(struct fatfs *hdl, struct fatfile *file, DWORD clust)
+{
+        UNUSED_ARG1(hdl);
+
+        DWORD *tbl  = file->clmt;
+        DWORD  ulen = tbl[0];
+
+        if ((ulen > 2) && (tbl[ulen - 2] + tbl[ulen - 3] == clust)) {
+                tbl[ulen - 3]++;
+
+        } else if (ulen + 2 <= file->clmt_size) {
+                tbl[ulen - 1] = 1;
+                tbl[ulen + 0] = clust;
+                tbl[ulen + 1] = 0;
+                tbl[0]        = ulen + 2;
+
+        } else {
+                return ENOMEM;
+        }
+
+        file->clmt_clusters++;
+
+        return ESUCC;
+}
+
+//==============================================================================
+/**
+ * @brief  Function write data that enlarge file with cluster link map. FatFs
+ *         can not allocate clusters in fast seek mode, so data is written in
+ *         normal mode cluster by cluster, and each allocated cluster is
+ *         appended to the table. If table is full then the table is deleted
+ *         and is created again on next seek.
+ *
+ * @param  hdl          file system handle
+ * @param  file         file
+ * @param  src          data source
+ * @param  count        number of bytes to write
+ * @param  wrcnt        number of written bytes
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+static int write_extend(struct fatfs *hdl, struct fatfile *file,
+                        const u8_t *src, size_t count, size_t *wrcnt)
+{
+        FIL  *fp  = &file->fil;
+        DWORD bcs = cast(DWORD, hdl->fatfs.csize) * FF_MIN_SS;
+        int   err = ESUCC;
+
+        *wrcnt    = 0;
+        fp->cltbl = NULL;
+
+        while (!err && count) {
+                size_t chunk = min(count, bcs - (f_tell(fp) % bcs));
+
+                uint n = 0;
+                err = faterr_2_errno(f_write(fp, src, chunk, &n));
+                if (err) {
+                        break;
+                }
+
+                *wrcnt += n;
+                src    += n;
+                count  -= n;
+
+                if (  file->clmt && (f_tell(fp) > 0)
+                   && (((f_tell(fp) - 1) / bcs) == file->clmt_clusters) ) {
+
+                        if (clmt_append(hdl, file, fp->clust) != ESUCC) {
+                                clmt_delete(hdl, file);
+                        }
+                }
+
+                if (n < chunk) {
+                        break;
+                }
+        }
+
+        fp->cltbl = file->clmt;
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function reserves space of file. An empty file gets a contiguous
+ *         cluster chain (f_expand()), so the file can be written later without
+ *         any FAT update. A non-empty file is extended by cluster chain
+ *         allocation (seek behind end of file).
+ *
+ * @param  hdl          file system handle
+ * @param  file         file
+ * @param  range        range to reserve
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+static int fallocate(struct fatfs *hdl, struct fatfile *file,
+                     const struct vfs_fallocate *range)
+{
+        FIL *fp  = &file->fil;
+        u64_t end = cast(u64_t, range->offset) + cast(u64_t, range->len);
+
+        if (end > 0xFFFFFFFFUL) {
+                return EFBIG;
+        }
+
+        if (end <= f_size(fp)) {
+                return ESUCC;
+        }
+
+        int err;
+
+        if (f_size(fp) == 0) {
+                FRESULT fr = f_expand(fp, cast(FSIZE_t, end), 1);
+                err = (fr == FR_DENIED) ? ENOSPC : faterr_2_errno(fr);
+
+        } else {
+                FSIZE_t fpos = f_tell(fp);
+
+                /* fast seek can not move file pointer behind end of file */
+                clmt_delete(hdl, file);
+
+                err = faterr_2_errno(f_lseek(fp, cast(FSIZE_t, end)));
+                if (!err && (f_tell(fp) != end)) {
+                        err = ENOSPC;
+                }
+
+                f_lseek(fp, fpos);
+        }
+
+        if (!err) {
+                err = faterr_2_errno(f_sync(fp));
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function discards all free cluster runs of the volume.
+ *
+ * @param  hdl          file system handle
+ * @param  fstrim       request (minimal run length and discarded bytes)
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+static int fstrim(struct fatfs *hdl, struct vfs_fstrim *fstrim)
+{
+#if FF_USE_TRIM
+        u64_t csize    = cast(u64_t, hdl->fatfs.csize) * FF_MIN_SS;
+        u64_t min_clst = (csize > 0) ? (fstrim->min_len + csize - 1) / csize : 1;
+        LBA_t nsect    = 0;
+
+        int err = faterr_2_errno(f_trim(&hdl->fatfs, min(min_clst, 0xFFFFFFFFULL), &nsect));
+
+        fstrim->trimmed = cast(u64_t, nsect) * FF_MIN_SS;
+
+        return err;
+#else
+        UNUSED_ARG2(hdl, fstrim);
+        return ENOTSUP;
+#endif
+}
+
 /*==============================================================================
   End of file
 ==============================================================================*/
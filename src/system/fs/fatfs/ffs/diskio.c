@@ -55,9 +55,9 @@ DRESULT disk_read (
 	UINT count		/* Number of sectors to read */
 )
 {
-        size_t rdcnt = 0;
-        sys_fseek(pdrv, sector * FF_MIN_SS, SEEK_SET);
-        return sys_fread(buff, count * FF_MIN_SS, &rdcnt, pdrv) == ESUCC ?
+        size_t rdcnt  = 0;
+        i64_t  offset = cast(i64_t, sector) * FF_MIN_SS;
+        return sys_bread(buff, count * FF_MIN_SS, offset, &rdcnt, pdrv) == ESUCC ?
                          RES_OK : RES_ERROR;
 }
 
@@ -76,9 +76,9 @@ DRESULT disk_write (
 	UINT count			/* Number of sectors to write */
 )
 {
-        size_t wrcnt = 0;
-        sys_fseek(pdrv, sector * FF_MIN_SS, SEEK_SET);
-        return sys_fwrite(buff, count * FF_MIN_SS, &wrcnt, pdrv) == ESUCC ?
+        size_t wrcnt  = 0;
+        i64_t  offset = cast(i64_t, sector) * FF_MIN_SS;
+        return sys_bwrite(buff, count * FF_MIN_SS, offset, &wrcnt, pdrv) == ESUCC ?
                           RES_OK : RES_ERROR;
 }
 
@@ -95,7 +95,21 @@ DRESULT disk_ioctl (
 	void *buff		/* Buffer to send/receive control data */
 )
 {
-        UNUSED_ARG3(pdrv, cmd, buff);
+        UNUSED_ARG1(buff);
+
+        if (cmd == CTRL_SYNC) {
+                return sys_bsync(pdrv) == ESUCC ? RES_OK : RES_ERROR;
+        }
+
+#if FF_USE_TRIM
+        if (cmd == CTRL_TRIM) {
+                /* buff contains inclusive sector range */
+                LBA_t *range = buff;
+                u64_t  first = cast(u64_t, range[0]) * FF_MIN_SS;
+                u64_t  size  = cast(u64_t, range[1] - range[0] + 1) * FF_MIN_SS;
+                return sys_bdiscard(first, size, pdrv) == ESUCC ? RES_OK : RES_ERROR;
+        }
+#endif
 
         return RES_OK;
 }
@@ -4855,6 +4855,67 @@ FRESULT f_getfree (
 
 
 
+#if !FF_FS_READONLY && FF_USE_TRIM
+/*-----------------------------------------------------------------------*/
+/* Discard Free Clusters                                                 */
+/*-----------------------------------------------------------------------*/
+
+FRESULT f_trim (
+        FATFS* fs,
+	DWORD min_clst,		/* Minimum number of contiguous free clusters to be discarded */
+	LBA_t* nsect		/* Pointer to a variable to return number of discarded sectors */
+)
+{
+	FRESULT res;
+	DWORD clst, scl, stat;
+	LBA_t rt[2];
+	FFOBJID obj;
+
+
+	*nsect = 0;
+	if (min_clst == 0) min_clst = 1;
+
+	res = mount_volume(fs, FA_WRITE);	/* The volume is kept locked, so no cluster is allocated during the scan */
+	if (res == FR_OK) {
+		obj.fs = fs; obj.stat = 0;
+		scl = 0;
+		for (clst = 2; clst <= fs->n_fatent; clst++) {
+			stat = 1;					/* The cluster past the last one terminates the free run */
+			if (clst < fs->n_fatent) {
+#if FF_FS_EXFAT
+				if (fs->fs_type == FS_EXFAT) {	/* exFAT: Get cluster status from the allocation bitmap */
+					res = move_window(fs, fs->bitbase + (clst - 2) / 8 / SS(fs));
+					if (res != FR_OK) break;
+					stat = (fs->win[(clst - 2) / 8 % SS(fs)] >> ((clst - 2) % 8)) & 1;
+				} else
+#endif
+				{							/* FAT12/16/32: Get cluster status from the FAT */
+					stat = get_fat(&obj, clst);
+					if (stat == 0xFFFFFFFF) { res = FR_DISK_ERR; break; }
+					if (stat == 1) { res = FR_INT_ERR; break; }
+				}
+			}
+			if (stat == 0) {			/* Free cluster: extend the run */
+				if (scl == 0) scl = clst;
+			} else if (scl != 0) {		/* End of free run */
+				if (clst - scl >= min_clst) {
+					rt[0] = clst2sect(fs, scl);
+					rt[1] = clst2sect(fs, clst - 1) + fs->csize - 1;
+					if (disk_ioctl(fs->pdrv, CTRL_TRIM, rt) == RES_OK) {
+						*nsect += rt[1] - rt[0] + 1;
+					}
+				}
+				scl = 0;
+			}
+		}
+	}
+
+	LEAVE_FF(fs, res);
+}
+
+#endif /* !FF_FS_READONLY && FF_USE_TRIM */
+
+
 
 /*-----------------------------------------------------------------------*/
 /* Truncate File                                                         */
@@ -30,11 +30,13 @@
   Include files
 ==============================================================================*/
 #include "config.h"
+#include <string.h>
 #include <sys/types.h>
 #include "dnx/misc.h"
 #include "libc/errno.h"
 #include "kernel/kwrapper.h"
 #include "fs/pipe.h"
+#include "mm/pool.h"
 
 /*==============================================================================
   Local macros
@@ -42,13 +44,35 @@
 #define CLOSED          (1<<0)
 #define PERMANENT       (1<<1)
 
+#define PIPE_LENGTH     __OS_PIPE_LENGTH__
+#define WATERMARK       max(1, PIPE_LENGTH / 2)
+#define READ_LATENCY_MS 10
+
 /*==============================================================================
   Local object types
 ==============================================================================*/
+/*
+ * Pipe is a ring buffer. Data are copied by memcpy() under pipe mutex.
+ * Reader and writer are blocked on their semaphores only when buffer is
+ * empty or full. Reader is woken up by writer when fill level reaches
+ * watermark, on pipe flush and close. Data below watermark are read at
+ * latest after READ_LATENCY_MS. Reader that found pipe empty after this
+ * time is idle and is woken up by the next write (no periodic wake ups).
+ * Writer is woken up by reader when free space reaches watermark.
+ */
 struct pipe {
-        queue_t     *queue;
         struct pipe *self;
+        mutex_t     *mtx;
+        sem_t       *rd_sem;
+        sem_t       *wr_sem;
         u32_t        flag;
+        u16_t        rd_waiting;
+        u16_t        rd_idle;
+        u16_t        wr_waiting;
+        size_t       head;
+        size_t       tail;
+        size_t       level;
+        u8_t         buf[PIPE_LENGTH];
 };
 
 /*==============================================================================
@@ -61,6 +85,8 @@ struct pipe {
 #if __OS_ENABLE_MKFIFO__ == _YES_
 static const u32_t PIPE_READ_TIMEOUT  = MAX_DELAY_MS;
 static const u32_t PIPE_WRITE_TIMEOUT = MAX_DELAY_MS;
+static const u32_t PIPE_MTX_TIMEOUT   = MAX_DELAY_MS;
+static _mm_pool_t  pipe_pool          = _MM_POOL_INIT("pipe", _MM_KRN, sizeof(pipe_t), 4);
 #endif
 
 /*==============================================================================
@@ -87,6 +113,32 @@ static bool is_valid(pipe_t *this)
 {
         return this && this->self == this;
 }
+
+//==============================================================================
+/**
+ * @brief  Function wait for data or free space. Pipe mutex is released during
+ *         waiting. Function shall be called with locked pipe mutex.
+ *
+ * @param  this         pipe object
+ * @param  sem          semaphore to wait for
+ * @param  waiting      counter of waiting tasks
+ * @param  timeout      wait timeout
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+static int wait_for(pipe_t *this, sem_t *sem, u16_t *waiting, u32_t timeout)
+{
+        (*waiting)++;
+        _mutex_unlock(this->mtx);
+
+        int err = _semaphore_wait(sem, timeout);
+
+        int mtxerr = _mutex_lock(this->mtx, PIPE_MTX_TIMEOUT);
+        (*waiting)--;
+
+        return err ? err : mtxerr;
+}
 #endif
 
 //==============================================================================
@@ -104,15 +156,31 @@ int _pipe_create(pipe_t **pipe)
         int err = EINVAL;
 
         if (pipe) {
-                err = _kmalloc(_MM_KRN, sizeof(pipe_t), NULL, 0, 0, cast(void**, pipe));
+                err = _mm_pool_zalloc(&pipe_pool, cast(void**, pipe));
                 if (!err) {
+                        pipe_t *this = *pipe;
+
+                        err = _mutex_create(MUTEX_TYPE_NORMAL, &this->mtx);
+                        if (!err) {
+                                err = _semaphore_create(1, 0, &this->rd_sem);
+                        }
+
+                        if (!err) {
+                                err = _semaphore_create(1, 0, &this->wr_sem);
+                        }
 
-                        err = _queue_create(__OS_PIPE_LENGTH__, sizeof(u8_t), &(*pipe)->queue);
                         if (err == ESUCC) {
-                                (*pipe)->self = *pipe;
-                                (*pipe)->flag = 0;
+                                this->self = this;
                         } else {
-                                _kfree(_MM_KRN, cast(void**, pipe));
+                                if (this->rd_sem) {
+                                        _semaphore_destroy(this->rd_sem);
+                                }
+
+                                if (this->mtx) {
+                                        _mutex_destroy(this->mtx);
+                                }
+
+                                _mm_pool_free(&pipe_pool, cast(void**, pipe));
                         }
                 }
         }
@@ -137,9 +205,11 @@ int _pipe_destroy(pipe_t *pipe)
 {
 #if __OS_ENABLE_MKFIFO__ == _YES_
         if (is_valid(pipe)) {
-                _queue_destroy(pipe->queue);
+                _semaphore_destroy(pipe->wr_sem);
+                _semaphore_destroy(pipe->rd_sem);
+                _mutex_destroy(pipe->mtx);
                 pipe->self = NULL;
-                _kfree(_MM_KRN, cast(void**, &pipe));
+                _mm_pool_free(&pipe_pool, cast(void**, &pipe));
                 return ESUCC;
         } else {
                 return EINVAL;
@@ -164,7 +234,8 @@ int _pipe_get_length(pipe_t *pipe, size_t *len)
 {
 #if __OS_ENABLE_MKFIFO__ == _YES_
         if (len && is_valid(pipe)) {
-                return _queue_get_number_of_items(pipe->queue, len);
+                *len = pipe->level;
+                return ESUCC;
         } else {
                 return EINVAL;
         }
@@ -176,7 +247,9 @@ int _pipe_get_length(pipe_t *pipe, size_t *len)
 
 //==============================================================================
 /**
- * @brief Read data from pipe
+ * @brief Read data from pipe. Function returns all available data (up to
+ *        count bytes) and blocks only if pipe is empty. If pipe is closed
+ *        and empty then 0 bytes are read (end of file).
  *
  * @param pipe          a pipe object
  * @param buf           a destination buffer
@@ -190,31 +263,59 @@ int _pipe_get_length(pipe_t *pipe, size_t *len)
 int _pipe_read(pipe_t *pipe, u8_t *buf, size_t count, size_t *rdcnt, bool non_blocking)
 {
 #if __OS_ENABLE_MKFIFO__ == _YES_
-        if (is_valid(pipe) && buf && count) {
+        if (!is_valid(pipe) || !buf || !count) {
+                return EINVAL;
+        }
 
-                size_t n = 0;
-                for (; n < count; n++) {
+        size_t n       = 0;
+        u32_t  timeout = READ_LATENCY_MS;
+        int    err     = _mutex_lock(pipe->mtx, PIPE_MTX_TIMEOUT);
+        if (!err) {
+                while (true) {
+                        if (pipe->level > 0) {
+                                n = min(count, pipe->level);
 
-                        size_t noitm = 0;
-                        _queue_get_number_of_items(pipe->queue, &noitm);
+                                size_t part = min(n, PIPE_LENGTH - pipe->tail);
+                                memcpy(buf, &pipe->buf[pipe->tail], part);
+                                memcpy(buf + part, &pipe->buf[0], n - part);
 
-                        if ((pipe->flag & CLOSED) && noitm == 0) {
-                                u8_t null = '\0';
-                                _queue_send(pipe->queue, &null, PIPE_WRITE_TIMEOUT);
+                                pipe->tail   = (pipe->tail + n) % PIPE_LENGTH;
+                                pipe->level -= n;
                                 break;
                         }
 
-                        u32_t tout = non_blocking || n ? 10 : PIPE_READ_TIMEOUT;
-                        if (_queue_receive(pipe->queue, &buf[n], tout) != ESUCC) {
+                        if ((pipe->flag & CLOSED) || non_blocking) {
+                                break;
+                        }
+
+                        bool idle = (timeout == PIPE_READ_TIMEOUT);
+                        pipe->rd_idle += idle;
+
+                        err = wait_for(pipe, pipe->rd_sem, &pipe->rd_waiting, timeout);
+
+                        pipe->rd_idle -= idle;
+
+                        if ((err == ETIME) && !idle) {
+                                timeout = PIPE_READ_TIMEOUT;
+
+                        } else if (err != ESUCC) {
                                 break;
                         }
                 }
 
-                *rdcnt = n;
-                return ESUCC;
-        } else {
-                return EINVAL;
+                if (pipe->wr_waiting && (PIPE_LENGTH - pipe->level >= WATERMARK)) {
+                        _semaphore_signal(pipe->wr_sem);
+                }
+
+                if (pipe->rd_waiting && (pipe->level > 0 || (pipe->flag & CLOSED))) {
+                        _semaphore_signal(pipe->rd_sem);
+                }
+
+                _mutex_unlock(pipe->mtx);
         }
+
+        *rdcnt = n;
+        return ESUCC;
 #else
         UNUSED_ARG5(pipe, buf, count, rdcnt, non_blocking);
         return ENOTSUP;
@@ -223,7 +324,9 @@ int _pipe_read(pipe_t *pipe, u8_t *buf, size_t count, size_t *rdcnt, bool non_bl
 
 //==============================================================================
 /**
- * @brief Read data from pipe
+ * @brief Write data to pipe. Function blocks until all data is written
+ *        (or until pipe is closed). In non-blocking mode only data that fit
+ *        in pipe are written.
  *
  * @param pipe          a pipe object
  * @param buf           a destination buffer
@@ -237,29 +340,59 @@ int _pipe_read(pipe_t *pipe, u8_t *buf, size_t count, size_t *rdcnt, bool non_bl
 int _pipe_write(pipe_t *pipe, const u8_t *buf, size_t count, size_t *wrcnt, bool non_blocking)
 {
 #if __OS_ENABLE_MKFIFO__ == _YES_
-        if (is_valid(pipe) && buf && count) {
-
-                size_t n = 0;
-                for (; n < count; n++) {
+        if (!is_valid(pipe) || !buf || !count) {
+                return EINVAL;
+        }
 
-                        size_t noitm = 0;
-                        _queue_get_number_of_items(pipe->queue, &noitm);
+        size_t n   = 0;
+        int    err = _mutex_lock(pipe->mtx, PIPE_MTX_TIMEOUT);
+        if (!err) {
+                while (n < count) {
 
-                        if ((pipe->flag & CLOSED) && noitm == 0) {
+                        if ((pipe->flag & CLOSED) && pipe->level == 0) {
                                 break;
                         }
 
-                        u32_t tout = non_blocking ? 10 : PIPE_WRITE_TIMEOUT;
-                        if (_queue_send(pipe->queue, &buf[n], tout) != ESUCC) {
+                        size_t space = PIPE_LENGTH - pipe->level;
+                        if (space > 0) {
+                                size_t len  = min(count - n, space);
+                                size_t part = min(len, PIPE_LENGTH - pipe->head);
+                                memcpy(&pipe->buf[pipe->head], buf + n, part);
+                                memcpy(&pipe->buf[0], buf + n + part, len - part);
+
+                                pipe->head   = (pipe->head + len) % PIPE_LENGTH;
+                                pipe->level += len;
+                                n           += len;
+
+                                if (  pipe->rd_waiting
+                                   && ((pipe->level >= WATERMARK) || pipe->rd_idle)) {
+                                        _semaphore_signal(pipe->rd_sem);
+                                }
+
+                        } else if (non_blocking) {
                                 break;
+
+                        } else {
+                                if (pipe->rd_waiting) {
+                                        _semaphore_signal(pipe->rd_sem);
+                                }
+
+                                if (wait_for(pipe, pipe->wr_sem, &pipe->wr_waiting,
+                                             PIPE_WRITE_TIMEOUT) != ESUCC) {
+                                        break;
+                                }
                         }
                 }
 
-                *wrcnt = n;
-                return ESUCC;
-        } else {
-                return EINVAL;
+                if (pipe->wr_waiting && pipe->level < PIPE_LENGTH) {
+                        _semaphore_signal(pipe->wr_sem);
+                }
+
+                _mutex_unlock(pipe->mtx);
         }
+
+        *wrcnt = n;
+        return ESUCC;
 #else
         UNUSED_ARG5(pipe, buf, count, wrcnt, non_blocking);
         return ENOTSUP;
@@ -281,10 +414,22 @@ int _pipe_close(pipe_t *pipe)
         if (is_valid(pipe)) {
 
                 if (not (pipe->flag & PERMANENT)) {
-                        pipe->flag |= CLOSED;
+                        int err = _mutex_lock(pipe->mtx, PIPE_MTX_TIMEOUT);
+                        if (!err) {
+                                pipe->flag |= CLOSED;
+
+                                if (pipe->rd_waiting) {
+                                        _semaphore_signal(pipe->rd_sem);
+                                }
+
+                                if (pipe->wr_waiting) {
+                                        _semaphore_signal(pipe->wr_sem);
+                                }
 
-                        u8_t nul = '\0';
-                        _queue_send(pipe->queue, &nul, 10);
+                                _mutex_unlock(pipe->mtx);
+                        }
+
+                        return err;
                 }
 
                 return ESUCC;
@@ -297,6 +442,39 @@ int _pipe_close(pipe_t *pipe)
 #endif
 }
 
+//==============================================================================
+/**
+ * @brief  Flush pipe. Reader is woken up if pipe contains data below
+ *         watermark.
+ *
+ * @param  pipe         a pipe object
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+int _pipe_flush(pipe_t *pipe)
+{
+#if __OS_ENABLE_MKFIFO__ == _YES_
+        if (is_valid(pipe)) {
+                int err = _mutex_lock(pipe->mtx, PIPE_MTX_TIMEOUT);
+                if (!err) {
+                        if (pipe->rd_waiting && (pipe->level > 0)) {
+                                _semaphore_signal(pipe->rd_sem);
+                        }
+
+                        _mutex_unlock(pipe->mtx);
+                }
+
+                return err;
+        } else {
+                return EINVAL;
+        }
+#else
+        UNUSED_ARG1(pipe);
+        return ENOTSUP;
+#endif
+}
+
 //==============================================================================
 /**
  * @brief  Clear pipe
@@ -310,7 +488,20 @@ int _pipe_clear(pipe_t *pipe)
 {
 #if __OS_ENABLE_MKFIFO__ == _YES_
         if (is_valid(pipe)) {
-                return _queue_reset(pipe->queue);
+                int err = _mutex_lock(pipe->mtx, PIPE_MTX_TIMEOUT);
+                if (!err) {
+                        pipe->head  = 0;
+                        pipe->tail  = 0;
+                        pipe->level = 0;
+
+                        if (pipe->wr_waiting) {
+                                _semaphore_signal(pipe->wr_sem);
+                        }
+
+                        _mutex_unlock(pipe->mtx);
+                }
+
+                return err;
         } else {
                 return EINVAL;
         }
@@ -89,6 +89,8 @@ static size_t get_file_size(struct file_info *file);
 /*==============================================================================
   Exported object definitions
 ==============================================================================*/
+/* content is created by kernel, so lookups are not cached by VFS */
+API_FS_NOCACHE(procfs);
 
 /*==============================================================================
   Function definitions
@@ -778,6 +780,21 @@ API_FS_SYNC(procfs, void *fs_handle)
         return ESUCC;
 }
 
+//==============================================================================
+/**
+ * @brief Check if file system has data to synchronize.
+ *
+ * @param[in ]          *fs_handle              file system allocated memory
+ *
+ * @return Always false, file system has no data to synchronize.
+ */
+//==============================================================================
+API_FS_DIRTY(procfs, void *fs_handle)
+{
+        UNUSED_ARG1(fs_handle);
+        return false;
+}
+
 //==============================================================================
 /**
  * @brief Read directory
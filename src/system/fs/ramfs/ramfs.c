@@ -38,16 +38,39 @@
 #define PIPE_LENGTH                     __OS_STREAM_BUFFER_LENGTH__
 #define PIPE_WRITE_TIMEOUT              1
 #define PIPE_READ_TIMEOUT               MAX_DELAY
-#define DATA_CHAIN_SIZE                 __RAMFS_FILE_CHAIN_SIZE__
+#define DATA_BLOCK_SIZE                 __RAMFS_FILE_BLOCK_SIZE__
+#if __RAMFS_FILE_CHAIN_SIZE__ < __RAMFS_FILE_BLOCK_SIZE__
+#define TAIL_BLOCK_SIZE                 __RAMFS_FILE_CHAIN_SIZE__
+#else
+#define TAIL_BLOCK_SIZE                 __RAMFS_FILE_BLOCK_SIZE__
+#endif
+#define INDEX_SHIFT                     5
+#define INDEX_FANOUT                    (1 << INDEX_SHIFT)
+#define INDEX_MAX_HEIGHT                12
+#define DIR_MIN_BUCKETS                 8
+#define NAME_HASH_INIT                  2166136261U
+#define NAME_HASH(h, c)                 (((h) ^ cast(u8_t, (c))) * 16777619U)
 
 /*==============================================================================
   Local types, enums definitions
 ==============================================================================*/
-/** regular file data chain */
-typedef struct data_chain {
-        struct data_chain *next;
-        u8_t buf[DATA_CHAIN_SIZE];
-} data_chain_t;
+/** directory: hash table of entry names and entry list in creation order */
+typedef struct dir {
+        struct node    **bucket;                //!< hash buckets (power of 2, can be NULL)
+        size_t           buckets;               //!< number of buckets
+        size_t           count;                 //!< number of entries
+        struct node     *first;                 //!< first entry
+        struct node     *last;                  //!< last entry
+        struct node     *cursor;                //!< last entry found by position
+        size_t           cursor_seek;           //!< position of cursor entry
+} dir_t;
+
+/** regular file data: radix tree of data blocks */
+typedef struct {
+        void            *root;                  //!< data block (height 0) or index block
+        u16_t            tail_size;             //!< size of data block of small file (height 0)
+        u8_t             height;                //!< number of index levels
+} file_data_t;
 
 /** node structure */
 typedef struct node {
@@ -58,11 +81,16 @@ typedef struct node {
         size_t           size;                  //!< file size
         time_t           mtime;                 //!< time of last modification
         time_t           ctime;                 //!< time of creation
+        u32_t            hash;                  //!< name hash
+        struct node     *parent;                //!< parent directory
+        struct node     *hnext;                 //!< next node in hash bucket
+        struct node     *prev;                  //!< previous node in directory
+        struct node     *next;                  //!< next node in directory
 
         union {
                 pipe_t       *pipe_t;
-                llist_t      *llist_t;
-                data_chain_t *data_chain_t;
+                dir_t        *dir_t;
+                file_data_t   file;
                 dev_t         dev_t;
         } data;
 } node_t;
@@ -85,9 +113,17 @@ struct RAMFS {
 /*==============================================================================
   Local function prototypes
 ==============================================================================*/
-static int  new_node                    (struct RAMFS *hdl, node_t *parent, char *filename, mode_t mode, i32_t *item, node_t **child);
-static int  delete_node                 (struct RAMFS *hdl, node_t *base, node_t *target, u32_t position);
-static int  get_node                    (const char *path, node_t *startnode, i32_t deep, i32_t *item, node_t **node);
+static int  new_node                    (struct RAMFS *hdl, node_t *parent, char *filename, mode_t mode, node_t **child);
+static int  delete_node                 (struct RAMFS *hdl, node_t *target);
+static int  get_node                    (const char *path, node_t *startnode, i32_t deep, node_t **node);
+static u32_t name_hash                  (const char *name, size_t len);
+static node_t *dir_find                 (node_t *dir, const char *name, size_t len);
+static node_t *dir_at                   (node_t *dir, size_t seek);
+static void dir_insert                  (node_t *dir, node_t *node);
+static void dir_remove                  (node_t *dir, node_t *node);
+static int  get_block                   (node_t *node, u64_t blk, size_t len, bool create, u8_t **block);
+static int  resize_tail_block           (file_data_t *file, size_t len);
+static void free_blocks                 (void *root, u8_t height);
 static uint get_path_deep               (const char *path);
 static int  add_node_to_open_files_list (struct RAMFS *hdl, node_t *parent, node_t *child);
 static void clear_regular_file          (node_t *node);
@@ -124,7 +160,7 @@ API_FS_INIT(ramfs, void **fs_handle, const char *src_path, const char *opts)
                 if (err)
                         goto finish;
 
-                err = sys_llist_create(NULL, NULL, cast(llist_t**, &hdl->root_dir.data.llist_t));
+                err = sys_zalloc(sizeof(dir_t), cast(void**, &hdl->root_dir.data.dir_t));
                 if (err)
                         goto finish;
 
@@ -141,8 +177,8 @@ API_FS_INIT(ramfs, void **fs_handle, const char *src_path, const char *opts)
                         if (hdl->resource_mtx)
                                 sys_mutex_destroy(hdl->resource_mtx);
 
-                        if (hdl->root_dir.data.llist_t)
-                                sys_llist_destroy(hdl->root_dir.data.llist_t);
+                        if (hdl->root_dir.data.dir_t)
+                                sys_free(cast(void**, &hdl->root_dir.data.dir_t));
 
                         if (hdl->opended_files)
                                 sys_llist_destroy(hdl->opended_files);
@@ -195,7 +231,7 @@ API_FS_MKNOD(ramfs, void *fs_handle, const char *path, const dev_t dev)
 
                 // parent node must exist
                 node_t *parent;
-                err = get_node(path, &hdl->root_dir, -1, NULL, &parent);
+                err = get_node(path, &hdl->root_dir, -1, &parent);
                 if (!err) {
                         // create new node
                         char *basename = strrchr(path, '/') + 1;
@@ -208,7 +244,7 @@ API_FS_MKNOD(ramfs, void *fs_handle, const char *path, const dev_t dev)
                                 node_t *child;
                                 err = new_node(hdl, parent, child_name,
                                                S_IRWXU | S_IRGRP | S_IROTH | S_IFDEV,
-                                               NULL, &child);
+                                               &child);
                                 if (!err) {
                                         child->data.dev_t = dev;
                                 } else {
@@ -243,7 +279,7 @@ API_FS_MKDIR(ramfs, void *fs_handle, const char *path, mode_t mode)
 
                 // parent node must exist
                 node_t *parent;
-                err = get_node(path, &hdl->root_dir, -1, NULL, &parent);
+                err = get_node(path, &hdl->root_dir, -1, &parent);
                 if (!err) {
                         // create new node
                         char *basename = strrchr(path, '/') + 1;
@@ -256,7 +292,7 @@ API_FS_MKDIR(ramfs, void *fs_handle, const char *path, mode_t mode)
                                 node_t *child;
                                 err = new_node(hdl, parent, child_name,
                                                S_IPMT(mode) | S_IFDIR,
-                                               NULL, &child);
+                                               &child);
                                 if (err) {
                                         sys_free(cast(void**, &child_name));
                                 }
@@ -289,7 +325,7 @@ API_FS_MKFIFO(ramfs, void *fs_handle, const char *path, mode_t mode)
 
                 // parent node must exist
                 node_t *parent;
-                err = get_node(path, &hdl->root_dir, -1, NULL, &parent);
+                err = get_node(path, &hdl->root_dir, -1, &parent);
                 if (!err) {
                         // create new node
                         char *basename = strrchr(path, '/') + 1;
@@ -302,7 +338,7 @@ API_FS_MKFIFO(ramfs, void *fs_handle, const char *path, mode_t mode)
                                 node_t *child;
                                 err = new_node(hdl, parent, child_name,
                                                S_IPMT(mode) | S_IFIFO,
-                                               NULL, &child);
+                                               &child);
                                 if (err) {
                                         sys_free(cast(void**, &child_name));
                                 }
@@ -334,10 +370,10 @@ API_FS_OPENDIR(ramfs, void *fs_handle, const char *path, DIR *dir)
         if (!err) {
 
                 node_t *parent;
-                err = get_node(path, &hdl->root_dir, 0, NULL, &parent);
+                err = get_node(path, &hdl->root_dir, 0, &parent);
                 if (!err) {
                         if (S_ISDIR(parent->mode)) {
-                                dir->d_items    = sys_llist_size(parent->data.llist_t);
+                                dir->d_items    = parent->data.dir_t->count;
                                 dir->d_seek     = 0;
                                 dir->d_hdl      = parent;
                         } else {
@@ -386,7 +422,7 @@ API_FS_READDIR(ramfs, void *fs_handle, DIR *dir)
         if (!err) {
 
                 node_t *parent = dir->d_hdl;
-                node_t *child  = sys_llist_at(parent->data.llist_t, dir->d_seek++);
+                node_t *child  = dir_at(parent, dir->d_seek++);
 
                 if (child) {
                         dir->dirent.d_name = child->name;
@@ -438,14 +474,8 @@ API_FS_REMOVE(ramfs, void *fs_handle, const char *path)
         int err = sys_mutex_lock(hdl->resource_mtx, MTX_TIMEOUT);
         if (!err) {
 
-                node_t *parent;
-                err = get_node(path, &hdl->root_dir, -1, NULL, &parent);
-                if (err){
-                        goto finish;
-                }
-
-                i32_t item; node_t *child;
-                err = get_node(path, &hdl->root_dir, 0, &item, &child);
+                node_t *child;
+                err = get_node(path, &hdl->root_dir, 0, &child);
                 if (err) {
                         goto finish;
                 }
@@ -475,7 +505,7 @@ API_FS_REMOVE(ramfs, void *fs_handle, const char *path)
 
                 /* remove node if possible */
                 if (remove_file == true) {
-                        err = delete_node(hdl, parent, child, item);
+                        err = delete_node(hdl, child);
                 } else {
                         err = ESUCC;
                 }
@@ -510,23 +540,46 @@ API_FS_RENAME(ramfs, void *fs_handle, const char *old_name, const char *new_name
         if (!err) {
 
                 node_t *target;
-                err = get_node(old_name, &hdl->root_dir, 0, NULL, &target);
-                if (!err) {
-                        char *basename = strrchr(new_name, '/') + 1;
+                err = get_node(old_name, &hdl->root_dir, 0, &target);
+                if (err) {
+                        goto finish;
+                }
 
-                        char *newname;
-                        err = sys_zalloc(strsize(basename), cast(void**, &newname));
-                        if (!err) {
-                                strcpy(newname, basename);
+                if (target == &hdl->root_dir) {
+                        err = EPERM;
+                        goto finish;
+                }
 
-                                if (target->name) {
-                                        sys_free(cast(void**, target->name));
-                                }
+                char   *basename = strrchr(new_name, '/') + 1;
+                node_t *parent   = target->parent;
+                node_t *existing = dir_find(parent, basename, strlen(basename));
+
+                if (existing == target) {
+                        goto finish;
+                } else if (existing) {
+                        err = EEXIST;
+                        goto finish;
+                }
 
-                                target->name = newname;
+                char *newname;
+                err = sys_zalloc(strsize(basename), cast(void**, &newname));
+                if (!err) {
+                        strcpy(newname, basename);
+
+                        dir_remove(parent, target);
+
+                        if (target->name) {
+                                sys_free(cast(void**, &target->name));
                         }
+
+                        target->name = newname;
+                        target->hash = name_hash(newname, strlen(newname));
+
+                        dir_insert(parent, target);
                 }
 
+                finish:
+
                 sys_mutex_unlock(hdl->resource_mtx);
         }
 
@@ -552,7 +605,7 @@ API_FS_CHMOD(ramfs, void *fs_handle, const char *path, mode_t mode)
         if (!err) {
 
                 node_t *target;
-                err = get_node(path, &hdl->root_dir, 0, NULL, &target);
+                err = get_node(path, &hdl->root_dir, 0, &target);
                 if (!err) {
                         target->mode = S_IFMT(target->mode) | S_IPMT(mode);
                 }
@@ -583,7 +636,7 @@ API_FS_CHOWN(ramfs, void *fs_handle, const char *path, uid_t owner, gid_t group)
         if (!err) {
 
                 node_t *target;
-                err = get_node(path, &hdl->root_dir, 0, NULL, &target);
+                err = get_node(path, &hdl->root_dir, 0, &target);
                 if (!err) {
                         target->uid = owner;
                         target->gid = group;
@@ -665,7 +718,7 @@ API_FS_STAT(ramfs, void *fs_handle, const char *path, struct stat *stat)
         if (!err) {
 
                 node_t *target;
-                err = get_node(path, &hdl->root_dir, 0, NULL, &target);
+                err = get_node(path, &hdl->root_dir, 0, &target);
                 if (!err) {
                         if ( (strlch(path) == '/' && S_ISDIR(target->mode))
                            || strlch(path) != '/') {
@@ -734,14 +787,14 @@ API_FS_OPEN(ramfs, void *fs_handle, void **fhdl, fpos_t *fpos, const char *path,
 
                 // open file parent
                 node_t *parent;
-                err = get_node(path, &hdl->root_dir, -1, NULL, &parent);
+                err = get_node(path, &hdl->root_dir, -1, &parent);
                 if (err) {
                         goto finish;
                 }
 
                 // try to open selected file, if not exist then try create if O_CREAT flag is set
-                i32_t item; node_t *child;
-                err = get_node(path, &hdl->root_dir, 0, &item, &child);
+                node_t *child;
+                err = get_node(path, &hdl->root_dir, 0, &child);
                 if (err == ENOENT) {
                         // check that file should be created
                         if (!(flags & O_CREAT)) {
@@ -758,8 +811,7 @@ API_FS_OPEN(ramfs, void *fs_handle, void **fhdl, fpos_t *fpos, const char *path,
 
                         strcpy(file_name, basename);
 
-                        err = new_node(hdl, parent, file_name, 0666 | S_IFREG,
-                                       &item, &child);
+                        err = new_node(hdl, parent, file_name, 0666 | S_IFREG, &child);
                         if (err) {
                                 sys_free(cast(void**, &file_name));
                                 goto finish;
@@ -847,17 +899,14 @@ API_FS_CLOSE(ramfs, void *fs_handle, void *fhdl, bool force)
                                         bool remove = true;
 
                                         sys_llist_foreach(struct opened_file_info*, file, hdl->opended_files) {
-                                                if (file->child == target) {
+                                                if (file != opened_file && file->child == target) {
                                                         remove = false;
                                                         break;
                                                 }
                                         }
 
                                         if (remove) {
-                                                err = delete_node(hdl,
-                                                                  opened_file->parent,
-                                                                  opened_file->child,
-                                                                  pos);
+                                                err = delete_node(hdl, target);
                                         }
                                 } else {
                                         err = ESUCC;
@@ -1012,6 +1061,162 @@ API_FS_READ(ramfs,
         return err;
 }
 
+//==============================================================================
+/**
+ * @brief Write data vector to file. Regular file is written at once, other
+ *        files are written by each vector element separately.
+ *
+ * @param[in ]          *fs_handle              file system allocated memory
+ * @param[in ]          *fhdl                   file handle
+ * @param[in ]          *iov                    data vector
+ * @param[in ]           iovcnt                 number of vector elements
+ * @param[in ]          *fpos                   position in file
+ * @param[out]          *wrcnt                  number of written bytes
+ * @param[in ]           fattr                  file attributes
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+API_FS_WRITEV(ramfs,
+              void               *fs_handle,
+              void               *fhdl,
+              const struct iovec *iov,
+              int                 iovcnt,
+              fpos_t             *fpos,
+              size_t             *wrcnt,
+              struct vfs_fattr    fattr)
+{
+        struct RAMFS *hdl = fs_handle;
+
+        int err = sys_mutex_lock(hdl->resource_mtx, MTX_TIMEOUT);
+        if (!err) {
+
+                err = ENOENT;
+
+                struct opened_file_info *opened_file = fhdl;
+                if (opened_file && opened_file->child) {
+                        node_t *node = opened_file->child;
+
+                        if (S_ISREG(node->mode)) {
+                                sys_gettime(&node->mtime);
+
+                                fpos_t pos = *fpos;
+                                err = ESUCC;
+
+                                for (int i = 0; !err && (i < iovcnt); i++) {
+                                        size_t n = *wrcnt;
+                                        err = write_regular_file(node, iov[i].iov_base,
+                                                                 iov[i].iov_len, pos, wrcnt);
+                                        pos += *wrcnt - n;
+                                }
+
+                        } else {
+                                sys_mutex_unlock(hdl->resource_mtx);
+
+                                fpos_t pos = *fpos;
+                                err = ESUCC;
+
+                                for (int i = 0; !err && (i < iovcnt); i++) {
+                                        size_t n = 0;
+                                        err = _ramfs_write(fs_handle, fhdl, iov[i].iov_base,
+                                                           iov[i].iov_len, &pos, &n, fattr);
+                                        pos    += n;
+                                        *wrcnt += n;
+
+                                        if (n < iov[i].iov_len) {
+                                                break;
+                                        }
+                                }
+
+                                return err;
+                        }
+                }
+
+                sys_mutex_unlock(hdl->resource_mtx);
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief Read data vector from file. Regular file is read at once, other
+ *        files are read by each vector element separately.
+ *
+ * @param[in ]          *fs_handle              file system allocated memory
+ * @param[in ]          *fhdl                   file handle
+ * @param[in ]          *iov                    data vector
+ * @param[in ]           iovcnt                 number of vector elements
+ * @param[in ]          *fpos                   position in file
+ * @param[out]          *rdcnt                  number of read bytes
+ * @param[in ]           fattr                  file attributes
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+API_FS_READV(ramfs,
+             void               *fs_handle,
+             void               *fhdl,
+             const struct iovec *iov,
+             int                 iovcnt,
+             fpos_t             *fpos,
+             size_t             *rdcnt,
+             struct vfs_fattr    fattr)
+{
+        struct RAMFS *hdl = fs_handle;
+
+        int err = sys_mutex_lock(hdl->resource_mtx, MTX_TIMEOUT);
+        if (!err) {
+
+                err = ENOENT;
+
+                struct opened_file_info *opened_file = fhdl;
+                if (opened_file && opened_file->child) {
+                        node_t *node = opened_file->child;
+
+                        if (S_ISREG(node->mode)) {
+                                fpos_t pos = *fpos;
+                                err = ESUCC;
+
+                                for (int i = 0; !err && (i < iovcnt); i++) {
+                                        size_t n = *rdcnt;
+                                        err = read_regular_file(node, iov[i].iov_base,
+                                                                iov[i].iov_len, pos, rdcnt);
+                                        pos += *rdcnt - n;
+
+                                        if ((*rdcnt - n) < iov[i].iov_len) {
+                                                break;
+                                        }
+                                }
+
+                        } else {
+                                sys_mutex_unlock(hdl->resource_mtx);
+
+                                fpos_t pos = *fpos;
+                                err = ESUCC;
+
+                                for (int i = 0; !err && (i < iovcnt); i++) {
+                                        size_t n = 0;
+                                        err = _ramfs_read(fs_handle, fhdl, iov[i].iov_base,
+                                                          iov[i].iov_len, &pos, &n, fattr);
+                                        pos    += n;
+                                        *rdcnt += n;
+
+                                        if (n < iov[i].iov_len) {
+                                                break;
+                                        }
+                                }
+
+                                return err;
+                        }
+                }
+
+                sys_mutex_unlock(hdl->resource_mtx);
+        }
+
+        return err;
+}
+
 //==============================================================================
 /**
  * @brief IO operations on files
@@ -1096,6 +1301,12 @@ API_FS_FLUSH(ramfs, void *fs_handle, void *fhdl)
                         if (S_ISDEV(opened_file->child->mode)) {
                                 sys_mutex_unlock(hdl->resource_mtx);
                                 return sys_driver_flush(opened_file->child->data.dev_t);
+
+                        } else if (S_ISFIFO(opened_file->child->mode)) {
+                                pipe_t *pipe = opened_file->child->data.pipe_t;
+                                sys_mutex_unlock(hdl->resource_mtx);
+                                return sys_pipe_flush(pipe);
+
                         } else {
                                 err = ESUCC;
                         }
@@ -1124,25 +1335,42 @@ API_FS_SYNC(ramfs, void *fs_handle)
         return ESUCC;
 }
 
+//==============================================================================
+/**
+ * @brief Check if file system has data to synchronize.
+ *
+ * @param[in ]          *fs_handle              file system allocated memory
+ *
+ * @return Always false, file system has no data to synchronize.
+ */
+//==============================================================================
+API_FS_DIRTY(ramfs, void *fs_handle)
+{
+        UNUSED_ARG1(fs_handle);
+        return false;
+}
+
 //==============================================================================
 /**
  * @brief Remove selected node
  *
- * @param[in] *base             base node
+ * @param[in] *hdl              file system handle
  * @param[in] *target           target node
- * @param[in]  position         item in base node that point to target
  *
  * @return One of errno value (errno.h)
  */
 //==============================================================================
-static int delete_node(struct RAMFS *hdl, node_t *base, node_t *target, u32_t position)
+static int delete_node(struct RAMFS *hdl, node_t *target)
 {
         if (S_ISDIR(target->mode)) {
-                if (sys_llist_size(target->data.llist_t) > 0) {
+                if (target->data.dir_t->count > 0) {
                         return ENOTEMPTY;
                 } else {
-                        sys_llist_destroy(target->data.llist_t);
-                        target->data.llist_t = NULL;
+                        if (target->data.dir_t->bucket) {
+                                sys_free(cast(void**, &target->data.dir_t->bucket));
+                        }
+
+                        sys_free(cast(void**, &target->data.dir_t));
                 }
 
         } else if (S_ISFIFO(target->mode)) {
@@ -1159,7 +1387,9 @@ static int delete_node(struct RAMFS *hdl, node_t *base, node_t *target, u32_t po
                 sys_free(cast(void**, &target->name));
         }
 
-        sys_llist_erase(base->data.llist_t, position);
+        dir_remove(target->parent, target);
+
+        sys_free(cast(void**, &target));
 
         hdl->file_count--;
 
@@ -1202,15 +1432,13 @@ static uint get_path_deep(const char *path)
  *
  * @param[in]  path             path
  * @param[in]  startnode        start node
- * @param[out] extPath          external path begin (pointer from path)
  * @param[in]  deep             deep control
- * @param[out] item             node is n-item of list which was found
  * @param[out] node             found node
  *
  * @return One of errno value (errno.h)
  */
 //==============================================================================
-static int get_node(const char *path, node_t *startnode, i32_t deep, i32_t *item, node_t **node)
+static int get_node(const char *path, node_t *startnode, i32_t deep, node_t **node)
 {
         if (!path || !startnode) {
                 return ENOENT;
@@ -1222,7 +1450,6 @@ static int get_node(const char *path, node_t *startnode, i32_t deep, i32_t *item
 
         node_t *current_node = startnode;
         int     dir_deep     = get_path_deep(path);
-        int     err          = ENOENT;
 
         /* go to selected node -----------------------------------------------*/
         while (dir_deep + deep > 0) {
@@ -1236,49 +1463,22 @@ static int get_node(const char *path, node_t *startnode, i32_t deep, i32_t *item
                 char *path_end    = strchr(path, '/');
                 uint  path_length = !path_end ? strlen(path) : (size_t)path_end - (size_t)path;
 
-                /* get number of list items */
-                int list_size = sys_llist_size(current_node->data.llist_t);
-
-                /* find that object exist ------------------------------------*/
-                int i = 0;
-                while (list_size > 0) {
-                        node_t *next_node = sys_llist_at(current_node->data.llist_t, i++);
-
-                        if (next_node == NULL) {
-                                dir_deep = 1 - deep;
-                                break;
-                        }
-
-                        if (  strlen(next_node->name) == path_length
-                           && strncmp(next_node->name, path, path_length) == 0 ) {
-
-                                current_node = next_node;
-
-                                if (item) {
-                                        *item = i - 1;
-                                }
-
-                                break;
-                        }
-
-                        list_size--;
+                /* find that object exist in directory hash table */
+                if (!S_ISDIR(current_node->mode)) {
+                        return ENOENT;
                 }
 
-                /* directory does not found or error */
-                if (list_size == 0 || current_node == NULL) {
-                        current_node = NULL;
-                        break;
+                current_node = dir_find(current_node, path, path_length);
+                if (current_node == NULL) {
+                        return ENOENT;
                 }
 
                 dir_deep--;
         }
 
-        if (current_node) {
-                *node  = current_node;
-                err = ESUCC;
-        }
+        *node = current_node;
 
-        return err;
+        return ESUCC;
 }
 
 //==============================================================================
@@ -1290,7 +1490,6 @@ static int get_node(const char *path, node_t *startnode, i32_t deep, i32_t *item
  * @param[in]  parent           parent node
  * @param[in]  filename         filename (must be earlier allocated)
  * @param[in]  mode             mode (permissions, file type)
- * @param[out] item             new node number in base node (can be NULL)
  * @param[out] child            new node
  *
  * @return One of errno value (errno.h)
@@ -1300,7 +1499,6 @@ static int new_node(struct RAMFS *hdl,
                     node_t       *parent,
                     char         *filename,
                     mode_t        mode,
-                    i32_t        *item,
                     node_t      **child)
 {
         if (!parent || !filename) {
@@ -1311,10 +1509,10 @@ static int new_node(struct RAMFS *hdl,
                 return ENOTDIR;
         }
 
-        sys_llist_foreach(node_t*, node, parent->data.llist_t) {
-                if (strncmp(node->name, filename, 255) == 0) {
-                        return EEXIST;
-                }
+        size_t name_len = strnlen(filename, 255);
+
+        if (dir_find(parent, filename, name_len)) {
+                return EEXIST;
         }
 
         node_t *node;
@@ -1325,7 +1523,7 @@ static int new_node(struct RAMFS *hdl,
                 sys_gettime(&tm);
 
                 node->name         = filename;
-                node->data.llist_t = NULL;
+                node->hash         = name_hash(filename, name_len);
                 node->gid          = 0;
                 node->uid          = 0;
                 node->mode         = mode;
@@ -1334,32 +1532,214 @@ static int new_node(struct RAMFS *hdl,
                 node->size         = 0;
 
                 if (S_ISDIR(mode)) {
-                        err = sys_llist_create(NULL, NULL, cast(llist_t**, &node->data));
+                        err = sys_zalloc(sizeof(dir_t), cast(void**, &node->data.dir_t));
 
                 } else if (S_ISFIFO(mode)) {
                         err = sys_pipe_create(cast(pipe_t**, &node->data));
                 }
 
                 if (!err) {
-                        if (sys_llist_push_back(parent->data.llist_t, node)) {
-                                if (item) {
-                                        *item = sys_llist_size(parent->data.llist_t) - 1;
-                                }
+                        dir_insert(parent, node);
 
-                                *child = node;
+                        *child = node;
 
-                                hdl->file_count++;
-                        } else {
-                                err = ENOMEM;
+                        hdl->file_count++;
+                } else {
+                        sys_free(cast(void**, &node));
+                }
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief Function calculate hash of file name (FNV-1a).
+ *
+ * @param name                  name
+ * @param len                   name length
+ *
+ * @return Name hash.
+ */
+//==============================================================================
+static u32_t name_hash(const char *name, size_t len)
+{
+        u32_t hash = NAME_HASH_INIT;
+
+        while (len--) {
+                hash = NAME_HASH(hash, *name++);
+        }
+
+        return hash;
+}
+
+//==============================================================================
+/**
+ * @brief Function find directory entry by name.
+ *
+ * @param dir                   directory node
+ * @param name                  entry name (not terminated)
+ * @param len                   name length
+ *
+ * @return Found node or NULL.
+ */
+//==============================================================================
+static node_t *dir_find(node_t *dir, const char *name, size_t len)
+{
+        dir_t  *d    = dir->data.dir_t;
+        u32_t   hash = name_hash(name, len);
+        node_t *node;
+
+        if (d->bucket) {
+                node = d->bucket[hash & (d->buckets - 1)];
+        } else {
+                node = d->first;
+        }
+
+        for (; node; node = d->bucket ? node->hnext : node->next) {
+                if (  node->hash == hash
+                   && strncmp(node->name, name, len) == 0
+                   && node->name[len] == '\0') {
+
+                        return node;
+                }
+        }
+
+        return NULL;
+}
+
+//==============================================================================
+/**
+ * @brief Function return directory entry at selected position. Last found
+ *        entry is remembered so sequential directory read is not quadratic.
+ *
+ * @param dir                   directory node
+ * @param seek                  entry position
+ *
+ * @return Found node or NULL.
+ */
+//==============================================================================
+static node_t *dir_at(node_t *dir, size_t seek)
+{
+        dir_t  *d    = dir->data.dir_t;
+        node_t *node = d->first;
+        size_t  pos  = 0;
+
+        if (d->cursor && d->cursor_seek <= seek) {
+                node = d->cursor;
+                pos  = d->cursor_seek;
+        }
+
+        for (; node && pos < seek; pos++) {
+                node = node->next;
+        }
+
+        if (node) {
+                d->cursor      = node;
+                d->cursor_seek = seek;
+        }
+
+        return node;
+}
+
+//==============================================================================
+/**
+ * @brief Function add node to directory. If hash table cannot be enlarged
+ *        then current table is used (longer bucket chains).
+ *
+ * @param dir                   directory node
+ * @param node                  node to add
+ */
+//==============================================================================
+static void dir_insert(node_t *dir, node_t *node)
+{
+        dir_t *d = dir->data.dir_t;
+
+        node->parent = dir;
+        node->next   = NULL;
+        node->prev   = d->last;
+
+        if (d->last) {
+                d->last->next = node;
+        } else {
+                d->first = node;
+        }
+
+        d->last = node;
+        d->count++;
+
+        /* enlarge hash table if load factor exceeds 1 */
+        if (d->count > d->buckets) {
+                size_t buckets = max(DIR_MIN_BUCKETS, d->buckets * 2);
+
+                node_t **bucket;
+                if (sys_zalloc(buckets * sizeof(node_t*), cast(void**, &bucket)) == ESUCC) {
+                        if (d->bucket) {
+                                sys_free(cast(void**, &d->bucket));
                         }
+
+                        d->bucket  = bucket;
+                        d->buckets = buckets;
+
+                        for (node_t *n = d->first; n; n = n->next) {
+                                node_t **slot = &d->bucket[n->hash & (buckets - 1)];
+                                n->hnext = *slot;
+                                *slot    = n;
+                        }
+
+                        return;
                 }
+        }
 
-                if (err) {
-                        sys_free(cast(void**, &node));
+        if (d->bucket) {
+                node_t **slot = &d->bucket[node->hash & (d->buckets - 1)];
+                node->hnext = *slot;
+                *slot       = node;
+        }
+}
+
+//==============================================================================
+/**
+ * @brief Function remove node from directory.
+ *
+ * @param dir                   directory node
+ * @param node                  node to remove
+ */
+//==============================================================================
+static void dir_remove(node_t *dir, node_t *node)
+{
+        dir_t *d = dir->data.dir_t;
+
+        if (d->bucket) {
+                node_t **slot = &d->bucket[node->hash & (d->buckets - 1)];
+
+                while (*slot && *slot != node) {
+                        slot = &(*slot)->hnext;
+                }
+
+                if (*slot) {
+                        *slot = node->hnext;
                 }
         }
 
-        return err;
+        if (node->prev) {
+                node->prev->next = node->next;
+        } else {
+                d->first = node->next;
+        }
+
+        if (node->next) {
+                node->next->prev = node->prev;
+        } else {
+                d->last = node->prev;
+        }
+
+        node->hnext = NULL;
+        node->prev  = NULL;
+        node->next  = NULL;
+
+        d->count--;
+        d->cursor = NULL;
 }
 
 //==============================================================================
@@ -1403,6 +1783,155 @@ static int add_node_to_open_files_list(struct RAMFS *hdl,
         return err;
 }
 
+//==============================================================================
+/**
+ * @brief Function free data blocks of regular file (recursive).
+ *
+ * @param root                  data block or index block
+ * @param height                index levels below root
+ */
+//==============================================================================
+static void free_blocks(void *root, u8_t height)
+{
+        if (root && height > 0) {
+                void **index = root;
+
+                for (size_t i = 0; i < INDEX_FANOUT; i++) {
+                        free_blocks(index[i], height - 1);
+                }
+        }
+
+        if (root) {
+                sys_free(&root);
+        }
+}
+
+//==============================================================================
+/**
+ * @brief Function resize data block of small file. Files smaller than one data
+ *        block keep only the allocated tail (multiple of TAIL_BLOCK_SIZE), so
+ *        small files do not waste entire data block.
+ *
+ * @param file                  file data
+ * @param len                   required length of block (from block begin)
+ *
+ * @retval One of errno value (errno.h)
+ */
+//==============================================================================
+static int resize_tail_block(file_data_t *file, size_t len)
+{
+        if (file->height > 0 || len <= file->tail_size) {
+                return ESUCC;
+        }
+
+        size_t size = ((len + TAIL_BLOCK_SIZE - 1) / TAIL_BLOCK_SIZE) * TAIL_BLOCK_SIZE;
+        size = max(size, 2 * cast(size_t, file->tail_size));
+        size = min(size, cast(size_t, DATA_BLOCK_SIZE));
+
+        u8_t *block;
+        int err = sys_zalloc(size, cast(void**, &block));
+        if (!err) {
+                if (file->root) {
+                        memcpy(block, file->root, file->tail_size);
+                        sys_free(&file->root);
+                }
+
+                file->root      = block;
+                file->tail_size = size;
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief Function find data block of regular file. Blocks are indexed by
+ *        radix tree, so block access time does not depend on file position.
+ *        Not allocated blocks (file holes) are read as zeros.
+ *
+ * @param node                  file node
+ * @param blk                   block number
+ * @param len                   required length of block (used if created)
+ * @param create                create block (and index) if not exist
+ * @param block                 found block (NULL if not exist)
+ *
+ * @retval One of errno value (errno.h)
+ */
+//==============================================================================
+static int get_block(node_t *node, u64_t blk, size_t len, bool create, u8_t **block)
+{
+        file_data_t *file = &node->data.file;
+        int          err  = ESUCC;
+
+        *block = NULL;
+
+        /* grow tree to cover selected block */
+        while ((blk >> (INDEX_SHIFT * file->height)) > 0) {
+                if (!create) {
+                        return ESUCC;
+                }
+
+                if (file->height >= INDEX_MAX_HEIGHT) {
+                        return EFBIG;
+                }
+
+                if (file->root) {
+                        /* small file becomes indexed: first block must be complete */
+                        err = resize_tail_block(file, DATA_BLOCK_SIZE);
+                        if (err) {
+                                return err;
+                        }
+
+                        void **index;
+                        err = sys_zalloc(INDEX_FANOUT * sizeof(void*), cast(void**, &index));
+                        if (err) {
+                                return err;
+                        }
+
+                        index[0]   = file->root;
+                        file->root = index;
+                }
+
+                file->height++;
+        }
+
+        /* small file: single data block allocated by tail size */
+        if (file->height == 0) {
+                if (create) {
+                        err = resize_tail_block(file, len);
+                }
+
+                *block = file->root;
+                return err;
+        }
+
+        /* walk through index levels */
+        void **slot = &file->root;
+
+        for (int level = file->height; level >= 0; level--) {
+                if (*slot == NULL) {
+                        if (!create) {
+                                return ESUCC;
+                        }
+
+                        size_t size = level ? INDEX_FANOUT * sizeof(void*) : DATA_BLOCK_SIZE;
+                        err = sys_zalloc(size, slot);
+                        if (err) {
+                                return err;
+                        }
+                }
+
+                if (level > 0) {
+                        size_t idx = (blk >> (INDEX_SHIFT * (level - 1))) & (INDEX_FANOUT - 1);
+                        slot = &cast(void**, *slot)[idx];
+                }
+        }
+
+        *block = *slot;
+
+        return err;
+}
+
 //==============================================================================
 /**
  * @brief Function clear data of regular file.
@@ -1412,16 +1941,12 @@ static int add_node_to_open_files_list(struct RAMFS *hdl,
 //==============================================================================
 static void clear_regular_file(node_t *node)
 {
-        data_chain_t *chain = node->data.data_chain_t;
-
-        while (chain) {
-                data_chain_t *next = chain->next;
-                sys_free(cast(void**, &chain));
-                chain = next;
-        }
+        free_blocks(node->data.file.root, node->data.file.height);
 
         node->size = 0;
-        node->data.data_chain_t = NULL;
+        node->data.file.root      = NULL;
+        node->data.file.tail_size = 0;
+        node->data.file.height    = 0;
 }
 
 //==============================================================================
@@ -1440,53 +1965,28 @@ static void clear_regular_file(node_t *node)
 static int write_regular_file(node_t *node, const u8_t *src,
                               size_t count, fpos_t fpos, size_t *wrcnt)
 {
-        int           err   = ESUCC;
-        data_chain_t *chain = node->data.data_chain_t;
-        size_t        depth = fpos / DATA_CHAIN_SIZE;
-        size_t        seek  = fpos - (depth * DATA_CHAIN_SIZE);
+        int err = ESUCC;
 
-        if (chain == NULL) {
-                err = sys_zalloc(sizeof(data_chain_t), cast(void**, &chain));
-                if (!err) {
-                        node->data.data_chain_t = chain;
-                }
-        }
+        while (count) {
+                size_t seek = fpos % DATA_BLOCK_SIZE;
 
-        // travel to selected chain
-        while (!err && depth) {
-                if (chain->next == NULL) {
-                        err = sys_zalloc(sizeof(data_chain_t),
-                                         cast(void**, &chain->next));
-                }
+                size_t tocpy = min(DATA_BLOCK_SIZE - seek, count);
 
-                chain = chain->next;
-                depth--;
-        }
+                u8_t *block;
+                err = get_block(node, fpos / DATA_BLOCK_SIZE, seek + tocpy, true, &block);
+                if (err) {
+                        break;
+                }
 
-        // at position
-        while (!err && count) {
-                size_t tocpy = min(DATA_CHAIN_SIZE - seek, count);
-                memcpy(&chain->buf[seek], src, tocpy);
+                memcpy(&block[seek], src, tocpy);
                 src    += tocpy;
                 fpos   += tocpy;
                 *wrcnt += tocpy;
                 count  -= tocpy;
-                seek    = 0;
-
-                if (count) {
-                        if (chain->next == NULL) {
-                                err = sys_zalloc(sizeof(data_chain_t),
-                                                 cast(void**, &chain->next));
-                        }
-
-                        chain = chain->next;
-                }
         }
 
         // calculate file size
-        if (depth == 0) {
-                node->size = max(node->size, fpos);
-        }
+        node->size = max(node->size, fpos);
 
         return err;
 }
@@ -1509,24 +2009,27 @@ static int read_regular_file(node_t *node, u8_t *dst,
 {
         int err = ESUCC;
 
-        data_chain_t *chain = node->data.data_chain_t;
-        size_t        depth = fpos / DATA_CHAIN_SIZE;
-        size_t        seek  = fpos - (depth * DATA_CHAIN_SIZE);
+        while (count && fpos < node->size) {
+                size_t seek  = fpos % DATA_BLOCK_SIZE;
+                size_t tocpy = min(DATA_BLOCK_SIZE - seek, count);
+                       tocpy = min(tocpy, node->size - fpos);
 
-        for (; chain && depth; chain = chain->next, depth--);
+                u8_t *block;
+                err = get_block(node, fpos / DATA_BLOCK_SIZE, 0, false, &block);
+                if (err) {
+                        break;
+                }
 
-        while (chain && count && fpos < node->size) {
-                size_t tocpy = min(DATA_CHAIN_SIZE - seek, count);
-                       tocpy = min(tocpy, node->size - fpos);
+                if (block) {
+                        memcpy(dst, &block[seek], tocpy);
+                } else {
+                        memset(dst, 0, tocpy);
+                }
 
-                memcpy(dst, &chain->buf[seek], tocpy);
                 dst    += tocpy;
                 fpos   += tocpy;
                 *rdcnt += tocpy;
                 count  -= tocpy;
-                seek    = 0;
-
-                chain = chain->next;
         }
 
         return err;
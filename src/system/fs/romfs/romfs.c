@@ -34,18 +34,35 @@ Brief   ROM File System
 /*==============================================================================
   Local macros
 ==============================================================================*/
+#define CACHE_BLOCKS            __ROMFS_CFG_CACHE_BLOCKS__
 
 /*==============================================================================
   Local object types
 ==============================================================================*/
+/* decompressed block */
 typedef struct {
-        sem_t *openfiles;
+        const romfs_file_t *file;
+        u32_t               block;
+        u32_t               stamp;
+        u8_t               *buf;
+} cache_t;
+
+typedef struct {
+        sem_t   *openfiles;
+        mutex_t *mtx;
+        u32_t    stamp;
+        cache_t  cache[CACHE_BLOCKS];
 } romfs_t;
 
 /*==============================================================================
   Local function prototypes
 ==============================================================================*/
 static int get_entry(const char *path, const romfs_entry_t **entry);
+static int find_entry(const romfs_dir_t *dir, const char *name, size_t nlen, const romfs_entry_t **entry);
+static size_t file_size(const romfs_entry_t *entry);
+static int read_block(romfs_t *hdl, const romfs_file_t *file, u32_t block, u8_t *dst, size_t seek, size_t len);
+static int get_block(romfs_t *hdl, const romfs_file_t *file, u32_t block, const u8_t **buf);
+static int lz4_decompress(const u8_t *src, size_t srclen, u8_t *dst, size_t dstlen, size_t *len);
 
 /*==============================================================================
   Local objects
@@ -56,6 +73,7 @@ static int get_entry(const char *path, const romfs_entry_t **entry);
 ==============================================================================*/
 extern const romfs_dir_t romfsdir_root;
 extern const size_t romfs_total_size;
+extern const size_t romfs_block_size;
 extern const size_t romfs_files;
 
 /*==============================================================================
@@ -86,6 +104,13 @@ API_FS_INIT(romfs, void **fs_handle, const char *src_path, const char *opts)
                 romfs_t *hdl = *fs_handle;
 
                 err = sys_semaphore_create(65536, 0, &hdl->openfiles);
+                if (!err) {
+                        err = sys_mutex_create(MUTEX_TYPE_NORMAL, &hdl->mtx);
+                        if (err) {
+                                sys_semaphore_destroy(hdl->openfiles);
+                        }
+                }
+
                 if (err) {
                         sys_free(fs_handle);
                 }
@@ -112,6 +137,13 @@ API_FS_RELEASE(romfs, void *fs_handle)
         int err = sys_semaphore_get_value(hdl->openfiles, &openfiles);
         if (!err) {
                 if (openfiles == 0) {
+                        for (size_t i = 0; i < CACHE_BLOCKS; i++) {
+                                if (hdl->cache[i].buf) {
+                                        sys_free(cast(void**, &hdl->cache[i].buf));
+                                }
+                        }
+
+                        sys_mutex_destroy(hdl->mtx);
                         sys_semaphore_destroy(hdl->openfiles);
                         hdl->openfiles = NULL;
                         err = sys_free(&fs_handle);
@@ -211,7 +243,10 @@ API_FS_WRITE(romfs,
 
 //==============================================================================
 /**
- * @brief Read data from file.
+ * @brief Read data from file. Not compressed blocks are copied directly from
+ *        the image, compressed whole blocks are decompressed directly to the
+ *        destination buffer and parts of compressed blocks are read through
+ *        the block cache.
  *
  * @param[in ]          *fs_handle              file system allocated memory
  * @param[in ]          *fhdl                   file handle
@@ -233,23 +268,43 @@ API_FS_READ(romfs,
             size_t          *rdcnt,
             struct vfs_fattr fattr)
 {
-        UNUSED_ARG2(fs_handle, fattr);
+        UNUSED_ARG1(fattr);
 
-        int err = EFAULT;
+        romfs_t             *hdl   = fs_handle;
+        const romfs_entry_t *entry = fhdl;
 
-        romfs_entry_t *entry = fhdl;
-        if (entry) {
-                i32_t len = ((entry->size) ? *entry->size : 0) - *fpos;
-                      len = min((i32_t)count, len);
+        if (!entry) {
+                return EFAULT;
+        }
 
-                if (len > 0) {
-                        memcpy(dst, entry->data + *fpos, len);
-                        *rdcnt = len;
-                } else {
-                        *rdcnt = 0;
+        const romfs_file_t *file = entry->data;
+
+        *rdcnt = 0;
+
+        if (*fpos >= file->size) {
+                return ESUCC;
+        }
+
+        size_t len = min(count, cast(size_t, file->size - *fpos));
+        size_t pos = *fpos;
+
+        int err = sys_mutex_lock(hdl->mtx, MAX_DELAY_MS);
+        if (!err) {
+                while (!err && len) {
+                        u32_t  block = pos / romfs_block_size;
+                        size_t seek  = pos % romfs_block_size;
+                        size_t n     = min(len, romfs_block_size - seek);
+
+                        err = read_block(hdl, file, block, dst, seek, n);
+                        if (!err) {
+                                dst    += n;
+                                pos    += n;
+                                len    -= n;
+                                *rdcnt += n;
+                        }
                 }
 
-                err = ESUCC;
+                sys_mutex_unlock(hdl->mtx);
         }
 
         return err;
@@ -311,7 +366,7 @@ API_FS_FSTAT(romfs, void *fs_handle, void *fhdl, struct stat *stat)
                 stat->st_ctime = COMPILE_EPOCH_TIME;
                 stat->st_mtime = COMPILE_EPOCH_TIME;
                 stat->st_dev   = 0;
-                stat->st_size  = entry->size ? *entry->size : 0;
+                stat->st_size  = file_size(entry);
                 stat->st_gid   = 0;
                 stat->st_uid   = 0;
                 stat->st_mode  = S_IRUSR | S_IRGRP | S_IROTH
@@ -497,8 +552,7 @@ API_FS_READDIR(romfs, void *fs_handle, DIR *dir)
         if (d && (dir->d_seek < d->items)) {
                 dir->dirent.dev    = 0;
                 dir->dirent.d_name = d->entry[dir->d_seek].name;
-                dir->dirent.size   = d->entry[dir->d_seek].size
-                                   ? *d->entry[dir->d_seek].size : 0;
+                dir->dirent.size   = file_size(&d->entry[dir->d_seek]);
                 dir->dirent.mode   = S_IRUSR | S_IRGRP | S_IROTH
                                  | (d->entry[dir->d_seek].type == ROMFS_FILE_TYPE__DIR
                                    ? S_IFDIR : S_IFREG);
@@ -596,6 +650,21 @@ API_FS_SYNC(romfs, void *fs_handle)
         return ESUCC;
 }
 
+//==============================================================================
+/**
+ * @brief Check if file system has data to synchronize.
+ *
+ * @param[in ]          *fs_handle              file system allocated memory
+ *
+ * @return Always false, file system has no data to synchronize.
+ */
+//==============================================================================
+API_FS_DIRTY(romfs, void *fs_handle)
+{
+        UNUSED_ARG1(fs_handle);
+        return false;
+}
+
 //==============================================================================
 /**
  * @brief Search entry by path.
@@ -610,74 +679,298 @@ static int get_entry(const char *path, const romfs_entry_t **entry)
 {
         static const romfs_entry_t root = {
                 .type = ROMFS_FILE_TYPE__DIR,
-                .size = NULL,
                 .data = &romfsdir_root,
                 .name = "/"
         };
 
-        int err = ENOENT;
+        const romfs_entry_t *ent = &root;
 
-        if (strcmp(path, "/") == 0) {
-                *entry = &root;
-                err    = ESUCC;
+        int err = ESUCC;
 
+        while (!err && *path) {
+                while (*path == '/') {
+                        path++;
+                }
+
+                size_t nlen = strcspn(path, "/");
+                if (nlen == 0) {
+                        break;
+                }
+
+                if (ent->type == ROMFS_FILE_TYPE__DIR) {
+                        err   = find_entry(ent->data, path, nlen, &ent);
+                        path += nlen;
+                } else {
+                        err = ENOTDIR;
+                }
+        }
+
+        if (!err) {
+                *entry = ent;
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief Search entry in directory. Entries are sorted by name, so entry is
+ *        found by binary search.
+ *
+ * @param  dir          directory
+ * @param  name         entry name (not terminated)
+ * @param  nlen         name length
+ * @param  entry        found entry
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+static int find_entry(const romfs_dir_t *dir, const char *name, size_t nlen,
+                      const romfs_entry_t **entry)
+{
+        size_t lo = 0;
+        size_t hi = dir->items;
+
+        while (lo < hi) {
+                size_t mid = lo + (hi - lo) / 2;
+
+                const romfs_entry_t *ent = &dir->entry[mid];
+
+                int cmp = strncmp(ent->name, name, nlen);
+                if (cmp == 0) {
+                        cmp = (ent->name[nlen] == '\0') ? 0 : 1;
+                }
+
+                if (cmp == 0) {
+                        *entry = ent;
+                        return ESUCC;
+
+                } else if (cmp < 0) {
+                        lo = mid + 1;
+
+                } else {
+                        hi = mid;
+                }
+        }
+
+        return ENOENT;
+}
+
+//==============================================================================
+/**
+ * @brief Return size of entry.
+ *
+ * @param  entry        entry
+ *
+ * @return File size, 0 for directories.
+ */
+//==============================================================================
+static size_t file_size(const romfs_entry_t *entry)
+{
+        if (entry->type == ROMFS_FILE_TYPE__FILE) {
+                return cast(const romfs_file_t*, entry->data)->size;
         } else {
-                path++;
+                return 0;
+        }
+}
 
-                const romfs_dir_t   *dir = &romfsdir_root;
-                const romfs_entry_t *ent = NULL;
-                bool               found = false;
+//==============================================================================
+/**
+ * @brief Read part of file block.
+ *
+ * @param  hdl          file system handle
+ * @param  file         file
+ * @param  block        block number
+ * @param  dst          destination buffer
+ * @param  seek         position in block
+ * @param  len          number of bytes to read (must be in block)
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+static int read_block(romfs_t *hdl, const romfs_file_t *file, u32_t block,
+                      u8_t *dst, size_t seek, size_t len)
+{
+        u32_t  offset = file->index[block];
+        size_t blen   = min(romfs_block_size, file->size - block * romfs_block_size);
+        int    err    = ESUCC;
 
-                do {
-                        const char *end = strchr(path, '/');
-                        size_t nlen = (end == NULL)
-                                    ? strlen(path)
-                                    : ((uintptr_t)end - (uintptr_t)path);
+        if (offset & ROMFS_BLOCK_RAW) {
+                memcpy(dst, &file->data[(offset & ~ROMFS_BLOCK_RAW) + seek], len);
 
-                        if (nlen == 0) break;
+        } else if ((seek == 0) && (len == blen)) {
+                size_t clen = (file->index[block + 1] & ~ROMFS_BLOCK_RAW) - offset;
+                size_t n    = 0;
 
-                        found = false;
+                err = lz4_decompress(&file->data[offset], clen, dst, len, &n);
+                if (!err && (n != len)) {
+                        err = EILSEQ;
+                }
 
-                        for (size_t i = 0; i < dir->items; i++) {
+        } else {
+                const u8_t *buf;
+                err = get_block(hdl, file, block, &buf);
+                if (!err) {
+                        memcpy(dst, &buf[seek], len);
+                }
+        }
 
-                                ent = &dir->entry[i];
+        return err;
+}
 
-                                if (  (strlen(ent->name) == nlen)
-                                   && (strncmp(ent->name, path, nlen) == 0) ) {
+//==============================================================================
+/**
+ * @brief Return decompressed block from the cache. If block is not cached then
+ *        the least recently used cache block is replaced.
+ *
+ * @param  hdl          file system handle
+ * @param  file         file
+ * @param  block        block number
+ * @param  buf          decompressed block
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+static int get_block(romfs_t *hdl, const romfs_file_t *file, u32_t block, const u8_t **buf)
+{
+        cache_t *slot = &hdl->cache[0];
+
+        for (size_t i = 0; i < CACHE_BLOCKS; i++) {
+                cache_t *c = &hdl->cache[i];
 
-                                        found = true;
-                                        path += nlen;
+                if ((c->file == file) && (c->block == block)) {
+                        c->stamp = ++hdl->stamp;
+                        *buf     = c->buf;
+                        return ESUCC;
+                }
 
-                                        if ((*path != '\0') && strcmp(path, "/")) {
-                                                path++;
+                if (c->stamp < slot->stamp) {
+                        slot = c;
+                }
+        }
 
-                                                if (ent->type == ROMFS_FILE_TYPE__DIR) {
-                                                        dir = ent->data;
+        int err = ESUCC;
 
-                                                } else {
-                                                        err = ENOTDIR;
-                                                        goto finish;
-                                                }
-                                        } else {
-                                                err = ESUCC;
-                                                goto finish;
-                                        }
+        if (!slot->buf) {
+                err = sys_malloc(romfs_block_size, cast(void**, &slot->buf));
+        }
 
-                                        break;
-                                }
-                        }
+        if (!err) {
+                u32_t  offset = file->index[block];
+                size_t clen   = (file->index[block + 1] & ~ROMFS_BLOCK_RAW) - offset;
+                size_t blen   = min(romfs_block_size, file->size - block * romfs_block_size);
+                size_t n      = 0;
 
-                } while (*path && dir && found);
+                slot->file  = NULL;
+                slot->stamp = 0;
+
+                err = lz4_decompress(&file->data[offset], clen, slot->buf, blen, &n);
+                if (!err && (n != blen)) {
+                        err = EILSEQ;
+                }
 
-                finish:
                 if (!err) {
-                        *entry = ent;
+                        slot->file  = file;
+                        slot->block = block;
+                        slot->stamp = ++hdl->stamp;
+                        *buf        = slot->buf;
                 }
         }
 
         return err;
 }
 
+//==============================================================================
+/**
+ * @brief Decompress LZ4 block.
+ *
+ * @param  src          compressed data
+ * @param  srclen       size of compressed data
+ * @param  dst          destination buffer
+ * @param  dstlen       size of destination buffer
+ * @param  len          number of decompressed bytes
+ *
+ * @return One of errno value. EILSEQ is returned if data are corrupted.
+ */
+//==============================================================================
+static int lz4_decompress(const u8_t *src, size_t srclen, u8_t *dst, size_t dstlen, size_t *len)
+{
+        const u8_t *send = src + srclen;
+        u8_t       *d    = dst;
+        u8_t       *dend = dst + dstlen;
+
+        while (src < send) {
+                u8_t   token = *src++;
+                size_t lit   = token >> 4;
+
+                if (lit == 15) {
+                        u8_t b;
+                        do {
+                                if (src >= send) {
+                                        return EILSEQ;
+                                }
+
+                                b    = *src++;
+                                lit += b;
+                        } while (b == 255);
+                }
+
+                if ((lit > cast(size_t, send - src)) || (lit > cast(size_t, dend - d))) {
+                        return EILSEQ;
+                }
+
+                memcpy(d, src, lit);
+                d   += lit;
+                src += lit;
+
+                // last sequence contains only literals
+                if (src >= send) {
+                        break;
+                }
+
+                if ((send - src) < 2) {
+                        return EILSEQ;
+                }
+
+                size_t offset = src[0] | (src[1] << 8);
+                src += 2;
+
+                if ((offset == 0) || (offset > cast(size_t, d - dst))) {
+                        return EILSEQ;
+                }
+
+                size_t mlen = token & 15;
+
+                if (mlen == 15) {
+                        u8_t b;
+                        do {
+                                if (src >= send) {
+                                        return EILSEQ;
+                                }
+
+                                b     = *src++;
+                                mlen += b;
+                        } while (b == 255);
+                }
+
+                mlen += 4;
+
+                if (mlen > cast(size_t, dend - d)) {
+                        return EILSEQ;
+                }
+
+                // match can overlap with copied data
+                const u8_t *m = d - offset;
+                while (mlen--) {
+                        *d++ = *m++;
+                }
+        }
+
+        *len = d - dst;
+
+        return ESUCC;
+}
+
 /*==============================================================================
   End of file
 ==============================================================================*/
@@ -48,6 +48,8 @@ extern "C" {
 /*==============================================================================
   Exported macros
 ==============================================================================*/
+/** block index flag: block is stored not compressed */
+#define ROMFS_BLOCK_RAW         0x80000000UL
 
 /*==============================================================================
   Exported object types
@@ -58,13 +60,31 @@ typedef enum {
         ROMFS_FILE_TYPE__FILE,
 } romfs_file_type_t;
 
+/*
+ * File is divided into blocks of romfs_block_size bytes. Each block is
+ * compressed separately (LZ4 block format) or stored not compressed if
+ * compression does not reduce its size. Index contains offset of each block
+ * in data and offset of data end (blocks + 1 items).
+ */
+typedef struct {
+        uint32_t size;
+        uint32_t blocks;
+        const uint32_t *index;
+        const uint8_t *data;
+} romfs_file_t;
+
+/*
+ * Directory entry. Data points to romfs_dir_t or romfs_file_t object.
+ */
 typedef struct {
         romfs_file_type_t type;
-        const size_t *size;
         const void *data;
         const char *name;
 } romfs_entry_t;
 
+/*
+ * Directory. Entries are sorted by name.
+ */
 typedef struct {
         size_t items;
         romfs_entry_t entry[];
@@ -1,57 +1,156 @@
 import os
 import sys
-import binascii
-import array
-import re
+import struct
 import hashlib
 
 try:
     walk_dir = sys.argv[1]
     dest_dir = sys.argv[2]
 except:
-    print("Usage: python romfsmap.py <source-dir> <output-dir>\n")
+    print("Usage: python romfsmap.py <source-dir> <output-dir> [block-size] [compress: _YES_|_NO_]\n")
     exit(1)
 
+block_size = int(sys.argv[3]) if len(sys.argv) > 3 else 1024
+compress   = (sys.argv[4] != "_NO_") if len(sys.argv) > 4 else True
+
 file_dict  = {}
 total_size = 0
+image_size = 0
+
+# block index flag: block is stored not compressed
+BLOCK_RAW = 0x80000000
+
+# LZ4 block format constraints
+MINMATCH     = 4
+LASTLITERALS = 5
+MFLIMIT      = 12
+MAX_OFFSET   = 65535
+
+
+def lz4_length(out, length):
+    while length >= 255:
+        out.append(255)
+        length = length - 255
+
+    out.append(length)
+
+
+def lz4_compress(src):
+    n      = len(src)
+    out    = bytearray()
+    table  = {}
+    anchor = 0
+    pos    = 0
+
+    while pos <= n - MFLIMIT:
+        key = bytes(src[pos:pos + MINMATCH])
+        ref = table.get(key)
+        table[key] = pos
+
+        if ref is None or pos - ref > MAX_OFFSET:
+            pos = pos + 1
+            continue
+
+        mlen = MINMATCH
+        while mlen < n - LASTLITERALS - pos and src[ref + mlen] == src[pos + mlen]:
+            mlen = mlen + 1
+
+        lit = pos - anchor
+        out.append((min(lit, 15) << 4) | min(mlen - MINMATCH, 15))
+        if lit >= 15:
+            lz4_length(out, lit - 15)
+
+        out += src[anchor:pos]
+        out += struct.pack("<H", pos - ref)
+
+        if mlen - MINMATCH >= 15:
+            lz4_length(out, mlen - MINMATCH - 15)
+
+        for i in range(pos + 1, min(pos + mlen, n - MFLIMIT + 1)):
+            table[bytes(src[i:i + MINMATCH])] = i
+
+        pos    = pos + mlen
+        anchor = pos
+
+    lit = n - anchor
+    out.append(min(lit, 15) << 4)
+    if lit >= 15:
+        lz4_length(out, lit - 15)
+
+    out += src[anchor:]
+
+    return out
+
+
+def write_array(fout, ctype, name, items, fmt):
+    fout.write("static const " + ctype + " " + name + "[" + str(max(len(items), 1)) + "] = {\n    ")
+
+    if not items:
+        fout.write("0")
+
+    ctr = 0
+    for item in items:
+        fout.write(fmt % item + ', ')
+        ctr = ctr + 1
+        if ctr >= (16 if ctype == "uint8_t" else 8):
+            fout.write('\n    ')
+            ctr = 0
+
+    fout.write("\n};\n\n")
 
 
 def file2carray(src_path, pointdir, filename):
 
     global file_dict
     global total_size
+    global image_size
 
-    filecontent = open(src_path, "rb").read()
+    filecontent = bytearray(open(src_path, "rb").read())
     total_size  = total_size + len(filecontent)
 
     hash_object = hashlib.sha1(filecontent)
     hash_name   = hash_object.hexdigest()
 
+    # split file to blocks, compressed block is used only if it is smaller
+    index = []
+    data  = bytearray()
+
+    for offset in range(0, len(filecontent), block_size):
+        block = filecontent[offset:offset + block_size]
+        packed = lz4_compress(block) if compress else block
+
+        if len(packed) < len(block):
+            index.append(len(data))
+            data += packed
+        else:
+            index.append(len(data) | BLOCK_RAW)
+            data += block
+
+    index.append(len(data))
+    image_size = image_size + len(data) + 4 * len(index)
+
     outfile = os.path.join(dest_dir, hash_name) + '.c'
 
-    fout = open(outfile, "wb")
+    fout = open(outfile, "w")
     fout.write("// file generated\n")
     fout.write("// source file: " + src_path + '\n')
     fout.write("#include <stddef.h>\n")
-    fout.write("#include <stdint.h>\n\n")
-
-    fout.write("const uint8_t romfsfile_" + hash_name + "["+ str(len(filecontent)) +"] = {\n    ")
-
-    ctr = 0
-    for byte in filecontent:
-        fout.write('0x' + binascii.hexlify(byte) + ', ')
-        ctr = ctr + 1
-        if ctr >= 16:
-            fout.write('\n    ')
-            ctr = 0
+    fout.write("#include <stdint.h>\n")
+    fout.write('#include "romfs_types.h"\n\n')
 
-    fout.write("\n};\n\n")
+    write_array(fout, "uint32_t", "index", index, "0x%08x")
+    write_array(fout, "uint8_t", "data", data, "0x%02x")
 
-    fout.write("const size_t romfsfile_" + hash_name + "_size = " + str(len(filecontent)) + ";\n")
+    fout.write("const romfs_file_t romfsfile_" + hash_name + " = {\n")
+    fout.write("    .size   = " + str(len(filecontent)) + ",\n")
+    fout.write("    .blocks = " + str(len(index) - 1) + ",\n")
+    fout.write("    .index  = index,\n")
+    fout.write("    .data   = data,\n")
+    fout.write("};\n")
 
     fout.close()
 
-    with open(os.path.join(dest_dir, "Makefile.in"), "ab") as mk:
+    with open(os.path.join(dest_dir, "Makefile.in"), "a") as mk:
         mk.write("               fs/romfs/" + outfile + '\\\n')
 
     file_dict[src_path] = hash_name
@@ -61,13 +160,13 @@ def hashdir(dirname, subdirs, files):
 
     global file_dict
 
-    hash_object = hashlib.sha1(dirname)
+    hash_object = hashlib.sha1(dirname.encode())
 
     for subdir in subdirs:
-        hash_object.update(subdir)
+        hash_object.update(subdir.encode())
 
     for file in files:
-        hash_object.update(file)
+        hash_object.update(file.encode())
 
     hash_name = hash_object.hexdigest()
 
@@ -82,58 +181,56 @@ def dir2c(dirname, subdirs, files):
 
     outfile = os.path.join(dest_dir, "root" if dirname == "/" else file_dict[dirname]) + '.c'
 
-    fout = open(outfile, "wb")
+    fout = open(outfile, "w")
     fout.write("// file generated\n")
     fout.write("// source dir: " + walk_dir + dirname + '\n')
     fout.write("#include <stdint.h>\n")
     fout.write("#include <stddef.h>\n")
     fout.write('#include "romfs_types.h"\n\n')
 
+    # entries are sorted by name (byte order), directory is binary searched
+    entries = []
+
     for subdir in subdirs:
         name = file_dict[(dirname if dirname != "/" else "") + '/' + subdir]
         fout.write("extern const romfs_dir_t romfsdir_" + name + ";\n")
+        entries.append((subdir, "ROMFS_FILE_TYPE__DIR", "&romfsdir_" + name))
 
     for file in files:
         name = file_dict[walk_dir + (dirname if dirname != "/" else "") + '/' + file]
-        fout.write("extern const uint8_t romfsfile_" + name + "[];\n")
-        fout.write("extern const size_t romfsfile_" + name + "_size;\n")
+        fout.write("extern const romfs_file_t romfsfile_" + name + ";\n")
+        entries.append((file, "ROMFS_FILE_TYPE__FILE", "&romfsfile_" + name))
+
+    entries.sort(key=lambda entry: bytearray(entry[0].encode()))
 
     fout.write("\n")
 
     name = "root" if dirname == "/" else file_dict[dirname]
 
     fout.write("const romfs_dir_t romfsdir_" + name + " = {\n")
-    fout.write("    .items = " + str(len(subdirs) + len(files)) + ",\n")
-
-    entry = 0
+    fout.write("    .items = " + str(len(entries)) + ",\n")
 
-    for subdir in subdirs:
-        name = file_dict[(dirname if dirname != "/" else "") + '/' + subdir]
-        fout.write("    .entry[" + str(entry) + "] = {ROMFS_FILE_TYPE__DIR, NULL, &romfsdir_"
-                   + name + ', "' + subdir + '"},\n')
-        entry = entry + 1
-
-    for file in files:
-        name = file_dict[walk_dir + (dirname if dirname != "/" else "") + '/' + file]
-        fout.write("    .entry[" + str(entry) + "] = {ROMFS_FILE_TYPE__FILE, &romfsfile_"
-                   + name + "_size, &romfsfile_" + name + ', "' + file + '"},\n')
-        entry = entry + 1
+    for i, (entry_name, entry_type, entry_data) in enumerate(entries):
+        fout.write("    .entry[" + str(i) + "] = {" + entry_type + ", " + entry_data
+                   + ', "' + entry_name + '"},\n')
 
     fout.write("};\n\n")
 
     if dirname == "/":
         fout.write("const size_t romfs_total_size = " + str(total_size) + ';\n')
+        fout.write("const size_t romfs_image_size = " + str(image_size) + ';\n')
+        fout.write("const size_t romfs_block_size = " + str(block_size) + ';\n')
         fout.write("const size_t romfs_files = " + str(len(file_dict)) + ';\n')
 
     fout.close()
 
-    with open(os.path.join(dest_dir, "Makefile.in"), "ab") as mk:
+    with open(os.path.join(dest_dir, "Makefile.in"), "a") as mk:
         mk.write("               fs/romfs/" + outfile + '\\\n')
 
 
 def main():
     # prepare Makefile.in
-    with open(os.path.join(dest_dir, "Makefile.in"), "wb") as mk:
+    with open(os.path.join(dest_dir, "Makefile.in"), "w") as mk:
         mk.write("CSRC_CORE += $(sort\\\n")
 
 
@@ -169,10 +266,12 @@ def main():
 
 
     # prepare Makefile.in
-    with open(os.path.join(dest_dir, "Makefile.in"), "ab") as mk:
+    with open(os.path.join(dest_dir, "Makefile.in"), "a") as mk:
         mk.write("              )\n")
 
 
+    print("romfs: " + str(total_size) + " bytes of files stored in " + str(image_size) + " bytes")
+
     # DEBUG: print file hashes
     # for key, val in file_dict.iteritems(): print(key, val)
 
@@ -2,12 +2,20 @@
 
 root=$(pwd)
 data=../../../../build/romfs
+flags="${root}/config/filesystems/romfs_flags.h"
+
+get_flag() {
+    echo $(cat "${flags}" | grep -oP "^#\s*define\s+$1\s+(.*)" | sed "s/^#\s*define\s*$1\s*//g")
+}
 
 mkdir -p res/romfs
 
+block_size=$(get_flag __ROMFS_CFG_BLOCK_SIZE__)
+compress=$(get_flag __ROMFS_CFG_COMPRESSION__)
+
 cd $(dirname $0)
 
 rm -rf "${data}"
 mkdir -p "${data}"
 
-/usr/bin/python2.7 romfsmap.py "${root}/res/romfs" "${data}"
+/usr/bin/python2.7 romfsmap.py "${root}/res/romfs" "${data}" ${block_size:-1024} ${compress:-_YES_}
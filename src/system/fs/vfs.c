@@ -34,10 +34,13 @@
 #include <errno.h>
 #include <string.h>
 #include "fs/vfs.h"
+#include "fs/dcache.h"
+#include "fs/bcache.h"
 #include "lib/llist.h"
 #include "kernel/kwrapper.h"
 #include "kernel/process.h"
 #include "kernel/sysfunc.h"
+#include "mm/pool.h"
 
 /*==============================================================================
   Local symbolic constants/macros
@@ -45,6 +48,13 @@
 #undef errno
 #define PATH_MAX_LEN             256
 
+#define MNT_HASH_INIT            2166136261U
+#define MNT_HASH(_h, _c)         (((_h) ^ (u8_t)(_c)) * 16777619U)
+#define MNT_INDEX_MIN_BUCKETS    8
+
+#define SYNC_THREADS             __OS_SYSTEM_SYNC_THREADS__
+#define SYNC_FLAG_RELEASED       (1 << 0)
+
 /*==============================================================================
   Local types, enums definitions
 ==============================================================================*/
@@ -54,29 +64,78 @@ typedef struct FS_entry {
         void               *handle;
         const vfs_FS_itf_t *interface;
         u8_t                children_cnt;
+        u8_t                refs;
+        bool                dcache;
+        u32_t               fgen;       /* changed when any file is modified */
 } FS_entry_t;
 
+/* mount point of index bucket */
+typedef struct mnt_node {
+        struct mnt_node    *next;
+        FS_entry_t         *fs;
+        u32_t               hash;
+        size_t              len;
+} mnt_node_t;
+
+/* immutable snapshot of mount points hashed by path prefix */
+typedef struct mnt_index {
+        u32_t               readers;
+        bool                retired;
+        FS_entry_t         *unmounted;  /* entry freed with the index */
+        u32_t               mask;
+        mnt_node_t        **bucket;
+        mnt_node_t          node[];
+} mnt_index_t;
+
+/* synchronization of snapshot of mounted file systems */
+typedef struct sync_job {
+        FS_entry_t        **fs;
+        size_t              count;
+        size_t              next;
+} sync_job_t;
+
 /*==============================================================================
   Local function prototypes
 ==============================================================================*/
 static bool is_first_fs      (const char *mount_point);
 static int  new_FS_entry     (FS_entry_t *parent_FS, const char *fs_mount_point, const char *fs_src_file, const vfs_FS_itf_t *fs_interface, const char *opts, FS_entry_t **fs_entry);
 static int  delete_FS_entry  (FS_entry_t *this);
+static int  release_FS_entry (FS_entry_t *this);
+static void free_FS_entry    (FS_entry_t *this);
 static bool is_file_valid    (FILE *file);
 static bool is_dir_valid     (DIR *dir);
 static int  parse_flags      (const char *str, u32_t *flags);
 static int  get_path_FS      (const char *path, size_t len, int *position, FS_entry_t **fs_entry);
 static int  get_path_base_FS (const char *path, const char **extPath, FS_entry_t **fs_entry);
 static int  new_absolute_path(const struct vfs_path *path, enum path_correction corr, char **new_path);
+static int  mnt_index_build  (FS_entry_t *exclude, mnt_index_t **index);
+static mnt_index_t *mnt_index_swap(mnt_index_t *index);
+static mnt_index_t *mnt_index_acquire(void);
+static void mnt_index_release(mnt_index_t *index, bool retire);
+static void dcache_invalidate(FS_entry_t *fs, const char *path);
+static void file_modified    (FS_entry_t *fs, bool wr);
+static bool is_cached_ENOENT (FS_entry_t *fs, const char *path);
+static int  iov_size         (const struct iovec *iov, int iovcnt, size_t *size);
+static void sync_FS_list     (FS_entry_t **fs, size_t count);
+static void sync_job_run     (sync_job_t *job);
 
 /*==============================================================================
   Local object definitions
 ==============================================================================*/
 static struct {
-        llist_t *mnt_list;
-        mutex_t *resource_mtx;
+        llist_t     *mnt_list;
+        mutex_t     *resource_mtx;
+        mnt_index_t *mnt_index;
+        flag_t      *sync_flag;         /* file system reference released */
+        mutex_t     *sync_mtx;          /* workers serve one synchronization */
+        queue_t     *sync_queue;        /* jobs of synchronization workers */
+        sem_t       *sync_done;         /* job finished by worker */
+        size_t       sync_workers;      /* number of started workers */
 } VFS;
 
+static _mm_pool_t file_pool = _MM_POOL_INIT("vfs:file", _MM_KRN, sizeof(FILE), 8);
+static _mm_pool_t dir_pool  = _MM_POOL_INIT("vfs:dir" , _MM_KRN, sizeof(DIR) , 4);
+
 /*==============================================================================
   Function definitions
 ==============================================================================*/
@@ -95,6 +154,30 @@ int _vfs_init(void)
                 err = _mutex_create(MUTEX_TYPE_RECURSIVE, &VFS.resource_mtx);
         }
 
+        if (!err) {
+                err = _flag_create(&VFS.sync_flag);
+        }
+
+        if (!err && (SYNC_THREADS > 1)) {
+                err = _mutex_create(MUTEX_TYPE_NORMAL, &VFS.sync_mtx);
+
+                if (!err) {
+                        err = _queue_create(SYNC_THREADS, sizeof(sync_job_t*), &VFS.sync_queue);
+                }
+
+                if (!err) {
+                        err = _semaphore_create(SYNC_THREADS, 0, &VFS.sync_done);
+                }
+        }
+
+        if (!err) {
+                err = _dcache_init();
+        }
+
+        if (!err) {
+                err = _bcache_init();
+        }
+
         return err;
 }
 
@@ -228,6 +311,20 @@ int _vfs_mount(const struct vfs_path   *src_path,
                         }
                 }
 
+                /*
+                 * publish new mount point index
+                 */
+                if (!err) {
+                        mnt_index_t *index;
+                        err = mnt_index_build(NULL, &index);
+                        if (!err) {
+                                mnt_index_release(mnt_index_swap(index), true);
+                        } else {
+                                _llist_take_back(VFS.mnt_list);
+                                delete_FS_entry(new_fs);
+                        }
+                }
+
                 _mutex_unlock(VFS.resource_mtx);
         }
 
@@ -262,17 +359,47 @@ int _vfs_umount(const struct vfs_path *path)
         int err = new_absolute_path(path, ADD_SLASH, &cwd_path);
         if (not err) {
                 err = _mutex_lock(VFS.resource_mtx, MAX_DELAY_MS);
-                if (not err) {
+                while (not err) {
 
                         int         position;
                         FS_entry_t *mount_fs;
                         err = get_path_FS(cwd_path, PATH_MAX_LEN, &position, &mount_fs);
 
+                        if (not err && (mount_fs->refs > 0)) {
+                                /* file system is synchronized at the moment */
+                                _flag_clear(VFS.sync_flag, SYNC_FLAG_RELEASED);
+                                _mutex_unlock(VFS.resource_mtx);
+                                _flag_wait(VFS.sync_flag, SYNC_FLAG_RELEASED, MAX_DELAY_MS);
+                                err = _mutex_lock(VFS.resource_mtx, MAX_DELAY_MS);
+                                continue;
+                        }
+
                         if (not err) {
                                 if (mount_fs->children_cnt == 0) {
-                                        err = delete_FS_entry(mount_fs);
+                                        mnt_index_t *index;
+                                        err = mnt_index_build(mount_fs, &index);
                                         if (not err) {
-                                                _llist_take(VFS.mnt_list, position);
+                                                mnt_index_t *prev = mnt_index_swap(index);
+
+                                                dcache_invalidate(mount_fs, NULL);
+
+                                                /*
+                                                 * readers of previous index can
+                                                 * still examine the entry, so it
+                                                 * is freed with the index
+                                                 */
+                                                err = release_FS_entry(mount_fs);
+                                                if (not err) {
+                                                        _llist_take(VFS.mnt_list, position);
+                                                        if (prev) {
+                                                                prev->unmounted = mount_fs;
+                                                                mnt_index_release(prev, true);
+                                                        } else {
+                                                                free_FS_entry(mount_fs);
+                                                        }
+                                                } else {
+                                                        mnt_index_release(mnt_index_swap(prev), true);
+                                                }
                                         }
                                 } else {
                                         err = EBUSY;
@@ -280,6 +407,7 @@ int _vfs_umount(const struct vfs_path *path)
                         }
 
                         _mutex_unlock(VFS.resource_mtx);
+                        break;
                 }
 
                 _kfree(_MM_KRN, cast(void**, &cwd_path));
@@ -360,6 +488,7 @@ int _vfs_mknod(const struct vfs_path *path, dev_t dev)
                 err = get_path_base_FS(cwd_path, &external_path, &fs);
                 if (!err) {
                         err = fs->interface->fs_mknod(fs->handle, external_path, dev);
+                        dcache_invalidate(fs, external_path);
                 }
 
                 _kfree(_MM_KRN, cast(void**, &cwd_path));
@@ -394,6 +523,7 @@ int _vfs_mkdir(const struct vfs_path *path, mode_t mode)
                 err = get_path_base_FS(cwd_path, &external_path, &fs);
                 if (!err) {
                         err = fs->interface->fs_mkdir(fs->handle, external_path, S_IPMT(mode));
+                        dcache_invalidate(fs, external_path);
                 }
 
                 _kfree(_MM_KRN, cast(void**, &cwd_path));
@@ -429,6 +559,7 @@ int _vfs_mkfifo(const struct vfs_path *path, mode_t mode)
                 err = get_path_base_FS(cwd_path, &external_path, &fs);
                 if (!err) {
                         err = fs->interface->fs_mkfifo(fs->handle, external_path, S_IPMT(mode));
+                        dcache_invalidate(fs, external_path);
                 }
 
                 _kfree(_MM_KRN, cast(void**, &cwd_path));
@@ -454,7 +585,7 @@ int _vfs_opendir(const struct vfs_path *path, DIR **dir)
                 return EINVAL;
         }
 
-        int err = _kmalloc(_MM_KRN, sizeof(DIR), NULL, 0, 0, cast(void**, dir));
+        int err = _mm_pool_malloc(&dir_pool, cast(void**, dir));
         if (!err) {
                 char *cwd_path;
                 err = new_absolute_path(path, ADD_SLASH, &cwd_path);
@@ -468,7 +599,9 @@ int _vfs_opendir(const struct vfs_path *path, DIR **dir)
                                 (*dir)->FS_hdl = fs->handle;
                                 (*dir)->FS_if  = fs->interface;
 
-                                err = fs->interface->fs_opendir(fs->handle, external_path, *dir);
+                                err = is_cached_ENOENT(fs, external_path)
+                                    ? ENOENT
+                                    : fs->interface->fs_opendir(fs->handle, external_path, *dir);
                         }
 
                         _kfree(_MM_KRN, cast(void**, &cwd_path));
@@ -478,7 +611,7 @@ int _vfs_opendir(const struct vfs_path *path, DIR **dir)
                         (*dir)->header.self = *dir;
                         (*dir)->header.type = RES_TYPE_DIR;
                 } else {
-                        _kfree(_MM_KRN, cast(void**, dir));
+                        _mm_pool_free(&dir_pool, cast(void**, dir));
                 }
         }
 
@@ -503,7 +636,7 @@ int _vfs_closedir(DIR *dir)
                 if (!err) {
                         dir->header.self = NULL;
                         dir->header.type = RES_TYPE_UNKNOWN;
-                        _kfree(_MM_KRN, cast(void**, &dir));
+                        _mm_pool_free(&dir_pool, cast(void**, &dir));
                 }
         }
 
@@ -620,6 +753,7 @@ int _vfs_remove(const struct vfs_path *path)
 
                 if (!err) {
                         err = base_fs->interface->fs_remove(base_fs->handle, external_path);
+                        dcache_invalidate(base_fs, external_path);
                 }
 
                 _kfree(_MM_KRN, cast(void**, &cwd_path));
@@ -677,6 +811,9 @@ int _vfs_rename(const struct vfs_path *old_name, const struct vfs_path *new_name
                                 err = old_fs->interface->fs_rename(old_fs->handle,
                                                                    old_extern_path,
                                                                    new_extern_path);
+
+                                dcache_invalidate(old_fs, old_extern_path);
+                                dcache_invalidate(old_fs, new_extern_path);
                         } else {
                                 err = ENOTSUP;
                         }
@@ -721,6 +858,7 @@ int _vfs_chmod(const struct vfs_path *path, mode_t mode)
                 err = get_path_base_FS(cwd_path, &external_path, &fs);
                 if (!err) {
                         err = fs->interface->fs_chmod(fs->handle, external_path, S_IPMT(mode));
+                        dcache_invalidate(fs, external_path);
                 }
 
                 _kfree(_MM_KRN, cast(void**, &cwd_path));
@@ -757,6 +895,7 @@ int _vfs_chown(const struct vfs_path *path, uid_t owner, gid_t group)
                 err = get_path_base_FS(cwd_path, &external_path, &fs);
                 if (!err) {
                         err = fs->interface->fs_chown(fs->handle, external_path, owner, group);
+                        dcache_invalidate(fs, external_path);
                 }
 
                 _kfree(_MM_KRN, cast(void**, &cwd_path));
@@ -791,7 +930,18 @@ int _vfs_stat(const struct vfs_path *path, struct stat *stat)
                 FS_entry_t *fs;
                 err = get_path_base_FS(cwd_path, &external_path, &fs);
                 if (!err) {
-                        err = fs->interface->fs_stat(fs->handle, external_path, stat);
+                        u32_t fgen = fs->fgen;
+                        u32_t gen;
+
+                        if (  !fs->dcache
+                           || !_dcache_lookup(fs, external_path, fgen, stat, &err, &gen) ) {
+
+                                err = fs->interface->fs_stat(fs->handle, external_path, stat);
+
+                                if (fs->dcache) {
+                                        _dcache_insert(fs, external_path, fgen, gen, err, stat);
+                                }
+                        }
                 }
 
                 _kfree(_MM_KRN, cast(void**, &cwd_path));
@@ -876,18 +1026,26 @@ int _vfs_fopen(const struct vfs_path *path, const char *mode, FILE **file)
         }
 
         FILE *file_obj = NULL;
-        err = _kzalloc(_MM_KRN, sizeof(FILE), NULL, 0, 0, cast(void**, &file_obj));
+        err = _mm_pool_zalloc(&file_pool, cast(void**, &file_obj));
         if (!err && file_obj) {
 
                 const char *external_path;
                 FS_entry_t *fs;
                 err = get_path_base_FS(cwd_path, &external_path, &fs);
                 if (!err) {
-                        err = fs->interface->fs_open(fs->handle,
-                                                     &file_obj->f_hdl,
-                                                     &file_obj->f_lseek,
-                                                     external_path,
-                                                     o_flags);
+                        if (!(o_flags & O_CREAT) && is_cached_ENOENT(fs, external_path)) {
+                                err = ENOENT;
+                        } else {
+                                err = fs->interface->fs_open(fs->handle,
+                                                             &file_obj->f_hdl,
+                                                             &file_obj->f_lseek,
+                                                             external_path,
+                                                             o_flags);
+                        }
+
+                        if (o_flags & O_CREAT) {
+                                dcache_invalidate(fs, external_path);
+                        }
 
                         struct stat stat;
                         if (!err) {
@@ -909,6 +1067,7 @@ int _vfs_fopen(const struct vfs_path *path, const char *mode, FILE **file)
                                         file_obj->f_lseek = stat.st_size;
                                 }
 
+                                file_obj->FS_entry    = fs;
                                 file_obj->FS_hdl      = fs->handle;
                                 file_obj->FS_if       = fs->interface;
                                 file_obj->f_flag      = f_flags;
@@ -926,7 +1085,7 @@ int _vfs_fopen(const struct vfs_path *path, const char *mode, FILE **file)
                 if (file_obj->header.type == RES_TYPE_FILE) {
                         *file = file_obj;
                 } else {
-                        _kfree(_MM_KRN, cast(void**, &file_obj));
+                        _mm_pool_free(&file_pool, cast(void**, &file_obj));
                 }
         }
 
@@ -948,12 +1107,20 @@ int _vfs_fclose(FILE *file, bool force)
         int err = EINVAL;
 
         if (is_file_valid(file) && file->FS_if->fs_close) {
+                _bcache_release(file);
+
+                FS_entry_t *fs = file->FS_entry;
+                bool        wr = file->f_flag.wr;
+
                 err = file->FS_if->fs_close(file->FS_hdl, file->f_hdl, force);
+
+                file_modified(fs, wr);
+
                 if (!err) {
                         file->header.self = NULL;
                         file->header.type = RES_TYPE_UNKNOWN;
                         file->FS_hdl      = NULL;
-                        _kfree(_MM_KRN, cast(void**, &file));
+                        _mm_pool_free(&file_pool, cast(void**, &file));
                 }
         }
 
@@ -994,6 +1161,8 @@ int _vfs_fwrite(const void *ptr, size_t size, size_t *wrcnt, FILE *file)
                                                     wrcnt,
                                                     file->f_flag.fattr);
 
+                        file_modified(file->FS_entry, true);
+
                         if (!err) {
                                 if ((*wrcnt < size) && !file->f_flag.fattr.non_blocking_wr) {
                                         file->f_flag.eof = true;
@@ -1062,6 +1231,181 @@ int _vfs_fread(void *ptr, size_t size, size_t *rdcnt, FILE *file)
         return err;
 }
 
+//==============================================================================
+/**
+ * @brief Function write data vector to file at selected position
+ *
+ * If file system does not support vectored write then each vector element is
+ * written by single file system write call. Function write data at selected
+ * position and does not change file position indicator. If offset is NULL
+ * then data is written at current position and position is moved.
+ *
+ * @param[in]  file             pointer to file object
+ * @param[in]  iov              data vector
+ * @param[in]  iovcnt           number of vector elements
+ * @param[in]  offset           file position (NULL: current position)
+ * @param[out] wrcnt            number of written bytes
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+int _vfs_fpwritev(FILE *file, const struct iovec *iov, int iovcnt, const i64_t *offset, size_t *wrcnt)
+{
+        size_t size = 0;
+        int    err  = EINVAL;
+
+        if (wrcnt && is_file_valid(file) && (iov_size(iov, iovcnt, &size) == ESUCC)) {
+                *wrcnt = 0;
+
+                if (!file->f_flag.wr) {
+                        file->f_flag.error = true;
+                        return EPERM;
+                }
+
+                if (!offset && file->f_flag.append && file->f_flag.rd && file->f_flag.seekmod) {
+                        _vfs_fseek(file, 0, VFS_SEEK_END);
+                        file->f_flag.seekmod = false;
+                }
+
+                fpos_t fpos = offset ? cast(fpos_t, *offset) : file->f_lseek;
+
+                if (file->FS_if->fs_writev) {
+                        err = file->FS_if->fs_writev(file->FS_hdl, file->f_hdl,
+                                                     iov, iovcnt, &fpos, wrcnt,
+                                                     file->f_flag.fattr);
+                        if (!err) {
+                                fpos += *wrcnt;
+                        }
+
+                } else {
+                        err = ESUCC;
+
+                        for (int i = 0; (i < iovcnt) && !err; i++) {
+                                if (iov[i].iov_len == 0) {
+                                        continue;
+                                }
+
+                                size_t n = 0;
+                                err = file->FS_if->fs_write(file->FS_hdl, file->f_hdl,
+                                                            iov[i].iov_base, iov[i].iov_len,
+                                                            &fpos, &n, file->f_flag.fattr);
+                                if (!err) {
+                                        fpos   += n;
+                                        *wrcnt += n;
+
+                                        if (n < iov[i].iov_len) {
+                                                break;
+                                        }
+                                }
+                        }
+
+                        if (err && (*wrcnt > 0)) {
+                                err = ESUCC;
+                        }
+                }
+
+                file_modified(file->FS_entry, true);
+
+                if (!err) {
+                        if (!offset) {
+                                file->f_lseek = fpos;
+                        }
+
+                        if ((*wrcnt < size) && !file->f_flag.fattr.non_blocking_wr) {
+                                file->f_flag.eof = true;
+                        }
+                } else {
+                        file->f_flag.error = true;
+                }
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief Function read data vector from file at selected position
+ *
+ * If file system does not support vectored read then each vector element is
+ * read by single file system read call. Function read data at selected
+ * position and does not change file position indicator. If offset is NULL
+ * then data is read from current position and position is moved.
+ *
+ * @param[in]  file             pointer to file object
+ * @param[in]  iov              data vector
+ * @param[in]  iovcnt           number of vector elements
+ * @param[in]  offset           file position (NULL: current position)
+ * @param[out] rdcnt            number of read bytes
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+int _vfs_fpreadv(FILE *file, const struct iovec *iov, int iovcnt, const i64_t *offset, size_t *rdcnt)
+{
+        size_t size = 0;
+        int    err  = EINVAL;
+
+        if (rdcnt && is_file_valid(file) && (iov_size(iov, iovcnt, &size) == ESUCC)) {
+                *rdcnt = 0;
+
+                if (!file->f_flag.rd) {
+                        file->f_flag.error = true;
+                        return EPERM;
+                }
+
+                fpos_t fpos = offset ? cast(fpos_t, *offset) : file->f_lseek;
+
+                if (file->FS_if->fs_readv) {
+                        err = file->FS_if->fs_readv(file->FS_hdl, file->f_hdl,
+                                                    iov, iovcnt, &fpos, rdcnt,
+                                                    file->f_flag.fattr);
+                        if (!err) {
+                                fpos += *rdcnt;
+                        }
+
+                } else {
+                        err = ESUCC;
+
+                        for (int i = 0; (i < iovcnt) && !err; i++) {
+                                if (iov[i].iov_len == 0) {
+                                        continue;
+                                }
+
+                                size_t n = 0;
+                                err = file->FS_if->fs_read(file->FS_hdl, file->f_hdl,
+                                                           iov[i].iov_base, iov[i].iov_len,
+                                                           &fpos, &n, file->f_flag.fattr);
+                                if (!err) {
+                                        fpos   += n;
+                                        *rdcnt += n;
+
+                                        if (n < iov[i].iov_len) {
+                                                break;
+                                        }
+                                }
+                        }
+
+                        if (err && (*rdcnt > 0)) {
+                                err = ESUCC;
+                        }
+                }
+
+                if (!err) {
+                        if (!offset) {
+                                file->f_lseek = fpos;
+                        }
+
+                        if ((*rdcnt < size) && !file->f_flag.fattr.non_blocking_rd) {
+                                file->f_flag.eof = true;
+                        }
+                } else {
+                        file->f_flag.error = true;
+                }
+        }
+
+        return err;
+}
+
 //==============================================================================
 /**
  * @brief Function set seek value
@@ -1168,11 +1512,48 @@ int _vfs_vfioctl(FILE *file, int rq, va_list arg)
                 case IOCTL_VFS__IS_NON_BLOCKING_WR_MODE:
                         *va_arg(arg, bool*) = file->f_flag.fattr.non_blocking_wr;
                         return ESUCC;
+
+                case IOCTL_VFS__FALLOCATE: {
+                        const struct vfs_fallocate *range = va_arg(arg, const struct vfs_fallocate*);
+
+                        if (!range || (range->offset < 0) || (range->len <= 0)
+                           || (range->len > INT64_MAX - range->offset)) {
+                                return EINVAL;
+                        }
+
+                        if (!file->f_flag.wr) {
+                                return EPERM;
+                        }
+
+                        int err = file->FS_if->fs_ioctl(file->FS_hdl, file->f_hdl,
+                                                        rq, cast(void*, range));
+
+                        file_modified(file->FS_entry, true);
+
+                        return err;
+                }
+
+                case IOCTL_VFS__FSTRIM: {
+                        struct vfs_fstrim *fstrim = va_arg(arg, struct vfs_fstrim*);
+
+                        if (!fstrim) {
+                                return EINVAL;
+                        }
+
+                        fstrim->trimmed = 0;
+
+                        return file->FS_if->fs_ioctl(file->FS_hdl, file->f_hdl,
+                                                     rq, fstrim);
                 }
+                }
+
+                int err = file->FS_if->fs_ioctl(file->FS_hdl,
+                                                file->f_hdl,
+                                                rq, va_arg(arg, void*));
+
+                file_modified(file->FS_entry, file->f_flag.wr);
 
-                return file->FS_if->fs_ioctl(file->FS_hdl,
-                                             file->f_hdl,
-                                             rq, va_arg(arg, void*));
+                return err;
         } else {
                 return EINVAL;
         }
@@ -1214,6 +1595,8 @@ int _vfs_fflush(FILE *file)
 
         if (is_file_valid(file)) {
                 err = file->FS_if->fs_flush(file->FS_hdl, file->f_hdl);
+
+                file_modified(file->FS_entry, file->f_flag.wr);
         }
 
         return err;
@@ -1281,7 +1664,11 @@ int _vfs_ferror(FILE *file, int *error)
 
 //==============================================================================
 /**
- * @brief Synchronize internal buffers of mounted file systems
+ * @brief Synchronize internal buffers of mounted file systems. Modified file
+ *        systems are referenced under VFS lock and are synchronized after
+ *        the lock is released, so file system operations are not blocked by
+ *        long synchronization. Unmount of referenced file system waits until
+ *        synchronization is finished.
  *
  * @param None
  *
@@ -1290,14 +1677,156 @@ int _vfs_ferror(FILE *file, int *error)
 //==============================================================================
 void _vfs_sync(void)
 {
+        FS_entry_t **list  = NULL;
+        size_t       count = 0;
+
         if (_mutex_lock(VFS.resource_mtx, MAX_DELAY_MS) == ESUCC) {
 
-                _llist_foreach(FS_entry_t*, fs, VFS.mnt_list) {
-                        fs->interface->fs_sync(fs->handle);
+                size_t size = _llist_size(VFS.mnt_list);
+
+                if (size && (_kmalloc(_MM_KRN, size * sizeof(FS_entry_t*),
+                                      NULL, 0, 0, cast(void**, &list)) == ESUCC)) {
+
+                        _llist_foreach(FS_entry_t*, fs, VFS.mnt_list) {
+                                if (  !fs->interface->fs_dirty
+                                   || fs->interface->fs_dirty(fs->handle)) {
+                                        fs->refs++;
+                                        list[count++] = fs;
+                                }
+                        }
+
+                } else {
+                        _llist_foreach(FS_entry_t*, fs, VFS.mnt_list) {
+                                fs->interface->fs_sync(fs->handle);
+                        }
                 }
 
                 _mutex_unlock(VFS.resource_mtx);
         }
+
+        if (list) {
+                sync_FS_list(list, count);
+
+                if (_mutex_lock(VFS.resource_mtx, MAX_DELAY_MS) == ESUCC) {
+                        for (size_t i = 0; i < count; i++) {
+                                list[i]->refs--;
+                        }
+
+                        _flag_set(VFS.sync_flag, SYNC_FLAG_RELEASED);
+
+                        _mutex_unlock(VFS.resource_mtx);
+                }
+
+                _kfree(_MM_KRN, cast(void**, &list));
+        }
+
+        _bcache_sync(NULL);
+}
+
+//==============================================================================
+/**
+ * @brief  Synchronize selected file systems. File systems are synchronized by
+ *         the caller and the synchronization workers, so file systems of
+ *         different devices are synchronized in parallel. Workers serve one
+ *         synchronization at a time, concurrent synchronization and single
+ *         file system are synchronized by the caller only.
+ *
+ * @param  fs           referenced file systems
+ * @param  count        number of file systems
+ */
+//==============================================================================
+static void sync_FS_list(FS_entry_t **fs, size_t count)
+{
+        sync_job_t job = {.fs = fs, .count = count, .next = 0};
+
+        size_t workers = 0;
+        bool   locked  = false;
+
+        if (  (count > 1) && (VFS.sync_workers > 0)
+           && (_mutex_lock(VFS.sync_mtx, 0) == ESUCC) ) {
+
+                sync_job_t *job_ptr = &job;
+                locked = true;
+
+                while ((workers < min(count - 1, VFS.sync_workers))
+                      && (_queue_send(VFS.sync_queue, &job_ptr, 0) == ESUCC)) {
+                        workers++;
+                }
+        }
+
+        sync_job_run(&job);
+
+        while (workers--) {
+                _semaphore_wait(VFS.sync_done, MAX_DELAY_MS);
+        }
+
+        if (locked) {
+                _mutex_unlock(VFS.sync_mtx);
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function takes file systems from the job and synchronize them until
+ *         all file systems are synchronized.
+ *
+ * @param  job          synchronization job
+ */
+//==============================================================================
+static void sync_job_run(sync_job_t *job)
+{
+        for (;;) {
+                FS_entry_t *fs = NULL;
+
+                _critical_section_begin();
+                if (job->next < job->count) {
+                        fs = job->fs[job->next++];
+                }
+                _critical_section_end();
+
+                if (fs) {
+                        int err = fs->interface->fs_sync(fs->handle);
+
+                        file_modified(fs, true);
+
+                        if (err) {
+                                printk("VFS: unable to sync '%s' (%d)", fs->mount_point, err);
+                        }
+                } else {
+                        break;
+                }
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Synchronization worker thread. Worker takes jobs of parallel
+ *         synchronization. Thread is started by kworker (SYNC_THREADS-1
+ *         workers).
+ *
+ * @param  arg          not used
+ */
+//==============================================================================
+void _vfs_sync_worker(void *arg)
+{
+        UNUSED_ARG1(arg);
+
+        if (!VFS.sync_queue) {
+                return;
+        }
+
+        _critical_section_begin();
+        VFS.sync_workers++;
+        _critical_section_end();
+
+        for (;;) {
+                sync_job_t *job;
+
+                if (_queue_receive(VFS.sync_queue, &job, MAX_DELAY_MS) == ESUCC) {
+                        sync_job_run(job);
+                        _semaphore_signal(VFS.sync_done);
+                }
+        }
 }
 
 //==============================================================================
@@ -1346,6 +1875,10 @@ static int new_FS_entry(FS_entry_t         *parent_FS,
                         new_FS->mount_point   = fs_mount_point;
                         new_FS->parent        = parent_FS;
                         new_FS->children_cnt  = 0;
+                        new_FS->refs          = 0;
+                        new_FS->fgen          = 0;
+                        new_FS->dcache        = !fs_interface->fs_nocache
+                                             && !_stropt_is_flag(opts, "nodcache");
                         *fs_entry             = new_FS;
                 } else {
                         _kfree(_MM_KRN, cast(void**, &new_FS));
@@ -1365,6 +1898,25 @@ static int new_FS_entry(FS_entry_t         *parent_FS,
  */
 //==============================================================================
 static int delete_FS_entry(FS_entry_t *this)
+{
+        int err = release_FS_entry(this);
+        if (!err) {
+                free_FS_entry(this);
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Release mounted file system of entry. Entry object is not freed.
+ *
+ * @param  this         file system entry object
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+static int release_FS_entry(FS_entry_t *this)
 {
         int err = EINVAL;
 
@@ -1379,16 +1931,60 @@ static int delete_FS_entry(FS_entry_t *this)
                         if (this->parent && this->parent->children_cnt) {
                                 this->parent->children_cnt--;
                         }
+                }
+        }
 
-                        if (this->mount_point) {
-                                _kfree(_MM_KRN, cast(void**, &this->mount_point));
-                        }
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Free file system entry object (file system must be released).
+ *
+ * @param  this         file system entry object
+ */
+//==============================================================================
+static void free_FS_entry(FS_entry_t *this)
+{
+        if (this->mount_point) {
+                _kfree(_MM_KRN, cast(void**, &this->mount_point));
+        }
+
+        _kfree(_MM_KRN, cast(void**, &this));
+}
+
+//==============================================================================
+/**
+ * @brief Function validate data vector and calculate its total size.
+ *
+ * @param[in]  iov              data vector
+ * @param[in]  iovcnt           number of vector elements
+ * @param[out] size             total size
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+static int iov_size(const struct iovec *iov, int iovcnt, size_t *size)
+{
+        if (!iov || (iovcnt <= 0) || (iovcnt > _VFS_IOV_MAX)) {
+                return EINVAL;
+        }
+
+        *size = 0;
+
+        for (int i = 0; i < iovcnt; i++) {
+                if (!iov[i].iov_base && iov[i].iov_len) {
+                        return EINVAL;
+                }
 
-                        _kfree(_MM_KRN, cast(void**, &this));
+                if (*size + iov[i].iov_len < *size) {
+                        return EINVAL;
                 }
+
+                *size += iov[i].iov_len;
         }
 
-        return err;
+        return ESUCC;
 }
 
 //==============================================================================
@@ -1503,7 +2099,10 @@ static int get_path_FS(const char *path, size_t len, int *position, FS_entry_t *
 //==============================================================================
 /**
  * @brief Function returned the base file system of selected path. The external
- *        path is passed by pointer ext_path.
+ *        path is passed by pointer ext_path. Mount points are searched in the
+ *        hashed index by path prefixes: each path component is examined once
+ *        and the deepest mount point is selected. Function does not lock VFS
+ *        mutex; the index snapshot is only referenced during search.
  *        Function is thread safe.
  *
  * @param[in]  path           path to FS
@@ -1515,34 +2114,175 @@ static int get_path_FS(const char *path, size_t len, int *position, FS_entry_t *
 //==============================================================================
 static int get_path_base_FS(const char *path, const char **ext_path, FS_entry_t **fs_entry)
 {
-        const char *path_tail = path + strlen(path);
+        int err = ENOENT;
 
-        if (*(path_tail - 1) == '/') {
-                path_tail--;
-        }
+        mnt_index_t *index = mnt_index_acquire();
+        if (index) {
+                const char *path_tail = NULL;
+                u32_t       hash      = MNT_HASH_INIT;
+                const char *p         = path;
 
-        int err = _mutex_lock(VFS.resource_mtx, MAX_DELAY_MS);
-        if (!err) {
+                // path without slash at the end belongs to the parent file system
+                for (; *p != '\0'; p++) {
+                        char c = *p;
 
-                while (path_tail >= path) {
-                        err = get_path_FS(path, path_tail - path + 1, NULL, fs_entry);
-                        if (!err) {
-                                break;
-                        } else {
-                                while (*(--path_tail) != '/' && path_tail >= path);
+                        hash = MNT_HASH(hash, c);
+
+                        if (c == '/') {
+                                size_t len = p - path + 1;
+
+                                for (mnt_node_t *node = index->bucket[hash & index->mask];
+                                     node; node = node->next) {
+
+                                        if (  (node->hash == hash)
+                                           && (node->len  == len)
+                                           && (strncmp(node->fs->mount_point, path, len - 1) == 0) ) {
+
+                                                *fs_entry = node->fs;
+                                                path_tail = p;
+                                                err       = ESUCC;
+                                                break;
+                                        }
+                                }
                         }
                 }
 
-                _mutex_unlock(VFS.resource_mtx);
+                mnt_index_release(index, false);
+
+                if (!err && ext_path) {
+                        *ext_path = path_tail;
+                }
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief Function create mount point index of all mounted file systems.
+ *        Function shall be called with locked VFS mutex.
+ *
+ * @param[in]  exclude        file system to exclude from index (can be NULL)
+ * @param[out] index          created index
+ *
+ * @return One of errno value (errno.h)
+ */
+//==============================================================================
+static int mnt_index_build(FS_entry_t *exclude, mnt_index_t **index)
+{
+        size_t count   = _llist_size(VFS.mnt_list);
+        size_t buckets = MNT_INDEX_MIN_BUCKETS;
+
+        while (buckets < (count * 2)) {
+                buckets <<= 1;
         }
 
-        if (!err && ext_path) {
-                *ext_path = path_tail;
+        int err = _kzalloc(_MM_KRN,
+                           sizeof(mnt_index_t)
+                           + (count * sizeof(mnt_node_t))
+                           + (buckets * sizeof(mnt_node_t*)),
+                           NULL, 0, 0, cast(void**, index));
+        if (!err) {
+                mnt_index_t *idx = *index;
+                idx->mask   = buckets - 1;
+                idx->bucket = cast(mnt_node_t**, &idx->node[count]);
+
+                size_t n = 0;
+                _llist_foreach(FS_entry_t*, fs, VFS.mnt_list) {
+                        if (fs == exclude) {
+                                continue;
+                        }
+
+                        mnt_node_t *node = &idx->node[n++];
+                        node->fs   = fs;
+                        node->len  = strlen(fs->mount_point);
+                        node->hash = MNT_HASH_INIT;
+
+                        for (size_t i = 0; i < node->len; i++) {
+                                node->hash = MNT_HASH(node->hash, fs->mount_point[i]);
+                        }
+
+                        node->next = idx->bucket[node->hash & idx->mask];
+                        idx->bucket[node->hash & idx->mask] = node;
+                }
         }
 
         return err;
 }
 
+//==============================================================================
+/**
+ * @brief Function publish new mount point index.
+ *
+ * @param index         new index
+ *
+ * @return Previous index (can be NULL).
+ */
+//==============================================================================
+static mnt_index_t *mnt_index_swap(mnt_index_t *index)
+{
+        _critical_section_begin();
+        mnt_index_t *prev = VFS.mnt_index;
+        VFS.mnt_index = index;
+        _critical_section_end();
+
+        return prev;
+}
+
+//==============================================================================
+/**
+ * @brief Function take reference of current mount point index.
+ *
+ * @return Current index (can be NULL if nothing is mounted).
+ */
+//==============================================================================
+static mnt_index_t *mnt_index_acquire(void)
+{
+        _critical_section_begin();
+        mnt_index_t *index = VFS.mnt_index;
+        if (index) {
+                index->readers++;
+        }
+        _critical_section_end();
+
+        return index;
+}
+
+//==============================================================================
+/**
+ * @brief Function release reference of mount point index. Retired index is
+ *        freed by the last reader, together with file system entry unmounted
+ *        when the index was retired (readers can examine the entry).
+ *
+ * @param index         index to release (can be NULL)
+ * @param retire        index is not published anymore
+ */
+//==============================================================================
+static void mnt_index_release(mnt_index_t *index, bool retire)
+{
+        if (index) {
+                bool free_index;
+
+                _critical_section_begin();
+                if (retire) {
+                        index->retired = true;
+                } else {
+                        index->readers--;
+                }
+
+                free_index = index->retired && (index->readers == 0);
+                _critical_section_end();
+
+                if (free_index) {
+                        if (index->unmounted) {
+                                free_FS_entry(index->unmounted);
+                        }
+
+                        _kfree(_MM_KRN, cast(void**, &index));
+                }
+        }
+}
+
 //==============================================================================
 /**
  * @brief Function create new path with slash and CWD correction.
@@ -1661,6 +2401,59 @@ int _vfs_realpath(char *path, enum path_correction corr)
         return err;
 }
 
+
+//==============================================================================
+/**
+ * @brief Function invalidate lookup cache entries of modified path.
+ *
+ * @param fs            file system
+ * @param path          modified path (NULL: whole file system)
+ */
+//==============================================================================
+static void dcache_invalidate(FS_entry_t *fs, const char *path)
+{
+        if (fs->dcache) {
+                _dcache_invalidate(fs, path);
+        }
+}
+
+//==============================================================================
+/**
+ * @brief Function check in lookup cache that path does not exist.
+ *
+ * @param fs            file system
+ * @param path          path to check
+ *
+ * @return If path is known as not existing then true is returned, otherwise false.
+ */
+//==============================================================================
+static bool is_cached_ENOENT(FS_entry_t *fs, const char *path)
+{
+        struct stat stat;
+        int         err;
+        u32_t       gen;
+
+        return fs->dcache
+            && _dcache_lookup(fs, path, fs->fgen, &stat, &err, &gen)
+            && (err == ENOENT);
+}
+
+//==============================================================================
+/**
+ * @brief Function marks that file of file system could be modified. Cached
+ *        attributes of regular files of the file system become invalid.
+ *
+ * @param fs            file system
+ * @param wr            file opened for write (file could be modified)
+ */
+//==============================================================================
+static void file_modified(FS_entry_t *fs, bool wr)
+{
+        if (wr && fs->dcache) {
+                fs->fgen++;
+        }
+}
+
 /*==============================================================================
   End of file
 ==============================================================================*/
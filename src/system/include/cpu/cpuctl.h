@@ -51,6 +51,8 @@ extern "C" {
 #       include "stm32h7/cpuctl.h"
 #elif defined(ARCH_efr32)
 #       include "efr32/cpuctl.h"
+#elif defined(ARCH_linux)
+#       include "linux/cpuctl.h"
 #endif
 
 /*==============================================================================
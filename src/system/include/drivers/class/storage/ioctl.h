@@ -62,9 +62,25 @@ extern "C" {
  */
 #define IOCTL_STORAGE__READ_MBR         _IO(STORAGE, 0x01)
 
+/**
+ *  @brief  Inform storage that data of selected range is not used anymore
+ *          (TRIM/discard). Only whole sectors of the range are discarded.
+ *  @param  [WR] @ref STORAGE_discard_t * range to discard
+ *  @return On success 0 is returned.
+ *          On error (e.g. operation not supported) -1 is returned and errno is set.
+ */
+#define IOCTL_STORAGE__DISCARD          _IOW(STORAGE, 0x02, const STORAGE_discard_t*)
+
 /*==============================================================================
   Exported object types
 ==============================================================================*/
+/**
+ * Range of storage discarded by the @ref IOCTL_STORAGE__DISCARD request.
+ */
+typedef struct {
+        u64_t offset;                   /*!< Device offset [bytes].*/
+        u64_t size;                     /*!< Range size [bytes].*/
+} STORAGE_discard_t;
 
 /*==============================================================================
   Exported objects
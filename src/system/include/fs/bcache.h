@@ -0,0 +1,93 @@
+/*=========================================================================*//**
+@file    bcache.h
+
+@author  Daniel Zorychta
+
+@brief   Block device buffer cache.
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+#ifndef _BCACHE_H_
+#define _BCACHE_H_
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <stddef.h>
+#include <stdbool.h>
+#include <sys/types.h>
+#include "config.h"
+#include "fs/vfs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*==============================================================================
+  Exported macros
+==============================================================================*/
+/** size of cached block [bytes] */
+#define _BCACHE_BLOCK_SIZE              512
+
+/*==============================================================================
+  Exported object types
+==============================================================================*/
+
+/*==============================================================================
+  Exported objects
+==============================================================================*/
+
+/*==============================================================================
+  Exported functions
+==============================================================================*/
+extern int  _bcache_discard(FILE*, u64_t, u64_t);
+
+#if __OS_BLOCK_CACHE_SIZE__ > 0
+extern int  _bcache_init   (void);
+extern int  _bcache_read   (FILE*, void*, size_t, u64_t, size_t*);
+extern int  _bcache_write  (FILE*, const void*, size_t, u64_t, size_t*);
+extern int  _bcache_sync   (FILE*);
+extern bool _bcache_dirty  (FILE*);
+extern void _bcache_release(FILE*);
+extern void _bcache_shrink (void);
+#else
+static inline int  _bcache_init(void) {return 0;}
+static inline int  _bcache_read(FILE *file, void *buf, size_t size, u64_t offset, size_t *rdcnt) {struct iovec iov = {buf, size}; i64_t pos = offset; return _vfs_fpreadv(file, &iov, 1, &pos, rdcnt);}
+static inline int  _bcache_write(FILE *file, const void *buf, size_t size, u64_t offset, size_t *wrcnt) {struct iovec iov = {(void*)buf, size}; i64_t pos = offset; return _vfs_fpwritev(file, &iov, 1, &pos, wrcnt);}
+static inline int  _bcache_sync(FILE *file) {(void)file; return 0;}
+static inline bool _bcache_dirty(FILE *file) {(void)file; return false;}
+static inline void _bcache_release(FILE *file) {(void)file;}
+static inline void _bcache_shrink(void) {}
+#endif
+
+/*==============================================================================
+  Exported inline functions
+==============================================================================*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _BCACHE_H_ */
+/*==============================================================================
+  End of file
+==============================================================================*/
@@ -0,0 +1,84 @@
+/*=========================================================================*//**
+@file    dcache.h
+
+@author  Daniel Zorychta
+
+@brief   VFS lookup cache (dentry cache).
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+#ifndef _DCACHE_H_
+#define _DCACHE_H_
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <stddef.h>
+#include <stdbool.h>
+#include <sys/types.h>
+#include "config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*==============================================================================
+  Exported macros
+==============================================================================*/
+/** maximum length of cached path (longer paths are not cached) */
+#define _DCACHE_PATH_LEN                40
+
+/*==============================================================================
+  Exported object types
+==============================================================================*/
+
+/*==============================================================================
+  Exported objects
+==============================================================================*/
+
+/*==============================================================================
+  Exported functions
+==============================================================================*/
+#if __OS_VFS_DENTRY_CACHE_SIZE__ > 0
+extern int  _dcache_init      (void);
+extern bool _dcache_lookup    (void*, const char*, u32_t, struct stat*, int*, u32_t*);
+extern void _dcache_insert    (void*, const char*, u32_t, u32_t, int, const struct stat*);
+extern void _dcache_invalidate(void*, const char*);
+#else
+static inline int  _dcache_init(void) {return 0;}
+static inline bool _dcache_lookup(void *fs, const char *path, u32_t fgen, struct stat *stat, int *err, u32_t *gen) {(void)fs; (void)path; (void)fgen; (void)stat; (void)err; (void)gen; return false;}
+static inline void _dcache_insert(void *fs, const char *path, u32_t fgen, u32_t gen, int err, const struct stat *stat) {(void)fs; (void)path; (void)fgen; (void)gen; (void)err; (void)stat;}
+static inline void _dcache_invalidate(void *fs, const char *path) {(void)fs; (void)path;}
+#endif
+
+/*==============================================================================
+  Exported inline functions
+==============================================================================*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _DCACHE_H_ */
+/*==============================================================================
+  End of file
+==============================================================================*/
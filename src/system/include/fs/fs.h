@@ -225,6 +225,99 @@ enum SYS_FS_TYPE {
 #define API_FS_READ(fsname, ...)        _FS_EXTERN_C int _##fsname##_read(__VA_ARGS__)
 #endif
 
+#ifdef DOXYGEN
+/**
+ * @brief Macro creates unique name of file vectored write function.
+ *
+ * Function created by this macro is called by system when file system has to
+ * write data vector to selected file. Function is optional, if file system
+ * does not define it then each vector element is written by write function.
+ *
+ * @note Macro can be used only by file system code.
+ *
+ * @param fsname        file system name
+ * @param fs_handle     [<b>void *</b>]         file system memory handler
+ * @param fhdl          [<b>void *</b>]         file handle (user defined)
+ * @param iov           [<b>const struct iovec *</b>] source data vector
+ * @param iovcnt        [<b>int</b>]            number of vector elements
+ * @param fpos          [<b>fpos_t *</b>]       file position indicator (can be modified)
+ * @param wrcnt         [<b>size_t *</b>]       number of wrote bytes
+ * @param fattr         [<b>struct vfs_fattr</b>] file access attributes
+ * @return One of @ref errno value.
+ *
+ * @see struct vfs_fattr
+ */
+#define API_FS_WRITEV(fsname, fs_handle, fhdl, iov, iovcnt, fpos, wrcnt, fattr)
+#else
+#define API_FS_WRITEV(fsname, ...)      _FS_EXTERN_C int _##fsname##_writev(__VA_ARGS__)
+#endif
+
+#ifdef DOXYGEN
+/**
+ * @brief Macro creates unique name of file vectored read function.
+ *
+ * Function created by this macro is called by system when file system has to
+ * read data vector from selected file. Function is optional, if file system
+ * does not define it then each vector element is read by read function.
+ *
+ * @note Macro can be used only by file system code.
+ *
+ * @param fsname        file system name
+ * @param fs_handle     [<b>void *</b>]         file system memory handler
+ * @param fhdl          [<b>void *</b>]         file handle (user defined)
+ * @param iov           [<b>const struct iovec *</b>] destination data vector
+ * @param iovcnt        [<b>int</b>]            number of vector elements
+ * @param fpos          [<b>fpos_t *</b>]       file position indicator (can be modified)
+ * @param rdcnt         [<b>size_t *</b>]       number of read bytes
+ * @param fattr         [<b>struct vfs_fattr</b>] file access attributes
+ * @return One of @ref errno value.
+ *
+ * @see struct vfs_fattr
+ */
+#define API_FS_READV(fsname, fs_handle, fhdl, iov, iovcnt, fpos, rdcnt, fattr)
+#else
+#define API_FS_READV(fsname, ...)       _FS_EXTERN_C int _##fsname##_readv(__VA_ARGS__)
+#endif
+
+#ifdef DOXYGEN
+/**
+ * @brief Macro creates unique name of file system dirty state function.
+ *
+ * Function created by this macro is called by system before file system
+ * synchronization. If function returns false then file system is not
+ * synchronized. Function must not block; if state cannot be determined
+ * immediately then true should be returned. Function is optional, if file
+ * system does not define it then file system is always synchronized.
+ *
+ * @note Macro can be used only by file system code.
+ *
+ * @param fsname        file system name
+ * @param fs_handle     [<b>void *</b>]         file system memory handler
+ * @return True if file system has data to synchronize, otherwise false.
+ */
+#define API_FS_DIRTY(fsname, fs_handle)
+#else
+#define API_FS_DIRTY(fsname, ...)       _FS_EXTERN_C bool _##fsname##_dirty(__VA_ARGS__)
+#endif
+
+#ifdef DOXYGEN
+/**
+ * @brief Macro marks file system which content is changed outside VFS.
+ *
+ * File system marked by this macro (e.g. procfs) is not cached by VFS lookup
+ * cache. By default lookups of all file systems are cached, because their
+ * content is changed by VFS only. Macro is optional and shall be used once
+ * in the file system code (as a file scope statement).
+ *
+ * @note Macro can be used only by file system code.
+ *
+ * @param fsname        file system name
+ */
+#define API_FS_NOCACHE(fsname)
+#else
+#define API_FS_NOCACHE(fsname)          _FS_EXTERN_C const bool _##fsname##_nocache = true
+#endif
+
 #ifdef DOXYGEN
 /**
  * @brief Macro creates unique name of file ioctl function.
@@ -815,6 +908,22 @@ static inline int sys_pipe_clear(pipe_t *pipe)
         return _pipe_clear(pipe);
 }
 
+//==============================================================================
+/**
+ * @brief  Flush pipe (wake up reader)
+ *
+ * @note Function can be used only by file system code.
+ *
+ * @param  pipe         a pipe object
+ *
+ * @return One of @ref errno value.
+ */
+//==============================================================================
+static inline int sys_pipe_flush(pipe_t *pipe)
+{
+        return _pipe_flush(pipe);
+}
+
 //==============================================================================
 /**
  * @brief  Function return size of programs table (number of programs)
@@ -62,6 +62,7 @@ extern int  _pipe_read      (pipe_t*, u8_t*, size_t, size_t*, bool);
 extern int  _pipe_write     (pipe_t*, const u8_t*, size_t, size_t*, bool);
 extern int  _pipe_close     (pipe_t*);
 extern int  _pipe_clear     (pipe_t*);
+extern int  _pipe_flush     (pipe_t*);
 extern int  _pipe_permanent (pipe_t*);
 
 /*==============================================================================
@@ -149,10 +149,15 @@ extern "C" {
 #define IOCTL_VFS__NON_BLOCKING_WR_MODE         _IO(VFS,  0x03)
 #define IOCTL_VFS__DEFAULT_WR_MODE              _IO(VFS,  0x04)
 #define IOCTL_VFS__IS_NON_BLOCKING_WR_MODE      _IO(VFS,  0x05)
+#define IOCTL_VFS__FALLOCATE                    _IOW(VFS, 0x06, const struct vfs_fallocate*)
+#define IOCTL_VFS__FSTRIM                       _IOWR(VFS, 0x07, struct vfs_fstrim*)
 
 /* file system identifier */
 #define _VFS_FILE_SYSTEM_MAGIC_NO               0xD9EFD24F
 
+/* maximum number of data vector elements */
+#define _VFS_IOV_MAX                            64
+
 /*==============================================================================
   Exported object types
 ==============================================================================*/
@@ -172,6 +177,18 @@ struct vfs_fattr {
         bool non_blocking_wr:1;         /**< non-blocking file write access */
 };
 
+/** file space preallocation range. Doxygen documentation in sys/ioctl.h */
+struct vfs_fallocate {
+        i64_t offset;                   /**< start of reserved range */
+        i64_t len;                      /**< length of reserved range */
+};
+
+/** free space discard request. Doxygen documentation in sys/ioctl.h */
+struct vfs_fstrim {
+        u64_t min_len;                  /**< [in] minimal length of discarded free extent */
+        u64_t trimmed;                  /**< [out] number of discarded bytes */
+};
+
 /** file system interface */
 typedef struct vfs_FS_itf {
         int (*fs_init    )(void **fshdl, const char *path, const char *opts);
@@ -212,6 +229,10 @@ typedef struct vfs_FS_itf {
     #if __OS_ENABLE_CHOWN__ == _YES_
         int (*fs_chown  )(void *fshdl, const char *path, uid_t owner, gid_t group);
     #endif
+        int (*fs_writev )(void *fshdl, void  *fhdl, const struct iovec *iov, int iovcnt, fpos_t *fpos, size_t *wrcnt, struct vfs_fattr attr); /* optional */
+        int (*fs_readv  )(void *fshdl, void  *fhdl, const struct iovec *iov, int iovcnt, fpos_t *fpos, size_t *rdcnt, struct vfs_fattr attr); /* optional */
+        bool (*fs_dirty )(void *fshdl); /* optional */
+        bool fs_nocache;                /* optional: content is changed outside VFS */
         uint32_t fs_magic;
 } vfs_FS_itf_t;
 
@@ -229,6 +250,7 @@ typedef struct vfs_file_flags {
 /** file type */
 struct vfs_file {
         res_header_t        header;
+        struct FS_entry    *FS_entry;
         void               *FS_hdl;
         const vfs_FS_itf_t *FS_if;
         void               *f_hdl;
@@ -292,6 +314,8 @@ extern int  _vfs_fopen      (const struct vfs_path*, const char*, FILE**);
 extern int  _vfs_fclose     (FILE*, bool);
 extern int  _vfs_fwrite     (const void*, size_t, size_t*, FILE*);
 extern int  _vfs_fread      (void*, size_t, size_t*, FILE*);
+extern int  _vfs_fpwritev   (FILE*, const struct iovec*, int, const i64_t*, size_t*);
+extern int  _vfs_fpreadv    (FILE*, const struct iovec*, int, const i64_t*, size_t*);
 extern int  _vfs_fseek      (FILE*, i64_t, int);
 extern int  _vfs_ftell      (FILE*, i64_t*);
 extern int  _vfs_vfioctl    (FILE*, int, va_list);
@@ -301,6 +325,7 @@ extern int  _vfs_feof       (FILE*, int*);
 extern int  _vfs_clearerr   (FILE*);
 extern int  _vfs_ferror     (FILE*, int*);
 extern void _vfs_sync       (void);
+extern void _vfs_sync_worker(void*);
 
 /*==============================================================================
   Exported inline functions
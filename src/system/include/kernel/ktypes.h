@@ -61,6 +61,7 @@ typedef enum {
         RES_TYPE_FILE          = 0x7D129250,
         RES_TYPE_DIR           = 0x19586E97,
         RES_TYPE_MEMORY        = 0x9E834645,
+        RES_TYPE_MEMORY_CACHED = 0x2B7F5C39,
         RES_TYPE_SOCKET        = 0x63ACC316,
         RES_TYPE_FLAG          = 0x18FAEC0D
 } res_type_t;
@@ -69,6 +70,8 @@ typedef enum {
 typedef struct res_header {
         void              *self;
         struct res_header *next;
+        struct res_header *prev;
+        struct _process   *owner;       /* O(1) release check, neighbour links cannot confirm list */
         res_type_t         type;
 } res_header_t;
 
@@ -153,6 +153,9 @@ typedef struct {
         u16_t       stack_max_usage;    //!< max stack usage
         i16_t       priority;           //!< priority
         u16_t       syscalls;           //!< syscalls per second
+        u32_t       malloc_hits;        //!< allocations served by thread malloc caches
+        u32_t       malloc_misses;      //!< small allocations not served by thread malloc caches
+        u32_t       locks_avoided;      //!< scheduler lock sections avoided by thread malloc caches
 } process_stat_t;
 
 /** USERSPACE: thread statistics */
@@ -194,7 +197,9 @@ extern const int                _prog_table_size;
 /*==============================================================================
   Exported function prototypes
 ==============================================================================*/
-extern void        _process_clean_up_killed_processes   (void);
+extern void        _process_reaper                      (void*);
+extern bool        _process_reap                        (size_t);
+extern bool        _process_reap_wait                   (u32_t);
 extern int         _process_create                      (const char*, const process_attr_t*, pid_t*);
 extern int         _process_kill                        (pid_t);
 extern void        _process_remove_zombie               (_process_t*, int*);
@@ -204,6 +209,9 @@ extern const char *_process_get_CWD                     (_process_t*);
 extern int         _process_set_CWD                     (_process_t*, const char*);
 extern int         _process_register_resource           (_process_t*, res_header_t*);
 extern int         _process_release_resource            (_process_t*, res_header_t*, res_type_t);
+extern res_header_t *_process_magazine_get              (_process_t*, tid_t, size_t);
+extern bool        _process_magazine_put                (_process_t*, tid_t, res_header_t*);
+extern void        _process_magazine_flush              (_process_t*, tid_t);
 extern FILE       *_process_get_stderr                  (_process_t*);
 extern const char *_process_get_name                    (_process_t*);
 extern size_t      _process_get_count                   (void);
@@ -222,13 +230,15 @@ extern int         _process_thread_kill                 (_process_t*, tid_t);
 extern task_t     *_process_thread_get_task             (_process_t *proc, tid_t tid);
 extern int         _process_thread_get_stat             (pid_t, tid_t tid, thread_stat_t*);
 extern void        _process_syscall_stat_inc            (_process_t *proc, _process_t *kworker);
+extern void        _process_async_begin                 (_process_t *proc);
+extern void        _process_async_end                   (_process_t *proc);
 extern bool        _process_is_consistent               (void);
 extern void        _process_enter_kernelspace           (_process_t *proc);
 extern void        _process_exit_kernelspace            (_process_t *proc);
 extern bool        _process_is_kernelspace              (_process_t *proc, tid_t thread);
 extern void        _task_switched_in                    (task_t *task, void *task_tag);
 extern void        _task_switched_out                   (task_t *task, void *task_tag);
-extern void        _calculate_CPU_load                  (void);
+extern void        _calculate_CPU_load                  (u32_t);
 extern int         _get_average_CPU_load                (avg_CPU_load_t*);
 extern void        _task_get_process_container          (task_t*, _process_t**, tid_t*);
 
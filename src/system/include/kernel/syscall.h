@@ -41,10 +41,62 @@ extern "C" {
 /*==============================================================================
   Exported macros
 ==============================================================================*/
+/** USERSPACE: ring entry flag: next entry is canceled if this entry fails */
+#define RING_SQE_LINK                   (1 << 0)
+
+/** USERSPACE: ring submit flag: entries are executed by kworker thread */
+#define RING_SUBMIT_ASYNC               (1 << 0)
+
+/** USERSPACE: ring entry offset: current file position is used and moved */
+#define RING_OFFSET_CURRENT             (-1)
 
 /*==============================================================================
   Exported object types
 ==============================================================================*/
+/** USERSPACE: ring operations */
+typedef enum {
+        RING_OP_NOP,                    //!< no operation
+        RING_OP_READ,                   //!< read file (obj: FILE, buf, len, offset)
+        RING_OP_WRITE,                  //!< write file (obj: FILE, buf, len, offset)
+        RING_OP_FSYNC,                  //!< flush file (obj: FILE)
+        RING_OP_STAT,                   //!< file statistics (obj: path, buf: struct stat)
+        RING_OP_FSTAT,                  //!< file statistics (obj: FILE, buf: struct stat)
+        RING_OP_SEND,                   //!< send to socket (obj: SOCKET, buf, len, msg_flags)
+        RING_OP_RECV                    //!< receive from socket (obj: SOCKET, buf, len, msg_flags)
+} ring_op_t;
+
+/** USERSPACE: ring submission entry */
+typedef struct {
+        u8_t            op;             //!< operation (ring_op_t)
+        u8_t            flags;          //!< entry flags (RING_SQE_*)
+        u16_t           msg_flags;      //!< socket flags (NET_flags_t)
+        void           *obj;            //!< file, socket or path
+        void           *buf;            //!< data or statistics buffer
+        size_t          len;            //!< buffer length
+        i64_t           offset;         //!< file position or RING_OFFSET_CURRENT
+        void           *user_data;      //!< value copied to completion entry
+} ring_sqe_t;
+
+/** USERSPACE: ring completion entry */
+typedef struct {
+        ssize_t         res;            //!< number of transferred bytes or -1 on error
+        int             err;            //!< error number (ESUCC on success)
+        void           *user_data;      //!< value of submission entry
+} ring_cqe_t;
+
+/** USERSPACE: submission and completion ring */
+typedef struct {
+        ring_sqe_t     *sqe;            //!< submission entries
+        ring_cqe_t     *cqe;            //!< completion entries
+        u16_t           entries;        //!< number of entries (power of 2)
+        volatile u16_t  sq_head;        //!< first not executed submission (kernel)
+        volatile u16_t  sq_tail;        //!< next free submission (user)
+        volatile u16_t  cq_head;        //!< first not reaped completion (user)
+        volatile u16_t  cq_tail;        //!< next free completion (kernel)
+        volatile bool   busy;           //!< asynchronous submission in progress
+        sem_t          *event;          //!< completion event of asynchronous submission
+} ring_t;
+
 // SYSCALLS                                |----------------+---------------------------+-------------------------------------+---------------------------+---------------------------+-------------------------------------------+
 typedef enum {// NAME                      | RETURN TYPE    | ARG 1                     | ARG 2                               | ARG 3                     | ARG 4                     | ARG 5                                     |
                                         // |----------------+---------------------------+-------------------------------------+---------------------------+---------------------------+-------------------------------------------+
@@ -125,6 +177,9 @@ typedef enum {// NAME                      | RETURN TYPE    | ARG 1
         SYSCALL_FWRITE,                 // | size_t         | const void *src           | size_t *size                        | size_t *count             | FILE *file                |                                           |
         SYSCALL_FREAD,                  // | size_t         | void *dst                 | size_t *size                        | size_t *count             | FILE *file                |                                           |
         SYSCALL_FSEEK,                  // | int            | FILE *file                | i64_t  *seek                        | int    *origin            |                           |                                           |
+        SYSCALL_FPWRITEV,               // | ssize_t        | FILE *file                | const struct iovec *iov             | int *iovcnt               | const i64_t *offset       |                                           |
+        SYSCALL_FPREADV,                // | ssize_t        | FILE *file                | const struct iovec *iov             | int *iovcnt               | const i64_t *offset       |                                           |
+        SYSCALL_RINGSUBMIT,             // | int            | ring_t *ring              | int *flags                          |                           |                           |                                           |
         SYSCALL_IOCTL,                  // | int            | FILE *file                | int *request                        | va_list *arg              |                           |                                           |
         SYSCALL_FFLUSH,                 // | int            | FILE *file                |                                     |                           |                           |                                           |
         SYSCALL_SYNC,                   // | void           |                           |                                     |                           |                           |                                           |
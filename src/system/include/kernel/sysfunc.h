@@ -60,6 +60,7 @@
 #include "kernel/process.h"
 #include "kernel/syscall.h"
 #include "fs/vfs.h"
+#include "fs/bcache.h"
 #include "drivers/drvctrl.h"
 #include "cpu/cpuctl.h"
 
@@ -2728,6 +2729,237 @@ static inline int sys_fread(void *ptr, size_t size, size_t *rdcnt, FILE *file)
         return _vfs_fread(ptr, size, rdcnt, file);
 }
 
+//==============================================================================
+/**
+ * @brief Function writes data vector to file at selected position.
+ *
+ * The function writes all elements of data vector <i>iov</i> to file
+ * <i>file</i> starting at position <i>offset</i>. File position indicator is
+ * not changed. If <i>offset</i> is @ref NULL then data is written at current
+ * file position and the position is moved.
+ *
+ * @note Function can be used only by file system or driver code.
+ *
+ * @param file          stream
+ * @param iov           data vector
+ * @param iovcnt        number of vector elements
+ * @param offset        file position (can be @ref NULL)
+ * @param wrcnt         number of written bytes
+ *
+ * @return One of @ref errno value.
+ *
+ * @b Example
+ * @code
+        // ...
+
+        struct iovec iov[2] = {{header, sizeof(header)}, {payload, len}};
+
+        i64_t  offset = 512;
+        size_t wrcnt  = 0;
+        int err = sys_fpwritev(file, iov, 2, &offset, &wrcnt);
+
+        // ...
+   @endcode
+ *
+ * @see sys_fpreadv(), sys_fpwrite()
+ */
+//==============================================================================
+static inline int sys_fpwritev(FILE *file, const struct iovec *iov, int iovcnt, const i64_t *offset, size_t *wrcnt)
+{
+        return _vfs_fpwritev(file, iov, iovcnt, offset, wrcnt);
+}
+
+//==============================================================================
+/**
+ * @brief Function reads data vector from file at selected position.
+ *
+ * The function reads data from file <i>file</i> starting at position
+ * <i>offset</i> to all elements of data vector <i>iov</i>. File position
+ * indicator is not changed. If <i>offset</i> is @ref NULL then data is read
+ * from current file position and the position is moved.
+ *
+ * @note Function can be used only by file system or driver code.
+ *
+ * @param file          stream
+ * @param iov           data vector
+ * @param iovcnt        number of vector elements
+ * @param offset        file position (can be @ref NULL)
+ * @param rdcnt         number of read bytes
+ *
+ * @return One of @ref errno value.
+ *
+ * @see sys_fpwritev(), sys_fpread()
+ */
+//==============================================================================
+static inline int sys_fpreadv(FILE *file, const struct iovec *iov, int iovcnt, const i64_t *offset, size_t *rdcnt)
+{
+        return _vfs_fpreadv(file, iov, iovcnt, offset, rdcnt);
+}
+
+//==============================================================================
+/**
+ * @brief Function writes data to file at selected position.
+ *
+ * The function is equivalent of sys_fseek() and sys_fwrite() calls, but
+ * file position indicator is not changed.
+ *
+ * @note Function can be used only by file system or driver code.
+ *
+ * @param ptr           data source
+ * @param size          number of bytes to write
+ * @param offset        file position
+ * @param wrcnt         number of written bytes
+ * @param file          stream
+ *
+ * @return One of @ref errno value.
+ *
+ * @see sys_fpread(), sys_fpwritev()
+ */
+//==============================================================================
+static inline int sys_fpwrite(const void *ptr, size_t size, i64_t offset, size_t *wrcnt, FILE *file)
+{
+        struct iovec iov = {.iov_base = cast(void*, ptr), .iov_len = size};
+        return _vfs_fpwritev(file, &iov, 1, &offset, wrcnt);
+}
+
+//==============================================================================
+/**
+ * @brief Function reads data from file at selected position.
+ *
+ * The function is equivalent of sys_fseek() and sys_fread() calls, but
+ * file position indicator is not changed.
+ *
+ * @note Function can be used only by file system or driver code.
+ *
+ * @param ptr           data destination
+ * @param size          number of bytes to read
+ * @param offset        file position
+ * @param rdcnt         number of read bytes
+ * @param file          stream
+ *
+ * @return One of @ref errno value.
+ *
+ * @see sys_fpwrite(), sys_fpreadv()
+ */
+//==============================================================================
+static inline int sys_fpread(void *ptr, size_t size, i64_t offset, size_t *rdcnt, FILE *file)
+{
+        struct iovec iov = {.iov_base = ptr, .iov_len = size};
+        return _vfs_fpreadv(file, &iov, 1, &offset, rdcnt);
+}
+
+//==============================================================================
+/**
+ * @brief Function writes data to block device file by system block cache.
+ *
+ * The function is equivalent of sys_fpwrite() but data is stored in the
+ * block cache. Modified blocks are written to the device by sys_bsync(),
+ * by periodic system cache synchronization, or when are evicted from cache.
+ * If cache is disabled the function is equivalent of sys_fpwrite().
+ *
+ * @note Function can be used only by file system code.
+ *
+ * @param ptr           data source
+ * @param size          number of bytes to write
+ * @param offset        device position
+ * @param wrcnt         number of written bytes
+ * @param file          device file
+ *
+ * @return One of @ref errno value.
+ *
+ * @see sys_bread(), sys_bsync()
+ */
+//==============================================================================
+static inline int sys_bwrite(const void *ptr, size_t size, u64_t offset, size_t *wrcnt, FILE *file)
+{
+        return _bcache_write(file, ptr, size, offset, wrcnt);
+}
+
+//==============================================================================
+/**
+ * @brief Function reads data from block device file by system block cache.
+ *
+ * The function is equivalent of sys_fpread() but blocks are read from the
+ * block cache if possible.
+ *
+ * @note Function can be used only by file system code.
+ *
+ * @param ptr           data destination
+ * @param size          number of bytes to read
+ * @param offset        device position
+ * @param rdcnt         number of read bytes
+ * @param file          device file
+ *
+ * @return One of @ref errno value.
+ *
+ * @see sys_bwrite(), sys_bsync()
+ */
+//==============================================================================
+static inline int sys_bread(void *ptr, size_t size, u64_t offset, size_t *rdcnt, FILE *file)
+{
+        return _bcache_read(file, ptr, size, offset, rdcnt);
+}
+
+//==============================================================================
+/**
+ * @brief Function writes modified cached blocks of device file to the device.
+ *
+ * @note Function can be used only by file system code.
+ *
+ * @param file          device file
+ *
+ * @return One of @ref errno value.
+ *
+ * @see sys_bread(), sys_bwrite()
+ */
+//==============================================================================
+static inline int sys_bsync(FILE *file)
+{
+        return _bcache_sync(file);
+}
+
+//==============================================================================
+/**
+ * @brief Function checks if device file has modified cached blocks. Function
+ *        does not block; if the cache is busy then device is reported as
+ *        modified.
+ *
+ * @note Function can be used only by file system code.
+ *
+ * @param file          device file
+ *
+ * @return If device has blocks to write then true is returned, otherwise false.
+ *
+ * @see sys_bsync()
+ */
+//==============================================================================
+static inline bool sys_bdirty(FILE *file)
+{
+        return _bcache_dirty(file);
+}
+
+//==============================================================================
+/**
+ * @brief Function informs device that data of selected range is not used
+ *        anymore (TRIM/discard). Cached blocks of the range are dropped.
+ *
+ * @note Function can be used only by file system code.
+ *
+ * @param offset        device position
+ * @param size          number of bytes to discard
+ * @param file          device file
+ *
+ * @return One of @ref errno value. ENOTSUP or EBADRQC is returned if device
+ *         does not support discard.
+ *
+ * @see sys_bwrite(), sys_bsync()
+ */
+//==============================================================================
+static inline int sys_bdiscard(u64_t offset, u64_t size, FILE *file)
+{
+        return _bcache_discard(file, offset, size);
+}
+
 //==============================================================================
 /**
  * @brief Function sets file position indicator.
@@ -35,6 +35,7 @@
 #include <stdarg.h>
 #include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
 #include "kernel/builtinfunc.h"
 
 #ifdef __cplusplus
@@ -48,6 +49,8 @@ extern "C" {
 /*==============================================================================
   Exported object types
 ==============================================================================*/
+/** sink of formatted characters, returns false to stop formatting */
+typedef bool (*_vprintf_sink_t)(void *ctx, const char *str, size_t len);
 
 /*==============================================================================
   Exported objects
@@ -58,6 +61,8 @@ extern "C" {
 ==============================================================================*/
 extern int _vsnprintf(char *buf, size_t size, const char *format, va_list arg);
 extern int _snprintf(char *bfr, size_t size, const char *format, ...);
+extern int _vcbprintf(char *buf, size_t size, _vprintf_sink_t sink, void *ctx,
+                      const char *format, va_list arg);
 
 /*==============================================================================
   Exported inline functions
@@ -51,6 +51,7 @@ extern "C" {
 #include <kernel/process.h>
 #include <kernel/printk.h>
 #include <mm/mm.h>
+#include <mm/pool.h>
 #include <drivers/drvctrl.h>
 
 /*==============================================================================
@@ -80,11 +81,33 @@ typedef struct {
         i32_t programs_memory_usage;    /*!< The amount of memory used by users' programs (applications).*/
         i32_t shared_memory_usage;      /*!< The amount of memory used by shared buffers.*/
         i32_t cached_memory_usage;      /*!< The anount of memory used by disc caches.*/
+        i32_t pools_memory_usage;       /*!< The amount of memory of object pools (part of kernel and file systems usage).*/
+        i32_t pools_free_memory;        /*!< The amount of memory of free objects in pools (released on low memory).*/
 } memstat_t;
 #else
 typedef _mm_mem_usage_t memstat_t;
 #endif
 
+#ifdef DOXYGEN
+/**
+ * @brief Memory pool usage
+ *
+ * The type contains usage statistics of kernel object pool.
+ *
+ * @see get_memory_pool_usage()
+ */
+typedef struct {
+        const char *name;               /*!< Pool name.*/
+        u32_t       object_size;        /*!< Size of single object.*/
+        u32_t       objects;            /*!< Number of objects in all pages of the pool.*/
+        u32_t       used;               /*!< Number of allocated objects.*/
+        u32_t       used_max;           /*!< Maximum number of allocated objects.*/
+        u32_t       pages;              /*!< Number of pages allocated by the pool.*/
+} mempoolstat_t;
+#else
+typedef _mm_pool_usage_t mempoolstat_t;
+#endif
+
 #ifdef DOXYGEN
 /**
  * @brief Average CPU load
@@ -279,6 +302,59 @@ static inline i32_t get_module_memory_usage(uint module_number)
         return size;
 }
 
+//==============================================================================
+/**
+ * @brief Function returns number of kernel object pools.
+ *
+ * The function get_number_of_memory_pools() return number of kernel object
+ * pools that are in use.
+ *
+ * @return Number of pools.
+ *
+ * @see get_memory_pool_usage()
+ */
+//==============================================================================
+static inline uint get_number_of_memory_pools(void)
+{
+        return _builtinfunc(mm_get_number_of_pools);
+}
+
+//==============================================================================
+/**
+ * @brief Function returns usage of selected kernel object pool.
+ *
+ * The function get_memory_pool_usage() fill pool usage container pointed
+ * by <i>stat</i> of pool selected by <i>pool_number</i>.
+ *
+ * @param pool_number       pool number
+ * @param stat              pool usage
+ *
+ * @return Return @b 0 on success. On error, @b positive value is returned.
+ *
+ * @b Example
+ * @code
+        #include <dnx/os.h>
+
+        // ...
+
+        uint number_of_pools = get_number_of_memory_pools();
+        for (uint i = 0; i < number_of_pools; i++) {
+                mempoolstat_t stat;
+                if (get_memory_pool_usage(i, &stat) == 0) {
+                        printf("%s : %u/%u\n", stat.name, stat.used, stat.objects);
+                }
+        }
+
+        // ...
+
+   @endcode
+ */
+//==============================================================================
+static inline int get_memory_pool_usage(uint pool_number, mempoolstat_t *stat)
+{
+        return _builtinfunc(mm_get_pool_usage, pool_number, stat);
+}
+
 //==============================================================================
 /**
  * @brief Function returns system uptime in seconds.
@@ -0,0 +1,474 @@
+/*=========================================================================*//**
+@file    ring.h
+
+@author  Daniel Zorychta
+
+@brief   Batched system calls (submission and completion ring).
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+/**
+\defgroup dnx-ring-h <dnx/ring.h>
+
+The library is used to execute many I/O operations by single system call.
+Program puts operations (read, write, flush, stat, socket send and receive)
+to the submission ring and submits them by ring_submit(). Result of each
+operation is put to the completion ring in submission order. Operations can
+be executed at once (by caller) or asynchronously by kworker thread.
+
+Entry with @ref RING_SQE_LINK flag is linked with the next entry: if the entry
+fails then the next entry is canceled (@ref ECANCELED).
+
+Ring, buffers, files and sockets used by submitted entries must exist until
+completions are reaped.
+
+@code
+#include <stdio.h>
+#include <dnx/ring.h>
+
+// ...
+
+ring_t ring;
+if (ring_init(&ring, 16) == 0) {
+
+        ring_sqe_t *sqe = ring_get_sqe(&ring);
+        ring_prep_write(sqe, file, record, sizeof(record), RING_OFFSET_CURRENT);
+        sqe->flags |= RING_SQE_LINK;
+
+        sqe = ring_get_sqe(&ring);
+        ring_prep_fsync(sqe, file);
+
+        ring_submit(&ring, RING_SUBMIT_ASYNC);
+
+        // ...
+
+        ring_cqe_t *cqe;
+        while ((cqe = ring_wait_cqe(&ring, 1000))) {
+                if (cqe->err) {
+                        printf("Operation failed: %d\n", cqe->err);
+                }
+
+                ring_cqe_seen(&ring);
+        }
+
+        ring_destroy(&ring);
+}
+
+// ...
+@endcode
+
+*/
+/**@{*/
+
+#ifndef _DNX_RING_H_
+#define _DNX_RING_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <dnx/thread.h>
+#include <kernel/syscall.h>
+#if __ENABLE_NETWORK__ == _YES_
+#include <dnx/net.h>
+#endif
+
+/*==============================================================================
+  Exported macros
+==============================================================================*/
+
+/*==============================================================================
+  Exported object types
+==============================================================================*/
+
+/*==============================================================================
+  Exported objects
+==============================================================================*/
+
+/*==============================================================================
+  Exported functions
+==============================================================================*/
+
+/*==============================================================================
+  Exported inline functions
+==============================================================================*/
+//==============================================================================
+/**
+ * @brief Function initializes ring.
+ *
+ * The ring_init() function allocates submission and completion entries and
+ * completion event of the ring <i>ring</i>.
+ *
+ * @param ring          ring to initialize
+ * @param entries       number of entries (power of 2)
+ *
+ * @exception | @ref EINVAL
+ * @exception | @ref ENOMEM
+ *
+ * @return On success 0 is returned. On error, \b -1 is returned, and
+ * \b errno is set appropriately.
+ *
+ * @see ring_destroy()
+ */
+//==============================================================================
+static inline int ring_init(ring_t *ring, u16_t entries)
+{
+        if (!ring || (entries == 0) || (entries & (entries - 1))) {
+                _errno = EINVAL;
+                return -1;
+        }
+
+        memset(ring, 0, sizeof(ring_t));
+
+        ring->entries = entries;
+        ring->sqe     = calloc(entries, sizeof(ring_sqe_t));
+        ring->cqe     = calloc(entries, sizeof(ring_cqe_t));
+        ring->event   = semaphore_new(1, 0);
+
+        if (!ring->sqe || !ring->cqe || !ring->event) {
+                free(ring->sqe);
+                free(ring->cqe);
+
+                if (ring->event) {
+                        semaphore_delete(ring->event);
+                }
+
+                memset(ring, 0, sizeof(ring_t));
+                return -1;
+        }
+
+        return 0;
+}
+
+//==============================================================================
+/**
+ * @brief Function releases ring.
+ *
+ * The ring_destroy() function releases ring <i>ring</i> initialized by
+ * ring_init(). Ring must not be in use by asynchronous submission.
+ *
+ * @param ring          ring to destroy
+ *
+ * @see ring_init()
+ */
+//==============================================================================
+static inline void ring_destroy(ring_t *ring)
+{
+        if (ring) {
+                free(ring->sqe);
+                free(ring->cqe);
+
+                if (ring->event) {
+                        semaphore_delete(ring->event);
+                }
+
+                memset(ring, 0, sizeof(ring_t));
+        }
+}
+
+//==============================================================================
+/**
+ * @brief Function returns next free submission entry.
+ *
+ * The ring_get_sqe() function returns next free submission entry of the ring
+ * <i>ring</i>. Entry is cleared and must be prepared by one of ring_prep
+ * functions before submission.
+ *
+ * @param ring          ring
+ *
+ * @return Submission entry or \b NULL if submission ring is full.
+ *
+ * @see ring_submit()
+ */
+//==============================================================================
+static inline ring_sqe_t *ring_get_sqe(ring_t *ring)
+{
+        if ((u16_t)(ring->sq_tail - ring->sq_head) >= ring->entries) {
+                return NULL;
+        }
+
+        ring_sqe_t *sqe = &ring->sqe[ring->sq_tail & (ring->entries - 1)];
+        memset(sqe, 0, sizeof(ring_sqe_t));
+        ring->sq_tail++;
+
+        return sqe;
+}
+
+//==============================================================================
+/**
+ * @brief Function prepares read operation.
+ *
+ * @param sqe           submission entry
+ * @param file          file
+ * @param buf           destination buffer
+ * @param len           number of bytes to read
+ * @param offset        file position or @ref RING_OFFSET_CURRENT
+ */
+//==============================================================================
+static inline void ring_prep_read(ring_sqe_t *sqe, FILE *file, void *buf, size_t len, i64_t offset)
+{
+        if (_libc_stdio) {
+                _libc_fread(file);
+        }
+
+        sqe->op     = RING_OP_READ;
+        sqe->obj    = file;
+        sqe->buf    = buf;
+        sqe->len    = len;
+        sqe->offset = offset;
+}
+
+//==============================================================================
+/**
+ * @brief Function prepares write operation.
+ *
+ * @param sqe           submission entry
+ * @param file          file
+ * @param buf           source buffer
+ * @param len           number of bytes to write
+ * @param offset        file position or @ref RING_OFFSET_CURRENT
+ */
+//==============================================================================
+static inline void ring_prep_write(ring_sqe_t *sqe, FILE *file, const void *buf, size_t len, i64_t offset)
+{
+        if (_libc_stdio) {
+                _libc_fflush(file);
+        }
+
+        sqe->op     = RING_OP_WRITE;
+        sqe->obj    = file;
+        sqe->buf    = (void*)buf;
+        sqe->len    = len;
+        sqe->offset = offset;
+}
+
+//==============================================================================
+/**
+ * @brief Function prepares file flush operation.
+ *
+ * @param sqe           submission entry
+ * @param file          file
+ */
+//==============================================================================
+static inline void ring_prep_fsync(ring_sqe_t *sqe, FILE *file)
+{
+        if (_libc_stdio) {
+                _libc_fflush(file);
+        }
+
+        sqe->op  = RING_OP_FSYNC;
+        sqe->obj = file;
+}
+
+//==============================================================================
+/**
+ * @brief Function prepares file statistics operation (by path).
+ *
+ * @param sqe           submission entry
+ * @param path          file path
+ * @param buf           statistics buffer
+ */
+//==============================================================================
+static inline void ring_prep_stat(ring_sqe_t *sqe, const char *path, struct stat *buf)
+{
+        sqe->op  = RING_OP_STAT;
+        sqe->obj = (void*)path;
+        sqe->buf = buf;
+}
+
+//==============================================================================
+/**
+ * @brief Function prepares file statistics operation (by file).
+ *
+ * @param sqe           submission entry
+ * @param file          file
+ * @param buf           statistics buffer
+ */
+//==============================================================================
+static inline void ring_prep_fstat(ring_sqe_t *sqe, FILE *file, struct stat *buf)
+{
+        sqe->op  = RING_OP_FSTAT;
+        sqe->obj = file;
+        sqe->buf = buf;
+}
+
+#if __ENABLE_NETWORK__ == _YES_
+//==============================================================================
+/**
+ * @brief Function prepares socket send operation.
+ *
+ * @param sqe           submission entry
+ * @param socket        socket
+ * @param buf           source buffer
+ * @param len           number of bytes to send
+ * @param flags         socket flags
+ */
+//==============================================================================
+static inline void ring_prep_send(ring_sqe_t *sqe, SOCKET *socket, const void *buf, size_t len, NET_flags_t flags)
+{
+        sqe->op        = RING_OP_SEND;
+        sqe->obj       = socket;
+        sqe->buf       = (void*)buf;
+        sqe->len       = len;
+        sqe->msg_flags = flags;
+}
+
+//==============================================================================
+/**
+ * @brief Function prepares socket receive operation.
+ *
+ * @param sqe           submission entry
+ * @param socket        socket
+ * @param buf           destination buffer
+ * @param len           buffer size
+ * @param flags         socket flags
+ */
+//==============================================================================
+static inline void ring_prep_recv(ring_sqe_t *sqe, SOCKET *socket, void *buf, size_t len, NET_flags_t flags)
+{
+        sqe->op        = RING_OP_RECV;
+        sqe->obj       = socket;
+        sqe->buf       = buf;
+        sqe->len       = len;
+        sqe->msg_flags = flags;
+}
+#endif
+
+//==============================================================================
+/**
+ * @brief Function submits prepared entries.
+ *
+ * The ring_submit() function executes all prepared entries of the ring
+ * <i>ring</i> by single system call. Without @ref RING_SUBMIT_ASYNC flag
+ * entries are executed before the function returns. With the flag entries
+ * are executed by kworker ring thread and ring is busy until all completions
+ * are put to completion ring (if the ring thread queue is full then entries are
+ * executed at once). Execution stops when completion ring is full. If previous
+ * asynchronous submission is in progress then function waits for its end.
+ *
+ * @param ring          ring
+ * @param flags         submit flags (@ref RING_SUBMIT_ASYNC)
+ *
+ * @exception | @ref EINVAL
+ *
+ * @return On success, number of submitted entries is returned. On error,
+ * \b -1 is returned, and \b errno is set appropriately.
+ *
+ * @see ring_wait_cqe()
+ */
+//==============================================================================
+static inline int ring_submit(ring_t *ring, int flags)
+{
+        while (ring->busy && ring->event) {
+                semaphore_wait(ring->event, MAX_DELAY_MS);
+        }
+
+        int r = -1;
+        syscall(SYSCALL_RINGSUBMIT, &r, ring, &flags);
+        return r;
+}
+
+//==============================================================================
+/**
+ * @brief Function returns oldest completion entry.
+ *
+ * @param ring          ring
+ *
+ * @return Completion entry or \b NULL if there is no completion.
+ *
+ * @see ring_cqe_seen()
+ */
+//==============================================================================
+static inline ring_cqe_t *ring_peek_cqe(ring_t *ring)
+{
+        if (ring->cq_head == ring->cq_tail) {
+                return NULL;
+        }
+
+        return &ring->cqe[ring->cq_head & (ring->entries - 1)];
+}
+
+//==============================================================================
+/**
+ * @brief Function waits for oldest completion entry.
+ *
+ * The ring_wait_cqe() function returns oldest completion entry. If there is
+ * no completion and asynchronous submission is in progress then function
+ * waits for completion at most <i>timeout</i> milliseconds.
+ *
+ * @param ring          ring
+ * @param timeout       timeout in milliseconds
+ *
+ * @return Completion entry or \b NULL if there is no completion.
+ *
+ * @see ring_cqe_seen()
+ */
+//==============================================================================
+static inline ring_cqe_t *ring_wait_cqe(ring_t *ring, u32_t timeout)
+{
+        for (;;) {
+                bool        busy = ring->busy;
+                ring_cqe_t *cqe  = ring_peek_cqe(ring);
+
+                if (cqe || !busy) {
+                        return cqe;
+                }
+
+                if (!semaphore_wait(ring->event, timeout)) {
+                        return NULL;
+                }
+        }
+}
+
+//==============================================================================
+/**
+ * @brief Function marks oldest completion entry as reaped.
+ *
+ * @param ring          ring
+ *
+ * @see ring_peek_cqe(), ring_wait_cqe()
+ */
+//==============================================================================
+static inline void ring_cqe_seen(ring_t *ring)
+{
+        if (ring->cq_head != ring->cq_tail) {
+                ring->cq_head++;
+        }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _DNX_RING_H_ */
+
+/**@}*/
+/*==============================================================================
+  End of file
+==============================================================================*/
@@ -183,6 +183,9 @@ typedef struct {
         u16_t       stack_max_usage;    /*!< max stack usage.*/
         i16_t       priority;           /*!< priority.*/
         bool        zombie;             /*!< process finished and wait for destory.*/
+        u32_t       malloc_hits;        /*!< allocations served by thread malloc caches.*/
+        u32_t       malloc_misses;      /*!< small allocations not served by thread malloc caches.*/
+        u32_t       locks_avoided;      /*!< scheduler lock sections avoided by thread malloc caches.*/
 } process_stat_t;
 
 /**
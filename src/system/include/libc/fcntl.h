@@ -47,6 +47,7 @@ extern "C" {
   Exported macros
 ==============================================================================*/
 #include <unistd.h>
+#include <sys/ioctl.h>
 #include <fs/vfs.h>
 
 /*==============================================================================
@@ -64,6 +65,55 @@ extern "C" {
 /*==============================================================================
   Exported inline functions
 ==============================================================================*/
+//==============================================================================
+/**
+ * @brief Function reserves disk space of file.
+ *
+ * The function posix_fallocate() ensures that disk space is allocated for
+ * the file referred to by the file descriptor <i>fd</i> for the bytes in the
+ * range starting at <i>offset</i> and continuing for <i>len</i> bytes. If
+ * range ends behind the end of file then file size is increased. Contents of
+ * newly reserved area are not defined.
+ *
+ * @param fd            file descriptor
+ * @param offset        start of range
+ * @param len           length of range
+ *
+ * @return On success zero is returned. On error, error number is returned
+ * (@ref EINVAL, @ref ENOSPC, @ref ENOTSUP, ...).
+ *
+ * @b Example
+ * @code
+        #include <stdio.h>
+        #include <fcntl.h>
+
+        // ...
+
+        FILE *file = fopen("/mnt/capture.bin", "w");
+        if (file) {
+                if (posix_fallocate(fileno(file), 0, 4*1024*1024) == 0) {
+                        // ...
+                }
+
+                fclose(file);
+        }
+
+        // ...
+   @endcode
+ *
+ * @see ioctl(), IOCTL_VFS__FALLOCATE
+ */
+//==============================================================================
+static inline int posix_fallocate(fd_t fd, off_t offset, off_t len)
+{
+        if (offset < 0 || len <= 0) {
+                return EINVAL;
+        }
+
+        struct vfs_fallocate range = {.offset = offset, .len = len};
+
+        return (ioctl(fd, IOCTL_VFS__FALLOCATE, &range) == 0) ? 0 : _errno;
+}
 
 #ifdef __cplusplus
 }
@@ -139,6 +139,15 @@ extern FILE *stdout;
 /** @brief Standard error file (one for each application) */
 extern FILE *stderr;
 
+#ifndef DOXYGEN
+/* stream buffers of process (user space buffering, see setvbuf()) */
+extern struct _libc_stdio *_libc_stdio;
+extern size_t _libc_fwrite(const void*, size_t, size_t, FILE*);
+extern int    _libc_fflush(FILE*);
+extern void   _libc_fread(FILE*);
+extern void   _libc_fclose(FILE*);
+#endif
+
 /*==============================================================================
   Exported functions
 ==============================================================================*/
@@ -255,6 +264,11 @@ static inline FILE *fopen(const char *path, const char *mode)
 static inline int fclose(FILE *file)
 {
         int r = EOF;
+
+        if (_libc_stdio) {
+                _libc_fclose(file);
+        }
+
         syscall(SYSCALL_FCLOSE, &r, file);
         return r;
 }
@@ -357,9 +371,7 @@ static inline FILE *freopen(const char *path, const char *mode, FILE *file)
 //==============================================================================
 static inline size_t fwrite(const void *ptr, size_t size, size_t count, FILE *file)
 {
-        size_t s = 0;
-        syscall(SYSCALL_FWRITE, &s, ptr, &size, &count, file);
-        return s;
+        return _libc_fwrite(ptr, size, count, file);
 }
 
 //==============================================================================
@@ -409,6 +421,11 @@ static inline size_t fwrite(const void *ptr, size_t size, size_t count, FILE *fi
 static inline size_t fread(void *ptr, size_t size, size_t count, FILE *file)
 {
         size_t s = 0;
+
+        if (_libc_stdio) {
+                _libc_fread(file);
+        }
+
         syscall(SYSCALL_FREAD, &s, ptr, &size, &count, file);
         return s;
 }
@@ -462,6 +479,11 @@ static inline size_t fread(void *ptr, size_t size, size_t count, FILE *file)
 static inline int fseek(FILE *file, i64_t offset, int mode)
 {
         size_t r = 1;
+
+        if (_libc_stdio) {
+                _libc_fflush(file);
+        }
+
         syscall(SYSCALL_FSEEK, &r, file, &offset, &mode);
         return r;
 }
@@ -602,6 +624,11 @@ static inline void rewind(FILE *file)
 static inline i64_t ftell(FILE *file)
 {
         i64_t lseek = 0;
+
+        if (_libc_stdio) {
+                _libc_fflush(file);
+        }
+
         _errno = _builtinfunc(vfs_ftell, file, &lseek);
         return lseek;
 }
@@ -666,6 +693,8 @@ static inline int fgetpos(FILE *file, fpos_t *pos)
  * the given output or update stream via the stream's underlying write function.
  * For input streams, fflush() discards any buffered data that has been
  * fetched from the underlying file. The open status of the stream is unaffected.
+ * If <i>file</i> is @ref NULL then user space buffers of all streams of
+ * the process are written.
  *
  * @param file          stream
  *
@@ -700,8 +729,14 @@ static inline int fgetpos(FILE *file, fpos_t *pos)
 //==============================================================================
 static inline int fflush(FILE *file)
 {
-        int r = EOF;
-        syscall(SYSCALL_FFLUSH, &r, file);
+        int r = _libc_stdio ? _libc_fflush(file) : 0;
+
+        if (file) {
+                int s = EOF;
+                syscall(SYSCALL_FFLUSH, &s, file);
+                r = (r == 0) ? s : r;
+        }
+
         return r;
 }
 
@@ -892,13 +927,26 @@ extern void perror(const char *s);
 /**
  * @brief Function sets stream buffer mode.
  *
- * The routine exist in dnx RTOS only for compatible reasons. Function in this
- * case do nothing.
- *
- * @note Function not supported.
+ * The setvbuf() function sets user space buffering of the stream. Data
+ * written to buffered stream is collected in the buffer and passed to the file
+ * system when buffer is full (@ref _IOFBF), when new line character is written
+ * (@ref _IOLBF), when stream is flushed, seek, closed or when process exits.
+ * Line buffered streams are also flushed when @ref stdin is read. Stream
+ * in @ref _IONBF mode is not buffered. If <i>buffer</i> is @ref NULL then
+ * buffer of selected <i>size</i> is allocated. By default regular files are
+ * fully buffered (mode is selected at first write), other streams (including
+ * @ref stdout and @ref stderr) are not buffered. Only writes are buffered.
  *
  * @param file      stream
- * @param buffer    buffer
+ * @param buffer    buffer (can be @ref NULL)
+ * @param mode      buffer mode (@ref _IONBF, @ref _IOLBF, @ref _IOFBF)
+ * @param size      buffer size (0: @ref BUFSIZ)
+ *
+ * @exception | @ref EINVAL
+ * @exception | @ref ENOMEM
+ *
+ * @return On success 0 is returned, otherwise @ref EOF and @ref errno is set
+ * to indicate the error.
  *
  * @b Example
  * @code
@@ -906,38 +954,30 @@ extern void perror(const char *s);
 
         // ...
 
-        FILE *file = fopen("/foo/bar", "r");
+        FILE *file = fopen("/foo/bar", "w");
         if (file) {
-               char buffer[100];
-               setbuf(file, buffer);
+               setvbuf(file, NULL, _IOLBF, 256);
 
                // ...
         }
         // ...
    @endcode
  *
- * @see setvbuf()
+ * @see setbuf()
  */
 //==============================================================================
-static inline void setbuf(FILE *file, char *buffer)
-{
-        (void) file;
-        (void) buffer;
-}
+extern int setvbuf(FILE *file, char *buffer, int mode, size_t size);
 
 //==============================================================================
 /**
- * @brief Function sets stream buffer mode.
- *
- * The routine exist in dnx RTOS only for compatible reasons. Function in this
- * case do nothing.
+ * @brief Function sets stream buffer.
  *
- * @note Function not supported.
+ * The setbuf() function is equivalent to <b>setvbuf</b>(file, buffer, _IOFBF,
+ * BUFSIZ) if <i>buffer</i> is not @ref NULL, otherwise stream is set to
+ * unbuffered mode. Buffer shall be at least @ref BUFSIZ bytes long.
  *
  * @param file      stream
  * @param buffer    buffer
- * @param mode      buffer mode (@ref _IONBF, @ref _IOLBF, @ref _IOFBF)
- * @param size      buffer size
  *
  * @b Example
  * @code
@@ -945,27 +985,22 @@ static inline void setbuf(FILE *file, char *buffer)
 
         // ...
 
-        FILE *file = fopen("/foo/bar", "r");
+        FILE *file = fopen("/foo/bar", "w");
         if (file) {
-               char buffer[100];
-               setvbuf(file, buffer, _IOFBF, 100);
+               static char buffer[BUFSIZ];
+               setbuf(file, buffer);
 
                // ...
         }
         // ...
    @endcode
  *
- * @see setbuf()
+ * @see setvbuf()
  */
 //==============================================================================
-static inline int setvbuf(FILE *file, char *buffer, int mode, size_t size)
+static inline void setbuf(FILE *file, char *buffer)
 {
-        (void) file;
-        (void) buffer;
-        (void) mode;
-        (void) size;
-
-        return 0;
+        setvbuf(file, buffer, buffer ? _IOFBF : _IONBF, BUFSIZ);
 }
 
 //==============================================================================
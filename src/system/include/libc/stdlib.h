@@ -51,8 +51,10 @@ extern "C" {
 #include <kernel/syscall.h>
 #include <kernel/kwrapper.h>
 #include <kernel/builtinfunc.h>
+#if !defined(ARCH_linux)
 #include <machine/ieeefp.h>
 #include <_ansi.h>
+#endif
 
 #ifndef DOXYGEN
 #define __need_size_t
@@ -635,7 +637,7 @@ static inline void abort(void)
  * @brief Function kills program with exit status.
  *
  * The exit() function kills program which execute it and program return
- * <i>status</i> value.
+ * <i>status</i> value. User space buffers of streams are written before exit.
  *
  * @param status        status to be return by program
  *
@@ -654,6 +656,8 @@ static inline void abort(void)
 static inline void exit(int status)
 {
         extern void _process_exit(struct _process*, int);
+        extern int  _libc_fflush(struct vfs_file*);
+        _libc_fflush(NULL);
         _builtinfunc(process_exit, (struct _process*)_builtinfunc(task_get_tag, _THIS_TASK), status);
         for (;;); // makes compiler happy
 }
@@ -44,7 +44,9 @@ extern "C" {
 /*==============================================================================
   Include files
 ==============================================================================*/
+#if !defined(ARCH_linux)
 #include <_ansi.h>
+#endif
 
 #ifndef DOXYGEN
 #define __need_size_t
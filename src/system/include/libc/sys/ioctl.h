@@ -107,6 +107,32 @@ extern "C" {
  * @see   ioctl()
  */
 #define IOCTL_VFS__DEFAULT_WR_MODE
+
+/**
+ * @brief Request reserves disk space of file.
+ *
+ * Request allocates storage for the range described by the
+ * <b>struct vfs_fallocate</b> argument and extends the file if the range ends
+ * behind the end of file. File systems allocate the range as contiguous as
+ * possible, so the file can be written later without allocation of further
+ * clusters/blocks. Contents of newly reserved area are not defined.
+ *
+ * @see   ioctl(), posix_fallocate()
+ */
+#define IOCTL_VFS__FALLOCATE
+
+/**
+ * @brief Request discards free space of file system.
+ *
+ * Request informs the storage device that all free extents of the file
+ * system that contains the file are not used (TRIM/discard). Extents shorter
+ * than <b>min_len</b> field of the <b>struct vfs_fstrim</b> argument are
+ * skipped. Number of discarded bytes is returned in the <b>trimmed</b> field.
+ * The request can be sent to any file of the file system.
+ *
+ * @see   ioctl()
+ */
+#define IOCTL_VFS__FSTRIM
 #endif
 
 /*==============================================================================
@@ -188,6 +214,11 @@ static inline int ioctl(fd_t fd, int request, ...)
         va_list arg;
         va_start(arg, request);
         int r = -1;
+
+        if (_libc_stdio) {
+                _libc_fflush((FILE*)fd);
+        }
+
         syscall(SYSCALL_IOCTL, &r, (FILE*)fd, &request, &arg);
         va_end(arg);
         return r;
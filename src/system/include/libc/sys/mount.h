@@ -83,6 +83,12 @@ extern "C" {
  * Additional options can be passed to file system by using <i>options</i>
  * argument. It can be NULL or empty if no options given.
  *
+ * Lookups of mounted file system are cached by VFS: attributes of directories,
+ * regular files and not existing paths are cached, so repeated stat() and
+ * open() of the same paths do not search file system. File systems which
+ * content is changed outside VFS (e.g. procfs) are not cached. The
+ * <i>nodcache</i> option disables the cache for mounted file system.
+ *
  * @param FS_name       file system name
  * @param src_path      file system source file (e.g. /dev/sda1)
  * @param mount_point   file system mount directory
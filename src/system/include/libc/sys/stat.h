@@ -385,6 +385,9 @@ static inline int stat(const char *pathname, struct stat *buf)
 static inline int fstat(FILE *file, struct stat *buf)
 {
 #if __OS_ENABLE_FSTAT__ == _YES_
+        extern int _libc_fflush(FILE*);
+        _libc_fflush(file);
+
         int r = -1;
         syscall(SYSCALL_FSTAT, &r, file, buf);
         return r;
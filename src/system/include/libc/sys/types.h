@@ -206,6 +206,13 @@ struct stat {
         time_t  st_mtime;       /*!< Time of last modification.*/
 };
 
+/** @brief Data vector element (scatter/gather I/O). */
+struct iovec {
+        void   *iov_base;       /*!< Buffer address.*/
+        size_t  iov_len;        /*!< Buffer size in bytes.*/
+};
+#define iovec iovec
+
 /** file system statistic */
 struct statfs {
         u32_t       f_type;     /*!< File system type. @see @ref SYS_FS_TYPE*/
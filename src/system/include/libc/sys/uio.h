@@ -0,0 +1,282 @@
+/*=========================================================================*//**
+@file    uio.h
+
+@author  Daniel Zorychta
+
+@brief   Vectored and positional file I/O.
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+/**
+\defgroup sys-uio-h <sys/uio.h>
+
+The library is used to read and write data vectors (scatter/gather I/O) and
+to access file at selected position without changing file position indicator.
+
+*/
+/**@{*/
+
+#ifndef _UIO_H_
+#define _UIO_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <sys/types.h>
+#include <stdio.h>
+#include <kernel/syscall.h>
+
+/*==============================================================================
+  Exported macros
+==============================================================================*/
+/** @brief Maximum number of data vector elements. */
+#define IOV_MAX                 _VFS_IOV_MAX
+
+/*==============================================================================
+  Exported object types
+==============================================================================*/
+
+/*==============================================================================
+  Exported objects
+==============================================================================*/
+
+/*==============================================================================
+  Exported functions
+==============================================================================*/
+
+/*==============================================================================
+  Exported inline functions
+==============================================================================*/
+//==============================================================================
+/**
+ * @brief Function writes data vector to file at selected position.
+ *
+ * The pwritev() function writes <i>iovcnt</i> buffers described by
+ * <i>iov</i> to the file <i>file</i> starting at position <i>offset</i>.
+ * Buffers are written in array order. File position indicator is not
+ * changed. All buffers are transferred by single system call.
+ *
+ * @param file          file
+ * @param iov           data vector
+ * @param iovcnt        number of vector elements (1..@ref IOV_MAX)
+ * @param offset        file position
+ *
+ * @exception | @ref EINVAL
+ * @exception | @ref EPERM
+ * @exception | @ref ENOENT
+ * @exception | ...
+ *
+ * @return On success, number of written bytes is returned. On error, \b -1
+ * is returned, and \b errno is set appropriately.
+ *
+ * @b Example
+ * @code
+        // ...
+
+        struct iovec iov[2] = {
+                {.iov_base = &header, .iov_len = sizeof(header)},
+                {.iov_base = payload, .iov_len = payload_len}
+        };
+
+        if (pwritev(file, iov, 2, 1024) == -1) {
+                perror(NULL);
+        }
+
+        // ...
+   @endcode
+ *
+ * @see preadv(), writev()
+ */
+//==============================================================================
+static inline ssize_t pwritev(FILE *file, const struct iovec *iov, int iovcnt, i64_t offset)
+{
+        ssize_t r = -1;
+
+        if (_libc_stdio) {
+                _libc_fflush(file);
+        }
+
+        syscall(SYSCALL_FPWRITEV, &r, file, iov, &iovcnt, &offset);
+        return r;
+}
+
+//==============================================================================
+/**
+ * @brief Function reads data vector from file at selected position.
+ *
+ * The preadv() function reads data from the file <i>file</i> starting at
+ * position <i>offset</i> into <i>iovcnt</i> buffers described by <i>iov</i>.
+ * Buffers are filled in array order. File position indicator is not changed.
+ * All buffers are transferred by single system call.
+ *
+ * @param file          file
+ * @param iov           data vector
+ * @param iovcnt        number of vector elements (1..@ref IOV_MAX)
+ * @param offset        file position
+ *
+ * @exception | @ref EINVAL
+ * @exception | @ref EPERM
+ * @exception | @ref ENOENT
+ * @exception | ...
+ *
+ * @return On success, number of read bytes is returned (0 at end of file).
+ * On error, \b -1 is returned, and \b errno is set appropriately.
+ *
+ * @see pwritev(), readv()
+ */
+//==============================================================================
+static inline ssize_t preadv(FILE *file, const struct iovec *iov, int iovcnt, i64_t offset)
+{
+        ssize_t r = -1;
+
+        if (_libc_stdio) {
+                _libc_fread(file);
+        }
+
+        syscall(SYSCALL_FPREADV, &r, file, iov, &iovcnt, &offset);
+        return r;
+}
+
+//==============================================================================
+/**
+ * @brief Function writes data vector to file.
+ *
+ * The writev() function works as pwritev() but data is written at current
+ * file position and the position is moved.
+ *
+ * @param file          file
+ * @param iov           data vector
+ * @param iovcnt        number of vector elements (1..@ref IOV_MAX)
+ *
+ * @return On success, number of written bytes is returned. On error, \b -1
+ * is returned, and \b errno is set appropriately.
+ *
+ * @see pwritev()
+ */
+//==============================================================================
+static inline ssize_t writev(FILE *file, const struct iovec *iov, int iovcnt)
+{
+        ssize_t r = -1;
+
+        if (_libc_stdio) {
+                _libc_fflush(file);
+        }
+
+        syscall(SYSCALL_FPWRITEV, &r, file, iov, &iovcnt, NULL);
+        return r;
+}
+
+//==============================================================================
+/**
+ * @brief Function reads data vector from file.
+ *
+ * The readv() function works as preadv() but data is read from current
+ * file position and the position is moved.
+ *
+ * @param file          file
+ * @param iov           data vector
+ * @param iovcnt        number of vector elements (1..@ref IOV_MAX)
+ *
+ * @return On success, number of read bytes is returned (0 at end of file).
+ * On error, \b -1 is returned, and \b errno is set appropriately.
+ *
+ * @see preadv()
+ */
+//==============================================================================
+static inline ssize_t readv(FILE *file, const struct iovec *iov, int iovcnt)
+{
+        ssize_t r = -1;
+
+        if (_libc_stdio) {
+                _libc_fread(file);
+        }
+
+        syscall(SYSCALL_FPREADV, &r, file, iov, &iovcnt, NULL);
+        return r;
+}
+
+//==============================================================================
+/**
+ * @brief Function writes data to file at selected position.
+ *
+ * The pwrite() function writes <i>count</i> bytes from <i>buf</i> to the file
+ * <i>file</i> at position <i>offset</i>. File position indicator is not
+ * changed. Function is equivalent of fseek() and fwrite() calls performed by
+ * single system call.
+ *
+ * @param file          file
+ * @param buf           data source
+ * @param count         number of bytes to write
+ * @param offset        file position
+ *
+ * @return On success, number of written bytes is returned. On error, \b -1
+ * is returned, and \b errno is set appropriately.
+ *
+ * @see pread(), pwritev()
+ */
+//==============================================================================
+static inline ssize_t pwrite(FILE *file, const void *buf, size_t count, i64_t offset)
+{
+        struct iovec iov = {.iov_base = (void*)buf, .iov_len = count};
+        return pwritev(file, &iov, 1, offset);
+}
+
+//==============================================================================
+/**
+ * @brief Function reads data from file at selected position.
+ *
+ * The pread() function reads up to <i>count</i> bytes from the file
+ * <i>file</i> at position <i>offset</i> to <i>buf</i>. File position indicator
+ * is not changed. Function is equivalent of fseek() and fread() calls
+ * performed by single system call.
+ *
+ * @param file          file
+ * @param buf           data destination
+ * @param count         number of bytes to read
+ * @param offset        file position
+ *
+ * @return On success, number of read bytes is returned (0 at end of file).
+ * On error, \b -1 is returned, and \b errno is set appropriately.
+ *
+ * @see pwrite(), preadv()
+ */
+//==============================================================================
+static inline ssize_t pread(FILE *file, void *buf, size_t count, i64_t offset)
+{
+        struct iovec iov = {.iov_base = buf, .iov_len = count};
+        return preadv(file, &iov, 1, offset);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _UIO_H_ */
+
+/**@}*/
+/*==============================================================================
+  End of file
+==============================================================================*/
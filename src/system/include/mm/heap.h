@@ -70,10 +70,16 @@ extern "C" {
 #include <sys/types.h>
 #include <stddef.h>
 #include <stdbool.h>
+#include "config.h"
 
 /*==============================================================================
   Exported symbolic constants/macros
 ==============================================================================*/
+/** number of size classes (segregated free lists) of small blocks */
+#define _HEAP_SIZE_CLASSES              16
+
+/** size class granularity [bytes] */
+#define _HEAP_SIZE_CLASS_GRANULE        8
 
 /*==============================================================================
   Exported types, enums definitions
@@ -96,6 +102,14 @@ typedef struct {
 
         /** heap amx usage */
         size_t used_max;
+
+#if __OS_HEAP_SIZE_CLASSES__ == _YES_
+        /** segregated free lists of small blocks, one per size class */
+        struct mem *bin[_HEAP_SIZE_CLASSES];
+
+        /** memory kept in segregated free lists */
+        size_t cached;
+#endif
 } _heap_t;
 
 /*==============================================================================
@@ -112,6 +126,7 @@ extern size_t _heap_get_free(_heap_t*);
 extern size_t _heap_get_used(_heap_t*);
 extern size_t _heap_get_size(_heap_t*);
 extern size_t _heap_get_block_size(_heap_t*, void*);
+extern size_t _heap_get_block_capacity(_heap_t*, void*);
 extern bool   _heap_check_consistency(_heap_t *heap);
 
 #ifdef __cplusplus
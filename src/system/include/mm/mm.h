@@ -60,6 +60,8 @@ typedef struct {
         i32_t programs_memory_usage;
         i32_t shared_memory_usage;
         i32_t cached_memory_usage;
+        i32_t pools_memory_usage;
+        i32_t pools_free_memory;
 } _mm_mem_usage_t;
 
 enum _mm_mem {
@@ -92,6 +94,8 @@ extern int    _mm_register_region(_mm_region_t*, void*, size_t, u32_t, const cha
 extern int    _mm_get_mem_usage_details(_mm_mem_usage_t*);
 extern int    _mm_get_module_mem_usage(uint module, i32_t *usage);
 extern size_t _mm_get_block_size(void*);
+extern size_t _mm_get_block_capacity(void*);
+extern u32_t  _mm_get_low_memory_events(void);
 extern size_t _mm_get_mem_free(void);
 extern size_t _mm_get_mem_usage(void);
 extern size_t _mm_get_mem_size(void);
@@ -0,0 +1,116 @@
+/*=========================================================================*//**
+@file    pool.h
+
+@author  Daniel Zorychta
+
+@brief   Pools of fixed-size objects.
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+#ifndef _POOL_H_
+#define _POOL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <stddef.h>
+#include <stdbool.h>
+#include <sys/types.h>
+#include "config.h"
+#include "mm/mm.h"
+
+/*==============================================================================
+  Exported symbolic constants/macros
+==============================================================================*/
+/**
+ * Static pool initializer. Pages of statically defined pool are allocated
+ * at first allocation.
+ *
+ * @param _name         pool name (shown in memory statistics)
+ * @param _mpur         memory purpose of pool pages
+ * @param _size         object size
+ * @param _count        number of objects in single page
+ */
+#define _MM_POOL_INIT(_name, _mpur, _size, _count)\
+        {.name = _name, .mpur = _mpur, .object_size = _mm_align(_size),\
+         .page_objects = _count, .flags = 0}
+
+/*==============================================================================
+  Exported types, enums definitions
+==============================================================================*/
+/** pool usage statistics */
+typedef struct {
+        const char *name;               //!< pool name
+        u32_t       object_size;        //!< object size
+        u32_t       objects;            //!< number of objects in all pages
+        u32_t       used;               //!< number of allocated objects
+        u32_t       used_max;           //!< maximum number of allocated objects
+        u32_t       pages;              //!< number of pages
+} _mm_pool_usage_t;
+
+/** pool of fixed-size objects */
+typedef struct _mm_pool {
+        struct _mm_pool *next;          //!< next registered pool
+        const char      *name;          //!< pool name
+        enum _mm_mem     mpur;          //!< memory purpose of pages
+        size_t           object_size;   //!< aligned object size
+        size_t           page_objects;  //!< number of objects in page
+        u32_t            flags;         //!< required region flags of pages
+        void            *avail;         //!< list of pages with free objects
+        void            *pages;         //!< list of allocated pages
+        u32_t            objects;       //!< number of objects in all pages
+        u32_t            used;          //!< number of allocated objects
+        u32_t            used_max;      //!< maximum number of allocated objects
+        u32_t            pages_count;   //!< number of pages
+        bool             registered;    //!< pool registered in statistics
+        bool             dynamic;       //!< pool descriptor allocated by _mm_pool_create()
+} _mm_pool_t;
+
+/*==============================================================================
+  Exported object declarations
+==============================================================================*/
+
+/*==============================================================================
+  Exported function prototypes
+==============================================================================*/
+extern int  _mm_pool_create(enum _mm_mem, size_t, size_t, u32_t, const char*, _mm_pool_t**);
+extern int  _mm_pool_destroy(_mm_pool_t*);
+extern int  _mm_pool_malloc(_mm_pool_t*, void**);
+extern int  _mm_pool_zalloc(_mm_pool_t*, void**);
+extern int  _mm_pool_free(_mm_pool_t*, void**);
+extern void _mm_pool_shrink(void);
+extern void _mm_pool_get_mem_usage(i32_t*, i32_t*);
+extern uint _mm_get_number_of_pools(void);
+extern int  _mm_get_pool_usage(uint, _mm_pool_usage_t*);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _POOL_H_ */
+/*==============================================================================
+  End of file
+==============================================================================*/
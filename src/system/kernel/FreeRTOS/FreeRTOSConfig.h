@@ -77,11 +77,13 @@
  *-----------------------------------------------------------*/
 extern void  vApplicationSwitchedIn (void);
 extern void  vApplicationSwitchedOut(void);
+extern void  _kernel_tickless_idle  (u32_t expected_idle_ticks);
 
 /* Application specific definitions */
 #define configUSE_PREEMPTION                    1
 #define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
-#define configUSE_TICKLESS_IDLE                 0
+#define configUSE_TICKLESS_IDLE                 ((__OS_TICKLESS_IDLE__ > 0) ? 2 : 0)
+#define configEXPECTED_IDLE_TIME_BEFORE_SLEEP   2
 #define configCPU_CLOCK_HZ                      _CPU_START_FREQUENCY_
 #define configTICK_RATE_HZ                      __OS_TASK_SCHED_FREQ__
 #define configMAX_PRIORITIES                    __OS_TASK_MAX_PRIORITIES__
@@ -153,6 +155,8 @@ extern void  vApplicationSwitchedOut(void);
 #define INCLUDE_xEventGroupSetBitFromISR        0
 #define INCLUDE_xTimerPendFunctionCall          0
 
+#define portSUPPRESS_TICKS_AND_SLEEP(x)         _kernel_tickless_idle(x)
+
 #define traceTASK_SWITCHED_OUT()                _task_switched_out(pxCurrentTCB, pxCurrentTCB->pxTaskTag)
 #define traceTASK_SWITCHED_IN()                 _task_switched_in(pxCurrentTCB, pxCurrentTCB->pxTaskTag)
 
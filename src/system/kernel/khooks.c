@@ -49,6 +49,7 @@
 /*==============================================================================
   Local function prototypes
 ==============================================================================*/
+static void count_ticks(u32_t ticks);
 
 /*==============================================================================
   Local object definitions
@@ -134,19 +135,64 @@ void vApplicationStackOverflowHook(TaskHandle_t taskHdl, char *taskName)
 //==============================================================================
 void vApplicationTickHook(void)
 {
-        _tick_counter++;
+        count_ticks(1);
+}
+
+//==============================================================================
+/**
+ * @brief  Function update tick counter, uptime and CPU load by selected
+ *         number of ticks.
+ *
+ * @param  ticks        number of elapsed ticks
+ */
+//==============================================================================
+static void count_ticks(u32_t ticks)
+{
+        _tick_counter += ticks;
 
 #if (__OS_MONITOR_CPU_LOAD__ > 0)
         _CPU_total_time += _cpuctl_get_CPU_load_counter_delta();
 #endif
 
-        if (++sec_divider >= configTICK_RATE_HZ) {
-                sec_divider = 0;
-                _uptime_counter_sec++;
-                _calculate_CPU_load();
+        sec_divider += ticks;
+
+        if (sec_divider >= configTICK_RATE_HZ) {
+                u32_t sec    = sec_divider / configTICK_RATE_HZ;
+                sec_divider %= configTICK_RATE_HZ;
+                _uptime_counter_sec += sec;
+                _calculate_CPU_load(sec);
         }
 }
 
+#if (__OS_TICKLESS_IDLE__ > 0)
+//==============================================================================
+/**
+ * @brief  Function stop system tick and sleep CPU until the nearest task
+ *         timeout or interrupt. Function is called by idle task when
+ *         scheduler is suspended (see FreeRTOSConfig.h file). Skipped ticks
+ *         are added to the kernel tick counter, uptime and CPU load.
+ *
+ * @param  expected_idle_ticks  number of ticks to the nearest task timeout
+ */
+//==============================================================================
+void _kernel_tickless_idle(u32_t expected_idle_ticks)
+{
+        u32_t ticks = min(expected_idle_ticks, _cpuctl_tickless_max_ticks());
+
+        if (ticks >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP) {
+
+                ticks = _cpuctl_tickless_sleep(ticks);
+
+                if (ticks > 0) {
+                        _critical_section_begin();
+                        vTaskStepTick(ticks);
+                        count_ticks(ticks);
+                        _critical_section_end();
+                }
+        }
+}
+#endif
+
 //==============================================================================
 /**
  * @brief Memory for idle task.
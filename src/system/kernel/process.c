@@ -30,6 +30,7 @@
   Include files
 ==============================================================================*/
 #include <stdlib.h>
+#include <stdio.h>
 #include <errno.h>
 #include <string.h>
 #include <unistd.h>
@@ -70,12 +71,35 @@
 
 #define PID_MIN                         1
 #define PID_MAX                         999
+#define PID_MAP_WORDS                   ((PID_MAX / 32) + 1)
+#define PID_HASH_MIN_SIZE               32
+#define PID_HASH_MAX_SIZE               1024
+#define PID_HASH(pid)                   ((pid) & (pid_hash_size - 1))
+
+#define MAGAZINE_DEPTH                  __OS_TASK_MALLOC_MAGAZINE_DEPTH__
+#define MAGAZINE_CLASSES                8
+#define MAGAZINE_GRANULE                16
+#define MAGAZINE_LOCKS_PER_OPERATION    2
+
+#define REAPER_OBJECTS_PER_SLICE        32
+#define RELEASE_ALL_OBJECTS             ((size_t)-1)
 
 /*==============================================================================
   Local types, enums definitions
 ==============================================================================*/
 typedef struct _prog_data pdata_t;
 
+#if MAGAZINE_DEPTH > 0
+typedef struct {
+        res_header_t    *blk[MAGAZINE_CLASSES][MAGAZINE_DEPTH]; //!< cached blocks
+        u8_t             count[MAGAZINE_CLASSES];               //!< number of cached blocks
+        u32_t            low_mem_events;//!< low memory events seen by the magazine
+        u32_t            hits;          //!< allocations served by the magazine
+        u32_t            misses;        //!< small allocations not served by the magazine
+        u32_t            frees;         //!< blocks cached by the magazine
+} magazine_t;
+#endif
+
 typedef struct {
         task_t          *task;          //!< task
         u32_t            timecnt;       //!< counter used to calculate CPU load
@@ -84,6 +108,9 @@ typedef struct {
         u16_t            syscalls_ctr;  //!< syscall counter
         u16_t            stack_size;    //!< stack size
         bool             kernelspace;   //!< execution in kernel space
+#if MAGAZINE_DEPTH > 0
+        magazine_t       magazine;      //!< cache of freed small memory blocks
+#endif
 } task_data_t;
 
 struct _process {
@@ -94,7 +121,9 @@ struct _process {
         FILE            *f_stdout;      //!< stdout file
         FILE            *f_stderr;      //!< stderr file
         void            *globals;       //!< address to global variables
+        struct _libc_stdio *stdio;      //!< user space stream buffers
         res_header_t    *res_list;      //!< list of used resources
+        res_header_t    *res_mem;       //!< memory blocks to free after other resources
         u32_t            res_list_size; //!< size of resources list
         char            *cwd;           //!< current working path
         const pdata_t   *pdata;         //!< program data
@@ -105,6 +134,14 @@ struct _process {
         i8_t             status;        //!< program status (return value)
         u8_t             flag;          //!< control flags
         u8_t             curr_task;     //!< current working task (thread)
+        u8_t             async_pending; //!< asynchronous requests in progress
+        _process_t     **list;          //!< process list that contains process
+        _process_t      *pid_next;      //!< next process in the PID hash bucket
+#if MAGAZINE_DEPTH > 0
+        u32_t            malloc_hits;   //!< magazine hits of finished threads
+        u32_t            malloc_misses; //!< magazine misses of finished threads
+        u32_t            malloc_frees;  //!< magazine frees of finished threads
+#endif
 };
 
 typedef struct {
@@ -115,9 +152,13 @@ typedef struct {
 /*==============================================================================
   Local function prototypes
 ==============================================================================*/
+static int  process_create(const char *cmd, const process_attr_t *attr, pid_t *pid);
 static void process_code(void *mainfn);
 static void thread_code(void *args);
-static void process_destroy_all_resources(_process_t *proc);
+static bool process_release_resources(_process_t *proc, size_t limit);
+static bool process_reap(_process_t *proc);
+static bool is_reapable(_process_t *proc);
+static void reaper_signal(void);
 static int  resource_destroy(res_header_t *resource);
 static int  argtab_create(const char *str, u8_t *argc, char **argv[]);
 static void argtab_destroy(char **argv);
@@ -125,8 +166,16 @@ static int  find_program(const char *name, const struct _prog_data **prog);
 static int  allocate_process_globals(_process_t *proc, const struct _prog_data *usrprog);
 static int  process_apply_attributes(_process_t *proc, const process_attr_t *attr);
 static void process_get_stat(_process_t *proc, process_stat_t *stat);
-static void process_move_list(_process_t *proc, _process_t **list_from, _process_t **list_to);
-static int  get_pid(pid_t *pid);
+static bool process_move_list(_process_t *proc, _process_t **list_from, _process_t **list_to);
+static void process_list_push(_process_t *proc, _process_t **list);
+static void process_list_remove(_process_t *proc);
+static void process_table_add(_process_t *proc);
+static void process_table_remove(_process_t *proc);
+static void process_table_resize(u32_t size);
+static _process_t *process_find(pid_t pid);
+static int  pid_alloc(pid_t *pid);
+static void pid_free(pid_t pid);
+static void magazine_flush(_process_t *proc, tid_t tid);
 
 #if __OS_SYSTEM_SHEBANG_ENABLE__ > 0
 static bool is_cmd_path(const char *cmd);
@@ -146,6 +195,13 @@ static avg_CPU_load_t avg_CPU_load_calc;
 static avg_CPU_load_t avg_CPU_load_result;
 static mutex_t       *process_mtx;
 static mutex_t       *kworker_mtx;
+static sem_t         *reaper_sem;
+static sem_t         *reaper_fallback_sem;
+static u32_t          pid_map[PID_MAP_WORDS] = {1};
+static _process_t    *pid_hash_min[PID_HASH_MIN_SIZE];
+static _process_t   **pid_hash = pid_hash_min;
+static u32_t          pid_hash_size = PID_HASH_MIN_SIZE;
+static u32_t          pid_hash_count;
 
 /*==============================================================================
   Exported object definitions
@@ -165,6 +221,9 @@ FILE *stderr = NULL;
 /* error number */
 int _errno = ESUCC;
 
+/* user space stream buffers */
+struct _libc_stdio *_libc_stdio = NULL;
+
 /* global variables */
 struct _GVAR_STRUCT_NAME *global = NULL;
 
@@ -191,6 +250,34 @@ extern u32_t                   _uptime_counter_sec;
  */
 //==============================================================================
 KERNELSPACE int _process_create(const char *cmd, const process_attr_t *attr, pid_t *pid)
+{
+        int err = process_create(cmd, attr, pid);
+
+        /*
+         * The reaper thread has the lowest priority and can be starved by busy
+         * threads, so memory of killed processes is released in the context of
+         * the caller and the process is created once again.
+         */
+        if ((err == ENOMEM) && destroy_process_list) {
+                while (process_reap(NULL));
+                err = process_create(cmd, attr, pid);
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Create a new process
+ *
+ * @param[in]  cmd      command (name + arguments)
+ * @param[in]  attr     process attributes (use NULL for default attributes)
+ * @param[out] pid      PID of created process (can be NULL)
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+static int process_create(const char *cmd, const process_attr_t *attr, pid_t *pid)
 {
         if (!process_mtx) {
                 _assert(_mutex_create(MUTEX_TYPE_RECURSIVE, &process_mtx) == ESUCC);
@@ -200,6 +287,14 @@ KERNELSPACE int _process_create(const char *cmd, const process_attr_t *attr, pid
                 _assert(_mutex_create(MUTEX_TYPE_RECURSIVE, &kworker_mtx) == ESUCC);
         }
 
+        if (!reaper_sem) {
+                _assert(_semaphore_create(1, 0, &reaper_sem) == ESUCC);
+        }
+
+        if (!reaper_fallback_sem) {
+                _assert(_semaphore_create(1, 0, &reaper_fallback_sem) == ESUCC);
+        }
+
         if (!cmd) {
                 return ENOENT;
         }
@@ -244,7 +339,7 @@ KERNELSPACE int _process_create(const char *cmd, const process_attr_t *attr, pid
                 err = allocate_process_globals(proc, proc->pdata);
                 if (err) goto finish;
 
-                err = get_pid(&proc->pid);
+                err = pid_alloc(&proc->pid);
                 if (err) goto finish;
 
                 if (proc->pdata->main != _syscall_kworker_process) {
@@ -278,15 +373,8 @@ KERNELSPACE int _process_create(const char *cmd, const process_attr_t *attr, pid
                                         *pid = proc->pid;
                                 }
 
-                                if (active_process_list == NULL) {
-                                        active_process_list = proc;
-
-                                } else {
-                                        proc->header.next = cast(res_header_t*,
-                                                                 active_process_list);
-
-                                        active_process_list = proc;
-                                }
+                                process_list_push(proc, &active_process_list);
+                                process_table_add(proc);
                         }
                 }
         }
@@ -298,7 +386,11 @@ KERNELSPACE int _process_create(const char *cmd, const process_attr_t *attr, pid
                 }
 
                 if (proc) {
-                        process_destroy_all_resources(proc);
+                        if (proc->pid) {
+                                pid_free(proc->pid);
+                        }
+
+                        process_release_resources(proc, RELEASE_ALL_OBJECTS);
                         proc->header.self = NULL;
                         proc->header.type = RES_TYPE_UNKNOWN;
                         _kfree(_MM_KRN, cast(void**, &proc));
@@ -310,36 +402,69 @@ KERNELSPACE int _process_create(const char *cmd, const process_attr_t *attr, pid
 
 //==============================================================================
 /**
- * Function clean up killed processes. If process has parent then is moved to
- * the zombie list. Only parent can remove zombie process.
+ * @brief  Reaper thread of killed processes. Resources of processes from the
+ *         destroy list are released in slices (process mutex is locked only
+ *         for single slice, so higher priority threads are not blocked for
+ *         the whole clean up). Thread is woken up when process is killed or
+ *         exits and when the last asynchronous request of killed process is
+ *         finished. Thread is started by kworker with the lowest priority.
+ *
+ * @param  arg          not used
  */
 //==============================================================================
-KERNELSPACE void _process_clean_up_killed_processes(void)
+KERNELSPACE void _process_reaper(void *arg)
 {
-        if (destroy_process_list) {
-                ATOMIC(process_mtx) {
-                        while (destroy_process_list) {
-                                _process_t *proc = destroy_process_list;
-
-                                process_destroy_all_resources(proc);
+        UNUSED_ARG1(arg);
 
-                                if (not (proc->flag & FLAG_DETACHED)) {
-                                        process_move_list(proc,
-                                                          &destroy_process_list,
-                                                          &zombie_process_list);
-                                } else {
-                                        destroy_process_list = cast(_process_t *, proc->header.next);
-                                        _flag_destroy(proc->event);
-                                        proc->event = NULL;
-                                        proc->header.self = NULL;
-                                        proc->header.type = RES_TYPE_UNKNOWN;
-                                        _kfree(_MM_KRN, cast(void*, &proc));
-                                }
-                        }
+        for (;;) {
+                if (_semaphore_wait(reaper_sem, MAX_DELAY_MS) == ESUCC) {
+                        while (process_reap(NULL));
                 }
         }
 }
 
+//==============================================================================
+/**
+ * @brief  Function release resources of killed processes in the context of
+ *         the caller. Function is a fallback of the reaper thread that has the
+ *         lowest priority and can be starved by busy threads. Number of
+ *         released slices is limited, so the caller is blocked for a short
+ *         time only.
+ *
+ * @param  slices       maximum number of released slices
+ *
+ * @return True if there are killed processes to release, otherwise false.
+ */
+//==============================================================================
+KERNELSPACE bool _process_reap(size_t slices)
+{
+        bool more = true;
+
+        for (size_t i = 0; more && (i < slices); i++) {
+                more = process_reap(NULL);
+        }
+
+        return more;
+}
+
+//==============================================================================
+/**
+ * @brief  Function waits until a process is killed or a request of killed
+ *         process is finished. Function is used by the reaper fallback
+ *         (kworker) to start releasing of killed processes without waiting for
+ *         its period.
+ *
+ * @param  timeout      timeout in milliseconds
+ *
+ * @return True if there is a killed process to release, otherwise false
+ *         (timeout).
+ */
+//==============================================================================
+KERNELSPACE bool _process_reap_wait(u32_t timeout)
+{
+        return _semaphore_wait(reaper_fallback_sem, timeout) == ESUCC;
+}
+
 //==============================================================================
 /**
  * Kill selected process. Kill moves process to the process destroy list. There
@@ -355,29 +480,29 @@ KERNELSPACE int _process_kill(pid_t pid)
         int err = ESRCH;
 
         ATOMIC(process_mtx) {
-                foreach_process(proc, active_process_list) {
+                _process_t *proc = process_find(pid);
 
-                        if (proc->pid == pid) {
-                                if (proc->event) {
-                                        _flag_set(proc->event, _PROCESS_EXIT_FLAG(0));
-                                }
+                if (proc && (proc->list == &active_process_list)) {
+                        if (proc->event) {
+                                _flag_set(proc->event, _PROCESS_EXIT_FLAG(0));
+                        }
 
-                                u8_t threads = PROC_MAX_THREADS(proc);
+                        u8_t threads = PROC_MAX_THREADS(proc);
 
-                                for (int i = 0; i < threads; i++) {
-                                        if (proc->taskdata && proc->taskdata[i].task) {
-                                                _task_destroy(proc->taskdata[i].task);
-                                                memset(&proc->taskdata[i], 0, sizeof(task_data_t));
-                                        }
+                        for (int i = 0; i < threads; i++) {
+                                if (proc->taskdata && proc->taskdata[i].task) {
+                                        _task_destroy(proc->taskdata[i].task);
+                                        memset(&proc->taskdata[i], 0, sizeof(task_data_t));
                                 }
+                        }
 
-                                process_move_list(proc,
-                                                  &active_process_list,
-                                                  &destroy_process_list);
+                        process_move_list(proc,
+                                          &active_process_list,
+                                          &destroy_process_list);
 
-                                err = ESUCC;
-                                break;
-                        }
+                        reaper_signal();
+
+                        err = ESUCC;
                 }
         }
 
@@ -396,29 +521,25 @@ KERNELSPACE void _process_remove_zombie(_process_t *proc, int *status)
 {
         _assert(is_proc_valid(proc));
 
-        ATOMIC(process_mtx) {
-                _process_t *prev = NULL;
-                foreach_process(p, zombie_process_list) {
-                        if (p == proc) {
-
-                                if (prev) {
-                                        prev->header.next = proc->header.next;
-                                } else {
-                                        zombie_process_list = cast(_process_t *,
-                                                                   proc->header.next);
-                                }
-
-                                if (status) {
-                                        *status = proc->status;
-                                }
+        /*
+         * Process not released by the reaper yet is released by the caller
+         * (parent), so the process resources are free when the function exits.
+         */
+        while (process_reap(proc));
 
-                                _flag_destroy(proc->event);
-                                _kfree(_MM_KRN, cast(void*, &proc));
+        ATOMIC(process_mtx) {
+                if (proc->list == &zombie_process_list) {
+                        process_list_remove(proc);
+                        process_table_remove(proc);
 
-                                break;
-                        } else {
-                                prev = p;
+                        if (status) {
+                                *status = proc->status;
                         }
+
+                        _flag_destroy(proc->event);
+                        proc->header.self = NULL;
+                        proc->header.type = RES_TYPE_UNKNOWN;
+                        _kfree(_MM_KRN, cast(void*, &proc));
                 }
         }
 }
@@ -470,6 +591,8 @@ KERNELSPACE void _process_exit(_process_t *proc, int status)
                         process_move_list(proc, &active_process_list, &destroy_process_list);
 
                         proc->taskdata[0].task = NULL;
+
+                        reaper_signal();
                 }
 
                 _task_exit();
@@ -625,30 +748,8 @@ KERNELSPACE int _process_get_stat_pid(pid_t pid, process_stat_t *stat)
                 err = ENOENT;
 
                 ATOMIC(process_mtx) {
-                        _process_t *proc = NULL;
+                        _process_t *proc = process_find(pid);
 
-                        foreach_process(p, active_process_list) {
-                                if (p->pid == pid) {
-                                        proc = p;
-                                        goto finish;
-                                }
-                        }
-
-                        foreach_process(p, destroy_process_list) {
-                                if (p->pid == pid) {
-                                        proc = p;
-                                        goto finish;
-                                }
-                        }
-
-                        foreach_process(p, zombie_process_list) {
-                                if (p->pid == pid) {
-                                        proc = p;
-                                        goto finish;
-                                }
-                        }
-
-                        finish:
                         if (proc) {
                                 process_get_stat(proc, stat);
                                 err = ESUCC;
@@ -798,18 +899,12 @@ KERNELSPACE int _process_get_priority(pid_t pid, int *prio)
         if (pid && prio) {
                 _kernel_scheduler_lock();
                 {
-                        if (active_process->pid == pid) {
-                                *prio = _task_get_priority(active_process->taskdata[0].task);
-                                err   = ESUCC;
+                        _process_t *proc = process_find(pid);
 
-                        } else {
-                                foreach_process(proc, active_process_list) {
-                                        if (proc->pid == pid) {
-                                                *prio  = _task_get_priority(proc->taskdata[0].task);
-                                                err = ESUCC;
-                                                break;
-                                        }
-                                }
+                        if (  proc && (proc->list == &active_process_list)
+                           && proc->taskdata[0].task) {
+                                *prio = _task_get_priority(proc->taskdata[0].task);
+                                err   = ESUCC;
                         }
                 }
                 _kernel_scheduler_unlock();
@@ -835,39 +930,11 @@ KERNELSPACE int _process_get_container(pid_t pid, _process_t **process)
         if (pid && process) {
                 _kernel_scheduler_lock();
                 {
-                        if (active_process->pid == pid) {
-                                *process = active_process;
-                                err = ESUCC;
-                        }
-
-                        if (err) {
-                                foreach_process(proc, active_process_list) {
-                                        if (proc->pid == pid) {
-                                                *process = proc;
-                                                err = ESUCC;
-                                                break;
-                                        }
-                                }
-                        }
+                        _process_t *proc = process_find(pid);
 
-                        if (err) {
-                                foreach_process(proc, destroy_process_list) {
-                                        if (proc->pid == pid) {
-                                                *process = proc;
-                                                err = ESUCC;
-                                                break;
-                                        }
-                                }
-                        }
-
-                        if (err) {
-                                foreach_process(proc, zombie_process_list) {
-                                        if (proc->pid == pid) {
-                                                *process = proc;
-                                                err = ESUCC;
-                                                break;
-                                        }
-                                }
+                        if (proc) {
+                                *process = proc;
+                                err = ESUCC;
                         }
                 }
                 _kernel_scheduler_unlock();
@@ -965,13 +1032,15 @@ KERNELSPACE int _process_register_resource(_process_t *proc, res_header_t *resou
                 mutex_t *mtx = (proc == _kworker_proc) ? kworker_mtx : process_mtx;
 
                 ATOMIC(mtx) {
-                        if (proc->res_list == NULL) {
-                                proc->res_list = resource;
-                        } else {
-                                resource->next = proc->res_list;
-                                proc->res_list = resource;
+                        resource->prev  = NULL;
+                        resource->next  = proc->res_list;
+                        resource->owner = proc;
+
+                        if (proc->res_list) {
+                                proc->res_list->prev = resource;
                         }
 
+                        proc->res_list = resource;
                         proc->res_list_size++;
                 }
 
@@ -1002,33 +1071,40 @@ KERNELSPACE int _process_release_resource(_process_t *proc, res_header_t *resour
                 mutex_t *mtx = (proc == _kworker_proc) ? kworker_mtx : process_mtx;
 
                 ATOMIC(mtx) {
-                        res_header_t *prev     = NULL;
-                        int           max_deep = proc->res_list_size + 1;
-
-                        foreach_resource(curr, proc->res_list) {
-                                if (curr == resource) {
-                                        if (curr->type == type) {
-                                                if (proc->res_list == curr) {
-                                                        proc->res_list = proc->res_list->next;
-                                                } else {
-                                                        prev->next = curr->next;
-                                                }
-
-                                                obj_to_destroy = curr;
-                                                proc->res_list_size--;
+                        res_header_t *prev = resource->prev;
+                        res_header_t *next = resource->next;
+
+                        // neighbour links of resource from list of other
+                        // process are consistent too, so owner is checked
+                        bool linked = (resource->owner == proc);
+
+                        linked = linked && ((prev == NULL) ? (proc->res_list == resource)
+                                                           : (  _mm_is_object_in_heap(prev)
+                                                             && (prev->next == resource)));
+
+                        linked = linked && ((next == NULL) || (  _mm_is_object_in_heap(next)
+                                                              && (next->prev == resource)));
+
+                        if (linked) {
+                                if (resource->type == type) {
+                                        if (prev) {
+                                                prev->next = next;
                                         } else {
-                                                err = EFAULT;
+                                                proc->res_list = next;
                                         }
 
-                                        break;
-                                } else {
+                                        if (next) {
+                                                next->prev = prev;
+                                        }
 
-                                        prev = curr;
+                                        resource->next  = NULL;
+                                        resource->prev  = NULL;
+                                        resource->owner = NULL;
 
-                                        if (--max_deep == 0) {
-                                                _assert(max_deep > 0);
-                                                _kernel_panic_report(_KERNEL_PANIC_DESC_CAUSE_INTERNAL_2);
-                                        }
+                                        obj_to_destroy = resource;
+                                        proc->res_list_size--;
+                                } else {
+                                        err = EFAULT;
                                 }
                         }
                 }
@@ -1044,6 +1120,106 @@ KERNELSPACE int _process_release_resource(_process_t *proc, res_header_t *resour
         return err;
 }
 
+//==============================================================================
+/**
+ * @brief  Function take memory block from the magazine of selected thread.
+ *         Magazine is accessed only by its own thread, so no lock is needed.
+ *         Returned block is still registered in the process resource list.
+ *
+ * @param  proc         process container
+ * @param  tid          thread ID (calling thread)
+ * @param  size         requested size (without resource header)
+ *
+ * @return Memory block (with resource header) or NULL if magazine is empty.
+ */
+//==============================================================================
+KERNELSPACE res_header_t *_process_magazine_get(_process_t *proc, tid_t tid, size_t size)
+{
+#if MAGAZINE_DEPTH > 0
+        if (is_proc_valid(proc) && proc->taskdata && (tid < PROC_MAX_THREADS(proc))) {
+                magazine_t *mag = &proc->taskdata[tid].magazine;
+
+                if (mag->low_mem_events != _mm_get_low_memory_events()) {
+                        magazine_flush(proc, tid);
+                }
+
+                size_t cls = (size + sizeof(res_header_t) - 1) / MAGAZINE_GRANULE;
+
+                if (cls < MAGAZINE_CLASSES) {
+                        if (mag->count[cls] > 0) {
+                                res_header_t *blk = mag->blk[cls][--mag->count[cls]];
+                                blk->type = RES_TYPE_MEMORY;
+                                mag->hits++;
+                                return blk;
+                        } else {
+                                mag->misses++;
+                        }
+                }
+        }
+#else
+        UNUSED_ARG3(proc, tid, size);
+#endif
+        return NULL;
+}
+
+//==============================================================================
+/**
+ * @brief  Function put freed memory block to the magazine of selected thread.
+ *         Block stays registered in the process resource list and is marked
+ *         as cached.
+ *
+ * @param  proc         process container
+ * @param  tid          thread ID (calling thread)
+ * @param  blk          memory block (with resource header)
+ *
+ * @return True if block was cached, false if block shall be released.
+ */
+//==============================================================================
+KERNELSPACE bool _process_magazine_put(_process_t *proc, tid_t tid, res_header_t *blk)
+{
+#if MAGAZINE_DEPTH > 0
+        if (  is_proc_valid(proc) && proc->taskdata && (tid < PROC_MAX_THREADS(proc))
+           && _mm_is_object_in_heap(blk) && (blk->self == blk)
+           && (blk->type == RES_TYPE_MEMORY) ) {
+
+                magazine_t *mag = &proc->taskdata[tid].magazine;
+
+                if (mag->low_mem_events != _mm_get_low_memory_events()) {
+                        magazine_flush(proc, tid);
+                        return false;
+                }
+
+                size_t cls = _mm_get_block_capacity(blk) / MAGAZINE_GRANULE;
+
+                if ((cls > 0) && (--cls < MAGAZINE_CLASSES) && (mag->count[cls] < MAGAZINE_DEPTH)) {
+                        blk->type = RES_TYPE_MEMORY_CACHED;
+                        mag->blk[cls][mag->count[cls]++] = blk;
+                        mag->frees++;
+                        return true;
+                }
+        }
+#else
+        UNUSED_ARG3(proc, tid, blk);
+#endif
+        return false;
+}
+
+//==============================================================================
+/**
+ * @brief  Function release all blocks cached in the magazine of selected
+ *         thread.
+ *
+ * @param  proc         process container
+ * @param  tid          thread ID
+ */
+//==============================================================================
+KERNELSPACE void _process_magazine_flush(_process_t *proc, tid_t tid)
+{
+        if (is_proc_valid(proc) && proc->taskdata && (tid < PROC_MAX_THREADS(proc))) {
+                magazine_flush(proc, tid);
+        }
+}
+
 //==============================================================================
 /**
  * @brief  Function create a new thread for selected process.
@@ -1138,6 +1314,7 @@ KERNELSPACE int _process_thread_kill(_process_t *proc, tid_t tid)
                 ATOMIC(process_mtx) {
                         if (proc->taskdata[tid].task) {
                                 _task_destroy(proc->taskdata[tid].task);
+                                magazine_flush(proc, tid);
                                 memset(&proc->taskdata[tid], 0, sizeof(task_data_t));
                         }
 
@@ -1194,30 +1371,8 @@ KERNELSPACE int _process_thread_get_stat(pid_t pid, tid_t tid, thread_stat_t *st
                 err = ENOENT;
 
                 ATOMIC(process_mtx) {
-                        _process_t *proc = NULL;
-
-                        foreach_process(p, active_process_list) {
-                                if (p->pid == pid) {
-                                        proc = p;
-                                        goto finish;
-                                }
-                        }
-
-                        foreach_process(p, destroy_process_list) {
-                                if (p->pid == pid) {
-                                        proc = p;
-                                        goto finish;
-                                }
-                        }
-
-                        foreach_process(p, zombie_process_list) {
-                                if (p->pid == pid) {
-                                        proc = p;
-                                        goto finish;
-                                }
-                        }
+                        _process_t *proc = process_find(pid);
 
-                        finish:
                         if (  proc && (is_tid_in_range(proc, tid) || (tid == 0))
                            && proc->taskdata && proc->taskdata[tid].task) {
 
@@ -1257,6 +1412,47 @@ KERNELSPACE void _process_syscall_stat_inc(_process_t *proc, _process_t *kworker
         }
 }
 
+//==============================================================================
+/**
+ * @brief  Function register asynchronous request of process executed by
+ *         kworker thread. Resources of killed process are not released until
+ *         all asynchronous requests are finished.
+ *
+ * @param  proc         process
+ */
+//==============================================================================
+KERNELSPACE void _process_async_begin(_process_t *proc)
+{
+        if (is_proc_valid(proc)) {
+                ATOMIC(process_mtx) {
+                        proc->async_pending++;
+                }
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Function unregister finished asynchronous request of process.
+ *
+ * @param  proc         process
+ */
+//==============================================================================
+KERNELSPACE void _process_async_end(_process_t *proc)
+{
+        if (is_proc_valid(proc)) {
+                ATOMIC(process_mtx) {
+                        if (proc->async_pending > 0) {
+                                proc->async_pending--;
+
+                                // killed process waits for its requests
+                                if (is_reapable(proc)) {
+                                        reaper_signal();
+                                }
+                        }
+                }
+        }
+}
+
 //==============================================================================
 /**
  * @brief  Function return process container and thread ID associated with task.
@@ -1298,9 +1494,12 @@ KERNELSPACE void _task_get_process_container(task_t *taskhdl, _process_t **proc,
 /**
  * @brief Function calculate general CPU load.
  *        Calculate are average values for 1/60, 1, 5, and 15 minutes.
+ *
+ * @param seconds       number of seconds elapsed from last calculation
+ *                      (more than 1 if ticks were skipped by tickless idle)
  */
 //==============================================================================
-KERNELSPACE void _calculate_CPU_load(void)
+KERNELSPACE void _calculate_CPU_load(u32_t seconds)
 {
         // calculates 1 second CPU load of all processes
         avg_CPU_load_calc.avg1sec = 0;
@@ -1314,7 +1513,7 @@ KERNELSPACE void _calculate_CPU_load(void)
                                 proc->taskdata[i].timecnt  = 0;
                                 avg_CPU_load_calc.avg1sec  += proc->taskdata[i].CPU_load;
 
-                                proc->taskdata[i].syscalls = proc->taskdata[i].syscalls_ctr;
+                                proc->taskdata[i].syscalls = proc->taskdata[i].syscalls_ctr / seconds;
                                 proc->taskdata[i].syscalls_ctr = 0;
                         }
                 }
@@ -1325,24 +1524,27 @@ KERNELSPACE void _calculate_CPU_load(void)
         _CPU_total_time     = 0;
         CPU_total_time_last = 0;
 
-        // calculates average CPU load
-        avg_CPU_load_calc.avg1min  += avg_CPU_load_result.avg1sec;
-        avg_CPU_load_calc.avg5min  += avg_CPU_load_result.avg1sec;
-        avg_CPU_load_calc.avg15min += avg_CPU_load_result.avg1sec;
+        // calculates average CPU load (the same load for each elapsed second)
+        for (u32_t sec = _uptime_counter_sec - seconds + 1; sec <= _uptime_counter_sec; sec++) {
 
-        if (_uptime_counter_sec % 60 == 0) {
-                avg_CPU_load_result.avg1min = avg_CPU_load_calc.avg1min / 60;
-                avg_CPU_load_calc.avg1min   = 0;
-        }
+                avg_CPU_load_calc.avg1min  += avg_CPU_load_result.avg1sec;
+                avg_CPU_load_calc.avg5min  += avg_CPU_load_result.avg1sec;
+                avg_CPU_load_calc.avg15min += avg_CPU_load_result.avg1sec;
 
-        if (_uptime_counter_sec % 300 == 0) {
-                avg_CPU_load_result.avg5min = avg_CPU_load_calc.avg5min / 300;
-                avg_CPU_load_calc.avg5min   = 0;
-        }
+                if (sec % 60 == 0) {
+                        avg_CPU_load_result.avg1min = avg_CPU_load_calc.avg1min / 60;
+                        avg_CPU_load_calc.avg1min   = 0;
+                }
+
+                if (sec % 300 == 0) {
+                        avg_CPU_load_result.avg5min = avg_CPU_load_calc.avg5min / 300;
+                        avg_CPU_load_calc.avg5min   = 0;
+                }
 
-        if (_uptime_counter_sec % 900 == 0) {
-                avg_CPU_load_result.avg15min = avg_CPU_load_calc.avg15min / 900;
-                avg_CPU_load_calc.avg15min   = 0;
+                if (sec % 900 == 0) {
+                        avg_CPU_load_result.avg15min = avg_CPU_load_calc.avg15min / 900;
+                        avg_CPU_load_calc.avg15min   = 0;
+                }
         }
 }
 
@@ -1467,6 +1669,7 @@ KERNELSPACE bool _process_is_consistent(void)
                                              || (res->type == RES_TYPE_QUEUE)
                                              || (res->type == RES_TYPE_DIR)
                                              || (res->type == RES_TYPE_MEMORY)
+                                             || (res->type == RES_TYPE_MEMORY_CACHED)
                                              || (res->type == RES_TYPE_SOCKET)
                                              || (res->type == RES_TYPE_FLAG)
                                              || (res->type == RES_TYPE_FILE)
@@ -1474,6 +1677,12 @@ KERNELSPACE bool _process_is_consistent(void)
                                              || (res->type == RES_TYPE_FILE) );
                                 if (!sanity_ok) goto end;
 
+                                sanity_ok = (res->next == NULL) || (res->next->prev == res);
+                                if (!sanity_ok) goto end;
+
+                                sanity_ok = (res->owner == p);
+                                if (!sanity_ok) goto end;
+
                                 res = res->next;
                                 n++;
                                 m--;
@@ -1491,6 +1700,13 @@ KERNELSPACE bool _process_is_consistent(void)
                         sanity_ok = (p->pid >= PID_MIN) && (p->pid <= PID_MAX);
                         if (!sanity_ok) goto end;
 
+                        sanity_ok = (process_find(p->pid) == p)
+                                  && (pid_map[p->pid / 32] & (1UL << (p->pid % 32)));
+                        if (!sanity_ok) goto end;
+
+                        sanity_ok = (p->list == &active_process_list);
+                        if (!sanity_ok) goto end;
+
                         sanity_ok = (p->pdata->main == _syscall_kworker_process)
                                   ? ((p->flag & FLAG_KWORKER) == FLAG_KWORKER) : true;
                         if (!sanity_ok) goto end;
@@ -1592,6 +1808,8 @@ USERSPACE static void process_code(void *mainfn)
 
         proc->status = funcmain(proc->argc, proc->argv);
 
+        _libc_fflush(NULL);
+
         _process_exit(proc, proc->status);
 }
 
@@ -1618,6 +1836,8 @@ USERSPACE static void thread_code(void *arg)
         _assert(is_proc_valid(proc));
         _assert(is_tid_in_range(proc, tid));
 
+        magazine_flush(proc, tid);
+
         ATOMIC(process_mtx) {
                 if (proc->event) {
                         _flag_set(proc->event, _PROCESS_EXIT_FLAG(tid));
@@ -1638,40 +1858,208 @@ USERSPACE static void thread_code(void *arg)
  * @param  list_to      destination list
  */
 //==============================================================================
-static void process_move_list(_process_t *proc, _process_t **list_from, _process_t **list_to)
+static bool process_move_list(_process_t *proc, _process_t **list_from, _process_t **list_to)
 {
+        bool moved = false;
+
         ATOMIC(process_mtx) {
-                _process_t *prev = NULL;
-                foreach_process(p, *list_from) {
-                        if (p == proc) {
+                if (proc->list == list_from) {
+                        process_list_remove(proc);
+                        process_list_push(proc, list_to);
+                        moved = true;
+                }
+        }
 
-                                if (prev) {
-                                        prev->header.next = proc->header.next;
-                                } else {
-                                        *list_from = cast(_process_t*, proc->header.next);
-                                }
+        return moved;
+}
 
-                                proc->header.next = cast(struct res_header*, *list_to);
+//==============================================================================
+/**
+ * @brief  Function push process at the beginning of selected list. Function
+ *         must be called with process mutex locked.
+ *
+ * @param  proc         process to push
+ * @param  list         destination list
+ */
+//==============================================================================
+static void process_list_push(_process_t *proc, _process_t **list)
+{
+        proc->header.prev = NULL;
+        proc->header.next = cast(res_header_t*, *list);
 
-                                *list_to = proc;
+        if (*list) {
+                (*list)->header.prev = cast(res_header_t*, proc);
+        }
 
-                                break;
-                        } else {
-                                prev = p;
+        *list      = proc;
+        proc->list = list;
+}
+
+//==============================================================================
+/**
+ * @brief  Function remove process from list that contains process. Function
+ *         must be called with process mutex locked. Next pointer of removed
+ *         process is not changed, so list iterated by CPU load calculation
+ *         stays valid.
+ *
+ * @param  proc         process to remove
+ */
+//==============================================================================
+static void process_list_remove(_process_t *proc)
+{
+        _process_t *prev = cast(_process_t*, proc->header.prev);
+        _process_t *next = cast(_process_t*, proc->header.next);
+
+        if (prev) {
+                prev->header.next = cast(res_header_t*, next);
+        } else {
+                *proc->list = next;
+        }
+
+        if (next) {
+                next->header.prev = cast(res_header_t*, prev);
+        }
+
+        proc->header.prev = NULL;
+        proc->list        = NULL;
+}
+
+//==============================================================================
+/**
+ * @brief  Function add process to the PID table. Function must be called with
+ *         process mutex locked.
+ *
+ * @param  proc         process to add
+ */
+//==============================================================================
+static void process_table_add(_process_t *proc)
+{
+        if ((++pid_hash_count > pid_hash_size) && (pid_hash_size < PID_HASH_MAX_SIZE)) {
+                process_table_resize(pid_hash_size * 2);
+        }
+
+        proc->pid_next = pid_hash[PID_HASH(proc->pid)];
+        pid_hash[PID_HASH(proc->pid)] = proc;
+}
+
+//==============================================================================
+/**
+ * @brief  Function remove process from the PID table and release process PID.
+ *         Function must be called with process mutex locked.
+ *
+ * @param  proc         process to remove
+ */
+//==============================================================================
+static void process_table_remove(_process_t *proc)
+{
+        _process_t **p = &pid_hash[PID_HASH(proc->pid)];
+
+        while (*p && (*p != proc)) {
+                p = &(*p)->pid_next;
+        }
+
+        if (*p) {
+                *p = proc->pid_next;
+                pid_hash_count--;
+        }
+
+        if ((pid_hash_size > PID_HASH_MIN_SIZE) && (pid_hash_count < (pid_hash_size / 4))) {
+                process_table_resize(pid_hash_size / 2);
+        }
+
+        pid_free(proc->pid);
+}
+
+//==============================================================================
+/**
+ * @brief  Function change number of PID table buckets and rehash processes.
+ *         Table grows with number of processes, so the bucket chains have
+ *         one process in average. The largest table holds each PID in own
+ *         bucket (PID-indexed array). The smallest table is static, so
+ *         small systems do not use heap. If table cannot be allocated then
+ *         the current table is used (lookups are longer only). Function must
+ *         be called with process mutex locked.
+ *
+ * @param  size         number of buckets (power of 2)
+ */
+//==============================================================================
+static void process_table_resize(u32_t size)
+{
+        _process_t **table = pid_hash_min;
+
+        if (size > PID_HASH_MIN_SIZE) {
+                if (_kzalloc(_MM_KRN, size * sizeof(_process_t*), NULL, 0, 0,
+                             cast(void**, &table)) != 0) {
+                        return;
+                }
+        }
+
+        _process_t **old      = pid_hash;
+        u32_t        old_size = pid_hash_size;
+
+        // process lookups can be done with scheduler locked only
+        _kernel_scheduler_lock();
+        {
+                if (table == pid_hash_min) {
+                        memset(pid_hash_min, 0, sizeof(pid_hash_min));
+                }
+
+                pid_hash      = table;
+                pid_hash_size = size;
+
+                for (u32_t i = 0; i < old_size; i++) {
+                        _process_t *proc = old[i];
+
+                        while (proc) {
+                                _process_t *next = proc->pid_next;
+                                proc->pid_next = pid_hash[PID_HASH(proc->pid)];
+                                pid_hash[PID_HASH(proc->pid)] = proc;
+                                proc = next;
                         }
                 }
         }
+        _kernel_scheduler_unlock();
+
+        if (old != pid_hash_min) {
+                _kfree(_MM_KRN, cast(void**, &old));
+        }
 }
 
 //==============================================================================
 /**
- * @brief  Function destroy (release) all process resources. Function does not
- *         destroy process object.
+ * @brief  Function find process by PID. Processes of all lists (active,
+ *         destroy, zombie) are found. Function must be called with process
+ *         mutex or scheduler locked.
+ *
+ * @param  pid          process ID
+ *
+ * @return Process object or NULL if process does not exist.
+ */
+//==============================================================================
+static _process_t *process_find(pid_t pid)
+{
+        _process_t *proc = pid_hash[PID_HASH(pid)];
+
+        while (proc && (proc->pid != pid)) {
+                proc = proc->pid_next;
+        }
+
+        return proc;
+}
+
+//==============================================================================
+/**
+ * @brief  Function destroy (release) process resources. Function releases at
+ *         most selected number of objects and can be called again to continue.
+ *         Function does not destroy process object.
  *
  * @param  proc     selected process container
+ * @param  limit    maximum number of objects to release
+ *
+ * @return True if all resources are released, false if there is more objects.
  */
 //==============================================================================
-static void process_destroy_all_resources(_process_t *proc)
+static bool process_release_resources(_process_t *proc, size_t limit)
 {
         u8_t threads = PROC_MAX_THREADS(proc);
 
@@ -1692,45 +2080,49 @@ static void process_destroy_all_resources(_process_t *proc)
                 proc->argc = 0;
         }
 
-        // close files, directories, sockets, etc
-        res_header_t *resource_curr = proc->res_list;
-        res_header_t *resource_prev = NULL;
-        res_header_t *resource_next = NULL;
+        // close files, directories, sockets, etc. in one pass, memory blocks
+        // are collected and freed after all other objects are closed
+        while (proc->res_list && limit) {
+                res_header_t *resource = proc->res_list;
 
-        while (resource_curr) {
-                resource_next = resource_curr->next;
+                proc->res_list = resource->next;
+                proc->res_list_size--;
 
-                if (resource_curr->type != RES_TYPE_MEMORY) {
+                if (proc->res_list) {
+                        proc->res_list->prev = NULL;
+                }
 
-                        if (resource_curr == proc->res_list) {
-                                proc->res_list = resource_next;
-                        } else {
-                                if (resource_prev) {
-                                        resource_prev->next = resource_next;
-                                }
-                        }
+                if (  (resource->type == RES_TYPE_MEMORY)
+                   || (resource->type == RES_TYPE_MEMORY_CACHED) ) {
 
-                        int err = resource_destroy(resource_curr);
+                        resource->next = proc->res_mem;
+                        proc->res_mem  = resource;
+
+                } else {
+                        int err = resource_destroy(resource);
                         if (err != ESUCC) {
                                 printk("PROCESS: PID %d: unknown object %p\n",
-                                       proc->pid, resource_curr);
+                                       proc->pid, resource);
                         }
-                } else {
-                        resource_prev = resource_curr;
                 }
 
-                resource_curr = resource_next;
+                limit--;
         }
 
-        // free all other resources
-        while (proc->res_list) {
-                res_header_t *resource = proc->res_list;
-                proc->res_list = resource->next;
+        while (proc->res_mem && limit) {
+                res_header_t *resource = proc->res_mem;
+                proc->res_mem = resource->next;
 
                 int err = resource_destroy(resource);
                 if (err != ESUCC) {
                         printk("PROCESS: PID %d: unknown object %p\n", proc->pid, resource);
                 }
+
+                limit--;
+        }
+
+        if (proc->res_list || proc->res_mem) {
+                return false;
         }
 
         if (proc->cwd) {
@@ -1743,11 +2135,117 @@ static void process_destroy_all_resources(_process_t *proc)
 #endif
 
         proc->res_list_size = 0;
-        proc->res_list = NULL;
         proc->f_stdin  = NULL;
         proc->f_stdout = NULL;
         proc->f_stderr = NULL;
         proc->globals  = NULL;
+
+        return true;
+}
+
+//==============================================================================
+/**
+ * @brief  Function release single slice of resources of killed process. When
+ *         all resources are released then process is moved to the zombie list
+ *         or destroyed if detached (only parent can remove zombie process).
+ *         Nothing is released while asynchronous requests of process are in
+ *         progress. If no process is given then processes with pending
+ *         requests are skipped; such process is released when its last
+ *         request is finished.
+ *
+ * @param  proc     process to release or NULL to select any killed process
+ *
+ * @return True if there is more work to do (selected process or any killed
+ *         process without pending requests is not released yet), otherwise
+ *         false.
+ */
+//==============================================================================
+static bool process_reap(_process_t *proc)
+{
+        bool more    = false;
+        bool pending = false;
+
+        ATOMIC(process_mtx) {
+                _process_t *killed = NULL;
+
+                foreach_process(p, destroy_process_list) {
+                        if (proc ? (p == proc) : is_reapable(p)) {
+                                killed = p;
+                                break;
+                        }
+                }
+
+                pending = killed && (killed->async_pending > 0);
+
+                if (  killed && !pending
+                   && process_release_resources(killed, REAPER_OBJECTS_PER_SLICE) ) {
+
+                        if (not (killed->flag & FLAG_DETACHED)) {
+                                process_move_list(killed,
+                                                  &destroy_process_list,
+                                                  &zombie_process_list);
+                        } else {
+                                process_list_remove(killed);
+                                process_table_remove(killed);
+
+                                _flag_destroy(killed->event);
+                                killed->event = NULL;
+                                killed->header.self = NULL;
+                                killed->header.type = RES_TYPE_UNKNOWN;
+                                _kfree(_MM_KRN, cast(void*, &killed));
+                        }
+
+                        killed = NULL;
+                }
+
+                if (proc) {
+                        more = (killed != NULL);
+                } else {
+                        foreach_process(p, destroy_process_list) {
+                                if (is_reapable(p)) {
+                                        more = true;
+                                        break;
+                                }
+                        }
+                }
+        }
+
+        /*
+         * Kworker finishes asynchronous requests of the process, the caller
+         * can have higher priority so it must give the CPU.
+         */
+        if (pending) {
+                _sleep_ms(1);
+        }
+
+        return more;
+}
+
+//==============================================================================
+/**
+ * @brief  Function wakes up the reaper thread and its fallback.
+ */
+//==============================================================================
+static void reaper_signal(void)
+{
+        _semaphore_signal(reaper_sem);
+        _semaphore_signal(reaper_fallback_sem);
+}
+
+//==============================================================================
+/**
+ * @brief  Function check if resources of process can be released: process is
+ *         killed and has no asynchronous requests in progress. Function shall
+ *         be called with locked process mutex.
+ *
+ * @param  proc     process
+ *
+ * @return True if process can be released, otherwise false.
+ */
+//==============================================================================
+static bool is_reapable(_process_t *proc)
+{
+        return (proc->list == &destroy_process_list) && (proc->async_pending == 0);
 }
 
 //==============================================================================
@@ -1777,6 +2275,23 @@ static void process_get_stat(_process_t *proc, process_stat_t *stat)
                 }
         }
 
+#if MAGAZINE_DEPTH > 0
+        u32_t frees = proc->malloc_frees;
+
+        stat->malloc_hits   = proc->malloc_hits;
+        stat->malloc_misses = proc->malloc_misses;
+
+        if (proc->taskdata) {
+                for (tid_t tid = 0; tid < threads; tid++) {
+                        stat->malloc_hits   += proc->taskdata[tid].magazine.hits;
+                        stat->malloc_misses += proc->taskdata[tid].magazine.misses;
+                        frees               += proc->taskdata[tid].magazine.frees;
+                }
+        }
+
+        stat->locks_avoided = (stat->malloc_hits + frees) * MAGAZINE_LOCKS_PER_OPERATION;
+#endif
+
         foreach_resource(res, proc->res_list) {
                 switch (res->type) {
                 case RES_TYPE_FILE:
@@ -1801,6 +2316,7 @@ static void process_get_stat(_process_t *proc, process_stat_t *stat)
                         break;
 
                 case RES_TYPE_MEMORY:
+                case RES_TYPE_MEMORY_CACHED:
                         stat->memory_block_count++;
                         stat->memory_usage += _mm_get_block_size(res);
                         break;
@@ -1944,49 +2460,36 @@ static int process_apply_attributes(_process_t *proc, const process_attr_t *attr
 
 //==============================================================================
 /**
- * @brief Function create PID number.
+ * @brief  Function allocate PID number from the PID bitmap. PIDs are allocated
+ *         in round robin order (next free PID after the last allocated one),
+ *         so recently released PID is not reused immediately. PID is
+ *         allocated until process object is released (also zombie PIDs).
+ *
+ * @param  pid          allocated PID
  *
- * @return On success PID number is returned, otherwise 0.
+ * @return One of errno value.
  */
 //==============================================================================
-static int get_pid(pid_t *pid)
+static int pid_alloc(pid_t *pid)
 {
         int err = ESRCH;
 
         ATOMIC(process_mtx) {
-                int n = PID_MAX + 1;
-                while (pid && (n-- > 0)) {
-                        if (++PID_cnt >= (PID_MAX + 1)) {
-                                PID_cnt = PID_MIN;
-                        }
-
-                        bool found = false;
-
-                        foreach_process(proc, active_process_list) {
-                                found = proc->pid == PID_cnt;
-                                if (found) break;
-                        }
-
-                        if (found) continue;
-
-                        foreach_process(proc, active_process_list) {
-                                found = proc->pid == PID_cnt;
-                                if (found) break;
-                        }
-
-                        if (found) continue;
-
-                        foreach_process(proc, active_process_list) {
-                                found = proc->pid == PID_cnt;
-                                if (found) break;
-                        }
-
-                        if (found) {
-                                continue;
+                u32_t n = (PID_cnt >= PID_MAX) ? PID_MIN : (PID_cnt + 1);
+
+                for (int i = 0; (i <= PID_MAP_WORDS) && err; i++) {
+                        u32_t base = n & ~31;
+                        u32_t free = ~pid_map[n / 32] & (UINT32_MAX << (n % 32));
+
+                        if (free && (base + __builtin_ctz(free) <= PID_MAX)) {
+                                n = base + __builtin_ctz(free);
+                                pid_map[n / 32] |= (1UL << (n % 32));
+                                PID_cnt = n;
+                                *pid    = n;
+                                err     = ESUCC;
                         } else {
-                                *pid = PID_cnt;
-                                err  = ESUCC;
-                                break;
+                                // PID 0 is always reserved in the map
+                                n = ((base + 32) > PID_MAX) ? 0 : (base + 32);
                         }
                 }
         }
@@ -1994,6 +2497,20 @@ static int get_pid(pid_t *pid)
         return err;
 }
 
+//==============================================================================
+/**
+ * @brief  Function release PID number.
+ *
+ * @param  pid          PID to release
+ */
+//==============================================================================
+static void pid_free(pid_t pid)
+{
+        ATOMIC(process_mtx) {
+                pid_map[pid / 32] &= ~(1UL << (pid % 32));
+        }
+}
+
 //==============================================================================
 /**
  * @brief  Function destroy (release) selected resource.
@@ -2021,6 +2538,11 @@ static int resource_destroy(res_header_t *resource)
                 _vfs_closedir(cast(DIR*, res2free));
                 break;
 
+        case RES_TYPE_MEMORY_CACHED:
+                res2free->type = RES_TYPE_MEMORY;
+                _kfree(_MM_PROG, cast(void*, &res2free));
+                break;
+
         case RES_TYPE_MEMORY:
                 _kfree(_MM_PROG, cast(void*, &res2free));
                 break;
@@ -2056,6 +2578,41 @@ static int resource_destroy(res_header_t *resource)
         return ESUCC;
 }
 
+//==============================================================================
+/**
+ * @brief  Function release all blocks cached in the magazine of selected
+ *         thread and move thread counters to the process.
+ *
+ * @param  proc         process container
+ * @param  tid          thread ID
+ */
+//==============================================================================
+static void magazine_flush(_process_t *proc, tid_t tid)
+{
+#if MAGAZINE_DEPTH > 0
+        magazine_t *mag = &proc->taskdata[tid].magazine;
+
+        mag->low_mem_events = _mm_get_low_memory_events();
+
+        for (size_t cls = 0; cls < MAGAZINE_CLASSES; cls++) {
+                while (mag->count[cls] > 0) {
+                        res_header_t *blk = mag->blk[cls][--mag->count[cls]];
+                        blk->type = RES_TYPE_MEMORY;
+                        _process_release_resource(proc, blk, RES_TYPE_MEMORY);
+                }
+        }
+
+        proc->malloc_hits   += mag->hits;
+        proc->malloc_misses += mag->misses;
+        proc->malloc_frees  += mag->frees;
+        mag->hits            = 0;
+        mag->misses          = 0;
+        mag->frees           = 0;
+#else
+        UNUSED_ARG2(proc, tid);
+#endif
+}
+
 //==============================================================================
 /**
  * @brief  Function check if first command argument is a path.
@@ -2381,6 +2938,7 @@ KERNELSPACE void _task_switched_in(task_t *task, void *task_tag)
                 stderr = active_process->f_stderr;
                 global = active_process->globals;
                 _errno = active_process->errnov;
+                _libc_stdio = active_process->stdio;
 
                 u8_t threads = PROC_MAX_THREADS(active_process);
 
@@ -2396,6 +2954,7 @@ KERNELSPACE void _task_switched_in(task_t *task, void *task_tag)
                 stderr = NULL;
                 global = NULL;
                 _errno = 0;
+                _libc_stdio = NULL;
         }
 }
 
@@ -2420,6 +2979,7 @@ KERNELSPACE void _task_switched_out(task_t *task, void *task_tag)
                 active_process->f_stderr = stderr;
                 active_process->globals  = global;
                 active_process->errnov   = _errno;
+                active_process->stdio    = _libc_stdio;
 
                 #if (__OS_MONITOR_CPU_LOAD__ > 0)
                 _CPU_total_time += _cpuctl_get_CPU_load_counter_delta();
@@ -33,6 +33,7 @@
 #include "config.h"
 #include "fs/fsctrl.h"
 #include "fs/vfs.h"
+#include "fs/bcache.h"
 #include "drivers/drvctrl.h"
 #include "kernel/syscall.h"
 #include "kernel/kwrapper.h"
@@ -47,7 +48,9 @@
 #include "lib/strlcat.h"
 #include "lib/strlcpy.h"
 #include "net/netm.h"
+#include "mm/mm.h"
 #include "mm/shm.h"
+#include "mm/pool.h"
 #include "dnx/misc.h"
 
 /*==============================================================================
@@ -56,6 +59,9 @@
 #define SYSCALL_QUEUE_LENGTH            4
 
 #define FS_CACHE_SYNC_PERIOD_MS         (1000 * __OS_SYSTEM_CACHE_SYNC_PERIOD__)
+#define REAPER_FALLBACK_SLICES          64
+#define REAPER_FALLBACK_PERIOD_MS       10
+#define RING_QUEUE_LENGTH               8
 
 #define GETARG(type, var)               type var = va_arg(rq->args, type)
 #define LOADARG(type)                   va_arg(rq->args, type)
@@ -71,6 +77,11 @@
 #define is_proc_valid(proc)             (_mm_is_object_in_heap(proc) && ((res_header_t*)proc)->type == RES_TYPE_PROCESS)
 #define is_tid_in_range(proc, tid)      (tid < _process_get_max_threads(proc))
 
+/* command of the first program can be given by CPU (e.g. host command line) */
+#ifndef _CPUCTL_INIT_PROG
+#define _CPUCTL_INIT_PROG               __OS_INIT_PROG__
+#endif
+
 /*==============================================================================
   Local object types
 ==============================================================================*/
@@ -85,10 +96,21 @@ typedef struct {
 
 typedef void (*syscallfunc_t)(syscallrq_t*);
 
+typedef struct {
+        ring_t     *ring;
+        _process_t *client_proc;
+        u16_t       count;
+} ring_work_t;
+
 /*==============================================================================
   Local function prototypes
 ==============================================================================*/
 static void syscall_do(void *rq);
+static int  program_alloc(syscallrq_t *rq, size_t size, bool clear, void **mem);
+static u16_t ring_run(ring_t *ring, _process_t *proc, u16_t count, bool notify);
+static int  ring_execute(ring_sqe_t *sqe, _process_t *proc, ssize_t *res);
+static void ring_release(ring_t *ring);
+static void ring_worker(void *arg);
 
 static void syscall_mount(syscallrq_t *rq);
 static void syscall_umount(syscallrq_t *rq);
@@ -131,6 +153,9 @@ static void syscall_fclose(syscallrq_t *rq);
 static void syscall_fwrite(syscallrq_t *rq);
 static void syscall_fread(syscallrq_t *rq);
 static void syscall_fseek(syscallrq_t *rq);
+static void syscall_fpwritev(syscallrq_t *rq);
+static void syscall_fpreadv(syscallrq_t *rq);
+static void syscall_ringsubmit(syscallrq_t *rq);
 static void syscall_ioctl(syscallrq_t *rq);
 static void syscall_fflush(syscallrq_t *rq);
 static void syscall_sync(syscallrq_t *rq);
@@ -251,6 +276,9 @@ static const syscallfunc_t syscalltab[] = {
         [SYSCALL_FWRITE] = syscall_fwrite,
         [SYSCALL_FREAD ] = syscall_fread,
         [SYSCALL_FSEEK ] = syscall_fseek,
+        [SYSCALL_FPWRITEV] = syscall_fpwritev,
+        [SYSCALL_FPREADV ] = syscall_fpreadv,
+        [SYSCALL_RINGSUBMIT] = syscall_ringsubmit,
         [SYSCALL_IOCTL ] = syscall_ioctl,
         [SYSCALL_FFLUSH] = syscall_fflush,
         [SYSCALL_SYNC  ] = syscall_sync,
@@ -311,6 +339,9 @@ static const syscallfunc_t syscalltab[] = {
         #endif
 };
 
+/* queue of asynchronous ring submissions executed by ring worker thread */
+static queue_t *ring_queue;
+
 /*==============================================================================
   Exported objects
 ==============================================================================*/
@@ -347,7 +378,7 @@ int _syscall_init()
 
         catcherr(err = _process_create("kworker", &attr, NULL), exit);
 
-        catcherr(err = _process_create(__OS_INIT_PROG__, &attr, NULL), exit);
+        catcherr(err = _process_create(_CPUCTL_INIT_PROG, &attr, NULL), exit);
 
         exit:
         return err;
@@ -371,8 +402,6 @@ void syscall(syscall_t syscall, void *retptr, ...)
                 _assert(proc);
                 _assert(is_tid_in_range(proc, tid));
 
-                _process_clean_up_killed_processes();
-
                 syscallrq_t syscallrq = {
                         .syscall_no     = syscall,
                         .client_proc    = proc,
@@ -408,18 +437,76 @@ int _syscall_kworker_process(int argc, char *argv[])
         _task_get_process_container(_THIS_TASK, &_kworker_proc, NULL);
         _assert(_kworker_proc);
 
+        static const thread_attr_t reaper_attr = {
+                .stack_depth = STACK_DEPTH_CUSTOM(__OS_IO_STACK_DEPTH__),
+                .priority    = PRIORITY_LOWEST,
+                .detached    = true
+        };
+
+        _assert(_process_thread_create(_kworker_proc, _process_reaper,
+                                       &reaper_attr, NULL, NULL) == ESUCC);
+
+        static const thread_attr_t ring_attr = {
+                .stack_depth = STACK_DEPTH_CUSTOM(__OS_IO_STACK_DEPTH__),
+                .priority    = PRIORITY_NORMAL,
+                .detached    = true
+        };
+
+        if (_queue_create(RING_QUEUE_LENGTH, sizeof(ring_work_t), &ring_queue) == ESUCC) {
+                if (_process_thread_create(_kworker_proc, ring_worker,
+                                           &ring_attr, NULL, NULL) != ESUCC) {
+                        _queue_destroy(ring_queue);
+                        ring_queue = NULL;
+                }
+        }
+
+        static const thread_attr_t sync_attr = {
+                .stack_depth = STACK_DEPTH_CUSTOM(__OS_IO_STACK_DEPTH__),
+                .priority    = PRIORITY_NORMAL,
+                .detached    = true
+        };
+
+        for (int i = 1; i < __OS_SYSTEM_SYNC_THREADS__; i++) {
+                _process_thread_create(_kworker_proc, _vfs_sync_worker,
+                                       &sync_attr, NULL, NULL);
+        }
+
         u64_t sync_period_ref = _kernel_get_time_ms();
+        u32_t low_mem_events  = _mm_get_low_memory_events();
 
         bool network_initialized = false;
+        bool reap_pending        = false;
 
         for (;;) {
-                _sleep_ms(1000);
+                /*
+                 * Kworker is woken up when a process is killed, the reaper
+                 * thread gets a short time to release it first.
+                 */
+                if (_process_reap_wait(reap_pending ? REAPER_FALLBACK_PERIOD_MS : 1000)) {
+                        _sleep_ms(REAPER_FALLBACK_PERIOD_MS);
+                }
 
                 if ( (_kernel_get_time_ms() - sync_period_ref) >= FS_CACHE_SYNC_PERIOD_MS) {
                         _vfs_sync();
                         sync_period_ref = _kernel_get_time_ms();
                 }
 
+                /*
+                 * Reaper thread has the lowest priority and can be starved by
+                 * busy threads, so kworker releases a few slices as well and
+                 * polls more often until all killed processes are released. On
+                 * low memory all killed processes are released first.
+                 */
+                if (_mm_get_low_memory_events() != low_mem_events) {
+                        while (_process_reap(REAPER_FALLBACK_SLICES));
+                        _bcache_shrink();
+                        _mm_pool_shrink();
+                        low_mem_events = _mm_get_low_memory_events();
+                        reap_pending   = false;
+                } else {
+                        reap_pending = _process_reap(REAPER_FALLBACK_SLICES);
+                }
+
                 if (not network_initialized) {
                         network_initialized = true;
 
@@ -905,6 +992,107 @@ static void syscall_fseek(syscallrq_t *rq)
         SETRETURN(int, GETERRNO() == ESUCC ? 0 : -1);
 }
 
+//==============================================================================
+/**
+ * @brief  This syscall write data vector to selected file at selected position.
+ *         If offset is NULL then current file position is used and moved.
+ *
+ * @param  rq                   syscall request
+ */
+//==============================================================================
+static void syscall_fpwritev(syscallrq_t *rq)
+{
+        GETARG(FILE *, file);
+        GETARG(const struct iovec *, iov);
+        GETARG(int *, iovcnt);
+        GETARG(const i64_t *, offset);
+
+        size_t wrcnt = 0;
+        SETERRNO(_vfs_fpwritev(file, iov, *iovcnt, offset, &wrcnt));
+        SETRETURN(ssize_t, GETERRNO() == ESUCC ? cast(ssize_t, wrcnt) : -1);
+}
+
+//==============================================================================
+/**
+ * @brief  This syscall read data vector from selected file at selected position.
+ *         If offset is NULL then current file position is used and moved.
+ *
+ * @param  rq                   syscall request
+ */
+//==============================================================================
+static void syscall_fpreadv(syscallrq_t *rq)
+{
+        GETARG(FILE *, file);
+        GETARG(const struct iovec *, iov);
+        GETARG(int *, iovcnt);
+        GETARG(const i64_t *, offset);
+
+        size_t rdcnt = 0;
+        SETERRNO(_vfs_fpreadv(file, iov, *iovcnt, offset, &rdcnt));
+        SETRETURN(ssize_t, GETERRNO() == ESUCC ? cast(ssize_t, rdcnt) : -1);
+}
+
+//==============================================================================
+/**
+ * @brief  This syscall execute entries of submission ring. Result of each
+ *         entry is put to the completion ring. Entries are executed at once
+ *         or by ring worker thread if asynchronous submission is requested (if
+ *         work cannot be queued then entries are executed at once).
+ *
+ * @param  rq                   syscall request
+ */
+//==============================================================================
+static void syscall_ringsubmit(syscallrq_t *rq)
+{
+        GETARG(ring_t *, ring);
+        GETARG(int *, flags);
+
+        if (  !ring || !ring->sqe || !ring->cqe || (ring->entries == 0)
+           || (ring->entries & (ring->entries - 1)) ) {
+
+                SETERRNO(EINVAL);
+                SETRETURN(int, -1);
+                return;
+        }
+
+        _critical_section_begin();
+        bool busy  = ring->busy;
+        ring->busy = true;
+        _critical_section_end();
+
+        if (busy) {
+                SETERRNO(EBUSY);
+                SETRETURN(int, -1);
+                return;
+        }
+
+        u16_t count = ring->sq_tail - ring->sq_head;
+
+        if ((*flags & RING_SUBMIT_ASYNC) && (count > 0) && ring_queue) {
+
+                ring_work_t work = {
+                        .ring        = ring,
+                        .client_proc = GETPROCESS(),
+                        .count       = count
+                };
+
+                _process_async_begin(GETPROCESS());
+
+                if (_queue_send(ring_queue, &work, 0) == ESUCC) {
+                        SETRETURN(int, count);
+                        return;
+                }
+
+                _process_async_end(GETPROCESS());
+        }
+
+        count = ring_run(ring, GETPROCESS(), count, false);
+
+        ring_release(ring);
+
+        SETRETURN(int, count);
+}
+
 //==============================================================================
 /**
  * @brief  This syscall perform not standard operation on selected file/device.
@@ -1024,14 +1212,8 @@ static void syscall_malloc(syscallrq_t *rq)
 {
         GETARG(size_t *, size);
 
-        void *mem = NULL;
-        int   err = _kmalloc(_MM_PROG, *size, NULL, _MM_FLAG__DMA_CAPABLE, _MM_FLAG__DMA_CAPABLE, &mem);
-        if (err == ESUCC) {
-                err = _process_register_resource(GETPROCESS(), mem);
-                if (err != ESUCC) {
-                        _kfree(_MM_PROG, &mem);
-                }
-        }
+        void *mem = _process_magazine_get(GETPROCESS(), rq->client_thread, *size);
+        int   err = mem ? ESUCC : program_alloc(rq, *size, false, &mem);
 
         SETERRNO(err);
         SETRETURN(void*, mem ? &cast(res_header_t*, mem)[1] : NULL);
@@ -1048,13 +1230,13 @@ static void syscall_zalloc(syscallrq_t *rq)
 {
         GETARG(size_t *, size);
 
-        void *mem = NULL;
-        int   err = _kzalloc(_MM_PROG, *size, NULL, _MM_FLAG__DMA_CAPABLE, _MM_FLAG__DMA_CAPABLE, &mem);
-        if (err == ESUCC) {
-                err = _process_register_resource(GETPROCESS(), mem);
-                if (err != ESUCC) {
-                        _kfree(_MM_PROG, &mem);
-                }
+        void *mem = _process_magazine_get(GETPROCESS(), rq->client_thread, *size);
+        int   err = ESUCC;
+
+        if (mem) {
+                memset(&cast(res_header_t*, mem)[1], 0, *size);
+        } else {
+                err = program_alloc(rq, *size, true, &mem);
         }
 
         SETERRNO(err);
@@ -1072,7 +1254,12 @@ static void syscall_free(syscallrq_t *rq)
 {
         GETARG(void *, mem);
 
-        int err = _process_release_resource(GETPROCESS(), cast(res_header_t*, mem) - 1, RES_TYPE_MEMORY);
+        int err = ESUCC;
+
+        if (!_process_magazine_put(GETPROCESS(), rq->client_thread, cast(res_header_t*, mem) - 1)) {
+                err = _process_release_resource(GETPROCESS(), cast(res_header_t*, mem) - 1, RES_TYPE_MEMORY);
+        }
+
         if (err != ESUCC) {
                 const char *msg = "*** Error: double free or corruption ***\n";
                 size_t wrcnt;
@@ -1086,6 +1273,210 @@ static void syscall_free(syscallrq_t *rq)
         SETERRNO(err);
 }
 
+//==============================================================================
+/**
+ * @brief  Function allocate memory block for application and register it in
+ *         the process. When system runs out of memory then malloc cache of
+ *         calling thread is flushed and allocation is repeated. If memory is
+ *         still missing then killed processes are released in the context of
+ *         the caller (the reaper thread can be starved) and allocation is
+ *         repeated once again.
+ *
+ * @param  rq                   syscall request
+ * @param  size                 block size
+ * @param  clear                clear allocated block
+ * @param  mem                  allocated block (with resource header)
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+static int program_alloc(syscallrq_t *rq, size_t size, bool clear, void **mem)
+{
+        int err;
+
+        for (int attempt = 0; attempt < 3; attempt++) {
+                if (clear) {
+                        err = _kzalloc(_MM_PROG, size, NULL, _MM_FLAG__DMA_CAPABLE, _MM_FLAG__DMA_CAPABLE, mem);
+                } else {
+                        err = _kmalloc(_MM_PROG, size, NULL, _MM_FLAG__DMA_CAPABLE, _MM_FLAG__DMA_CAPABLE, mem);
+                }
+
+                if ((err == ENOMEM) && (attempt == 0)) {
+                        _process_magazine_flush(GETPROCESS(), rq->client_thread);
+                } else if ((err == ENOMEM) && (attempt == 1)) {
+                        while (_process_reap(REAPER_FALLBACK_SLICES));
+                } else {
+                        break;
+                }
+        }
+
+        if (err == ESUCC) {
+                err = _process_register_resource(GETPROCESS(), *mem);
+                if (err != ESUCC) {
+                        _kfree(_MM_PROG, mem);
+                }
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function execute selected number of submission entries and put
+ *         results to the completion ring. Execution is stopped when the
+ *         completion ring is full. Entry linked with failed entry is canceled.
+ *
+ * @param  ring         ring
+ * @param  proc         client process
+ * @param  count        number of entries to execute
+ * @param  notify       signal completion event after each entry
+ *
+ * @return Number of executed entries.
+ */
+//==============================================================================
+static u16_t ring_run(ring_t *ring, _process_t *proc, u16_t count, bool notify)
+{
+        u16_t mask   = ring->entries - 1;
+        bool  cancel = false;
+        u16_t n      = 0;
+
+        for (; n < count; n++) {
+                if (cast(u16_t, ring->cq_tail - ring->cq_head) >= ring->entries) {
+                        break;
+                }
+
+                ring_sqe_t *sqe = &ring->sqe[ring->sq_head & mask];
+                ring_cqe_t *cqe = &ring->cqe[ring->cq_tail & mask];
+
+                ssize_t res = 0;
+                int     err = cancel ? ECANCELED : ring_execute(sqe, proc, &res);
+
+                cancel = (sqe->flags & RING_SQE_LINK) && (err != ESUCC);
+
+                cqe->res       = (err == ESUCC) ? res : -1;
+                cqe->err       = err;
+                cqe->user_data = sqe->user_data;
+
+                ring->sq_head++;
+                ring->cq_tail++;
+
+                if (notify && ring->event) {
+                        _semaphore_signal(ring->event);
+                }
+        }
+
+        return n;
+}
+
+//==============================================================================
+/**
+ * @brief  Function execute single submission entry.
+ *
+ * @param  sqe          submission entry
+ * @param  proc         client process
+ * @param  res          number of transferred bytes
+ *
+ * @return One of errno value.
+ */
+//==============================================================================
+static int ring_execute(ring_sqe_t *sqe, _process_t *proc, ssize_t *res)
+{
+        const i64_t *offset = (sqe->offset == RING_OFFSET_CURRENT) ? NULL : &sqe->offset;
+        struct iovec iov    = {.iov_base = sqe->buf, .iov_len = sqe->len};
+        size_t       n      = 0;
+        int          err    = ENOTSUP;
+
+        UNUSED_ARG1(proc);
+
+        switch (sqe->op) {
+        case RING_OP_NOP:
+                err = ESUCC;
+                break;
+
+        case RING_OP_READ:
+                err = _vfs_fpreadv(sqe->obj, &iov, 1, offset, &n);
+                break;
+
+        case RING_OP_WRITE:
+                err = _vfs_fpwritev(sqe->obj, &iov, 1, offset, &n);
+                break;
+
+        case RING_OP_FSYNC:
+                err = _vfs_fflush(sqe->obj);
+                break;
+
+#if __OS_ENABLE_FSTAT__ == _YES_
+        case RING_OP_STAT: {
+                struct vfs_path path;
+                path.CWD  = _process_get_CWD(proc);
+                path.PATH = sqe->obj;
+                err = _vfs_stat(&path, sqe->buf);
+                break;
+        }
+
+        case RING_OP_FSTAT:
+                err = _vfs_fstat(sqe->obj, sqe->buf);
+                break;
+#endif
+
+#if __ENABLE_NETWORK__ == _YES_
+        case RING_OP_SEND:
+                err = _net_socket_send(sqe->obj, sqe->buf, sqe->len, sqe->msg_flags, &n);
+                break;
+
+        case RING_OP_RECV:
+                err = _net_socket_recv(sqe->obj, sqe->buf, sqe->len, sqe->msg_flags, &n);
+                break;
+#endif
+
+        default:
+                break;
+        }
+
+        *res = n;
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function finish ring submission. Threads that wait for the end of
+ *         asynchronous submission are woken up.
+ *
+ * @param  ring         ring
+ */
+//==============================================================================
+static void ring_release(ring_t *ring)
+{
+        ring->busy = false;
+
+        if (ring->event) {
+                _semaphore_signal(ring->event);
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Kworker thread that execute queued asynchronous ring submissions.
+ *
+ * @param  arg          not used
+ */
+//==============================================================================
+static void ring_worker(void *arg)
+{
+        UNUSED_ARG1(arg);
+
+        for (;;) {
+                ring_work_t work;
+
+                if (_queue_receive(ring_queue, &work, MAX_DELAY_MS) == ESUCC) {
+                        ring_run(work.ring, work.client_proc, work.count, true);
+                        ring_release(work.ring);
+                        _process_async_end(work.client_proc);
+                }
+        }
+}
+
 #if ((__OS_SYSTEM_MSG_ENABLE__ > 0) && (__OS_PRINTF_ENABLE__ > 0))
 //==============================================================================
 /**
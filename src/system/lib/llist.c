@@ -34,6 +34,7 @@
 #include "lib/llist.h"
 #include <string.h>
 #include "libc/errno.h"
+#include "mm/pool.h"
 
 /*==============================================================================
   Local macros
@@ -90,6 +91,8 @@ static void   *krnmalloc        (size_t size, void *allocctx);
 static void    krnfree          (void *mem, void *freectx);
 static void   *modmalloc        (size_t size, void *allocctx);
 static void    modfree          (void *mem, void *freectx);
+static item_t *item_alloc       (llist_t *this);
+static void    item_free        (llist_t *this, item_t *item);
 
 
 /*==============================================================================
@@ -97,6 +100,15 @@ static void    modfree          (void *mem, void *freectx);
 ==============================================================================*/
 static const uint32_t magic_number = 0x6D89B264;
 
+/* items of kernel lists are allocated from pools of selected memory purpose */
+static _mm_pool_t item_pool[_MM_COUNT] = {
+        [_MM_KRN]   = _MM_POOL_INIT("llist:krn"  , _MM_KRN  , sizeof(item_t), 16),
+        [_MM_FS]    = _MM_POOL_INIT("llist:fs"   , _MM_FS   , sizeof(item_t), 8),
+        [_MM_NET]   = _MM_POOL_INIT("llist:net"  , _MM_NET  , sizeof(item_t), 8),
+        [_MM_SHM]   = _MM_POOL_INIT("llist:shm"  , _MM_SHM  , sizeof(item_t), 4),
+        [_MM_CACHE] = _MM_POOL_INIT("llist:cache", _MM_CACHE, sizeof(item_t), 8),
+};
+
 /*==============================================================================
   Function definitions
 ==============================================================================*/
@@ -1105,7 +1117,7 @@ static int remove_item(llist_t *this, item_t *item, bool unlink)
                         item->data = NULL;
                 }
 
-                this->free(item, this->freectx);
+                item_free(this, item);
 
                 this->count--;
 
@@ -1136,7 +1148,7 @@ static int insert_item(llist_t *this, int index, const void *data)
                 return 0;
 
         } else {
-                item_t *new_item = this->malloc(sizeof(item_t), this->allocctx);
+                item_t *new_item = item_alloc(this);
                 if (new_item) {
                         new_item->data = const_cast(void*, data);
 
@@ -1152,7 +1164,7 @@ static int insert_item(llist_t *this, int index, const void *data)
                                 return 1;
                         }
 
-                        this->free(new_item, this->freectx);
+                        item_free(this, new_item);
                 }
 
         }
@@ -1170,7 +1182,7 @@ static int insert_item(llist_t *this, int index, const void *data)
 //==============================================================================
 static int prepend(llist_t *this, const void *data)
 {
-        item_t *new_item = this->malloc(sizeof(item_t), this->allocctx);
+        item_t *new_item = item_alloc(this);
         if (new_item) {
                 new_item->data = const_cast(void*, data);
 
@@ -1204,7 +1216,7 @@ static int prepend(llist_t *this, const void *data)
 //==============================================================================
 static int append(llist_t *this, const void *data)
 {
-        item_t *new_item = this->malloc(sizeof(item_t), this->allocctx);
+        item_t *new_item = item_alloc(this);
         if (new_item) {
                 new_item->data = const_cast(void*, data);
 
@@ -1374,6 +1386,45 @@ static void modfree(void *mem, void *freectx)
         _kfree(_MM_MOD, &mem, cast(size_t, freectx));
 }
 
+//==============================================================================
+/**
+ * @brief  Allocate list item. Items of kernel lists are taken from pool.
+ *
+ * @param  this         list object
+ *
+ * @return Allocated item or NULL on error.
+ */
+//==============================================================================
+static item_t *item_alloc(llist_t *this)
+{
+        if ((this->malloc == krnmalloc) && item_pool[cast(size_t, this->allocctx)].name) {
+                item_t *item = NULL;
+                _mm_pool_malloc(&item_pool[cast(size_t, this->allocctx)], cast(void**, &item));
+                return item;
+        } else {
+                return this->malloc(sizeof(item_t), this->allocctx);
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Free list item.
+ *
+ * @param  this         list object
+ * @param  item         item to free
+ *
+ * @return None
+ */
+//==============================================================================
+static void item_free(llist_t *this, item_t *item)
+{
+        if ((this->free == krnfree) && item_pool[cast(size_t, this->freectx)].name) {
+                _mm_pool_free(&item_pool[cast(size_t, this->freectx)], cast(void**, &item));
+        } else {
+                this->free(item, this->freectx);
+        }
+}
+
 /*==============================================================================
   End of file
 ==============================================================================*/
@@ -34,11 +34,13 @@
 #include "lib/vfprintf.h"
 #include "lib/vsnprintf.h"
 #include "lib/cast.h"
+#include "kernel/errno.h"
 #include "mm/mm.h"
 
 /*==============================================================================
   Local macros
 ==============================================================================*/
+#define LINE_LEN                128
 
 /*==============================================================================
   Local object types
@@ -47,6 +49,9 @@
 /*==============================================================================
   Local function prototypes
 ==============================================================================*/
+#if (__OS_PRINTF_ENABLE__ > 0)
+static bool write_to_file(void *file, const char *str, size_t len);
+#endif
 
 /*==============================================================================
   Local objects
@@ -66,7 +71,11 @@
 
 //==============================================================================
 /**
- * @brief Function write to file formatted string
+ * @brief Function write to file formatted string. Message is written to file
+ *        by single write, so output of concurrent writers does not interleave.
+ *        Message is formatted in stack buffer, longer message is formatted in
+ *        allocated buffer. If memory is not available then message is written
+ *        in line size chunks.
  *
  * @param file                file
  * @param format              formated text
@@ -82,21 +91,30 @@ int _vfprintf(FILE *file, const char *format, va_list arg)
 #if (__OS_PRINTF_ENABLE__ > 0)
 
         if (file && format) {
+                char line[LINE_LEN];
+
                 va_list carg;
                 va_copy(carg, arg);
-                u32_t size = _vsnprintf(NULL, 0, format, carg) + 1;
+                n = _vsnprintf(line, sizeof(line), format, carg);
                 va_end(carg);
 
-                char *str = NULL;
-                int err = _kzalloc(_MM_KRN, size, NULL, _MM_FLAG__DMA_CAPABLE,
-                                   _MM_FLAG__DMA_CAPABLE, cast(void*, &str));
-                if (!err && str) {
-                        n = _vsnprintf(str, size, format, arg);
-
-                        size_t wrcnt;
-                        _vfs_fwrite(str, n, &wrcnt, file);
-
-                        _kfree(_MM_KRN, cast(void*, &str));
+                if (n < cast(int, sizeof(line) - 1)) {
+                        write_to_file(file, line, n);
+                } else {
+                        va_copy(carg, arg);
+                        u32_t size = _vsnprintf(NULL, 0, format, carg) + 1;
+                        va_end(carg);
+
+                        char *str = NULL;
+                        int err = _kmalloc(_MM_KRN, size, NULL, _MM_FLAG__DMA_CAPABLE,
+                                           _MM_FLAG__DMA_CAPABLE, cast(void*, &str));
+                        if (!err && str) {
+                                n = _vsnprintf(str, size, format, arg);
+                                write_to_file(file, str, n);
+                                _kfree(_MM_KRN, cast(void*, &str));
+                        } else {
+                                n = _vcbprintf(line, sizeof(line), write_to_file, file, format, arg);
+                        }
                 }
         }
 
@@ -106,6 +124,25 @@ int _vfprintf(FILE *file, const char *format, va_list arg)
         return n;
 }
 
+#if (__OS_PRINTF_ENABLE__ > 0)
+//==============================================================================
+/**
+ * @brief Function write formatted characters to file (printf sink).
+ *
+ * @param file                file
+ * @param str                 characters
+ * @param len                 number of characters
+ *
+ * @return On success true is returned, otherwise false.
+ */
+//==============================================================================
+static bool write_to_file(void *file, const char *str, size_t len)
+{
+        size_t wrcnt = 0;
+        return (_vfs_fwrite(str, len, &wrcnt, file) == ESUCC) && (wrcnt == len);
+}
+#endif
+
 /*==============================================================================
   End of file
 ==============================================================================*/
@@ -49,6 +49,8 @@
 /*==============================================================================
   Local function prototypes
 ==============================================================================*/
+static int vprintf_to(char *buf, size_t size, _vprintf_sink_t sink, void *ctx,
+                      const char *format, va_list arg);
 
 /*==============================================================================
   Local objects
@@ -120,6 +122,71 @@
  */
 //==============================================================================
 int _vsnprintf(char *buf, size_t size, const char *format, va_list arg)
+{
+        return vprintf_to(buf, size, NULL, NULL, format, arg);
+}
+
+//==============================================================================
+/**
+ * @brief Function convert arguments to stream and pass produced characters
+ *        to the sink function. Characters are collected in buffer given by
+ *        caller and passed to the sink when buffer is full and at the end of
+ *        message, so no memory is allocated. Message that fits in the buffer
+ *        is passed to the sink at once. See _vsnprintf() for supported flags.
+ *
+ * @param[in] *buf           buffer for characters
+ * @param[in]  size          buffer size
+ * @param[in]  sink          sink function (returns false to stop formatting)
+ * @param[in] *ctx           sink context
+ * @param[in] *format        message format
+ * @param[in]  arg           argument list
+ *
+ * @return number of printed characters
+ */
+//==============================================================================
+int _vcbprintf(char *buf, size_t size, _vprintf_sink_t sink, void *ctx,
+               const char *format, va_list arg)
+{
+        return (buf && size && sink) ? vprintf_to(buf, size, sink, ctx, format, arg) : 0;
+}
+
+//==============================================================================
+/**
+ * @brief Function convert arguments to stream.
+ *
+ * @param[in] *buf           buffer for stream
+ * @param[in]  size          buffer size
+ * @param[in] *format        message format
+ * @param[in]  ...           arguments
+ *
+ * @return number of printed characters
+ */
+//==============================================================================
+int _snprintf(char *bfr, size_t size, const char *format, ...)
+{
+        va_list arg;
+        va_start(arg, format);
+        int r = _vsnprintf(bfr, size, format, arg);
+        va_end(arg);
+        return r;
+}
+
+//==============================================================================
+/**
+ * @brief Function convert arguments to buffer or to sink function.
+ *
+ * @param[in] *buf           buffer for stream (chunk buffer if sink is set)
+ * @param[in]  size          buffer size
+ * @param[in]  sink          sink function (can be NULL)
+ * @param[in] *ctx           sink context
+ * @param[in] *format        message format
+ * @param[in]  arg           argument list
+ *
+ * @return number of printed characters
+ */
+//==============================================================================
+static int vprintf_to(char *buf, size_t size, _vprintf_sink_t sink, void *ctx,
+                      const char *format, va_list arg)
 {
 #if (__OS_PRINTF_ENABLE__ > 0)
         char   chr;
@@ -129,6 +196,7 @@ int _vsnprintf(char *buf, size_t size, const char *format, va_list arg)
         bool   loop_break   = false;
         bool   long_long    = false;
         bool   arg_size_str = false;
+        size_t sink_len     = 0;
 
         /// @brief  Function break loop
         /// @param  None
@@ -143,7 +211,19 @@ int _vsnprintf(char *buf, size_t size, const char *format, va_list arg)
         /// @return On success true is returned, otherwise false and loop is break
         bool put_char(const char c)
         {
-                if (buf) {
+                if (sink) {
+                        buf[sink_len++] = c;
+
+                        if (sink_len == size) {
+                                sink_len = 0;
+
+                                if (!sink(ctx, buf, size)) {
+                                        break_loop();
+                                        return false;
+                                }
+                        }
+
+                } else if (buf) {
                         if (scan_len < size) {
                                 *buf++ = c;
                         } else {
@@ -476,40 +556,25 @@ int _vsnprintf(char *buf, size_t size, const char *format, va_list arg)
                 }
         }
 
-        if (buf)
+        if (sink && sink_len) {
+                sink(ctx, buf, sink_len);
+        }
+
+        if (buf && !sink)
                 *buf = 0;
 
         return (scan_len - 1);
 #else
         UNUSED_ARG1(buf);
         UNUSED_ARG1(size);
+        UNUSED_ARG1(sink);
+        UNUSED_ARG1(ctx);
         UNUSED_ARG1(format);
         UNUSED_ARG1(arg);
         return 0;
 #endif
 }
 
-//==============================================================================
-/**
- * @brief Function convert arguments to stream.
- *
- * @param[in] *buf           buffer for stream
- * @param[in]  size          buffer size
- * @param[in] *format        message format
- * @param[in]  ...           arguments
- *
- * @return number of printed characters
- */
-//==============================================================================
-int _snprintf(char *bfr, size_t size, const char *format, ...)
-{
-        va_list arg;
-        va_start(arg, format);
-        int r = _vsnprintf(bfr, size, format, arg);
-        va_end(arg);
-        return r;
-}
-
 /*==============================================================================
   End of file
 ==============================================================================*/
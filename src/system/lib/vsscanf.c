@@ -277,7 +277,7 @@ int _vsscanf(const char *str, const char *format, va_list args)
                                         if (value) {
                                                 char *end;
                                                 *value = _strtod(str, &end);
-                                                str += ((int)end - (int)str);
+                                                str += (end - str);
 
                                                 if (*end != '\0')
                                                         str++;
@@ -0,0 +1,490 @@
+/*=========================================================================*//**
+@file    stdiobuf.c
+
+@author  Daniel Zorychta
+
+@brief   User space buffering of streams (setvbuf).
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <dnx/thread.h>
+
+/*==============================================================================
+  Local macros
+==============================================================================*/
+#define MTX_TIMEOUT             MAX_DELAY_MS
+
+/*==============================================================================
+  Local object types
+==============================================================================*/
+/* buffer of single stream */
+typedef struct stream {
+        struct stream *next;
+        FILE          *file;
+        char          *buf;
+        size_t         size;
+        size_t         len;
+        int            mode;
+        bool           own_buf;
+} stream_t;
+
+/* stream buffers of process */
+struct _libc_stdio {
+        mutex_t       *mtx;
+        stream_t      *streams;
+};
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+static struct _libc_stdio *get_stdio(void);
+static stream_t *find_stream(FILE *file);
+static int  flush_stream(stream_t *stream);
+static void release_stream(stream_t *stream);
+static stream_t *default_stream(FILE *file);
+static size_t sys_fwrite(const void *ptr, size_t size, size_t count, FILE *file);
+
+/*==============================================================================
+  Local objects
+==============================================================================*/
+
+/*==============================================================================
+  Exported objects
+==============================================================================*/
+
+/*==============================================================================
+  External objects
+==============================================================================*/
+extern void _kernel_scheduler_lock(void);
+extern void _kernel_scheduler_unlock(void);
+extern int  _mutex_lock(mutex_t*, const u32_t);
+extern int  _mutex_unlock(mutex_t*);
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+
+//==============================================================================
+/**
+ * @brief Function sets stream buffer mode.
+ *
+ * @param file      stream
+ * @param buffer    buffer (NULL: buffer is allocated)
+ * @param mode      buffer mode (_IONBF, _IOLBF, _IOFBF)
+ * @param size      buffer size
+ *
+ * @return On success 0 is returned, otherwise EOF.
+ */
+//==============================================================================
+int setvbuf(FILE *file, char *buffer, int mode, size_t size)
+{
+        if (!file || (mode < _IOFBF) || (mode > _IONBF)) {
+                _errno = EINVAL;
+                return EOF;
+        }
+
+        struct _libc_stdio *stdio = get_stdio();
+        if (!stdio) {
+                return EOF;
+        }
+
+        int r = EOF;
+
+        if (_builtinfunc(mutex_lock, stdio->mtx, MTX_TIMEOUT) == ESUCC) {
+
+                stream_t *stream = find_stream(file);
+                if (stream) {
+                        flush_stream(stream);
+                        release_stream(stream);
+                }
+
+                stream = calloc(1, sizeof(stream_t));
+                if (stream) {
+                        if (mode == _IONBF) {
+                                // stream is registered to skip default buffer
+                                stream->file    = file;
+                                stream->mode    = mode;
+                                stream->next    = stdio->streams;
+                                stdio->streams  = stream;
+                                r = 0;
+
+                        } else {
+                                size = size ? size : BUFSIZ;
+
+                                if (buffer) {
+                                        stream->buf = buffer;
+                                } else {
+                                        stream->buf     = malloc(size);
+                                        stream->own_buf = true;
+                                }
+
+                                if (stream->buf) {
+                                        stream->file    = file;
+                                        stream->size    = size;
+                                        stream->mode    = mode;
+                                        stream->next    = stdio->streams;
+                                        stdio->streams  = stream;
+                                        r = 0;
+                                } else {
+                                        free(stream);
+                                }
+                        }
+                }
+
+                _builtinfunc(mutex_unlock, stdio->mtx);
+        }
+
+        return r;
+}
+
+//==============================================================================
+/**
+ * @brief Function writes data to stream through stream buffer. At first write
+ *        to the stream its default buffer mode is selected: regular files are
+ *        fully buffered, other files are not buffered.
+ *
+ * @param ptr           pointer to data
+ * @param size          element size
+ * @param count         number of elements
+ * @param file          stream
+ *
+ * @return Number of written items.
+ */
+//==============================================================================
+size_t _libc_fwrite(const void *ptr, size_t size, size_t count, FILE *file)
+{
+        struct _libc_stdio *stdio = get_stdio();
+
+        if (stdio && (_builtinfunc(mutex_lock, stdio->mtx, MTX_TIMEOUT) == ESUCC)) {
+
+                size_t    n      = 0;
+                size_t    total  = size * count;
+                stream_t *stream = find_stream(file);
+
+                if (!stream && file && ptr && (total > 0)) {
+                        stream = default_stream(file);
+                }
+
+                if (!stream || (stream->mode == _IONBF) || !ptr || (total == 0)) {
+                        n = sys_fwrite(ptr, size, count, file);
+
+                } else {
+                        n = count;
+
+                        if (total > (stream->size - stream->len)) {
+                                if (flush_stream(stream) != 0) {
+                                        n = 0;
+                                }
+                        }
+
+                        if (n && (total >= stream->size)) {
+                                n = sys_fwrite(ptr, size, count, file);
+
+                        } else if (n) {
+                                memcpy(&stream->buf[stream->len], ptr, total);
+                                stream->len += total;
+
+                                if (  (stream->mode == _IOLBF)
+                                   && memchr(ptr, '\n', total) ) {
+
+                                        if (flush_stream(stream) != 0) {
+                                                n = 0;
+                                        }
+                                }
+                        }
+                }
+
+                _builtinfunc(mutex_unlock, stdio->mtx);
+
+                return n;
+        }
+        return sys_fwrite(ptr, size, count, file);
+}
+
+//==============================================================================
+/**
+ * @brief Function write buffered data of stream.
+ *
+ * @param file          stream (NULL: all streams of process)
+ *
+ * @return On success 0 is returned, otherwise EOF.
+ */
+//==============================================================================
+int _libc_fflush(FILE *file)
+{
+        int r = 0;
+
+        struct _libc_stdio *stdio = _libc_stdio;
+
+        if (stdio && (_builtinfunc(mutex_lock, stdio->mtx, MTX_TIMEOUT) == ESUCC)) {
+
+                for (stream_t *stream = stdio->streams; stream; stream = stream->next) {
+                        if (!file || (stream->file == file)) {
+                                if (flush_stream(stream) != 0) {
+                                        r = EOF;
+                                }
+                        }
+                }
+
+                _builtinfunc(mutex_unlock, stdio->mtx);
+        }
+
+        return r;
+}
+
+//==============================================================================
+/**
+ * @brief Function prepares stream before read. Buffered data of stream is
+ *        written. Reading stdin flushes line buffered streams.
+ *
+ * @param file          stream
+ */
+//==============================================================================
+void _libc_fread(FILE *file)
+{
+        struct _libc_stdio *stdio = _libc_stdio;
+
+        if (stdio && (_builtinfunc(mutex_lock, stdio->mtx, MTX_TIMEOUT) == ESUCC)) {
+
+                for (stream_t *stream = stdio->streams; stream; stream = stream->next) {
+                        if (  (stream->file == file)
+                           || ((file == stdin) && (stream->mode == _IOLBF)) ) {
+
+                                flush_stream(stream);
+                        }
+                }
+
+                _builtinfunc(mutex_unlock, stdio->mtx);
+        }
+}
+
+//==============================================================================
+/**
+ * @brief Function write buffered data and release buffer of stream that
+ *        will be closed.
+ *
+ * @param file          stream
+ */
+//==============================================================================
+void _libc_fclose(FILE *file)
+{
+        struct _libc_stdio *stdio = _libc_stdio;
+
+        if (stdio && (_builtinfunc(mutex_lock, stdio->mtx, MTX_TIMEOUT) == ESUCC)) {
+
+                stream_t *stream = find_stream(file);
+                if (stream) {
+                        flush_stream(stream);
+                        release_stream(stream);
+                }
+
+                _builtinfunc(mutex_unlock, stdio->mtx);
+        }
+}
+
+//==============================================================================
+/**
+ * @brief Function returns stream buffers of process. Object is created at
+ *        first use.
+ *
+ * @return Stream buffers object or NULL if not enough free memory.
+ */
+//==============================================================================
+static struct _libc_stdio *get_stdio(void)
+{
+        if (!_libc_stdio) {
+                struct _libc_stdio *stdio = calloc(1, sizeof(struct _libc_stdio));
+                if (stdio) {
+                        stdio->mtx = mutex_new(MUTEX_TYPE_RECURSIVE);
+                        if (stdio->mtx) {
+
+                                // other thread of process can create object as well
+                                _builtinfunc(kernel_scheduler_lock);
+                                bool set = (_libc_stdio == NULL);
+                                if (set) {
+                                        _libc_stdio = stdio;
+                                }
+                                _builtinfunc(kernel_scheduler_unlock);
+
+                                if (!set) {
+                                        mutex_delete(stdio->mtx);
+                                        free(stdio);
+                                }
+                        } else {
+                                free(stdio);
+                        }
+                }
+        }
+
+        return _libc_stdio;
+}
+
+//==============================================================================
+/**
+ * @brief Function find buffer of stream. Found stream is moved to the
+ *        beginning of list. Function shall be called with locked mutex.
+ *
+ * @param file          stream
+ *
+ * @return Stream buffer or NULL if stream is not buffered.
+ */
+//==============================================================================
+static stream_t *find_stream(FILE *file)
+{
+        stream_t **pstream = &_libc_stdio->streams;
+
+        for (stream_t *stream = *pstream; stream; stream = stream->next) {
+                if (stream->file == file) {
+                        *pstream        = stream->next;
+                        stream->next    = _libc_stdio->streams;
+                        _libc_stdio->streams = stream;
+                        return stream;
+                }
+
+                pstream = &stream->next;
+        }
+
+        return NULL;
+}
+
+//==============================================================================
+/**
+ * @brief Function write buffered data to file.
+ *
+ * @param stream        stream buffer
+ *
+ * @return On success 0 is returned, otherwise EOF.
+ */
+//==============================================================================
+static int flush_stream(stream_t *stream)
+{
+        int r = 0;
+
+        if (stream->len > 0) {
+                if (sys_fwrite(stream->buf, 1, stream->len, stream->file) != stream->len) {
+                        r = EOF;
+                }
+
+                stream->len = 0;
+        }
+
+        return r;
+}
+
+//==============================================================================
+/**
+ * @brief Function remove stream buffer. Function shall be called with locked
+ *        mutex.
+ *
+ * @param stream        stream buffer
+ */
+//==============================================================================
+static void release_stream(stream_t *stream)
+{
+        stream_t **pstream = &_libc_stdio->streams;
+
+        while (*pstream) {
+                if (*pstream == stream) {
+                        *pstream = stream->next;
+                        break;
+                }
+
+                pstream = &(*pstream)->next;
+        }
+
+        if (stream->own_buf) {
+                free(stream->buf);
+        }
+
+        free(stream);
+}
+
+//==============================================================================
+/**
+ * @brief Function creates default buffer of stream. Regular files are fully
+ *        buffered, other files are registered as not buffered, so file type
+ *        is checked only once. Function shall be called with locked mutex.
+ *
+ * @param file          stream
+ *
+ * @return Stream buffer or NULL if not enough free memory.
+ */
+//==============================================================================
+static stream_t *default_stream(FILE *file)
+{
+        stream_t *stream = calloc(1, sizeof(stream_t));
+        if (stream) {
+                stream->file = file;
+                stream->mode = _IONBF;
+
+#if (__OS_ENABLE_FSTAT__ == _YES_)
+                int err = _errno;
+
+                struct stat st;
+                if ((fstat(file, &st) == 0) && S_ISREG(st.st_mode)) {
+                        stream->buf = malloc(BUFSIZ);
+                        if (stream->buf) {
+                                stream->size    = BUFSIZ;
+                                stream->mode    = _IOFBF;
+                                stream->own_buf = true;
+                        }
+                }
+
+                _errno = err;
+#endif
+                stream->next = _libc_stdio->streams;
+                _libc_stdio->streams = stream;
+        }
+
+        return stream;
+}
+
+//==============================================================================
+/**
+ * @brief Function writes data to stream without buffering.
+ *
+ * @param ptr           pointer to data
+ * @param size          element size
+ * @param count         number of elements
+ * @param file          stream
+ *
+ * @return Number of written items.
+ */
+//==============================================================================
+static size_t sys_fwrite(const void *ptr, size_t size, size_t count, FILE *file)
+{
+        size_t s = 0;
+        syscall(SYSCALL_FWRITE, &s, ptr, &size, &count, file);
+        return s;
+}
+
+/*==============================================================================
+  End of file
+==============================================================================*/
@@ -29,6 +29,7 @@ Brief    unistd function implementation.
 /*==============================================================================
   Include files
 ==============================================================================*/
+#include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 #include <unistd.h>
@@ -118,6 +119,10 @@ int close(fd_t fd)
                         f = stderr;
                 }
 
+                if (_libc_stdio) {
+                        _libc_fclose(f);
+                }
+
                 int r = EOF;
                 syscall(SYSCALL_FCLOSE, &r, f);
                 return r;
@@ -150,6 +155,10 @@ ssize_t read(fd_t fd, void *buf, size_t count)
                         f = stderr;
                 }
 
+                if (_libc_stdio) {
+                        _libc_fread(f);
+                }
+
                 size_t n = 0;
                 size_t size = 1;
                 syscall(SYSCALL_FREAD, &n, buf, &size, &count, f);
@@ -187,6 +196,10 @@ ssize_t write(fd_t fd, const void *buf, size_t count)
                         f = stderr;
                 }
 
+                if (_libc_stdio) {
+                        _libc_fflush(f);
+                }
+
                 size_t n = 0;
                 size_t size = 1;
                 syscall(SYSCALL_FWRITE, &n, buf, &size, &count, f);
@@ -225,6 +238,10 @@ off_t lseek(fd_t fd, off_t offset, int whence)
                         f = stderr;
                 }
 
+                if (_libc_stdio) {
+                        _libc_fflush(f);
+                }
+
                 size_t r = 1;
                 i64_t seek = offset;
                 syscall(SYSCALL_FSEEK, &r, f, &seek, &whence);
@@ -39,6 +39,7 @@
 /*==============================================================================
   Local macros
 ==============================================================================*/
+#define LINE_LEN                128
 
 /*==============================================================================
   Local object types
@@ -47,6 +48,9 @@
 /*==============================================================================
   Local function prototypes
 ==============================================================================*/
+#if (__OS_PRINTF_ENABLE__ > 0)
+static bool write_to_file(void *file, const char *str, size_t len);
+#endif
 
 /*==============================================================================
   Local objects
@@ -66,7 +70,11 @@
 
 //==============================================================================
 /**
- * @brief Function write to file formatted string
+ * @brief Function write to file formatted string. Message is passed to file
+ *        by single write, so output of concurrent writers does not interleave.
+ *        Message is formatted in stack buffer, longer message is formatted in
+ *        allocated buffer. If memory is not available then message is written
+ *        in line size chunks.
  *
  * @param file                file
  * @param format              formated text
@@ -80,18 +88,30 @@ int vfprintf(FILE *file, const char *format, va_list arg)
         int n = 0;
 
 #if (__OS_PRINTF_ENABLE__ > 0)
+        char line[LINE_LEN];
+
         va_list carg;
         va_copy(carg, arg);
-        u32_t size = vsnprintf(NULL, 0, format, carg) + 1;
+        n = _builtinfunc(vsnprintf, line, sizeof(line), format, carg);
         va_end(carg);
 
-        char *str = calloc(1, size);
-        if (str) {
-                n = vsnprintf(str, size, format, arg);
-                fwrite(str, sizeof(char), n, file);
-                int err = _errno;
-                free(str);
-                _errno = err;
+        if (n < (int)sizeof(line) - 1) {
+                write_to_file(file, line, n);
+        } else {
+                va_copy(carg, arg);
+                size_t size = _builtinfunc(vsnprintf, NULL, 0, format, carg) + 1;
+                va_end(carg);
+
+                char *str = malloc(size);
+                if (str) {
+                        n = _builtinfunc(vsnprintf, str, size, format, arg);
+                        write_to_file(file, str, n);
+                        int err = _errno;
+                        free(str);
+                        _errno = err;
+                } else {
+                        n = _builtinfunc(vcbprintf, line, sizeof(line), write_to_file, file, format, arg);
+                }
         }
 #else
         UNUSED_ARG3(file, format, arg);
@@ -100,6 +120,25 @@ int vfprintf(FILE *file, const char *format, va_list arg)
         return n;
 }
 
+#if (__OS_PRINTF_ENABLE__ > 0)
+//==============================================================================
+/**
+ * @brief Function write formatted characters to file (printf sink). Data is
+ *        stored in stream buffer if stream is buffered.
+ *
+ * @param file                file
+ * @param str                 characters
+ * @param len                 number of characters
+ *
+ * @return On success true is returned, otherwise false.
+ */
+//==============================================================================
+static bool write_to_file(void *file, const char *str, size_t len)
+{
+        return fwrite(str, sizeof(char), len, file) == len;
+}
+#endif
+
 /*==============================================================================
   End of file
 ==============================================================================*/
@@ -85,10 +85,7 @@ int vfscanf(FILE *stream, const char *format, va_list arg)
                 return 0;
 
         if (fgets(str, BUFSIZ, stream) == str) {
-                char *lf;
-                if ((lf = strchr(str, '\n')) != NULL) {
-                        *lf = '\0';
-                }
+                str[strcspn(str, "\n")] = '\0';
 
                 n = vsscanf(str, format, arg);
         }
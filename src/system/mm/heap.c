@@ -84,8 +84,8 @@
 #define SIZEOF_STRUCT_MEM               MEM_ALIGN_SIZE(sizeof(struct mem))
 
 #if __OS_HEAP_OVERFLOW_CHECK__ == _YES_
-#define MEM_SANITY_REGION_BEFORE_ALIGNED 8
-#define MEM_SANITY_REGION_AFTER_ALIGNED  8
+#define MEM_SANITY_REGION_BEFORE_ALIGNED MEM_ALIGN_SIZE(8)
+#define MEM_SANITY_REGION_AFTER_ALIGNED  MEM_ALIGN_SIZE(8)
 #else
 #define MEM_SANITY_REGION_BEFORE_ALIGNED 0
 #define MEM_SANITY_REGION_AFTER_ALIGNED  0
@@ -94,6 +94,18 @@
 #define MEM_SANITY_OFFSET               MEM_SANITY_REGION_BEFORE_ALIGNED
 #define MEM_SANITY_OVERHEAD             (MEM_SANITY_REGION_BEFORE_ALIGNED + MEM_SANITY_REGION_AFTER_ALIGNED)
 
+/** block usage indicators */
+#define MEM_UNUSED                      0
+#define MEM_USED                        1
+#define MEM_CACHED                      2
+
+/** the biggest block (with sanity regions) that is handled by size classes */
+#define SIZE_CLASS_MAX                  (_HEAP_SIZE_CLASSES * SIZE_CLASS_GRANULE)
+#define SIZE_CLASS_GRANULE              MEM_ALIGN_SIZE(_HEAP_SIZE_CLASS_GRANULE)
+
+/** part of the heap that can be kept in segregated lists (1/16 of heap size) */
+#define SIZE_CLASS_CACHE_LIMIT(heap)    ((heap)->size >> 4)
+
 #define PROTECT                         _kernel_scheduler_lock
 #define UNPROTECT                       _kernel_scheduler_unlock
 
@@ -110,7 +122,7 @@
 struct mem {
         size_t next;            /**< index (-> ram[next]) of the next struct      */
         size_t prev;            /**< index (-> ram[prev]) of the previous struct  */
-        u8_t   used;            /**< 1: this area is used; 0: this area is unused */
+        u8_t   used;            /**< 2: area cached in size class; 1: area is used; 0: area is unused */
 #if __OS_HEAP_OVERFLOW_CHECK__ == _YES_
         size_t user_size;       /**< user size used in overflow check */
 #endif
@@ -253,7 +265,7 @@ static bool sanity(_heap_t *heap)
         /* begin with first element here */
         struct mem *mem = (struct mem *)heap->ram;
 
-        HEAP_ASSERT((mem->used == 0) || (mem->used == 1), "HEAP: element used invalid", fail);
+        HEAP_ASSERT(mem->used <= MEM_CACHED, "HEAP: element used invalid", fail);
         if (fail) return false;
 
         u8_t last_used = mem->used;
@@ -292,12 +304,12 @@ static bool sanity(_heap_t *heap)
                             "HEAP: element next ptr unaligned", fail);
                 if (fail) return false;
 
-                if (last_used == 0) {
+                if (last_used == MEM_UNUSED) {
                         /* 2 unused elements in a row? */
-                        HEAP_ASSERT(mem->used == 1, "HEAP: 2 element unused in row?", fail);
+                        HEAP_ASSERT(mem->used != MEM_UNUSED, "HEAP: 2 element unused in row?", fail);
                         if (fail) return false;
                 } else {
-                        HEAP_ASSERT((mem->used == 0) || (mem->used == 1), "HEAP: element used invalid", fail);
+                        HEAP_ASSERT(mem->used <= MEM_CACHED, "HEAP: element used invalid", fail);
                         if (fail) return false;
                 }
 
@@ -314,7 +326,7 @@ static bool sanity(_heap_t *heap)
         HEAP_ASSERT(mem == ptr_to_mem(heap, heap->size), "HEAP: end ptr sanity", fail);
         if (fail) return false;
 
-        HEAP_ASSERT(mem->used == 1, "HEAP: element used invalid", fail);
+        HEAP_ASSERT(mem->used == MEM_USED, "HEAP: element used invalid", fail);
         if (fail) return false;
 
         HEAP_ASSERT(mem->prev == heap->size, "HEAP: element prev ptr invalid", fail);
@@ -409,6 +421,243 @@ static void overflow_check_element(struct mem *mem)
 #endif
 }
 
+#if __OS_HEAP_SIZE_CLASSES__ == _YES_
+//==============================================================================
+/**
+ * @brief  Function return link to next block of size class list. The link is
+ *         stored in the user data area of cached block.
+ *
+ * @param  mem          memory block
+ *
+ * @return Pointer to link.
+ */
+//==============================================================================
+static struct mem **size_class_link(struct mem *mem)
+{
+        return (struct mem **)(void *)((u8_t *)mem + SIZEOF_STRUCT_MEM + MEM_SANITY_OFFSET);
+}
+
+//==============================================================================
+/**
+ * @brief  Function return size class of block of selected data size. Size
+ *         class n contains blocks that have at least (n + 1) * granule bytes.
+ *
+ * @param  size         block data size (aligned, with sanity regions)
+ *
+ * @return Size class index.
+ */
+//==============================================================================
+static size_t size_class_index(size_t size)
+{
+        return (size / SIZE_CLASS_GRANULE) - 1;
+}
+
+//==============================================================================
+/**
+ * @brief  Function take block from size class list. This assumes access to
+ *         the heap is protected by the calling function already.
+ *
+ * @param  heap         heap object
+ * @param  size         requested data size (size class size)
+ * @param  size_in      user size
+ * @param  allocated    real size of allocated block (can be NULL)
+ *
+ * @return Pointer to allocated memory or NULL if size class list is empty.
+ */
+//==============================================================================
+static void *size_class_alloc(_heap_t *heap, size_t size, size_t size_in, size_t *allocated)
+{
+        size_t idx = size_class_index(size);
+        struct mem *mem = heap->bin[idx];
+
+        if (mem == NULL) {
+                return NULL;
+        }
+
+        heap->bin[idx] = *size_class_link(mem);
+        mem->used = MEM_USED;
+
+        size_t used = (mem->next - mem_to_ptr(heap, mem));
+
+        heap->cached  -= used;
+        heap->used    += used;
+        heap->used_max = heap->used_max < heap->used ? heap->used : heap->used_max;
+        if (allocated) *allocated = used;
+
+        overflow_init_element(mem, size_in);
+
+        return (u8_t *)mem + SIZEOF_STRUCT_MEM + MEM_SANITY_OFFSET;
+}
+
+//==============================================================================
+/**
+ * @brief  Function put block to size class list if block is small enough and
+ *         cache limit is not reached. This assumes access to the heap is
+ *         protected by the calling function already.
+ *
+ * @param  heap         heap object
+ * @param  mem          freed block
+ * @param  blksize      block size (with block header)
+ *
+ * @return True if block is cached, otherwise false.
+ */
+//==============================================================================
+static bool size_class_free(_heap_t *heap, struct mem *mem, size_t blksize)
+{
+        size_t size = blksize - SIZEOF_STRUCT_MEM;
+
+        if (  (size < SIZE_CLASS_GRANULE) || (size > SIZE_CLASS_MAX)
+           || (heap->cached + blksize > SIZE_CLASS_CACHE_LIMIT(heap)) ) {
+
+                return false;
+        }
+
+        size_t idx = size_class_index(size);
+
+        mem->used = MEM_CACHED;
+        *size_class_link(mem) = heap->bin[idx];
+        heap->bin[idx] = mem;
+        heap->cached += blksize;
+
+        return true;
+}
+
+//==============================================================================
+/**
+ * @brief  Function return all cached blocks to the heap. Used when first-fit
+ *         search cannot find block big enough. This assumes access to the heap
+ *         is protected by the calling function already.
+ *
+ * @param  heap         heap object
+ *
+ * @return True if any block was returned, otherwise false.
+ */
+//==============================================================================
+static bool size_class_flush(_heap_t *heap)
+{
+        bool flushed = false;
+
+        for (size_t i = 0; i < _HEAP_SIZE_CLASSES; i++) {
+                while (heap->bin[i]) {
+                        struct mem *mem = heap->bin[i];
+                        heap->bin[i] = *size_class_link(mem);
+
+                        mem->used = MEM_UNUSED;
+
+                        if (mem < heap->lfree) {
+                                heap->lfree = mem;
+                        }
+
+                        plug_holes(heap, mem);
+
+                        flushed = true;
+                }
+        }
+
+        heap->cached = 0;
+
+        return flushed;
+}
+#endif
+
+//==============================================================================
+/**
+ * @brief  Function search heap for a free block that is big enough, beginning
+ *         with the lowest free block (first-fit). This assumes access to the
+ *         heap is protected by the calling function already.
+ *
+ * @param  heap         heap object
+ * @param  size         block size (aligned, with sanity regions)
+ * @param  size_in      user size
+ * @param  allocated    real size of allocated block (can be NULL)
+ *
+ * @return Pointer to allocated memory or NULL if no free memory was found.
+ */
+//==============================================================================
+static void *first_fit_alloc(_heap_t *heap, size_t size, size_t size_in, size_t *allocated)
+{
+        size_t ptr, ptr2;
+        struct mem *mem, *mem2;
+        size_t used;
+
+        for (ptr = mem_to_ptr(heap, heap->lfree); ptr < heap->size - size; ptr = ptr_to_mem(heap, ptr)->next) {
+
+                mem = ptr_to_mem(heap, ptr);
+
+                if ((mem->used == MEM_UNUSED) && (mem->next - (ptr + SIZEOF_STRUCT_MEM)) >= size) {
+                        /*
+                         * mem is not used and at least perfect fit is possible:
+                         * mem->next - (ptr + SIZEOF_STRUCT_MEM) gives us the 'user data size' of mem
+                         */
+
+                        if (mem->next - (ptr + SIZEOF_STRUCT_MEM)
+                           >= (size + SIZEOF_STRUCT_MEM + BLOCK_MIN_SIZE_ALIGNED)) {
+                                /* (in addition to the above, we test if another struct mem
+                                * (SIZEOF_STRUCT_MEM) containing
+                                * at least BLOCK_MIN_SIZE_ALIGNED of data also fits in the 'user
+                                * data space' of 'mem')
+                                * -> split large block, create empty remainder,
+                                * remainder must be large enough to contain BLOCK_MIN_SIZE_ALIGNED data: if
+                                * mem->next - (ptr + (2*SIZEOF_STRUCT_MEM)) == size,
+                                * struct mem would fit in but no data between mem2 and mem2->next
+                                * @todo we could leave out BLOCK_MIN_SIZE_ALIGNED. We would create an empty
+                                *       region that couldn't hold data, but when mem->next gets freed,
+                                *       the 2 regions would be combined, resulting in more free memory
+                                */
+                                ptr2 = ptr + SIZEOF_STRUCT_MEM + size;
+
+                                /* create mem2 struct */
+                                mem2 = ptr_to_mem(heap, ptr2);
+                                mem2->used = MEM_UNUSED;
+                                mem2->next = mem->next;
+                                mem2->prev = ptr;
+                                /* and insert it between mem and mem->next */
+                                mem->next = ptr2;
+                                mem->used = MEM_USED;
+
+                                if (mem2->next != heap->size) {
+                                        ptr_to_mem(heap, mem2->next)->prev = ptr2;
+                                }
+
+                                used = (size + SIZEOF_STRUCT_MEM);
+                        } else {
+                                /* (a mem2 struct does no fit into the user data space of
+                                 *  mem and mem->next will always
+                                 * be used at this point: if not we have 2 unused structs
+                                 * in a row, plug_holes should have
+                                 * take care of this).
+                                 * -> near fit or excact fit: do not split, no mem2 creation
+                                 * also can't move mem->next directly behind mem, since mem->next
+                                 * will always be used at this point!
+                                 */
+                                mem->used = MEM_USED;
+
+                                used = (mem->next - mem_to_ptr(heap, mem));
+                        }
+
+                        if (mem == heap->lfree) {
+                                volatile struct mem *cur = heap->lfree;
+
+                                /* Find next free block after mem and update lowest free pointer */
+                                while (cur->used && cur != heap->ram_end) {
+                                        cur = ptr_to_mem(heap, cur->next);
+                                }
+
+                                heap->lfree = cur;
+                        }
+
+                        heap->used    += used;
+                        heap->used_max = heap->used_max < heap->used ? heap->used : heap->used_max;
+                        if (allocated) *allocated = used;
+
+                        overflow_init_element(mem, size_in);
+
+                        return (u8_t *)mem + SIZEOF_STRUCT_MEM + MEM_SANITY_OFFSET;
+                }
+        }
+
+        return NULL;
+}
 
 //==============================================================================
 /**
@@ -429,6 +678,11 @@ int _heap_init(_heap_t *heap, void *start, size_t size)
                 heap->used     = 0;
                 heap->used_max = 0;
 
+                #if __OS_HEAP_SIZE_CLASSES__ == _YES_
+                memset(heap->bin, 0, sizeof(heap->bin));
+                heap->cached = 0;
+                #endif
+
                 /* align the heap */
                 heap->ram = start;
 
@@ -439,11 +693,11 @@ int _heap_init(_heap_t *heap, void *start, size_t size)
                 struct mem *mem = (struct mem *)heap->ram;
                 mem->next = heap->size;
                 mem->prev = 0;
-                mem->used = 0;
+                mem->used = MEM_UNUSED;
 
                 /* initialize the end of the heap */
                 heap->ram_end = ptr_to_mem(heap, heap->size);
-                heap->ram_end->used = 1;
+                heap->ram_end->used = MEM_USED;
                 heap->ram_end->next = heap->size;
                 heap->ram_end->prev = heap->size;
 
@@ -493,13 +747,13 @@ void _heap_free(_heap_t *heap, void *rmem, size_t *freed)
 
         overflow_check_element(mem);
 
-        if (mem->used > 1) {
+        if (mem->used > MEM_CACHED) {
                 _printk("HEAP: free: invalid usage indicator");
                 UNPROTECT();
                 return;
         }
 
-        if (!mem->used) {
+        if (mem->used != MEM_USED) {
                 _printk("HEAP: free: block unused");
                 UNPROTECT();
                 return;
@@ -511,17 +765,24 @@ void _heap_free(_heap_t *heap, void *rmem, size_t *freed)
                 return;
         }
 
-        mem->used = 0;
+        size_t blksize = (mem->next - (size_t)(((u8_t *)mem - heap->ram)));
+        heap->used -= blksize;
+        if (freed) *freed = blksize;
+
+        #if __OS_HEAP_SIZE_CLASSES__ == _YES_
+        if (size_class_free(heap, mem, blksize)) {
+                UNPROTECT();
+                return;
+        }
+        #endif
+
+        mem->used = MEM_UNUSED;
 
         if (mem < heap->lfree) {
                 /* the newly freed struct is now the lowest */
                 heap->lfree = mem;
         }
 
-        size_t blksize = (mem->next - (size_t)(((u8_t *)mem - heap->ram)));
-        heap->used -= blksize;
-        if (freed) *freed = blksize;
-
         plug_holes(heap, mem);
 
         #if __OS_HEAP_SANITY_CHECK__ == _YES_
@@ -545,9 +806,8 @@ void _heap_free(_heap_t *heap, void *rmem, size_t *freed)
 //==============================================================================
 void *_heap_alloc(_heap_t *heap, size_t size_in, size_t *allocated)
 {
-        size_t ptr, ptr2, size;
-        struct mem *mem, *mem2;
-        size_t used;
+        size_t size;
+        void  *blk = NULL;
 
         if (!heap || size_in == 0) {
                 return NULL;
@@ -566,98 +826,39 @@ void *_heap_alloc(_heap_t *heap, size_t size_in, size_t *allocated)
                 return NULL;
         }
 
+        #if __OS_HEAP_SIZE_CLASSES__ == _YES_
+        if (size <= SIZE_CLASS_MAX) {
+                /* small blocks are rounded up to size class to be reusable */
+                size = (size + SIZE_CLASS_GRANULE - 1) & ~(SIZE_CLASS_GRANULE - 1);
+        }
+        #endif
+
         /* protect the heap from concurrent access */
         PROTECT();
 
-        /*
-         * Scan through the heap searching for a free block that is big enough,
-         * beginning with the lowest free block.
-         */
-        for (ptr = mem_to_ptr(heap, heap->lfree); ptr < heap->size - size; ptr = ptr_to_mem(heap, ptr)->next) {
-
-                mem = ptr_to_mem(heap, ptr);
-
-                if ((!mem->used) && (mem->next - (ptr + SIZEOF_STRUCT_MEM)) >= size) {
-                        /*
-                         * mem is not used and at least perfect fit is possible:
-                         * mem->next - (ptr + SIZEOF_STRUCT_MEM) gives us the 'user data size' of mem
-                         */
-
-                        if (mem->next - (ptr + SIZEOF_STRUCT_MEM)
-                           >= (size + SIZEOF_STRUCT_MEM + BLOCK_MIN_SIZE_ALIGNED)) {
-                                /* (in addition to the above, we test if another struct mem
-                                * (SIZEOF_STRUCT_MEM) containing
-                                * at least BLOCK_MIN_SIZE_ALIGNED of data also fits in the 'user
-                                * data space' of 'mem')
-                                * -> split large block, create empty remainder,
-                                * remainder must be large enough to contain BLOCK_MIN_SIZE_ALIGNED data: if
-                                * mem->next - (ptr + (2*SIZEOF_STRUCT_MEM)) == size,
-                                * struct mem would fit in but no data between mem2 and mem2->next
-                                * @todo we could leave out BLOCK_MIN_SIZE_ALIGNED. We would create an empty
-                                *       region that couldn't hold data, but when mem->next gets freed,
-                                *       the 2 regions would be combined, resulting in more free memory
-                                */
-                                ptr2 = ptr + SIZEOF_STRUCT_MEM + size;
-
-                                /* create mem2 struct */
-                                mem2 = ptr_to_mem(heap, ptr2);
-                                mem2->used = 0;
-                                mem2->next = mem->next;
-                                mem2->prev = ptr;
-                                /* and insert it between mem and mem->next */
-                                mem->next = ptr2;
-                                mem->used = 1;
-
-                                if (mem2->next != heap->size) {
-                                        ptr_to_mem(heap, mem2->next)->prev = ptr2;
-                                }
-
-                                used = (size + SIZEOF_STRUCT_MEM);
-                        } else {
-                                /* (a mem2 struct does no fit into the user data space of
-                                 *  mem and mem->next will always
-                                 * be used at this point: if not we have 2 unused structs
-                                 * in a row, plug_holes should have
-                                 * take care of this).
-                                 * -> near fit or excact fit: do not split, no mem2 creation
-                                 * also can't move mem->next directly behind mem, since mem->next
-                                 * will always be used at this point!
-                                 */
-                                mem->used = 1;
-
-                                used = (mem->next - mem_to_ptr(heap, mem));
-                        }
-
-                        if (mem == heap->lfree) {
-                                volatile struct mem *cur = heap->lfree;
-
-                                /* Find next free block after mem and update lowest free pointer */
-                                while (cur->used && cur != heap->ram_end) {
-                                        cur = ptr_to_mem(heap, cur->next);
-                                }
-
-                                heap->lfree = cur;
-                        }
-
-                        heap->used    += used;
-                        heap->used_max = heap->used_max < heap->used ? heap->used : heap->used_max;
-                        if (allocated) *allocated = used;
-
-                        overflow_init_element(mem, size_in);
-
-                        #if __OS_HEAP_SANITY_CHECK__ == _YES_
-                        sanity(heap);
-                        #endif
+        #if __OS_HEAP_SIZE_CLASSES__ == _YES_
+        if (size <= SIZE_CLASS_MAX) {
+                blk = size_class_alloc(heap, size, size_in, allocated);
+        }
+        #endif
 
-                        UNPROTECT();
+        if (!blk) {
+                blk = first_fit_alloc(heap, size, size_in, allocated);
 
-                        return (u8_t *)mem + SIZEOF_STRUCT_MEM + MEM_SANITY_OFFSET;
+                #if __OS_HEAP_SIZE_CLASSES__ == _YES_
+                if (!blk && size_class_flush(heap)) {
+                        blk = first_fit_alloc(heap, size, size_in, allocated);
                 }
+                #endif
         }
 
+        #if __OS_HEAP_SANITY_CHECK__ == _YES_
+        sanity(heap);
+        #endif
+
         UNPROTECT();
 
-        return NULL;
+        return blk;
 }
 
 //==============================================================================
@@ -737,13 +938,13 @@ size_t _heap_get_block_size(_heap_t *heap, void *rmem)
 
         PROTECT();
 
-        if (mem->used > 1) {
+        if (mem->used > MEM_CACHED) {
                 UNPROTECT();
                 _printk("HEAP: blksize: invalid usage indicator");
                 return 0;
         }
 
-        if (!mem->used) {
+        if (mem->used != MEM_USED) {
                 UNPROTECT();
                 _printk("HEAP: blksize: block unused");
                 return 0;
@@ -762,6 +963,24 @@ size_t _heap_get_block_size(_heap_t *heap, void *rmem)
         return blksize;
 }
 
+//==============================================================================
+/**
+ * @brief  Function return number of bytes that can be used in selected block
+ *         (block size without block header and sanity regions)
+ *
+ * @param  heap     heap object
+ * @param  rmem     memory block
+ *
+ * @return Block capacity, 0 on error
+ */
+//==============================================================================
+size_t _heap_get_block_capacity(_heap_t *heap, void *rmem)
+{
+        size_t blksize = _heap_get_block_size(heap, rmem);
+
+        return blksize ? blksize - SIZEOF_STRUCT_MEM - MEM_SANITY_OVERHEAD : 0;
+}
+
 //==============================================================================
 /**
  * @brief  Function check heap consistency.
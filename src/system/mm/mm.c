@@ -35,6 +35,7 @@
 #include "mm/mm.h"
 #include "mm/heap.h"
 #include "mm/shm.h"
+#include "mm/pool.h"
 #include "lib/cast.h"
 #include "kernel/errno.h"
 #include "kernel/ktypes.h"
@@ -90,6 +91,7 @@ static const char  *REGISTRATION_ERROR_STR = "Memory %s registration error (%d)
 static _mm_region_t *regions;
 static i32_t         memory_usage[_MM_COUNT - 1];
 static i32_t         module_memory_usage[_drvreg_number_of_modules];
+static u32_t         low_memory_events;
 
 /*==============================================================================
   Exported objects
@@ -274,6 +276,7 @@ int _kfree(enum _mm_mem mpur, void **mem, ...)
                                 usage = &memory_usage[mpur];
                                 err   = ESUCC;
                                 (*cast(res_header_t**, mem))->next = NULL;
+                                (*cast(res_header_t**, mem))->prev = NULL;
                                 (*cast(res_header_t**, mem))->self = NULL;
                                 (*cast(res_header_t**, mem))->type = RES_TYPE_UNKNOWN;
                         } else {
@@ -341,6 +344,9 @@ int _mm_get_mem_usage_details(_mm_mem_usage_t *mem_usage)
                 mem_usage->cached_memory_usage      = memory_usage[_MM_CACHE];
                 mem_usage->modules_memory_usage     = 0;
 
+                _mm_pool_get_mem_usage(&mem_usage->pools_memory_usage,
+                                       &mem_usage->pools_free_memory);
+
                 for (size_t i = 0; i < _drvreg_number_of_modules; i++) {
                         mem_usage->modules_memory_usage += module_memory_usage[i];
                 }
@@ -371,6 +377,19 @@ int _mm_get_module_mem_usage(uint module, i32_t *usage)
         }
 }
 
+//==============================================================================
+/**
+ * @brief  Return number of failed allocations caused by lack of memory.
+ *         Value is used by caches to detect memory pressure.
+ *
+ * @return Number of low memory events.
+ */
+//==============================================================================
+u32_t _mm_get_low_memory_events(void)
+{
+        return low_memory_events;
+}
+
 //==============================================================================
 /**
  * @brief  Return size of selected memory block
@@ -391,6 +410,26 @@ size_t _mm_get_block_size(void *mem)
         return 0;
 }
 
+//==============================================================================
+/**
+ * @brief  Return number of bytes that can be used in selected memory block
+ *
+ * @param  mem      block to check
+ *
+ * @return Capacity of selected memory block, 0 on error
+ */
+//==============================================================================
+size_t _mm_get_block_capacity(void *mem)
+{
+        for (_mm_region_t *r = regions; r; r = r->next) {
+                if (IS_IN_HEAP(r->heap, mem)) {
+                        return _heap_get_block_capacity(&r->heap, mem);
+                }
+        }
+
+        return 0;
+}
+
 //==============================================================================
 /**
  * @brief  Return free memory (calculate by using all heap regions).
@@ -633,7 +672,7 @@ static int kalloc(enum _mm_mem mpur, size_t size, bool clear, const char *prefre
 
                 switch (mpur) {
                 case _MM_MOD: {
-                        i32_t modid = cast(i32_t, arg);
+                        i32_t modid = cast(i32_t, cast(intptr_t, arg));
                         if ((modid < 0) || (modid > cast(i32_t, _drvreg_number_of_modules))) {
                                 return EINVAL;
 
@@ -715,6 +754,7 @@ static int kalloc(enum _mm_mem mpur, size_t size, bool clear, const char *prefre
 
                         if (mpur == _MM_PROG) {
                                  cast(res_header_t*, blk)->next = NULL;
+                                 cast(res_header_t*, blk)->prev = NULL;
                                  cast(res_header_t*, blk)->self = blk;
                                  cast(res_header_t*, blk)->type = RES_TYPE_MEMORY;
                         }
@@ -726,6 +766,10 @@ static int kalloc(enum _mm_mem mpur, size_t size, bool clear, const char *prefre
         }
 
         finish:
+        if (err == ENOMEM) {
+                low_memory_events++;
+        }
+
         return err;
 }
 
@@ -0,0 +1,577 @@
+/*=========================================================================*//**
+@file    pool.c
+
+@author  Daniel Zorychta
+
+@brief   Pools of fixed-size objects.
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <string.h>
+#include "config.h"
+#include "mm/pool.h"
+#include "mm/mm.h"
+#include "lib/cast.h"
+#include "kernel/errno.h"
+#include "kernel/kwrapper.h"
+#include "dnx/misc.h"
+
+/*==============================================================================
+  Local macros
+==============================================================================*/
+#define PAGE_HEADER_SIZE                _mm_align(sizeof(page_t))
+
+/*==============================================================================
+  Local object types
+==============================================================================*/
+typedef struct page {
+        struct page *next;              //!< next page of pool
+        struct page *avail_next;        //!< next page with free objects
+        void        *free_list;         //!< free objects of page
+        u32_t        used;              //!< number of allocated objects of page
+} page_t;
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+static void register_pool(_mm_pool_t *pool);
+#if __OS_MEMORY_POOLS__ == _YES_
+static int  add_page(_mm_pool_t *pool);
+static page_t *find_page(_mm_pool_t *pool, void *obj);
+static page_t *take_free_pages(_mm_pool_t *pool);
+#endif
+
+/*==============================================================================
+  Local objects
+==============================================================================*/
+static _mm_pool_t *pools;
+
+/*==============================================================================
+  Exported objects
+==============================================================================*/
+
+/*==============================================================================
+  External objects
+==============================================================================*/
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+
+//==============================================================================
+/**
+ * @brief  Function create pool of fixed-size objects. First page of pool
+ *         is allocated immediately.
+ *
+ * @param[in]  mpur             memory purpose of pool pages
+ * @param[in]  size             object size
+ * @param[in]  count            number of objects in single page
+ * @param[in]  flags            required region features (DMA, cacheable)
+ * @param[in]  name             pool name
+ * @param[out] pool             created pool
+ *
+ * @return One of errno values.
+ */
+//==============================================================================
+int _mm_pool_create(enum _mm_mem mpur, size_t size, size_t count, u32_t flags,
+                    const char *name, _mm_pool_t **pool)
+{
+        if (  (mpur >= _MM_COUNT) || (mpur == _MM_PROG) || (mpur == _MM_MOD)
+           || !size || !count || !name || !pool) {
+
+                return EINVAL;
+        }
+
+        int err = _kzalloc(mpur, sizeof(_mm_pool_t), NULL, 0, 0, cast(void**, pool));
+        if (!err) {
+                (*pool)->name         = name;
+                (*pool)->mpur         = mpur;
+                (*pool)->object_size  = _mm_align(max(size, sizeof(void*)));
+                (*pool)->page_objects = count;
+                (*pool)->flags        = flags;
+                (*pool)->dynamic      = true;
+
+#if __OS_MEMORY_POOLS__ == _YES_
+                err = add_page(*pool);
+                if (err) {
+                        _kfree(mpur, cast(void**, pool));
+                }
+#else
+                register_pool(*pool);
+#endif
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function destroy pool created by _mm_pool_create(). All objects
+ *         shall be returned to the pool before.
+ *
+ * @param  pool         pool to destroy
+ *
+ * @return One of errno values.
+ */
+//==============================================================================
+int _mm_pool_destroy(_mm_pool_t *pool)
+{
+        if (!pool || !pool->dynamic) {
+                return EINVAL;
+        }
+
+        int err = EBUSY;
+
+        _kernel_scheduler_lock();
+        {
+                if (pool->used == 0) {
+                        if (pools == pool) {
+                                pools = pool->next;
+                        } else {
+                                for (_mm_pool_t *p = pools; p; p = p->next) {
+                                        if (p->next == pool) {
+                                                p->next = pool->next;
+                                                break;
+                                        }
+                                }
+                        }
+
+                        err = ESUCC;
+                }
+        }
+        _kernel_scheduler_unlock();
+
+        if (!err) {
+                page_t *page = pool->pages;
+                while (page) {
+                        page_t *next = page->next;
+                        _kfree(pool->mpur, cast(void**, &page));
+                        page = next;
+                }
+
+                _kfree(pool->mpur, cast(void**, &pool));
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function allocate object from pool. New page is allocated if
+ *         there is no free object in the pool.
+ *
+ * @param[in]  pool             pool
+ * @param[out] obj              allocated object
+ *
+ * @return One of errno values.
+ */
+//==============================================================================
+int _mm_pool_malloc(_mm_pool_t *pool, void **obj)
+{
+        if (!pool || !pool->object_size || !pool->page_objects || !obj) {
+                return EINVAL;
+        }
+
+#if __OS_MEMORY_POOLS__ == _YES_
+        int err = ESUCC;
+
+        while (!err) {
+                _critical_section_begin();
+                void   *blk  = NULL;
+                page_t *page = pool->avail;
+                if (page) {
+                        blk             = page->free_list;
+                        page->free_list = *cast(void**, blk);
+                        page->used++;
+
+                        if (!page->free_list) {
+                                pool->avail = page->avail_next;
+                        }
+
+                        pool->used++;
+                        pool->used_max = max(pool->used, pool->used_max);
+                }
+                _critical_section_end();
+
+                if (blk) {
+                        *obj = blk;
+                        break;
+                } else {
+                        err = add_page(pool);
+                }
+        }
+
+        return err;
+#else
+        int err = _kmalloc(pool->mpur, pool->object_size, NULL,
+                           pool->flags, pool->flags, obj);
+        if (!err) {
+                _critical_section_begin();
+                pool->used++;
+                pool->used_max = max(pool->used, pool->used_max);
+                _critical_section_end();
+
+                register_pool(pool);
+        }
+
+        return err;
+#endif
+}
+
+//==============================================================================
+/**
+ * @brief  Function allocate object from pool and clear it.
+ *
+ * @param[in]  pool             pool
+ * @param[out] obj              allocated object
+ *
+ * @return One of errno values.
+ */
+//==============================================================================
+int _mm_pool_zalloc(_mm_pool_t *pool, void **obj)
+{
+        int err = _mm_pool_malloc(pool, obj);
+        if (!err) {
+                memset(*obj, 0, pool->object_size);
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function return object to the pool. Set selected object pointer
+ *         to NULL.
+ *
+ * @param[in]     pool          pool
+ * @param[in,out] obj           pointer to object to free
+ *
+ * @return One of errno values.
+ */
+//==============================================================================
+int _mm_pool_free(_mm_pool_t *pool, void **obj)
+{
+        if (!pool || !obj || !*obj) {
+                return EINVAL;
+        }
+
+#if __OS_MEMORY_POOLS__ == _YES_
+        int err = EFAULT;
+
+        _critical_section_begin();
+        page_t *page = find_page(pool, *obj);
+        if (page) {
+                if (!page->free_list) {
+                        page->avail_next = pool->avail;
+                        pool->avail      = page;
+                }
+
+                *cast(void**, *obj) = page->free_list;
+                page->free_list = *obj;
+                page->used--;
+                pool->used--;
+                err = ESUCC;
+        }
+        _critical_section_end();
+
+        if (!err) {
+                *obj = NULL;
+        }
+
+        return err;
+#else
+        int err = _kfree(pool->mpur, obj);
+        if (!err) {
+                _critical_section_begin();
+                pool->used--;
+                _critical_section_end();
+        }
+
+        return err;
+#endif
+}
+
+//==============================================================================
+/**
+ * @brief  Function release pages of all pools that have no allocated objects.
+ *         Function is called by kworker on low memory.
+ */
+//==============================================================================
+void _mm_pool_shrink(void)
+{
+#if __OS_MEMORY_POOLS__ == _YES_
+        for (uint n = 0;; n++) {
+                page_t      *pages = NULL;
+                enum _mm_mem mpur  = _MM_KRN;
+                bool         found = false;
+
+                _kernel_scheduler_lock();
+                {
+                        uint i = 0;
+                        for (_mm_pool_t *p = pools; p; p = p->next, i++) {
+                                if (i == n) {
+                                        pages = take_free_pages(p);
+                                        mpur  = p->mpur;
+                                        found = true;
+                                        break;
+                                }
+                        }
+                }
+                _kernel_scheduler_unlock();
+
+                while (pages) {
+                        page_t *next = pages->next;
+                        _kfree(mpur, cast(void**, &pages));
+                        pages = next;
+                }
+
+                if (!found) {
+                        break;
+                }
+        }
+#endif
+}
+
+//==============================================================================
+/**
+ * @brief  Function return memory used by pools.
+ *
+ * @param[out] size     memory of all pool pages (part of purpose usage)
+ * @param[out] free     memory of free objects of pools
+ */
+//==============================================================================
+void _mm_pool_get_mem_usage(i32_t *size, i32_t *free)
+{
+        *size = 0;
+        *free = 0;
+
+        _kernel_scheduler_lock();
+        for (_mm_pool_t *p = pools; p; p = p->next) {
+#if __OS_MEMORY_POOLS__ == _YES_
+                *size += p->pages_count * (PAGE_HEADER_SIZE + (p->object_size * p->page_objects));
+                *free += (p->objects - p->used) * p->object_size;
+#else
+                *size += p->used * p->object_size;
+#endif
+        }
+        _kernel_scheduler_unlock();
+}
+
+//==============================================================================
+/**
+ * @brief  Function return number of pools that are in use.
+ *
+ * @return Number of pools.
+ */
+//==============================================================================
+uint _mm_get_number_of_pools(void)
+{
+        uint n = 0;
+
+        _kernel_scheduler_lock();
+        for (_mm_pool_t *p = pools; p; p = p->next) {
+                n++;
+        }
+        _kernel_scheduler_unlock();
+
+        return n;
+}
+
+//==============================================================================
+/**
+ * @brief  Function return usage statistics of selected pool.
+ *
+ * @param[in]  n        pool number
+ * @param[out] usage    pool usage
+ *
+ * @return One of errno values.
+ */
+//==============================================================================
+int _mm_get_pool_usage(uint n, _mm_pool_usage_t *usage)
+{
+        int err = EINVAL;
+
+        if (usage) {
+                _kernel_scheduler_lock();
+                for (_mm_pool_t *p = pools; p; p = p->next) {
+                        if (n-- == 0) {
+                                usage->name        = p->name;
+                                usage->object_size = p->object_size;
+                                usage->objects     = (__OS_MEMORY_POOLS__ == _YES_) ? p->objects : p->used;
+                                usage->used        = p->used;
+                                usage->used_max    = p->used_max;
+                                usage->pages       = p->pages_count;
+                                err                = ESUCC;
+                                break;
+                        }
+                }
+                _kernel_scheduler_unlock();
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function add pool to the list of pools shown in statistics.
+ *
+ * @param  pool         pool to register
+ */
+//==============================================================================
+static void register_pool(_mm_pool_t *pool)
+{
+        if (!pool->registered) {
+                _kernel_scheduler_lock();
+                if (!pool->registered) {
+                        pool->next       = pools;
+                        pools            = pool;
+                        pool->registered = true;
+                }
+                _kernel_scheduler_unlock();
+        }
+}
+
+#if __OS_MEMORY_POOLS__ == _YES_
+//==============================================================================
+/**
+ * @brief  Function allocate new page and put its objects to the free list.
+ *
+ * @param  pool         pool
+ *
+ * @return One of errno values.
+ */
+//==============================================================================
+static int add_page(_mm_pool_t *pool)
+{
+        page_t *page = NULL;
+
+        int err = _kmalloc(pool->mpur,
+                           PAGE_HEADER_SIZE + (pool->object_size * pool->page_objects),
+                           NULL, pool->flags, pool->flags, cast(void**, &page));
+        if (!err) {
+                u8_t *first = cast(u8_t*, page) + PAGE_HEADER_SIZE;
+                u8_t *last  = first + (pool->object_size * (pool->page_objects - 1));
+
+                for (u8_t *obj = first; obj < last; obj += pool->object_size) {
+                        *cast(void**, obj) = obj + pool->object_size;
+                }
+
+                *cast(void**, last) = NULL;
+                page->free_list     = first;
+                page->used          = 0;
+
+                _critical_section_begin();
+                page->next          = pool->pages;
+                pool->pages         = page;
+                page->avail_next    = pool->avail;
+                pool->avail         = page;
+                pool->objects      += pool->page_objects;
+                pool->pages_count++;
+                _critical_section_end();
+
+                register_pool(pool);
+        }
+
+        return err;
+}
+
+//==============================================================================
+/**
+ * @brief  Function find page that contains selected object. New pages are at
+ *         the beginning of the list, so recently allocated objects are found
+ *         first. Function must be called in critical section.
+ *
+ * @param  pool         pool
+ * @param  obj          object
+ *
+ * @return Page or NULL if object is not from the pool.
+ */
+//==============================================================================
+static page_t *find_page(_mm_pool_t *pool, void *obj)
+{
+        size_t size = pool->object_size * pool->page_objects;
+
+        for (page_t *page = pool->pages; page; page = page->next) {
+                u8_t *first = cast(u8_t*, page) + PAGE_HEADER_SIZE;
+
+                if ((cast(u8_t*, obj) >= first) && (cast(u8_t*, obj) < (first + size))) {
+                        return page;
+                }
+        }
+
+        return NULL;
+}
+
+//==============================================================================
+/**
+ * @brief  Function remove pages without allocated objects from the pool. List
+ *         of pages with free objects is built again.
+ *
+ * @param  pool         pool
+ *
+ * @return List of removed pages (linked by next field).
+ */
+//==============================================================================
+static page_t *take_free_pages(_mm_pool_t *pool)
+{
+        page_t *removed = NULL;
+
+        _critical_section_begin();
+        {
+                page_t **pages = cast(page_t**, &pool->pages);
+                page_t **avail = cast(page_t**, &pool->avail);
+
+                while (*pages) {
+                        page_t *page = *pages;
+
+                        if (page->used == 0) {
+                                *pages     = page->next;
+                                page->next = removed;
+                                removed    = page;
+
+                                pool->objects -= pool->page_objects;
+                                pool->pages_count--;
+
+                        } else {
+                                if (page->free_list) {
+                                        *avail = page;
+                                        avail  = &page->avail_next;
+                                }
+
+                                pages = &page->next;
+                        }
+                }
+
+                *avail = NULL;
+        }
+        _critical_section_end();
+
+        return removed;
+}
+#endif
+
+/*==============================================================================
+  End of file
+==============================================================================*/
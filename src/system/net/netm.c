@@ -34,6 +34,7 @@ Brief    Network management.
 #include "net/sipc/sipc.h"
 #include "cpuctl.h"
 #include "kernel/sysfunc.h"
+#include "mm/pool.h"
 
 /*==============================================================================
   Local macros
@@ -95,6 +96,19 @@ typedef u64_t (*proxy_func_u64_t)();
 /*==============================================================================
   Local objects
 ==============================================================================*/
+/* sockets are allocated from pools, one pool per network family */
+static _mm_pool_t socket_pool[_NET_FAMILY__COUNT] = {
+        #if __ENABLE_TCPIP_STACK__ > 0
+        [NET_FAMILY__INET] = _MM_POOL_INIT("net:inet", _MM_NET,
+                                           _mm_align(sizeof(SOCKET))
+                                           + _mm_align(sizeof(INET_socket_t)), 4),
+        #endif
+        #if __ENABLE_SIPC_STACK__ > 0
+        [NET_FAMILY__SIPC] = _MM_POOL_INIT("net:sipc", _MM_NET,
+                                           _mm_align(sizeof(SOCKET))
+                                           + _mm_align(sizeof(SIPC_socket_t)), 4),
+        #endif
+};
 
 /*==============================================================================
   Exported objects
@@ -118,18 +132,7 @@ typedef u64_t (*proxy_func_u64_t)();
 //==============================================================================
 static int socket_alloc(SOCKET **socket, NET_family_t family)
 {
-        static const uint8_t net_socket_size[_NET_FAMILY__COUNT] = {
-                #if __ENABLE_TCPIP_STACK__ > 0
-                [NET_FAMILY__INET] = _mm_align(sizeof(INET_socket_t)),
-                #endif
-                #if __ENABLE_SIPC_STACK__ > 0
-                [NET_FAMILY__SIPC] = _mm_align(sizeof(SIPC_socket_t)),
-                #endif
-        };
-
-        int err = _kzalloc(_MM_NET,
-                           _mm_align(sizeof(SOCKET)) + net_socket_size[family],
-                           NULL, false, cast(void**, socket));
+        int err = _mm_pool_zalloc(&socket_pool[family], cast(void**, socket));
         if (!err) {
                 (*socket)->header.self = *socket;
                 (*socket)->header.type = RES_TYPE_SOCKET;
@@ -152,8 +155,7 @@ static void socket_free(SOCKET **socket)
 {
         (*socket)->header.self = NULL;
         (*socket)->header.type = RES_TYPE_UNKNOWN;
-        _kfree(_MM_NET, cast(void**, socket));
-        *socket = NULL;
+        _mm_pool_free(&socket_pool[(*socket)->family], cast(void**, socket));
 }
 
 //==============================================================================
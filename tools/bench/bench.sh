@@ -0,0 +1,51 @@
+#!/usr/bin/env bash
+#
+# Runs kernel benchmark suite on host (make bench). Script creates FAT and ext4
+# disk images in the work directory and starts host image of dnx RTOS with the
+# 'bench' init program. Summary is stored in bench.log file.
+#
+#   tools/bench/bench.sh <host image> <work dir>
+#
+
+IMAGE=$1
+WORKDIR=$2
+TIMEOUT="${BENCH_TIMEOUT:-600}"
+FAT_MIB=16
+EXT4_MIB=32
+
+main() {
+
+    if [ "$IMAGE" == "" ] || [ "$WORKDIR" == "" ]; then
+        echo "Usage: $0 <host image> <work dir>"
+        exit 1
+    fi
+
+    IMAGE=$(realpath "$IMAGE")
+    TOOLS=$(dirname $(realpath "$0"))
+
+    mkdir -p "$WORKDIR" && cd "$WORKDIR" || exit 1
+
+    rm -f fat.img ext4.img bench.log
+
+    python3 "$TOOLS/mkfat.py" fat.img $FAT_MIB || exit 1
+
+    if which mkfs.ext4 &> /dev/null; then
+        truncate -s ${EXT4_MIB}M ext4.img
+        mkfs.ext4 -q -F -b 4096 ext4.img || rm -f ext4.img
+    else
+        echo "mkfs.ext4 not found, ext4 steps skipped"
+    fi
+
+    timeout $TIMEOUT "$IMAGE" bench fat.img ext4.img < /dev/null | tee bench.log
+
+    if [ ${PIPESTATUS[0]} -ne 0 ]; then
+        echo "bench: host image exited with error"
+        exit 1
+    fi
+
+    if ! grep -q "^bench: all steps passed" bench.log; then
+        exit 1
+    fi
+}
+
+main
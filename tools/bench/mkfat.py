@@ -0,0 +1,59 @@
+#!/usr/bin/env python3
+#
+# Creates empty FAT16 file system image used by host benchmark (make bench).
+# Script does not require dosfstools.
+#
+#   python3 tools/bench/mkfat.py <image> [MiB]
+#
+import struct
+import sys
+
+SECTOR_SIZE  = 512
+RESERVED     = 1
+FAT_COUNT    = 2
+ROOT_ENTRIES = 512
+
+try:
+    image = sys.argv[1]
+    MiB   = int(sys.argv[2]) if len(sys.argv) > 2 else 16
+except:
+    print("Usage: python3 mkfat.py <image> [MiB]\n")
+    exit(1)
+
+if MiB < 4 or MiB > 1024:
+    print("mkfat: image size should be in range 4-1024 MiB")
+    exit(1)
+
+sectors      = MiB * 1024 * 1024 // SECTOR_SIZE
+root_sectors = ROOT_ENTRIES * 32 // SECTOR_SIZE
+
+# the smallest cluster size that keeps number of clusters in FAT16 range
+cluster = 1
+while sectors // cluster >= 65525 - 16:
+    cluster *= 2
+
+clusters = (sectors - RESERVED - root_sectors) // cluster
+fat_size = ((clusters + 2) * 2 + SECTOR_SIZE - 1) // SECTOR_SIZE
+
+boot = bytearray(SECTOR_SIZE)
+boot[0:3]   = b"\xEB\x3C\x90"
+boot[3:11]  = b"MSDOS5.0"
+struct.pack_into("<HBHBHHBHHHII", boot, 11,
+                 SECTOR_SIZE, cluster, RESERVED, FAT_COUNT, ROOT_ENTRIES,
+                 sectors if sectors < 0x10000 else 0, 0xF8, fat_size,
+                 32, 64, 0, sectors if sectors >= 0x10000 else 0)
+struct.pack_into("<BBBI", boot, 36, 0x80, 0, 0x29, 0x20260101)
+boot[43:54] = b"DNXBENCH   "
+boot[54:62] = b"FAT16   "
+boot[510:512] = b"\x55\xAA"
+
+fat = bytearray(fat_size * SECTOR_SIZE)
+struct.pack_into("<HH", fat, 0, 0xFFF8, 0xFFFF)
+
+with open(image, "wb") as f:
+    f.write(boot)
+    f.write(bytes((RESERVED - 1) * SECTOR_SIZE))
+    for i in range(FAT_COUNT):
+        f.write(fat)
+    f.write(bytes(root_sectors * SECTOR_SIZE))
+    f.truncate(sectors * SECTOR_SIZE)
@@ -0,0 +1,610 @@
+/*=========================================================================*//**
+@file    eefsbench.c
+
+@author  Daniel Zorychta
+
+@brief   Host benchmark of eefs file system (device accesses per operation).
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+/*
+ * Benchmark formats eefs image file, mounts it by using file system code
+ * (src/system/fs/eefs/eefs.c) and runs workloads typical for small EEPROM
+ * storage: directory creation, file creation with small appends, stat, read,
+ * append and file churn (remove/create). For each workload number of device
+ * block reads and writes per operation is reported. At the end block wear is
+ * summarized (number of written blocks and maximum writes of single block).
+ *
+ * Each block read/write is 128 bytes access to EEPROM (I2C/SPI), thus number
+ * of accesses directly corresponds to operation time.
+ *
+ * Usage: eefsbench [-i image] [-b blocks] [-n files] [-s]
+ *        -s    mount with "sync" option (cache write-through)
+ */
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include "fs/fs.h"
+
+/*==============================================================================
+  Local macros
+==============================================================================*/
+#define BLOCK_SIZE              128
+#define MAIN_BITMAP_SIZE        119
+#define BITMAP_SIZE             122
+#define MAGIC_MAIN              0x53464545
+#define MAGIC_BITMAP            0x20504D42
+#define MAGIC_DIR               0x30524944
+#define DIRS                    4
+
+/*==============================================================================
+  Local object types
+==============================================================================*/
+typedef struct {
+        u32_t reads;
+        u32_t writes;
+} stats_t;
+
+/*==============================================================================
+  Local function prototypes
+==============================================================================*/
+API_FS_INIT(eefs, void **fs_handle, const char *src_path, const char *opts);
+API_FS_RELEASE(eefs, void *fs_handle);
+API_FS_MKDIR(eefs, void *fs_handle, const char *path, mode_t mode);
+API_FS_REMOVE(eefs, void *fs_handle, const char *path);
+API_FS_STAT(eefs, void *fs_handle, const char *path, struct stat *stat);
+API_FS_STATFS(eefs, void *fs_handle, struct statfs *statfs);
+API_FS_OPEN(eefs, void *fs_handle, void **fhdl, fpos_t *fpos, const char *path, u32_t flags);
+API_FS_CLOSE(eefs, void *fs_handle, void *fhdl, bool force);
+API_FS_WRITE(eefs, void *fs_handle, void *fhdl, const u8_t *src, size_t count, fpos_t *fpos, size_t *wrcnt, struct vfs_fattr fattr);
+API_FS_READ(eefs, void *fs_handle, void *fhdl, u8_t *dst, size_t count, fpos_t *fpos, size_t *rdcnt, struct vfs_fattr fattr);
+API_FS_SYNC(eefs, void *fs_handle);
+
+/*==============================================================================
+  Local objects
+==============================================================================*/
+static stats_t  stats;
+static u32_t   *wear;
+static u32_t    wear_blocks;
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+
+//==============================================================================
+/**
+ * @brief  System function stubs used by file system.
+ */
+//==============================================================================
+int sys_zalloc(size_t size, void **mem)
+{
+        *mem = calloc(1, size);
+        return *mem ? ESUCC : ENOMEM;
+}
+
+int sys_malloc(size_t size, void **mem)
+{
+        *mem = malloc(size);
+        return *mem ? ESUCC : ENOMEM;
+}
+
+int sys_free(void **mem)
+{
+        free(*mem);
+        *mem = NULL;
+        return ESUCC;
+}
+
+int sys_mutex_create(enum mutex_type type, mutex_t **mtx)
+{
+        (void)type;
+        return sys_zalloc(1, (void**)mtx);
+}
+
+void sys_mutex_destroy(mutex_t *mtx)
+{
+        free(mtx);
+}
+
+int sys_mutex_lock(mutex_t *mtx, u32_t timeout)
+{
+        (void)mtx; (void)timeout;
+        return ESUCC;
+}
+
+int sys_mutex_unlock(mutex_t *mtx)
+{
+        (void)mtx;
+        return ESUCC;
+}
+
+int sys_fopen(const char *path, const char *mode, FILE **file)
+{
+        (void)mode;
+        *file = fopen(path, "r+b");
+        return *file ? ESUCC : errno;
+}
+
+int sys_fclose(FILE *file)
+{
+        return fclose(file) == 0 ? ESUCC : EIO;
+}
+
+int sys_bread(void *ptr, size_t size, u64_t offset, size_t *rdcnt, FILE *file)
+{
+        stats.reads++;
+
+        if (fseek(file, offset, SEEK_SET) != 0) {
+                return EIO;
+        }
+
+        *rdcnt = fread(ptr, 1, size, file);
+        return (*rdcnt == size) ? ESUCC : EIO;
+}
+
+int sys_bwrite(const void *ptr, size_t size, u64_t offset, size_t *wrcnt, FILE *file)
+{
+        stats.writes++;
+
+        u32_t blk = offset / BLOCK_SIZE;
+        if (blk < wear_blocks) {
+                wear[blk]++;
+        }
+
+        if (fseek(file, offset, SEEK_SET) != 0) {
+                return EIO;
+        }
+
+        *wrcnt = fwrite(ptr, 1, size, file);
+        return (*wrcnt == size) ? ESUCC : EIO;
+}
+
+int sys_bsync(FILE *file)
+{
+        return fflush(file) == 0 ? ESUCC : EIO;
+}
+
+bool sys_bdirty(FILE *file)
+{
+        (void)file;
+        return false;
+}
+
+int sys_gettime(time_t *timer)
+{
+        *timer = 0;
+        return ESUCC;
+}
+
+bool sys_stropt_is_flag(const char *opts, const char *flag)
+{
+        size_t len = strlen(flag);
+
+        for (const char *s = opts; (s = strstr(s, flag)); s += len) {
+                if ((s == opts || s[-1] == ',') && (s[len] == '\0' || s[len] == ',')) {
+                        return true;
+                }
+        }
+
+        return false;
+}
+
+int sys_driver_open(dev_t id, u32_t flags)
+{
+        (void)id; (void)flags;
+        return ENODEV;
+}
+
+int sys_driver_close(dev_t id, bool force)
+{
+        (void)id; (void)force;
+        return ENODEV;
+}
+
+int sys_driver_read(dev_t id, u8_t *dst, size_t count, fpos_t *fpos, size_t *rdcnt, struct vfs_fattr fattr)
+{
+        (void)id; (void)dst; (void)count; (void)fpos; (void)rdcnt; (void)fattr;
+        return ENODEV;
+}
+
+int sys_driver_write(dev_t id, const u8_t *src, size_t count, fpos_t *fpos, size_t *wrcnt, struct vfs_fattr fattr)
+{
+        (void)id; (void)src; (void)count; (void)fpos; (void)wrcnt; (void)fattr;
+        return ENODEV;
+}
+
+int sys_driver_ioctl(dev_t id, int request, void *arg)
+{
+        (void)id; (void)request; (void)arg;
+        return ENODEV;
+}
+
+int sys_driver_flush(dev_t id)
+{
+        (void)id;
+        return ENODEV;
+}
+
+int sys_driver_stat(dev_t id, struct vfs_dev_stat *stat)
+{
+        (void)id; (void)stat;
+        return ENODEV;
+}
+
+//==============================================================================
+/**
+ * @brief  Calculate block checksum (the same as in eefs).
+ */
+//==============================================================================
+static void block_checksum(u8_t *blk, u16_t num)
+{
+        u16_t sum1 = 0xff, sum2 = 0xff;
+        const u8_t *data = blk;
+        size_t bytes = BLOCK_SIZE - 2;
+
+        while (bytes) {
+                size_t tlen = ((bytes >= 20) ? 20 : bytes);
+                bytes -= tlen;
+                do {
+                        sum2 += sum1 += *data++;
+                } while (--tlen);
+
+                sum1 = (sum1 & 0xff) + (sum1 >> 8);
+                sum2 = (sum2 & 0xff) + (sum2 >> 8);
+        }
+
+        sum1 = (sum1 & 0xff) + (sum1 >> 8);
+        sum2 = (sum2 & 0xff) + (sum2 >> 8);
+
+        u16_t chsum = ((sum2 << 8) | sum1) ^ num;
+        memcpy(&blk[BLOCK_SIZE - 2], &chsum, sizeof(chsum));
+}
+
+//==============================================================================
+/**
+ * @brief  Create formatted eefs image (main block, bitmap blocks, root dir).
+ */
+//==============================================================================
+static bool image_format(const char *path, u16_t blocks)
+{
+        u32_t bmpbytes = (blocks + 7) / 8;
+        u8_t  bmpblks  = (bmpbytes > MAIN_BITMAP_SIZE)
+                       ? (bmpbytes - MAIN_BITMAP_SIZE + BITMAP_SIZE - 1) / BITMAP_SIZE
+                       : 0;
+        u16_t root     = 1 + bmpblks;
+
+        u8_t *bitmap = calloc(MAIN_BITMAP_SIZE + bmpblks * BITMAP_SIZE, 1);
+        u8_t *image  = malloc((size_t)blocks * BLOCK_SIZE);
+        if (!bitmap || !image) {
+                return false;
+        }
+
+        memset(image, 0xFF, (size_t)blocks * BLOCK_SIZE);
+
+        for (u16_t blk = root + 1; blk < blocks; blk++) {
+                bitmap[blk / 8] |= (1 << (blk % 8));
+        }
+
+        // main block
+        u8_t *b = &image[0];
+        u32_t magic = MAGIC_MAIN;
+        memcpy(&b[0], &magic, 4);
+        memcpy(&b[4], &blocks, 2);
+        b[6] = bmpblks;
+        memcpy(&b[7], bitmap, MAIN_BITMAP_SIZE);
+        block_checksum(b, 0);
+
+        // bitmap blocks
+        for (u8_t i = 1; i <= bmpblks; i++) {
+                b = &image[i * BLOCK_SIZE];
+                magic = MAGIC_BITMAP;
+                memcpy(&b[0], &magic, 4);
+                memcpy(&b[4], &bitmap[MAIN_BITMAP_SIZE + (i - 1) * BITMAP_SIZE], BITMAP_SIZE);
+                block_checksum(b, i);
+        }
+
+        // root directory
+        b = &image[root * BLOCK_SIZE];
+        u32_t zero32 = 0;
+        u16_t zero16 = 0;
+        u16_t mode   = S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH;
+        magic = MAGIC_DIR;
+        memcpy(&b[0],  &magic,  4);
+        memcpy(&b[4],  &zero32, 4);     // ctime
+        memcpy(&b[8],  &zero32, 4);     // mtime
+        memcpy(&b[12], &zero16, 2);     // gid
+        memcpy(&b[14], &zero16, 2);     // uid
+        memcpy(&b[16], &mode,   2);     // mode
+        memcpy(&b[18], &root,   2);     // parent
+        memcpy(&b[20], &zero16, 2);     // next
+        memcpy(&b[22], &zero16, 2);     // all items
+        block_checksum(b, root);
+
+        FILE *f = fopen(path, "wb");
+        bool ok = f && fwrite(image, BLOCK_SIZE, blocks, f) == blocks;
+        if (f) {
+                fclose(f);
+        }
+
+        free(image);
+        free(bitmap);
+
+        return ok;
+}
+
+//==============================================================================
+/**
+ * @brief  Append data to file in small chunks (log-like write).
+ */
+//==============================================================================
+static int file_append(void *fs, const char *path, size_t size, size_t chunk, u32_t flags)
+{
+        void  *fhdl = NULL;
+        fpos_t fpos = 0;
+
+        int err = _eefs_open(fs, &fhdl, &fpos, path, flags);
+        if (err) {
+                return err;
+        }
+
+        if (flags & O_APPEND) {
+                struct stat st;
+                err = _eefs_stat(fs, path, &st);
+                fpos = st.st_size;
+        }
+
+        u8_t buf[64];
+        memset(buf, 'x', sizeof(buf));
+
+        struct vfs_fattr fattr = {false, false};
+
+        while (!err && size > 0) {
+                size_t n = min(min(chunk, sizeof(buf)), size);
+                size_t wrcnt = 0;
+
+                err = _eefs_write(fs, fhdl, buf, n, &fpos, &wrcnt, fattr);
+                fpos += wrcnt;
+                size -= wrcnt;
+        }
+
+        int cerr = _eefs_close(fs, fhdl, false);
+
+        return err ? err : cerr;
+}
+
+//==============================================================================
+/**
+ * @brief  Read entire file.
+ */
+//==============================================================================
+static int file_read(void *fs, const char *path)
+{
+        void  *fhdl = NULL;
+        fpos_t fpos = 0;
+
+        int err = _eefs_open(fs, &fhdl, &fpos, path, O_RDONLY);
+        if (err) {
+                return err;
+        }
+
+        struct vfs_fattr fattr = {false, false};
+        u8_t   buf[64];
+        size_t rdcnt;
+
+        do {
+                rdcnt = 0;
+                err = _eefs_read(fs, fhdl, buf, sizeof(buf), &fpos, &rdcnt, fattr);
+                fpos += rdcnt;
+        } while (!err && rdcnt > 0);
+
+        int cerr = _eefs_close(fs, fhdl, false);
+
+        return err ? err : cerr;
+}
+
+//==============================================================================
+/**
+ * @brief  Print workload results. Synchronization is a part of workload.
+ */
+//==============================================================================
+static void report(const char *name, u32_t ops, int err)
+{
+        printf("%-12s %6u %10u %10u %9.2f %9.2f%s\n",
+               name, ops, stats.reads, stats.writes,
+               ops ? (double)stats.reads / ops : 0.0,
+               ops ? (double)stats.writes / ops : 0.0,
+               err ? "  (error)" : "");
+
+        memset(&stats, 0, sizeof(stats));
+}
+
+//==============================================================================
+/**
+ * @brief  Main function.
+ */
+//==============================================================================
+int main(int argc, char *argv[])
+{
+        const char *image  = "eefs.img";
+        u32_t       blocks = 1024;
+        u32_t       files  = 32;
+        bool        sync   = false;
+
+        int c;
+        while ((c = getopt(argc, argv, "i:b:n:s")) != -1) {
+                switch (c) {
+                case 'i': image  = optarg; break;
+                case 'b': blocks = strtoul(optarg, NULL, 0); break;
+                case 'n': files  = strtoul(optarg, NULL, 0); break;
+                case 's': sync   = true; break;
+                default:
+                        fprintf(stderr, "Usage: %s [-i image] [-b blocks] [-n files] [-s]\n", argv[0]);
+                        return EXIT_FAILURE;
+                }
+        }
+
+        if (blocks < 8 || blocks > 0xFFFF) {
+                fprintf(stderr, "Invalid number of blocks\n");
+                return EXIT_FAILURE;
+        }
+
+        if (!image_format(image, blocks)) {
+                fprintf(stderr, "Unable to create image %s\n", image);
+                return EXIT_FAILURE;
+        }
+
+        wear_blocks = blocks;
+        wear = calloc(blocks, sizeof(u32_t));
+
+        printf("eefs: %u blocks, %u files, cache blocks: %d, mount: %s\n",
+               blocks, files, __EEFS_CFG_CACHE_BLOCKS__, sync ? "sync" : "default");
+
+        void *fs = NULL;
+        int err = _eefs_init(&fs, image, sync ? "sync" : "");
+        if (err) {
+                fprintf(stderr, "Mount error %d\n", err);
+                return EXIT_FAILURE;
+        }
+
+        report("mount", 1, err);
+
+        printf("%-12s %6s %10s %10s %9s %9s\n",
+               "workload", "ops", "reads", "writes", "reads/op", "writes/op");
+
+        char path[32];
+
+        // directories
+        for (u32_t d = 0; !err && d < DIRS; d++) {
+                snprintf(path, sizeof(path), "/d%u", d);
+                err = _eefs_mkdir(fs, path, 0666);
+        }
+        err = err ? err : _eefs_sync(fs);
+        report("mkdir", DIRS, err);
+
+        // file creation with small writes
+        for (u32_t f = 0; !err && f < files; f++) {
+                snprintf(path, sizeof(path), "/d%u/f%u", f % DIRS, f);
+                err = file_append(fs, path, 300, 30, O_CREAT | O_WRONLY);
+        }
+        err = err ? err : _eefs_sync(fs);
+        report("create", files, err);
+
+        // stat
+        for (u32_t f = 0; !err && f < files; f++) {
+                struct stat st;
+                snprintf(path, sizeof(path), "/d%u/f%u", f % DIRS, f);
+                err = _eefs_stat(fs, path, &st);
+        }
+        err = err ? err : _eefs_sync(fs);
+        report("stat", files, err);
+
+        // read
+        for (u32_t f = 0; !err && f < files; f++) {
+                snprintf(path, sizeof(path), "/d%u/f%u", f % DIRS, f);
+                err = file_read(fs, path);
+        }
+        err = err ? err : _eefs_sync(fs);
+        report("read", files, err);
+
+        // append
+        for (u32_t f = 0; !err && f < files; f++) {
+                snprintf(path, sizeof(path), "/d%u/f%u", f % DIRS, f);
+                err = file_append(fs, path, 100, 10, O_WRONLY | O_APPEND);
+        }
+        err = err ? err : _eefs_sync(fs);
+        report("append", files, err);
+
+        // churn: remove file and create new one in the same place
+        u32_t churn = files * 4;
+        for (u32_t i = 0; !err && i < churn; i++) {
+                u32_t f = i % files;
+                snprintf(path, sizeof(path), "/d%u/f%u", f % DIRS, f);
+                err = _eefs_remove(fs, path);
+                if (!err) {
+                        err = file_append(fs, path, 200, 50, O_CREAT | O_WRONLY);
+                }
+        }
+        err = err ? err : _eefs_sync(fs);
+        report("churn", churn, err);
+
+        struct statfs sfs;
+        if (!err) {
+                err = _eefs_statfs(fs, &sfs);
+        }
+
+        int rerr = _eefs_release(fs);
+        report("umount", 1, rerr);
+
+        // verify: mount image again and check files and free space
+        if (!err) {
+                err = _eefs_init(&fs, image, "ro");
+                for (u32_t f = 0; !err && f < files; f++) {
+                        struct stat st;
+                        snprintf(path, sizeof(path), "/d%u/f%u", f % DIRS, f);
+                        err = _eefs_stat(fs, path, &st);
+                        err = (!err && st.st_size != 200) ? EILSEQ : err;
+                }
+
+                struct statfs vsfs;
+                if (!err) {
+                        err = _eefs_statfs(fs, &vsfs);
+                        err = (!err && vsfs.f_bfree != sfs.f_bfree) ? EILSEQ : err;
+                }
+
+                if (fs) {
+                        _eefs_release(fs);
+                }
+
+                report("verify", files, err);
+        }
+
+        if (err || rerr) {
+                fprintf(stderr, "Workload error %d\n", err ? err : rerr);
+                return EXIT_FAILURE;
+        }
+
+        u32_t written = 0, wmax = 0, wsum = 0;
+        for (u32_t i = 0; i < blocks; i++) {
+                written += wear[i] ? 1 : 0;
+                wsum    += wear[i];
+                wmax     = max(wmax, wear[i]);
+        }
+
+        printf("\nused blocks: %u/%u\n", sfs.f_blocks - sfs.f_bfree, sfs.f_blocks);
+        printf("wear: %u blocks written, %u writes, max %u writes of single block, "
+               "%.2f writes/written block\n",
+               written, wsum, wmax, written ? (double)wsum / written : 0.0);
+
+        free(wear);
+
+        return EXIT_SUCCESS;
+}
+
+/*==============================================================================
+  End of file
+==============================================================================*/
@@ -0,0 +1,246 @@
+/*=========================================================================*//**
+@file    fs.h
+
+@author  Daniel Zorychta
+
+@brief   Host environment of eefs benchmark (file system interface stubs).
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+#ifndef _EEFSBENCH_FS_H_
+#define _EEFSBENCH_FS_H_
+
+/*
+ * The header replaces system fs/fs.h when eefs is compiled on the host. Only
+ * types and functions used by src/system/fs/eefs/eefs.c are defined. Block
+ * access functions (sys_bread(), sys_bwrite()) are implemented by benchmark
+ * and count device operations.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <stdio.h>
+#include <time.h>
+
+/* configuration */
+#define _NO_                            0
+#define _YES_                           1
+
+#define __EEFS_LOG_ENABLE__             _NO_
+#ifndef __EEFS_CFG_CACHE_BLOCKS__
+#define __EEFS_CFG_CACHE_BLOCKS__       8
+#endif
+
+/* basic types */
+typedef uint8_t  u8_t;
+typedef uint16_t u16_t;
+typedef uint32_t u32_t;
+typedef uint64_t u64_t;
+typedef int32_t  i32_t;
+typedef u32_t    mode_t_;
+typedef u16_t    uid_t_;
+typedef u16_t    gid_t_;
+typedef i32_t    dev_t_;
+#define mode_t   mode_t_
+#define uid_t    uid_t_
+#define gid_t    gid_t_
+#define dev_t    dev_t_
+typedef int64_t  fpos_t_;
+#define fpos_t   fpos_t_
+
+typedef struct mutex mutex_t;
+
+enum mutex_type {
+        MUTEX_TYPE_RECURSIVE,
+        MUTEX_TYPE_NORMAL
+};
+
+#define ESUCC                           0
+
+/* misc macros */
+#define PACKED                          __attribute__((packed))
+#define cast(type, what)                ((type)(what))
+#define ARRAY_SIZE(array)               (sizeof(array) / sizeof(array[0]))
+#define CEILING(x, y)                   (((x) + (y) - 1) / (y))
+#define FIRST_CHARACTER(str)            (str)[0]
+#define LAST_CHARACTER(str)             (str)[strlen((str)) - 1]
+#define isstrempty(str)                 ((str) == NULL || (str)[0] == '\0')
+#define isstreq(a, b)                   (strcmp(a, b) == 0)
+#define isstreqn(a, b, n)               (strncmp(a, b, n) == 0)
+#ifndef min
+#define min(a, b)                       ((a) < (b) ? (a) : (b))
+#endif
+#ifndef max
+#define max(a, b)                       ((a) > (b) ? (a) : (b))
+#endif
+#define UNUSED_ARG1(_arg1)                      ((void)_arg1)
+#define UNUSED_ARG2(_arg1, _arg2)               UNUSED_ARG1(_arg1); UNUSED_ARG1(_arg2)
+#define UNUSED_ARG3(_arg1, _arg2, _arg3)        UNUSED_ARG2(_arg1, _arg2); UNUSED_ARG1(_arg3)
+#define UNUSED_ARG4(_arg1, _arg2, _arg3, _arg4) UNUSED_ARG3(_arg1, _arg2, _arg3); UNUSED_ARG1(_arg4)
+#define printk(...)
+#define not                             !
+#define and                             &&
+#define or                              ||
+
+static inline size_t strlcpy(char *dst, const char *src, size_t size)
+{
+        size_t len = strlen(src);
+
+        if (size) {
+                size_t n = (len >= size) ? size - 1 : len;
+                memcpy(dst, src, n);
+                dst[n] = '\0';
+        }
+
+        return len;
+}
+
+/* file flags and modes (as in fs/vfs.h) */
+#define O_RDONLY                        00
+#define O_WRONLY                        01
+#define O_RDWR                          02
+#define O_CREAT                         0100
+#define O_EXCL                          0200
+#define O_TRUNC                         01000
+#define O_APPEND                        02000
+
+#define S_IRUSR                         0000400
+#define S_IWUSR                         0000200
+#define S_IRGRP                         0000040
+#define S_IWGRP                         0000020
+#define S_IROTH                         0000004
+#define S_IWOTH                         0000002
+#define S_IFMT(mode_t_m)                ((mode_t_m) & 070000)
+#define S_IFREG                         0000000
+#define S_IFDIR                         0010000
+#define S_IFDEV                         0020000
+#define S_IFLNK                         0030000
+#define S_IFPROG                        0040000
+#define S_IFIFO                         0050000
+#define S_ISREG(mode_t_m)               (S_IFMT(mode_t_m) == S_IFREG)
+#define S_ISDIR(mode_t_m)               (S_IFMT(mode_t_m) == S_IFDIR)
+#define S_ISDEV(mode_t_m)               (S_IFMT(mode_t_m) == S_IFDEV)
+
+/* file system types (as in fs/vfs.h) */
+typedef struct dirent {
+        const char *d_name;
+        u64_t       size;
+        mode_t      mode;
+        dev_t       dev;
+} dirent_t;
+
+typedef struct {
+        void     *d_hdl;
+        size_t    d_items;
+        size_t    d_seek;
+        dirent_t  dirent;
+} DIR;
+
+struct stat {
+        u64_t   st_size;
+        dev_t   st_dev;
+        mode_t  st_mode;
+        uid_t   st_uid;
+        gid_t   st_gid;
+        time_t  st_ctime;
+        time_t  st_mtime;
+};
+
+struct statfs {
+        u32_t       f_type;
+        u32_t       f_bsize;
+        u32_t       f_blocks;
+        u32_t       f_bfree;
+        u32_t       f_files;
+        u32_t       f_ffree;
+        const char *f_fsname;
+};
+
+struct vfs_dev_stat {
+        u64_t st_size;
+        u8_t  st_major;
+        u8_t  st_minor;
+};
+
+struct vfs_fattr {
+        bool non_blocking_rd:1;
+        bool non_blocking_wr:1;
+};
+
+#define SYS_FS_TYPE__SOLID              1
+
+/* file system interface */
+#define API_FS_INIT(fsname, ...)        int _##fsname##_init(__VA_ARGS__)
+#define API_FS_RELEASE(fsname, ...)     int _##fsname##_release(__VA_ARGS__)
+#define API_FS_OPEN(fsname, ...)        int _##fsname##_open(__VA_ARGS__)
+#define API_FS_CLOSE(fsname, ...)       int _##fsname##_close(__VA_ARGS__)
+#define API_FS_WRITE(fsname, ...)       int _##fsname##_write(__VA_ARGS__)
+#define API_FS_READ(fsname, ...)        int _##fsname##_read(__VA_ARGS__)
+#define API_FS_IOCTL(fsname, ...)       int _##fsname##_ioctl(__VA_ARGS__)
+#define API_FS_FSTAT(fsname, ...)       int _##fsname##_fstat(__VA_ARGS__)
+#define API_FS_FLUSH(fsname, ...)       int _##fsname##_flush(__VA_ARGS__)
+#define API_FS_MKDIR(fsname, ...)       int _##fsname##_mkdir(__VA_ARGS__)
+#define API_FS_MKFIFO(fsname, ...)      int _##fsname##_mkfifo(__VA_ARGS__)
+#define API_FS_MKNOD(fsname, ...)       int _##fsname##_mknod(__VA_ARGS__)
+#define API_FS_OPENDIR(fsname, ...)     int _##fsname##_opendir(__VA_ARGS__)
+#define API_FS_CLOSEDIR(fsname, ...)    int _##fsname##_closedir(__VA_ARGS__)
+#define API_FS_READDIR(fsname, ...)     int _##fsname##_readdir(__VA_ARGS__)
+#define API_FS_REMOVE(fsname, ...)      int _##fsname##_remove(__VA_ARGS__)
+#define API_FS_RENAME(fsname, ...)      int _##fsname##_rename(__VA_ARGS__)
+#define API_FS_CHMOD(fsname, ...)       int _##fsname##_chmod(__VA_ARGS__)
+#define API_FS_CHOWN(fsname, ...)       int _##fsname##_chown(__VA_ARGS__)
+#define API_FS_STAT(fsname, ...)        int _##fsname##_stat(__VA_ARGS__)
+#define API_FS_STATFS(fsname, ...)      int _##fsname##_statfs(__VA_ARGS__)
+#define API_FS_SYNC(fsname, ...)        int _##fsname##_sync(__VA_ARGS__)
+#define API_FS_DIRTY(fsname, ...)       bool _##fsname##_dirty(__VA_ARGS__)
+
+/* system functions (implemented by benchmark) */
+extern int  sys_zalloc(size_t size, void **mem);
+extern int  sys_malloc(size_t size, void **mem);
+extern int  sys_free(void **mem);
+extern int  sys_mutex_create(enum mutex_type type, mutex_t **mtx);
+extern void sys_mutex_destroy(mutex_t *mtx);
+extern int  sys_mutex_lock(mutex_t *mtx, u32_t timeout);
+extern int  sys_mutex_unlock(mutex_t *mtx);
+extern int  sys_fopen(const char *path, const char *mode, FILE **file);
+extern int  sys_fclose(FILE *file);
+extern int  sys_bread(void *ptr, size_t size, u64_t offset, size_t *rdcnt, FILE *file);
+extern int  sys_bwrite(const void *ptr, size_t size, u64_t offset, size_t *wrcnt, FILE *file);
+extern int  sys_bsync(FILE *file);
+extern bool sys_bdirty(FILE *file);
+extern int  sys_gettime(time_t *timer);
+extern bool sys_stropt_is_flag(const char *opts, const char *flag);
+extern int  sys_driver_open(dev_t id, u32_t flags);
+extern int  sys_driver_close(dev_t id, bool force);
+extern int  sys_driver_read(dev_t id, u8_t *dst, size_t count, fpos_t *fpos, size_t *rdcnt, struct vfs_fattr fattr);
+extern int  sys_driver_write(dev_t id, const u8_t *src, size_t count, fpos_t *fpos, size_t *wrcnt, struct vfs_fattr fattr);
+extern int  sys_driver_ioctl(dev_t id, int request, void *arg);
+extern int  sys_driver_flush(dev_t id);
+extern int  sys_driver_stat(dev_t id, struct vfs_dev_stat *stat);
+
+#endif /* _EEFSBENCH_FS_H_ */
+/*==============================================================================
+  End of file
+==============================================================================*/
@@ -0,0 +1,341 @@
+/*=========================================================================*//**
+@file    heapbench.c
+
+@author  Daniel Zorychta
+
+@brief   Host benchmark of kernel heap (first-fit vs size classes).
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+/*
+ * Benchmark replays an allocation trace on the kernel heap (src/system/mm/heap.c)
+ * and reports alloc/free latency and fragmentation. Trace is a text file with
+ * one operation per line:
+ *
+ *      a <id> <size>   - allocate block of selected size and store as <id>
+ *      f <id>          - free block <id>
+ *
+ * If trace file is not given then synthetic trace is generated. The trace
+ * imitates kernel workload: many short living small objects (list items,
+ * program blocks, network buffers) and some long living bigger buffers.
+ *
+ * Usage: heapbench [-r trace] [-w trace] [-n operations] [-s heap_size]
+ */
+
+/*==============================================================================
+  Include files
+==============================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#include <unistd.h>
+#include "config.h"
+#include "mm/heap.h"
+
+/*==============================================================================
+  Local macros
+==============================================================================*/
+#define MAX_IDS                 65536
+
+/*==============================================================================
+  Local object types
+==============================================================================*/
+typedef struct {
+        char   op;
+        u32_t  id;
+        u32_t  size;
+} trace_op_t;
+
+typedef struct {
+        u64_t  count;
+        u64_t  total_ns;
+        u64_t  max_ns;
+} lat_t;
+
+/*==============================================================================
+  Local objects
+==============================================================================*/
+static trace_op_t *trace;
+static size_t      trace_len;
+static void       *blocks[MAX_IDS];
+
+/*==============================================================================
+  Function definitions
+==============================================================================*/
+
+//==============================================================================
+/**
+ * @brief  Return monotonic time in nanoseconds.
+ */
+//==============================================================================
+static u64_t now_ns(void)
+{
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (u64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+//==============================================================================
+/**
+ * @brief  Add sample to latency statistics.
+ */
+//==============================================================================
+static void lat_add(lat_t *lat, u64_t ns)
+{
+        lat->count++;
+        lat->total_ns += ns;
+        lat->max_ns = ns > lat->max_ns ? ns : lat->max_ns;
+}
+
+//==============================================================================
+/**
+ * @brief  Generate synthetic trace.
+ */
+//==============================================================================
+static void trace_generate(size_t n)
+{
+        trace = calloc(n, sizeof(trace_op_t));
+        bool *live = calloc(MAX_IDS, sizeof(bool));
+        u32_t *ids = calloc(MAX_IDS, sizeof(u32_t));
+        size_t nlive = 0;
+
+        srand(1);
+
+        for (trace_len = 0; trace_len < n; trace_len++) {
+                trace_op_t *op = &trace[trace_len];
+
+                if ((nlive > 0) && ((rand() % 100) < 48 || nlive >= 1000)) {
+                        size_t k = rand() % nlive;
+                        op->op = 'f';
+                        op->id = ids[k];
+                        live[ids[k]] = false;
+                        ids[k] = ids[--nlive];
+                } else {
+                        u32_t id;
+                        do {
+                                id = rand() % MAX_IDS;
+                        } while (live[id]);
+
+                        int r = rand() % 100;
+                        op->op   = 'a';
+                        op->id   = id;
+                        op->size = (r < 70) ? 8 + rand() % 48
+                                 : (r < 95) ? 56 + rand() % 200
+                                 : 256 + rand() % 1800;
+
+                        live[id] = true;
+                        ids[nlive++] = id;
+                }
+        }
+
+        free(live);
+        free(ids);
+}
+
+//==============================================================================
+/**
+ * @brief  Load trace from file.
+ */
+//==============================================================================
+static bool trace_load(const char *path)
+{
+        FILE *f = fopen(path, "r");
+        if (!f) {
+                perror(path);
+                return false;
+        }
+
+        size_t cap = 1024;
+        trace = malloc(cap * sizeof(trace_op_t));
+
+        char line[64];
+        while (fgets(line, sizeof(line), f)) {
+                trace_op_t op = {0};
+                if (  (sscanf(line, "a %u %u", &op.id, &op.size) == 2)
+                   || (sscanf(line, "f %u", &op.id) == 1) ) {
+
+                        op.op = line[0];
+
+                        if (op.id >= MAX_IDS) {
+                                continue;
+                        }
+
+                        if (trace_len == cap) {
+                                cap *= 2;
+                                trace = realloc(trace, cap * sizeof(trace_op_t));
+                        }
+
+                        trace[trace_len++] = op;
+                }
+        }
+
+        fclose(f);
+        return true;
+}
+
+//==============================================================================
+/**
+ * @brief  Save trace to file.
+ */
+//==============================================================================
+static void trace_save(const char *path)
+{
+        FILE *f = fopen(path, "w");
+        if (f) {
+                for (size_t i = 0; i < trace_len; i++) {
+                        if (trace[i].op == 'a') {
+                                fprintf(f, "a %u %u\n", trace[i].id, trace[i].size);
+                        } else {
+                                fprintf(f, "f %u\n", trace[i].id);
+                        }
+                }
+                fclose(f);
+        } else {
+                perror(path);
+        }
+}
+
+//==============================================================================
+/**
+ * @brief  Find the biggest block that can be allocated.
+ */
+//==============================================================================
+static size_t largest_free_block(_heap_t *heap)
+{
+        size_t lo = 0, hi = _heap_get_free(heap);
+        size_t used_max = heap->used_max;
+
+        while (lo < hi) {
+                size_t mid = (lo + hi + 1) / 2;
+                void *p = _heap_alloc(heap, mid, NULL);
+                if (p) {
+                        _heap_free(heap, p, NULL);
+                        lo = mid;
+                } else {
+                        hi = mid - 1;
+                }
+        }
+
+        heap->used_max = used_max;
+
+        return lo;
+}
+
+//==============================================================================
+/**
+ * @brief  Main function.
+ */
+//==============================================================================
+int main(int argc, char *argv[])
+{
+        const char *rd_path = NULL;
+        const char *wr_path = NULL;
+        size_t      ops     = 200000;
+        size_t      size    = 512 * 1024;
+
+        int c;
+        while ((c = getopt(argc, argv, "r:w:n:s:")) != -1) {
+                switch (c) {
+                case 'r': rd_path = optarg; break;
+                case 'w': wr_path = optarg; break;
+                case 'n': ops  = strtoul(optarg, NULL, 0); break;
+                case 's': size = strtoul(optarg, NULL, 0); break;
+                default:
+                        fprintf(stderr, "Usage: %s [-r trace] [-w trace] [-n operations] [-s heap_size]\n", argv[0]);
+                        return EXIT_FAILURE;
+                }
+        }
+
+        if (rd_path) {
+                if (!trace_load(rd_path)) {
+                        return EXIT_FAILURE;
+                }
+        } else {
+                trace_generate(ops);
+        }
+
+        if (wr_path) {
+                trace_save(wr_path);
+        }
+
+        void *ram = malloc(size);
+        _heap_t heap;
+        _heap_init(&heap, ram, size);
+
+        lat_t  alloc_lat = {0}, free_lat = {0};
+        size_t failed = 0, min_largest = SIZE_MAX;
+
+        for (size_t i = 0; i < trace_len; i++) {
+                trace_op_t *op = &trace[i];
+
+                if (op->op == 'a') {
+                        if (blocks[op->id]) {
+                                continue;
+                        }
+
+                        u64_t t = now_ns();
+                        blocks[op->id] = _heap_alloc(&heap, op->size, NULL);
+                        lat_add(&alloc_lat, now_ns() - t);
+
+                        if (!blocks[op->id]) {
+                                failed++;
+                        }
+
+                } else if (blocks[op->id]) {
+                        u64_t t = now_ns();
+                        _heap_free(&heap, blocks[op->id], NULL);
+                        lat_add(&free_lat, now_ns() - t);
+
+                        blocks[op->id] = NULL;
+                }
+
+                if ((i % (trace_len / 16 + 1)) == 0) {
+                        size_t largest = largest_free_block(&heap);
+                        min_largest = largest < min_largest ? largest : min_largest;
+                }
+        }
+
+        size_t free_mem = _heap_get_free(&heap);
+        size_t largest  = largest_free_block(&heap);
+
+        printf("allocator      : %s\n", __OS_HEAP_SIZE_CLASSES__ ? "size classes + first-fit" : "first-fit");
+        printf("operations     : %zu\n", trace_len);
+        printf("alloc avg/max  : %.1f / %llu ns\n",
+               alloc_lat.count ? (double)alloc_lat.total_ns / alloc_lat.count : 0.0,
+               (unsigned long long)alloc_lat.max_ns);
+        printf("free avg/max   : %.1f / %llu ns\n",
+               free_lat.count ? (double)free_lat.total_ns / free_lat.count : 0.0,
+               (unsigned long long)free_lat.max_ns);
+        printf("failed allocs  : %zu\n", failed);
+        printf("heap used/max  : %zu / %zu bytes\n", _heap_get_used(&heap), heap.used_max);
+        printf("free memory    : %zu bytes\n", free_mem);
+        printf("largest block  : %zu bytes (min during trace: %zu)\n", largest, min_largest);
+        printf("fragmentation  : %.1f %%\n", free_mem ? 100.0 * (1.0 - (double)largest / free_mem) : 0.0);
+
+        return _heap_check_consistency(&heap) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*==============================================================================
+  End of file
+==============================================================================*/
@@ -0,0 +1,59 @@
+/*=========================================================================*//**
+@file    config.h
+
+@author  Daniel Zorychta
+
+@brief   Host configuration of heap benchmark.
+
+@note    Copyright (C) 2026 Daniel Zorychta <daniel.zorychta@gmail.com>
+
+         This program is free software; you can redistribute it and/or modify
+         it under the terms of the GNU General Public License as published by
+         the Free Software Foundation and modified by the dnx RTOS exception.
+
+         NOTE: The modification  to the GPL is  included to allow you to
+               distribute a combined work that includes dnx RTOS without
+               being obliged to provide the source  code for proprietary
+               components outside of the dnx RTOS.
+
+         The dnx RTOS  is  distributed  in the hope  that  it will be useful,
+         but WITHOUT  ANY  WARRANTY;  without  even  the implied  warranty of
+         MERCHANTABILITY  or  FITNESS  FOR  A  PARTICULAR  PURPOSE.  See  the
+         GNU General Public License for more details.
+
+         Full license text is available on the following file: doc/license.txt.
+
+
+*//*==========================================================================*/
+
+#ifndef _HEAPBENCH_CONFIG_H_
+#define _HEAPBENCH_CONFIG_H_
+
+#include <stdint.h>
+
+#define _NO_                            0
+#define _YES_                           1
+
+#define __HEAP_BLOCK_SIZE__             4
+#define _HEAP_ALIGN_                    sizeof(void*)
+#ifndef __OS_HEAP_SANITY_CHECK__
+#define __OS_HEAP_SANITY_CHECK__        _NO_
+#endif
+
+#ifndef __OS_HEAP_OVERFLOW_CHECK__
+#define __OS_HEAP_OVERFLOW_CHECK__      _NO_
+#endif
+
+#ifndef __OS_HEAP_SIZE_CLASSES__
+#define __OS_HEAP_SIZE_CLASSES__        _YES_
+#endif
+
+typedef uint8_t  u8_t;
+typedef uint16_t u16_t;
+typedef uint32_t u32_t;
+typedef uint64_t u64_t;
+
+#endif /* _HEAPBENCH_CONFIG_H_ */
+/*==============================================================================
+  End of file
+==============================================================================*/
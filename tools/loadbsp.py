@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+#
+# Loads board configuration (BSP/*.dnxc file) to the project configuration
+# without Configtool. Script is used by automated builds (e.g. host benchmark).
+#
+#   python3 tools/loadbsp.py BSP/linux.dnxc [config-dir]
+#
+import os
+import re
+import sys
+
+try:
+    bsp_file   = sys.argv[1]
+    config_dir = sys.argv[2] if len(sys.argv) > 2 else os.path.join(os.path.dirname(__file__), "..", "config")
+except:
+    print("Usage: python3 loadbsp.py <bsp-file> [config-dir]\n")
+    exit(1)
+
+
+def lua_string(s):
+    return s.replace('\\"', '"').replace('\\\\', '\\')
+
+
+def parse_bsp(path):
+    files = {}
+    entry = None
+    key   = None
+
+    with open(path) as f:
+        for line in f:
+            m = re.match(r'^\t\t\["(.+)"\]=\{', line)
+            if m:
+                entry = files.setdefault(m.group(1), [])
+                continue
+
+            m = re.match(r'^\t\t\t\t\["key"\]="(.*)";', line)
+            if m:
+                key = lua_string(m.group(1))
+                continue
+
+            m = re.match(r'^\t\t\t\t\["value"\]="(.*)";', line)
+            if m and entry is not None and key is not None:
+                entry.append((key, lua_string(m.group(1))))
+                key = None
+
+    return files
+
+
+def apply_flags(path, flags):
+    with open(path) as f:
+        text = f.read()
+
+    missing = []
+
+    for key, value in flags:
+        define = re.compile(r'^(#define[ \t]+' + re.escape(key) + r')[ \t]+.*$', re.M)
+        make   = re.compile(r'^(' + re.escape(key) + r')=.*$', re.M)
+
+        if not define.search(text):
+            missing.append(key)
+            continue
+
+        text = define.sub(lambda m: m.group(1) + " " + value, text)
+        text = make.sub(lambda m: m.group(1) + "=" + value, text)
+
+    with open(path, "w") as f:
+        f.write(text)
+
+    return missing
+
+
+status = 0
+
+for name, flags in sorted(parse_bsp(bsp_file).items()):
+    path = os.path.join(config_dir, name)
+
+    if not os.path.isfile(path):
+        print("loadbsp: %s: configuration file does not exist" % name)
+        status = 1
+        continue
+
+    for key in apply_flags(path, flags):
+        print("loadbsp: %s: flag %s does not exist" % (name, key))
+        status = 1
+
+exit(status)